@@ -0,0 +1,24 @@
+# Find the LZ4 include files and library.
+#
+# LZ4 is a fast lossless compression library. See http://lz4.github.io/lz4/
+# for more details.
+#
+# This module defines:
+# LZ4_INCLUDE_DIRS - where to find lz4.h
+# LZ4_LIBRARIES - the libraries to link against to use LZ4
+# LZ4_FOUND - if false the library was not found.
+
+find_path(LZ4_INCLUDE_DIR "lz4.h"
+  DOC "Specify the LZ4 include directory here")
+
+find_library(LZ4_LIBRARY
+  NAMES lz4 liblz4
+  DOC "Specify the LZ4 library here")
+set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+set(LZ4_LIBRARIES "${LZ4_LIBRARY}")
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4 DEFAULT_MSG
+  LZ4_LIBRARIES LZ4_INCLUDE_DIRS)
+
+mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARY)
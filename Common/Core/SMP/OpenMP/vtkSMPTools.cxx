@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkCriticalSection.h"
+
+#include <omp.h>
+
+#include <vector>
+
+static bool vtkSMPToolsInitialized = false;
+static int vtkSMPToolsNumberOfThreads = 0;
+static bool vtkSMPToolsNestedParallelism = false;
+static vtkSimpleCriticalSection vtkSMPToolsCS;
+
+// Thread ids used by vtkSMPThreadLocal. omp_get_thread_num() is only unique
+// within a team, so every OS thread that asks gets its own process-wide id
+// the first time instead. OpenMP runtimes reuse their worker threads so the
+// ids stay small in practice.
+static int vtkSMPToolsNextThreadID = 0;
+static int vtkSMPToolsThreadID = -1;
+#pragma omp threadprivate(vtkSMPToolsThreadID)
+
+static vtkSimpleCriticalSection vtkSMPToolsThreadLocalCS;
+
+VTKCOMMONCORE_EXPORT int vtkSMPToolsGetNumberOfThreads()
+{
+  vtkSMPTools::Initialize();
+
+  return vtkSMPToolsNumberOfThreads;
+}
+
+VTKCOMMONCORE_EXPORT int vtkSMPToolsGetThreadID()
+{
+  if (vtkSMPToolsThreadID < 0)
+    {
+    int id;
+#pragma omp atomic capture
+    id = vtkSMPToolsNextThreadID++;
+    vtkSMPToolsThreadID = id;
+    }
+  return vtkSMPToolsThreadID;
+}
+
+VTKCOMMONCORE_EXPORT vtkSimpleCriticalSection& vtkSMPToolsGetThreadLocalLock()
+{
+  return vtkSMPToolsThreadLocalCS;
+}
+
+VTKCOMMONCORE_EXPORT void vtkSMPToolsImplForOpenMP(
+  vtkIdType first, vtkIdType last, vtkIdType grain,
+  vtkSMPToolsExecuteFunctorType execute, void* functor)
+{
+  int numThreads = vtkSMPToolsGetNumberOfThreads();
+  int inParallel = omp_in_parallel();
+  if (numThreads < 2 || (inParallel && !vtkSMPToolsNestedParallelism))
+    {
+    execute(functor, first, last);
+    return;
+    }
+
+  vtkIdType n = last - first;
+  if (grain <= 0)
+    {
+    // A few chunks per thread so that dynamic scheduling can balance
+    // irregular work.
+    vtkIdType estimate = n / (static_cast<vtkIdType>(numThreads) * 4);
+    grain = (estimate > 0) ? estimate : 1;
+    }
+  vtkIdType numChunks = (n + grain - 1) / grain;
+
+  // Nesting is a property of the calling task, restore it when done.
+  int wasNested = omp_get_nested();
+  if (inParallel)
+    {
+    omp_set_nested(1);
+    }
+
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+    {
+    vtkIdType from = first + chunk * grain;
+    vtkIdType to = (last - from > grain) ? from + grain : last;
+    execute(functor, from, to);
+    }
+
+  if (inParallel)
+    {
+    omp_set_nested(wasNested);
+    }
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtkSMPToolsCS.Lock();
+  if (!vtkSMPToolsInitialized)
+    {
+    // omp_get_max_threads() honors OMP_NUM_THREADS.
+    vtkSMPToolsNumberOfThreads =
+      numThreads > 0 ? numThreads : omp_get_max_threads();
+    // The default for nested parallelism comes from OMP_NESTED.
+    vtkSMPToolsNestedParallelism = omp_get_nested() != 0;
+    vtkSMPToolsInitialized = true;
+    }
+  vtkSMPToolsCS.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  vtkSMPTools::Initialize();
+  vtkSMPToolsNestedParallelism = isNested;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  vtkSMPTools::Initialize();
+  return vtkSMPToolsNestedParallelism;
+}
+
+//--------------------------------------------------------------------------------
+// Tasks added outside of a parallel section are queued and executed by a
+// parallel loop in Wait(). Inside a parallel section they become OpenMP
+// tasks. A taskwait only waits for the children of the waiting task, so
+// each task also waits for its own children before it completes, and the
+// taskwait in Wait() covers the whole tree of tasks.
+class vtkSMPTaskGroupInternals
+{
+public:
+  vtkSimpleCriticalSection Lock;
+  std::vector<vtk::detail::smp::vtkSMPToolsTask*> Queued;
+};
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::TaskGroup()
+{
+  this->Internals = new vtkSMPTaskGroupInternals;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::~TaskGroup()
+{
+  this->Wait();
+  delete this->Internals;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::RunTask(vtk::detail::smp::vtkSMPToolsTask* task)
+{
+  if (omp_in_parallel())
+    {
+#pragma omp task firstprivate(task)
+      {
+      task->Execute();
+      delete task;
+#pragma omp taskwait
+      }
+    return;
+    }
+
+  this->Internals->Lock.Lock();
+  this->Internals->Queued.push_back(task);
+  this->Internals->Lock.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Wait()
+{
+  int numThreads = vtkSMPToolsGetNumberOfThreads();
+  int inParallel = omp_in_parallel();
+  // Like For(), only start a team of threads inside a parallel section
+  // when nested parallelism is enabled.
+  if (inParallel && !vtkSMPToolsNestedParallelism)
+    {
+    numThreads = 1;
+    }
+  for (;;)
+    {
+    // Tasks may add more tasks to the group while they run.
+    std::vector<vtk::detail::smp::vtkSMPToolsTask*> tasks;
+    this->Internals->Lock.Lock();
+    tasks.swap(this->Internals->Queued);
+    this->Internals->Lock.Unlock();
+    if (tasks.empty())
+      {
+      break;
+      }
+
+    int numTasks = static_cast<int>(tasks.size());
+    if (numThreads < 2 || numTasks < 2)
+      {
+      for (int i = 0; i < numTasks; ++i)
+        {
+        tasks[i]->Execute();
+        delete tasks[i];
+        }
+      continue;
+      }
+
+    int wasNested = omp_get_nested();
+    if (inParallel)
+      {
+      omp_set_nested(1);
+      }
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (int i = 0; i < numTasks; ++i)
+      {
+      tasks[i]->Execute();
+      delete tasks[i];
+      }
+    if (inParallel)
+      {
+      omp_set_nested(wasNested);
+      }
+    }
+
+  if (inParallel)
+    {
+#pragma omp taskwait
+    }
+}
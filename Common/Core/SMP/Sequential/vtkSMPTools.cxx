@@ -21,3 +21,40 @@
 void vtkSMPTools::Initialize(int)
 {
 }
+
+static bool vtkSMPToolsNestedParallelism = false;
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  vtkSMPToolsNestedParallelism = isNested;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  return vtkSMPToolsNestedParallelism;
+}
+
+//--------------------------------------------------------------------------------
+// Tasks are executed as soon as they are added.
+vtkSMPTools::TaskGroup::TaskGroup() : Internals(0)
+{
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::~TaskGroup()
+{
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::RunTask(vtk::detail::smp::vtkSMPToolsTask* task)
+{
+  task->Execute();
+  delete task;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Wait()
+{
+}
@@ -15,16 +15,369 @@
 
 #include "vtkSMPTools.h"
 
-#include "vtkObjectFactory.h"
+#include "vtkAtomicInt.h"
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 
-#include <pthread.h>
+#include <deque>
+#include <vector>
 
-static bool vtkSMPToolsInitialized = false;
+// The Simple backend runs everything on a persistent pool of threads
+// created by vtkMultiThreader. Each thread, including the one that
+// initialized the pool, owns a queue of work. New work is spread over all
+// the queues, a thread takes work from the back of its own queue and, once
+// it is empty, steals from the front of the other queues. A thread waiting
+// for work to complete executes queued work instead of blocking, which also
+// makes nested parallel sections safe.
+//
+// Threads that are neither in the pool nor the thread that initialized it
+// get the thread ids that follow vtkSMPToolsNumberOfThreads, in the order
+// in which they first ask for one, and can run parallel sections at the
+// same time as the pool threads and each other. Their thread local objects
+// are created and looked up under vtkSMPToolsThreadLocalCS.
+
+static vtkAtomicInt<vtkTypeInt32> vtkSMPToolsInitialized(0);
 static int vtkSMPToolsNumberOfThreads = 0;
+static vtkSimpleCriticalSection vtkSMPToolsCS;
 
+// Written before vtkSMPToolsInitialized is set, read only afterwards.
 static std::vector<vtkMultiThreaderIDType> vtkSMPToolsThreadIds;
 
-//static pthread_barrier_t barr;
+static std::vector<vtkMultiThreaderIDType> vtkSMPToolsExternalThreadIds;
+static vtkSimpleCriticalSection vtkSMPToolsExternalCS;
+static vtkSimpleCriticalSection vtkSMPToolsThreadLocalCS;
+
+VTKCOMMONCORE_EXPORT int vtkSMPToolsGetThreadID();
+
+namespace
+{
+//--------------------------------------------------------------------------------
+// A unit of work of the pool. Pending is decremented once it has run.
+class vtkSMPToolsWork
+{
+public:
+  vtkAtomicInt<vtkTypeInt32>* Pending;
+  bool Owned;
+
+  vtkSMPToolsWork() : Pending(0), Owned(false) {}
+  virtual ~vtkSMPToolsWork() {}
+  virtual void Run() = 0;
+};
+
+//--------------------------------------------------------------------------------
+// A contiguous piece of the range of a For(), executed in pieces of at
+// most Grain items when Grain is not 0.
+class vtkSMPToolsForChunk : public vtkSMPToolsWork
+{
+public:
+  vtkSMPToolsExecuteFunctorType Execute;
+  void* Functor;
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+
+  virtual void Run()
+  {
+    if (this->Grain <= 0)
+      {
+      this->Execute(this->Functor, this->First, this->Last);
+      return;
+      }
+    for (vtkIdType b = this->First; b < this->Last; b += this->Grain)
+      {
+      vtkIdType e = (this->Last - b > this->Grain) ? b + this->Grain : this->Last;
+      this->Execute(this->Functor, b, e);
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// A task added to a vtkSMPTools::TaskGroup.
+class vtkSMPToolsGroupTask : public vtkSMPToolsWork
+{
+public:
+  vtk::detail::smp::vtkSMPToolsTask* Task;
+
+  virtual ~vtkSMPToolsGroupTask()
+  {
+    delete this->Task;
+  }
+
+  virtual void Run()
+  {
+    this->Task->Execute();
+  }
+};
+
+//--------------------------------------------------------------------------------
+class vtkSMPToolsThreadPool
+{
+public:
+  vtkSMPToolsThreadPool(int numThreads);
+  ~vtkSMPToolsThreadPool();
+
+  // Spreads work over the queues, starting with the queue of the calling
+  // thread, and wakes up idle threads.
+  void Submit(vtkSMPToolsWork** work, size_t count);
+
+  // Executes queued work until pending drops to zero.
+  void WaitFor(vtkAtomicInt<vtkTypeInt32>& pending);
+
+private:
+  struct Queue
+  {
+    vtkSimpleCriticalSection Lock;
+    std::deque<vtkSMPToolsWork*> Work;
+  };
+
+  struct WorkerArgs
+  {
+    vtkSMPToolsThreadPool* Pool;
+    int Index;
+  };
+
+  vtkSMPToolsWork* FindWork(int self);
+  void Execute(vtkSMPToolsWork* work);
+  void Notify();
+  void Sleep(vtkTypeInt64 version, vtkAtomicInt<vtkTypeInt32>* pending);
+
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void* arg);
+
+  std::vector<Queue*> Queues;
+  std::vector<WorkerArgs> Args;
+  std::vector<int> SpawnedIds;
+  vtkMultiThreader* Threader;
+
+  // The number of workers that have recorded their id.
+  int Registered;
+
+  // Version is bumped, and sleeping threads woken up, whenever work is
+  // submitted or completes a wait.
+  vtkSimpleMutexLock SleepLock;
+  vtkSimpleConditionVariable WakeUp;
+  vtkAtomicInt<vtkTypeInt64> Version;
+  vtkAtomicInt<vtkTypeInt32> Shutdown;
+};
+
+static vtkSMPToolsThreadPool* vtkSMPToolsPool = 0;
+
+// Destroys the pool, and joins its threads, at exit.
+class vtkSMPToolsPoolCleanup
+{
+public:
+  ~vtkSMPToolsPoolCleanup()
+  {
+    delete vtkSMPToolsPool;
+    vtkSMPToolsPool = 0;
+  }
+};
+static vtkSMPToolsPoolCleanup vtkSMPToolsPoolCleanupInstance;
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsThreadPool::vtkSMPToolsThreadPool(int numThreads)
+  : Registered(0), Version(0), Shutdown(0)
+{
+  this->Queues.resize(numThreads);
+  for (int i = 0; i < numThreads; ++i)
+    {
+    this->Queues[i] = new Queue;
+    }
+
+  // Thread 0 is the thread that created the pool.
+  this->Threader = vtkMultiThreader::New();
+  this->Args.resize(numThreads);
+  for (int i = 1; i < numThreads; ++i)
+    {
+    this->Args[i].Pool = this;
+    this->Args[i].Index = i;
+    int id = this->Threader->SpawnThread(
+      vtkSMPToolsThreadPool::WorkerMain, &this->Args[i]);
+    if (id >= 0)
+      {
+      this->SpawnedIds.push_back(id);
+      }
+    }
+
+  // vtkSMPToolsThreadIds must be complete before Initialize() returns.
+  this->SleepLock.Lock();
+  while (this->Registered < static_cast<int>(this->SpawnedIds.size()))
+    {
+    this->WakeUp.Wait(this->SleepLock);
+    }
+  this->SleepLock.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsThreadPool::~vtkSMPToolsThreadPool()
+{
+  this->Shutdown = 1;
+  this->Notify();
+  for (size_t i = 0; i < this->SpawnedIds.size(); ++i)
+    {
+    this->Threader->TerminateThread(this->SpawnedIds[i]);
+    }
+  this->Threader->Delete();
+
+  for (size_t i = 0; i < this->Queues.size(); ++i)
+    {
+    delete this->Queues[i];
+    }
+}
+
+//--------------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkSMPToolsThreadPool::WorkerMain(void* varg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(varg);
+  WorkerArgs* args = static_cast<WorkerArgs*>(info->UserData);
+  vtkSMPToolsThreadPool* self = args->Pool;
+  int index = args->Index;
+
+  vtkSMPToolsThreadIds[index] = vtkMultiThreader::GetCurrentThreadID();
+  self->SleepLock.Lock();
+  ++self->Registered;
+  self->WakeUp.Broadcast();
+  self->SleepLock.Unlock();
+
+  while (!self->Shutdown.load())
+    {
+    vtkTypeInt64 version = self->Version.load();
+    vtkSMPToolsWork* work = self->FindWork(index);
+    if (work)
+      {
+      self->Execute(work);
+      }
+    else
+      {
+      self->Sleep(version, 0);
+      }
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsWork* vtkSMPToolsThreadPool::FindWork(int self)
+{
+  int numQueues = static_cast<int>(this->Queues.size());
+  vtkSMPToolsWork* work = 0;
+
+  if (self >= 0 && self < numQueues)
+    {
+    Queue* own = this->Queues[self];
+    own->Lock.Lock();
+    if (!own->Work.empty())
+      {
+      work = own->Work.back();
+      own->Work.pop_back();
+      }
+    own->Lock.Unlock();
+    if (work)
+      {
+      return work;
+      }
+    }
+
+  int start = (self >= 0 && self < numQueues) ? self : 0;
+  for (int i = 1; i <= numQueues && !work; ++i)
+    {
+    Queue* victim = this->Queues[(start + i) % numQueues];
+    victim->Lock.Lock();
+    if (!victim->Work.empty())
+      {
+      work = victim->Work.front();
+      victim->Work.pop_front();
+      }
+    victim->Lock.Unlock();
+    }
+  return work;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::Execute(vtkSMPToolsWork* work)
+{
+  // Once Pending is decremented the work may be destroyed by its owner.
+  vtkAtomicInt<vtkTypeInt32>* pending = work->Pending;
+  work->Run();
+  if (work->Owned)
+    {
+    delete work;
+    }
+  if (--(*pending) == 0)
+    {
+    this->Notify();
+    }
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::Notify()
+{
+  this->SleepLock.Lock();
+  ++this->Version;
+  this->WakeUp.Broadcast();
+  this->SleepLock.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::Sleep(vtkTypeInt64 version,
+                                  vtkAtomicInt<vtkTypeInt32>* pending)
+{
+  this->SleepLock.Lock();
+  while (this->Version.load() == version && !this->Shutdown.load() &&
+         (!pending || pending->load() > 0))
+    {
+    this->WakeUp.Wait(this->SleepLock);
+    }
+  this->SleepLock.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::Submit(vtkSMPToolsWork** work, size_t count)
+{
+  int numQueues = static_cast<int>(this->Queues.size());
+  int self = vtkSMPToolsGetThreadID();
+  int start = self < numQueues ? self : 0;
+  for (int q = 0; q < numQueues && static_cast<size_t>(q) < count; ++q)
+    {
+    Queue* queue = this->Queues[(start + q) % numQueues];
+    queue->Lock.Lock();
+    for (size_t i = q; i < count; i += numQueues)
+      {
+      queue->Work.push_back(work[i]);
+      }
+    queue->Lock.Unlock();
+    }
+  this->Notify();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::WaitFor(vtkAtomicInt<vtkTypeInt32>& pending)
+{
+  int self = vtkSMPToolsGetThreadID();
+  while (pending.load() > 0)
+    {
+    vtkTypeInt64 version = this->Version.load();
+    vtkSMPToolsWork* work = this->FindWork(self);
+    if (work)
+      {
+      this->Execute(work);
+      }
+    else
+      {
+      this->Sleep(version, &pending);
+      }
+    }
+}
+}
+
+//--------------------------------------------------------------------------------
+class vtkSMPTaskGroupInternals
+{
+public:
+  vtkAtomicInt<vtkTypeInt32> Pending;
+};
 
 VTKCOMMONCORE_EXPORT void vtkSMPToolsInitialize()
 {
@@ -43,29 +396,107 @@ VTKCOMMONCORE_EXPORT int vtkSMPToolsGetThreadID()
   vtkSMPTools::Initialize();
 
   vtkMultiThreaderIDType rawID = vtkMultiThreader::GetCurrentThreadID();
-  size_t numIDs = vtkSMPToolsThreadIds.size();
-  for (size_t i=0; i<numIDs; i++)
+  int numIDs = static_cast<int>(vtkSMPToolsThreadIds.size());
+  for (int i=0; i<numIDs; i++)
     {
-    if (vtkSMPToolsThreadIds[i] == rawID)
+    if (vtkMultiThreader::ThreadsEqual(vtkSMPToolsThreadIds[i], rawID))
       {
       return i;
       }
     }
-  return -1;
+
+  // A thread outside of the pool. A thread created after another one has
+  // exited may get the same raw id, and then the same thread id.
+  vtkSMPToolsExternalCS.Lock();
+  size_t numExternal = vtkSMPToolsExternalThreadIds.size();
+  size_t external = 0;
+  while (external < numExternal && !vtkMultiThreader::ThreadsEqual(
+           vtkSMPToolsExternalThreadIds[external], rawID))
+    {
+    external++;
+    }
+  if (external == numExternal)
+    {
+    vtkSMPToolsExternalThreadIds.push_back(rawID);
+    }
+  vtkSMPToolsExternalCS.Unlock();
+  return numIDs + static_cast<int>(external);
 }
 
-VTKCOMMONCORE_EXPORT std::vector<vtkMultiThreaderIDType>& vtkSMPToolsGetThreadIds()
+VTKCOMMONCORE_EXPORT void vtkSMPToolsLockThreadLocal()
 {
-  return vtkSMPToolsThreadIds;
+  vtkSMPToolsThreadLocalCS.Lock();
+}
+
+VTKCOMMONCORE_EXPORT void vtkSMPToolsUnlockThreadLocal()
+{
+  vtkSMPToolsThreadLocalCS.Unlock();
+}
+
+VTKCOMMONCORE_EXPORT void vtkSMPToolsImplForSimple(
+  vtkIdType first, vtkIdType last, vtkIdType grain,
+  vtkSMPToolsExecuteFunctorType execute, void* functor)
+{
+  int numThreads = vtkSMPToolsGetNumberOfThreads();
+  vtkIdType n = last - first;
+
+  // Split into a few chunks per thread so that idle threads have something
+  // to steal, but never below the grain.
+  vtkIdType chunkSize = n / (static_cast<vtkIdType>(numThreads) * 8);
+  if (chunkSize < grain)
+    {
+    chunkSize = grain;
+    }
+  if (chunkSize < 1)
+    {
+    chunkSize = 1;
+    }
+  if (numThreads < 2 || chunkSize >= n)
+    {
+    vtkSMPToolsForChunk chunk;
+    chunk.Execute = execute;
+    chunk.Functor = functor;
+    chunk.First = first;
+    chunk.Last = last;
+    chunk.Grain = grain;
+    chunk.Run();
+    return;
+    }
+
+  vtkIdType numChunks = (n + chunkSize - 1) / chunkSize;
+  vtkAtomicInt<vtkTypeInt32> pending(static_cast<vtkTypeInt32>(numChunks));
+  std::vector<vtkSMPToolsForChunk> chunks(numChunks);
+  std::vector<vtkSMPToolsWork*> work(numChunks);
+  for (vtkIdType i = 0; i < numChunks; ++i)
+    {
+    vtkSMPToolsForChunk& chunk = chunks[i];
+    chunk.Pending = &pending;
+    chunk.Execute = execute;
+    chunk.Functor = functor;
+    chunk.First = first + i * chunkSize;
+    chunk.Last = (last - chunk.First > chunkSize) ? chunk.First + chunkSize : last;
+    chunk.Grain = grain;
+    work[i] = &chunk;
+    }
+
+  vtkSMPToolsPool->Submit(&work[0], work.size());
+  vtkSMPToolsPool->WaitFor(pending);
 }
 
 //--------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int nThreads)
 {
-  if (vtkSMPToolsInitialized)
+  // Every thread id lookup calls this, so only the first call may lock.
+  if (vtkSMPToolsInitialized.load())
     {
     return;
     }
+  vtkSMPToolsCS.Lock();
+  if (vtkSMPToolsInitialized.load())
+    {
+    vtkSMPToolsCS.Unlock();
+    return;
+    }
   if (nThreads == 0)
     {
     vtkSMPToolsNumberOfThreads =
@@ -75,9 +506,76 @@ void vtkSMPTools::Initialize(int nThreads)
     {
     vtkSMPToolsNumberOfThreads = nThreads;
     }
-
-  vtkSMPToolsInitialized = true;
+  // The pool threads are spawned by a single vtkMultiThreader.
+  if (vtkSMPToolsNumberOfThreads > VTK_MAX_THREADS)
+    {
+    vtkSMPToolsNumberOfThreads = VTK_MAX_THREADS;
+    }
 
   vtkSMPToolsThreadIds.resize(vtkSMPToolsNumberOfThreads);
   vtkSMPToolsThreadIds[0] = vtkMultiThreader::GetCurrentThreadID();
+
+  if (vtkSMPToolsNumberOfThreads > 1)
+    {
+    vtkSMPToolsPool = new vtkSMPToolsThreadPool(vtkSMPToolsNumberOfThreads);
+    }
+
+  vtkSMPToolsInitialized = 1;
+  vtkSMPToolsCS.Unlock();
+}
+
+static bool vtkSMPToolsNestedParallelism = false;
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  vtkSMPToolsNestedParallelism = isNested;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  return vtkSMPToolsNestedParallelism;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::TaskGroup()
+{
+  this->Internals = new vtkSMPTaskGroupInternals;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::~TaskGroup()
+{
+  this->Wait();
+  delete this->Internals;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::RunTask(vtk::detail::smp::vtkSMPToolsTask* task)
+{
+  vtkSMPTools::Initialize();
+  if (!vtkSMPToolsPool)
+    {
+    task->Execute();
+    delete task;
+    return;
+    }
+
+  vtkSMPToolsGroupTask* work = new vtkSMPToolsGroupTask;
+  work->Pending = &this->Internals->Pending;
+  work->Owned = true;
+  work->Task = task;
+  ++this->Internals->Pending;
+  vtkSMPToolsWork* item = work;
+  vtkSMPToolsPool->Submit(&item, 1);
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Wait()
+{
+  if (vtkSMPToolsPool)
+    {
+    vtkSMPToolsPool->WaitFor(this->Internals->Pending);
+    }
 }
@@ -17,6 +17,7 @@
 
 #include "vtkCriticalSection.h"
 
+#include <tbb/task_group.h>
 #include <tbb/task_scheduler_init.h>
 
 struct vtkSMPToolsInit
@@ -47,3 +48,63 @@ void vtkSMPTools::Initialize(int numThreads)
     }
   vtkSMPToolsCS.Unlock();
 }
+
+static bool vtkSMPToolsNestedParallelism = false;
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  vtkSMPToolsNestedParallelism = isNested;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  return vtkSMPToolsNestedParallelism;
+}
+
+class vtkSMPTaskGroupInternals
+{
+public:
+  tbb::task_group Group;
+};
+
+namespace
+{
+struct vtkSMPToolsTaskRunner
+{
+  vtk::detail::smp::vtkSMPToolsTask* Task;
+
+  void operator()() const
+    {
+      this->Task->Execute();
+      delete this->Task;
+    }
+};
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::TaskGroup()
+{
+  this->Internals = new vtkSMPTaskGroupInternals;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::~TaskGroup()
+{
+  this->Wait();
+  delete this->Internals;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::RunTask(vtk::detail::smp::vtkSMPToolsTask* task)
+{
+  vtkSMPToolsTaskRunner runner = { task };
+  this->Internals->Group.run(runner);
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Wait()
+{
+  this->Internals->Group.wait();
+}
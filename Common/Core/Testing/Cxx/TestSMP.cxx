@@ -13,6 +13,8 @@
 
 =========================================================================*/
 #include "vtkSMPThreadLocal.h"
+#include "vtkAtomicInt.h"
+#include "vtkMultiThreader.h"
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
@@ -89,10 +91,110 @@ public:
 
 };
 
+class NestedFunctor
+{
+public:
+  vtkSMPThreadLocal<int> Counter;
+
+  NestedFunctor(): Counter(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i=begin; i<end; i++)
+      {
+      ARangeFunctor inner;
+      vtkSMPTools::For(0, 100, inner);
+      for (vtkSMPThreadLocal<int>::iterator itr = inner.Counter.begin();
+           itr != inner.Counter.end(); ++itr)
+        {
+        this->Counter.Local() += *itr;
+        }
+      }
+  }
+};
+
+// Counts the leaves of a binary tree of tasks, each level spawning its
+// children into the same group.
+class TreeTask
+{
+public:
+  vtkSMPTools::TaskGroup* Group;
+  vtkAtomicInt<vtkTypeInt32>* Leaves;
+  int Depth;
+
+  void operator()() const
+  {
+    if (this->Depth == 0)
+      {
+      ++(*this->Leaves);
+      return;
+      }
+    TreeTask child = *this;
+    child.Depth--;
+    vtkSMPTools::Spawn(*this->Group, child);
+    vtkSMPTools::Spawn(*this->Group, child);
+  }
+};
+
+// Waits for a tree of tasks inside a parallel section, and counts the
+// waits that returned before all the leaves had run.
+class TaskTreeFunctor
+{
+public:
+  vtkAtomicInt<vtkTypeInt32>* Failures;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkAtomicInt<vtkTypeInt32> leaves(0);
+      vtkSMPTools::TaskGroup group;
+      TreeTask root = { &group, &leaves, 6 };
+      vtkSMPTools::Spawn(group, root);
+      group.Wait();
+      if (leaves != 64)
+        {
+        ++(*this->Failures);
+        }
+      }
+  }
+};
+
+// Runs a parallel section from threads that vtkSMPTools does not know
+// about, and counts the ones that did not get the right result.
+VTK_THREAD_RETURN_TYPE ForFromOtherThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkAtomicInt<vtkTypeInt32>* failures =
+    static_cast<vtkAtomicInt<vtkTypeInt32>*>(info->UserData);
+  for (int run = 0; run < 10; ++run)
+    {
+    ARangeFunctor functor;
+    vtkSMPTools::For(0, Target, functor);
+    int total = 0;
+    for (vtkSMPThreadLocal<int>::iterator itr = functor.Counter.begin();
+         itr != functor.Counter.end(); ++itr)
+      {
+      total += *itr;
+      }
+    if (total != Target)
+      {
+      ++(*failures);
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 int TestSMP(int, char*[])
 {
   //vtkSMPTools::Initialize(8);
 
+  // Several threads even on a single core, so that the pool is used
+  vtkSMPTools::Initialize(4);
+
   ARangeFunctor functor1;
 
   vtkSMPTools::For(0, Target, functor1);
@@ -135,5 +237,66 @@ int TestSMP(int, char*[])
     return 1;
     }
 
+  // Nested parallel sections must produce the same result whether or not
+  // the backend actually nests them.
+  for (int nested = 0; nested < 2; ++nested)
+    {
+    vtkSMPTools::SetNestedParallelism(nested != 0);
+    if (vtkSMPTools::GetNestedParallelism() != (nested != 0))
+      {
+      cerr << "Error: SetNestedParallelism was not honored" << endl;
+      return 1;
+      }
+
+    NestedFunctor functor3;
+    vtkSMPTools::For(0, 100, functor3);
+
+    total = 0;
+    for (vtkSMPThreadLocal<int>::iterator itr3 = functor3.Counter.begin();
+         itr3 != functor3.Counter.end(); ++itr3)
+      {
+      total += *itr3;
+      }
+    if (total != Target)
+      {
+      cerr << "Error: NestedFunctor did not generate " << Target << endl;
+      return 1;
+      }
+    }
+  vtkSMPTools::SetNestedParallelism(false);
+
+  vtkAtomicInt<vtkTypeInt32> leaves(0);
+  vtkSMPTools::TaskGroup group;
+  TreeTask root = { &group, &leaves, 10 };
+  vtkSMPTools::Spawn(group, root);
+  group.Wait();
+  if (leaves != 1024)
+    {
+    cerr << "Error: TaskGroup ran " << leaves << " leaf tasks instead of 1024"
+         << endl;
+    return 1;
+    }
+
+  vtkAtomicInt<vtkTypeInt32> failures(0);
+  TaskTreeFunctor functor4 = { &failures };
+  vtkSMPTools::For(0, 16, functor4);
+  if (failures != 0)
+    {
+    cerr << "Error: " << failures << " waits in a parallel section returned "
+         << "before the tasks spawned by tasks were done" << endl;
+    return 1;
+    }
+
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(4);
+  threader->SetSingleMethod(ForFromOtherThread, &failures);
+  threader->SingleMethodExecute();
+  if (failures != 0)
+    {
+    cerr << "Error: " << failures << " parallel sections run from other "
+         << "threads did not generate " << Target << endl;
+    return 1;
+    }
+
   return 0;
 }
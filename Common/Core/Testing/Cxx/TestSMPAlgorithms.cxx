@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPAlgorithms.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkSMPTools::Sort, Transform, Fill, InclusiveScan, ExclusiveScan
+// and Reduce against their serial std counterparts.
+
+#include "vtkSMPTools.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+static const int Size = 100003;
+
+namespace
+{
+struct Square
+{
+  double operator()(int x) const
+  {
+    return static_cast<double>(x) * x;
+  }
+};
+
+struct Subtract
+{
+  int operator()(int a, int b) const
+  {
+    return a - b;
+  }
+};
+
+// Associative but not commutative: keeps the first and last value seen.
+struct FirstLast
+{
+  std::pair<int, int> operator()(const std::pair<int, int>& a,
+                                 const std::pair<int, int>& b) const
+  {
+    return std::make_pair(a.first, b.second);
+  }
+};
+}
+
+int TestSMPAlgorithms(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775070);
+
+  std::vector<int> values(Size);
+  for (int i = 0; i < Size; ++i)
+    {
+    random->Next();
+    values[i] = static_cast<int>(random->GetRangeValue(-1000, 1000));
+    }
+
+  // Sort
+  std::vector<int> sorted(values);
+  std::vector<int> expected(values);
+  vtkSMPTools::Sort(sorted.begin(), sorted.end());
+  std::sort(expected.begin(), expected.end());
+  if (sorted != expected)
+    {
+    cerr << "Error: Sort did not produce a sorted sequence." << endl;
+    return EXIT_FAILURE;
+    }
+
+  sorted = values;
+  vtkSMPTools::Sort(&sorted[0], &sorted[0] + Size, std::greater<int>());
+  std::reverse(expected.begin(), expected.end());
+  if (sorted != expected)
+    {
+    cerr << "Error: Sort with a comparator failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Transform
+  std::vector<double> squares(Size);
+  vtkSMPTools::Transform(values.begin(), values.end(), squares.begin(), Square());
+  for (int i = 0; i < Size; ++i)
+    {
+    if (squares[i] != static_cast<double>(values[i]) * values[i])
+      {
+      cerr << "Error: Transform produced a wrong value at " << i << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::vector<int> differences(Size);
+  vtkSMPTools::Transform(values.begin(), values.end(), sorted.begin(),
+                         differences.begin(), Subtract());
+  for (int i = 0; i < Size; ++i)
+    {
+    if (differences[i] != values[i] - sorted[i])
+      {
+      cerr << "Error: binary Transform produced a wrong value at " << i << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Fill
+  std::vector<std::string> strings(Size);
+  vtkSMPTools::Fill(strings.begin(), strings.end(), std::string("vtk"));
+  if (std::count(strings.begin(), strings.end(), "vtk") != Size)
+    {
+    cerr << "Error: Fill did not assign all values." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Scans
+  std::vector<int> scan(Size);
+  std::vector<int> expectedScan(Size);
+  vtkSMPTools::InclusiveScan(values.begin(), values.end(), scan.begin());
+  std::partial_sum(values.begin(), values.end(), expectedScan.begin());
+  if (scan != expectedScan)
+    {
+    cerr << "Error: InclusiveScan failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // In place exclusive scan, as used to turn counts into offsets.
+  scan = values;
+  vtkSMPTools::ExclusiveScan(scan.begin(), scan.end(), scan.begin(), 7);
+  expectedScan[0] = 7;
+  for (int i = 1; i < Size; ++i)
+    {
+    expectedScan[i] = expectedScan[i - 1] + values[i - 1];
+    }
+  if (scan != expectedScan)
+    {
+    cerr << "Error: ExclusiveScan failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  std::vector<std::pair<int, int> > pairs(Size);
+  for (int i = 0; i < Size; ++i)
+    {
+    pairs[i] = std::make_pair(i, i);
+    }
+  std::vector<std::pair<int, int> > pairScan(Size);
+  vtkSMPTools::InclusiveScan(pairs.begin(), pairs.end(), pairScan.begin(),
+                             FirstLast());
+  for (int i = 0; i < Size; ++i)
+    {
+    if (pairScan[i].first != 0 || pairScan[i].second != i)
+      {
+      cerr << "Error: InclusiveScan did not preserve order at " << i << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Reduce
+  long long sum = vtkSMPTools::Reduce(values.begin(), values.end(), 0LL);
+  long long expectedSum = std::accumulate(values.begin(), values.end(), 0LL);
+  if (sum != expectedSum)
+    {
+    cerr << "Error: Reduce returned " << sum << " instead of "
+         << expectedSum << endl;
+    return EXIT_FAILURE;
+    }
+
+  std::pair<int, int> firstLast = vtkSMPTools::Reduce(
+    pairs.begin(), pairs.end(), std::make_pair(-1, -1), FirstLast());
+  if (firstLast.first != -1 || firstLast.second != Size - 1)
+    {
+    cerr << "Error: Reduce did not preserve order." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Empty ranges must be no-ops.
+  std::vector<int> empty;
+  vtkSMPTools::Sort(empty.begin(), empty.end());
+  vtkSMPTools::InclusiveScan(empty.begin(), empty.end(), empty.begin());
+  vtkSMPTools::ExclusiveScan(empty.begin(), empty.end(), empty.begin(), 0);
+  if (vtkSMPTools::Reduce(empty.begin(), empty.end(), 3) != 3)
+    {
+    cerr << "Error: Reduce of an empty range did not return init." << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
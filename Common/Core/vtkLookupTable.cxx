@@ -414,6 +414,56 @@ inline unsigned char *vtkLinearLookup(
                          nanColor);
 }
 
+//----------------------------------------------------------------------------
+// Compute the offsets into the table of n values, in a loop that the
+// compiler can vectorize.  Not-a-number values get an offset of -1.
+#define VTK_LOOKUP_TABLE_CHUNK_SIZE 256
+
+template<class T>
+inline void vtkLinearLookupOffsets(
+  const T *input, int inIncr, int n, double maxIndex, double shift,
+  double scale, int *offsets)
+{
+  for (int k = 0; k < n; k++)
+    {
+    double findx = (input[k*inIncr] + shift)*scale;
+    findx = (findx > 0 ? findx : 0);
+    findx = (findx < maxIndex ? findx : maxIndex);
+    offsets[k] = 4*static_cast<int>(findx);
+    }
+}
+
+template<class T>
+inline void vtkLinearLookupOffsetsWithNan(
+  const T *input, int inIncr, int n, double maxIndex, double shift,
+  double scale, int *offsets)
+{
+  for (int k = 0; k < n; k++)
+    {
+    double v = input[k*inIncr];
+    double findx = (v + shift)*scale;
+    findx = (findx > 0 ? findx : 0);
+    findx = (findx < maxIndex ? findx : maxIndex);
+    offsets[k] = (vtkMath::IsNan(v) ? -1 : 4*static_cast<int>(findx));
+    }
+}
+
+inline void vtkLinearLookupOffsets(
+  const double *input, int inIncr, int n, double maxIndex, double shift,
+  double scale, int *offsets)
+{
+  vtkLinearLookupOffsetsWithNan(input, inIncr, n, maxIndex, shift, scale,
+                                offsets);
+}
+
+inline void vtkLinearLookupOffsets(
+  const float *input, int inIncr, int n, double maxIndex, double shift,
+  double scale, int *offsets)
+{
+  vtkLinearLookupOffsetsWithNan(input, inIncr, n, maxIndex, shift, scale,
+                                offsets);
+}
+
 //----------------------------------------------------------------------------
 void vtkLookupTable::GetLogRange(const double range[2], double log_range[2])
 {
@@ -640,55 +690,62 @@ void vtkLookupTableMapData(vtkLookupTable *self, T *input,
         scale = (maxIndex + 1)/(range[1] - range[0]);
         }
 
-      if (outFormat == VTK_RGBA)
+      // the offsets are computed by chunks, which is faster than
+      // looking up the values one at a time
+      int offsets[VTK_LOOKUP_TABLE_CHUNK_SIZE];
+      while (i > 0)
         {
-        while (--i >= 0)
+        int n = (i < VTK_LOOKUP_TABLE_CHUNK_SIZE ?
+                 i : VTK_LOOKUP_TABLE_CHUNK_SIZE);
+        vtkLinearLookupOffsets(input, inIncr, n, maxIndex, shift, scale,
+                               offsets);
+        input += n*inIncr;
+        i -= n;
+
+        if (outFormat == VTK_RGBA)
           {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = cptr[3];
-          input += inIncr;
-          output += 4;
+          for (int k = 0; k < n; k++)
+            {
+            cptr = (offsets[k] >= 0 ? &table[offsets[k]] : nanColor);
+            output[0] = cptr[0];
+            output[1] = cptr[1];
+            output[2] = cptr[2];
+            output[3] = cptr[3];
+            output += 4;
+            }
           }
-        }
-      else if (outFormat == VTK_RGB)
-        {
-        while (--i >= 0)
+        else if (outFormat == VTK_RGB)
           {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          input += inIncr;
-          output += 3;
+          for (int k = 0; k < n; k++)
+            {
+            cptr = (offsets[k] >= 0 ? &table[offsets[k]] : nanColor);
+            output[0] = cptr[0];
+            output[1] = cptr[1];
+            output[2] = cptr[2];
+            output += 3;
+            }
           }
-        }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-        {
-        while (--i >= 0)
+        else if (outFormat == VTK_LUMINANCE_ALPHA)
           {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
+          for (int k = 0; k < n; k++)
+            {
+            cptr = (offsets[k] >= 0 ? &table[offsets[k]] : nanColor);
+            output[0] = static_cast<unsigned char>(cptr[0]*0.30 +
+                                                   cptr[1]*0.59 +
+                                                   cptr[2]*0.11 + 0.5);
+            output[1] = cptr[3];
+            output += 2;
+            }
           }
-        }
-      else // outFormat == VTK_LUMINANCE
-        {
-        while (--i >= 0)
+        else // outFormat == VTK_LUMINANCE
           {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          *output++ = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          input += inIncr;
+          for (int k = 0; k < n; k++)
+            {
+            cptr = (offsets[k] >= 0 ? &table[offsets[k]] : nanColor);
+            *output++ = static_cast<unsigned char>(cptr[0]*0.30 +
+                                                   cptr[1]*0.59 +
+                                                   cptr[2]*0.11 + 0.5);
+            }
           }
         }
       }//if not log lookup
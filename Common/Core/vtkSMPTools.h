@@ -17,8 +17,8 @@
 // vtkSMPTools provides a set of utility functions that can
 // be used to parallelize parts of VTK code using multiple threads.
 // There are several back-end implementations of parallel functionality
-// (currently Sequential, TBB and X-Kaapi) that actual execution is
-// delegated to.
+// (currently Sequential, Simple, TBB, X-Kaapi and OpenMP) that actual
+// execution is delegated to.
 
 #ifndef __vtkSMPTools_h__
 #define __vtkSMPTools_h__
@@ -28,6 +28,9 @@
 
 #include "vtkSMPThreadLocal.h" // For Initialized
 
+#include <functional> // For std::less and std::plus
+#include <iterator>   // For std::iterator_traits
+
 class vtkSMPTools;
 
 #include "vtkSMPToolsInternal.h"
@@ -113,6 +116,27 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
     const vtkSMPTools_FunctorInternal<Functor, true>&);
 };
 
+// Type-erased unit of work handed to the backends by
+// vtkSMPTools::TaskGroup.
+class vtkSMPToolsTask
+{
+public:
+  virtual ~vtkSMPToolsTask() {}
+  virtual void Execute() = 0;
+};
+
+template <typename Functor>
+class vtkSMPToolsFunctorTask : public vtkSMPToolsTask
+{
+  Functor F;
+public:
+  vtkSMPToolsFunctorTask(const Functor& f): F(f) {}
+  virtual void Execute()
+  {
+    this->F();
+  }
+};
+
 template <typename Functor>
 class vtkSMPTools_Lookup_For
 {
@@ -134,9 +158,70 @@ public:
 #endif // __WRAP__
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
+class vtkSMPTaskGroupInternals;
+
 class VTKCOMMONCORE_EXPORT vtkSMPTools
 {
 public:
+  // Description:
+  // A set of tasks that can be waited on together. Tasks are added with
+  // Run() or vtkSMPTools::Spawn() and may execute concurrently with each
+  // other and with the calling thread, in any order. Wait() returns once
+  // every task added so far, including tasks added by other tasks of the
+  // group, has completed. The destructor waits as well.
+  // \verbatim
+  // vtkSMPTools::TaskGroup group;
+  // vtkSMPTools::Spawn(group, ContourBlock(block0));
+  // vtkSMPTools::Spawn(group, ContourBlock(block1));
+  // group.Wait();
+  // \endverbatim
+  // The Simple backend executes tasks on its work-stealing thread pool and
+  // TBB uses a tbb::task_group. OpenMP runs the tasks of a group in
+  // parallel when Wait() is called, or as OpenMP tasks of the enclosing
+  // team when they are added inside a parallel section. Like For(), an
+  // OpenMP Wait() inside a parallel section only starts a new team when
+  // nested parallelism is enabled. The Sequential and Kaapi backends
+  // execute each task as soon as it is added.
+  class VTKCOMMONCORE_EXPORT TaskGroup
+  {
+  public:
+    TaskGroup();
+    ~TaskGroup();
+
+    // Description:
+    // Adds a task to the group. The functor is copied and its operator()
+    // is invoked with no arguments, possibly on another thread.
+    template <typename Functor>
+    void Run(const Functor& f)
+    {
+      this->RunTask(new vtk::detail::smp::vtkSMPToolsFunctorTask<Functor>(f));
+    }
+
+    // Description:
+    // Blocks until all the tasks of the group have completed. The calling
+    // thread may execute pending tasks while it waits.
+    void Wait();
+
+  private:
+    // Takes ownership of the task and deletes it after execution.
+    void RunTask(vtk::detail::smp::vtkSMPToolsTask* task);
+
+    vtkSMPTaskGroupInternals* Internals;
+
+    TaskGroup(const TaskGroup&); // Not implemented.
+    void operator=(const TaskGroup&); // Not implemented.
+  };
+
+  // Description:
+  // Adds a task to a group. Equivalent to group.Run(f). Use
+  // group.Wait() to wait for the task (and the rest of the group) to
+  // complete.
+  template <typename Functor>
+  static void Spawn(TaskGroup& group, const Functor& f)
+  {
+    group.Run(f);
+  }
+
 
   // Description:
   // Execute a for operation in parallel. First and last
@@ -196,16 +281,169 @@ public:
     vtkSMPTools::For(first, last, 0, f);
   }
 
+  // Description:
+  // HasInitialize<Functor>::value is true when Functor has the
+  // void Initialize() member that For() calls once per thread, in which
+  // case For() also calls its Reduce() after the loop. Functors that wrap
+  // another functor use it to forward Initialize() and Reduce() only when
+  // the wrapped functor defines them.
+  template <typename Functor>
+  struct HasInitialize
+  {
+    static bool const value =
+      vtk::detail::smp::vtkSMPTools_Has_Initialize<Functor>::value;
+  };
+
+  // Description:
+  // A parallel replacement for std::sort(). Sorts the elements of the
+  // range [begin, end) in ascending order using operator<. The TBB backend
+  // uses tbb::parallel_sort, the Sequential backend std::sort and the other
+  // backends sort one block per thread and merge the blocks in parallel.
+  // The sort is not stable.
+  template <typename RandomAccessIterator>
+  static void Sort(RandomAccessIterator begin, RandomAccessIterator end)
+  {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type
+      ValueType;
+    vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end, std::less<ValueType>());
+  }
+
+  // Description:
+  // Same as above but uses the given comparison function object instead of
+  // operator<.
+  template <typename RandomAccessIterator, typename Compare>
+  static void Sort(RandomAccessIterator begin, RandomAccessIterator end,
+                   Compare comp)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end, comp);
+  }
+
+  // Description:
+  // A parallel replacement for std::transform(). Applies op to each element
+  // of [inBegin, inEnd) and stores the result in the range starting at
+  // outBegin. op must be safe to call concurrently and the iterators must
+  // be random access iterators. The output range may be the input range.
+  template <typename InputIterator, typename OutputIterator,
+            typename UnaryOperation>
+  static void Transform(InputIterator inBegin, InputIterator inEnd,
+                        OutputIterator outBegin, UnaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Transform(inBegin, inEnd, outBegin, op);
+  }
+
+  // Description:
+  // Binary version of Transform(). Applies op to pairs of elements taken
+  // from [inBegin1, inEnd1) and from the range starting at inBegin2.
+  template <typename InputIterator1, typename InputIterator2,
+            typename OutputIterator, typename BinaryOperation>
+  static void Transform(InputIterator1 inBegin1, InputIterator1 inEnd1,
+                        InputIterator2 inBegin2, OutputIterator outBegin,
+                        BinaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Transform(
+      inBegin1, inEnd1, inBegin2, outBegin, op);
+  }
+
+  // Description:
+  // A parallel replacement for std::fill(). Assigns value to every element
+  // of the random access range [begin, end).
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Fill(begin, end, value);
+  }
+
+  // Description:
+  // Computes the inclusive prefix sum of [begin, end) into the range
+  // starting at out: out[i] = in[0] + ... + in[i]. The output range may be
+  // the input range.
+  template <typename InputIterator, typename OutputIterator>
+  static void InclusiveScan(InputIterator begin, InputIterator end,
+                            OutputIterator out)
+  {
+    typedef typename std::iterator_traits<InputIterator>::value_type
+      ValueType;
+    vtk::detail::smp::vtkSMPTools_Impl_InclusiveScan(
+      begin, end, out, std::plus<ValueType>());
+  }
+
+  // Description:
+  // Same as above but combines elements with op, which must be associative.
+  template <typename InputIterator, typename OutputIterator,
+            typename BinaryOperation>
+  static void InclusiveScan(InputIterator begin, InputIterator end,
+                            OutputIterator out, BinaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_InclusiveScan(begin, end, out, op);
+  }
+
+  // Description:
+  // Computes the exclusive prefix sum of [begin, end) into the range
+  // starting at out: out[0] = init and out[i] = init + in[0] + ... +
+  // in[i-1]. This is typically used to turn counts into offsets. The output
+  // range may be the input range.
+  template <typename InputIterator, typename OutputIterator, typename T>
+  static void ExclusiveScan(InputIterator begin, InputIterator end,
+                            OutputIterator out, T init)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_ExclusiveScan(
+      begin, end, out, init, std::plus<T>());
+  }
+
+  // Description:
+  // Same as above but combines elements with op, which must be associative.
+  template <typename InputIterator, typename OutputIterator, typename T,
+            typename BinaryOperation>
+  static void ExclusiveScan(InputIterator begin, InputIterator end,
+                            OutputIterator out, T init, BinaryOperation op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_ExclusiveScan(
+      begin, end, out, init, op);
+  }
+
+  // Description:
+  // A parallel replacement for std::accumulate(). Returns init plus the
+  // sum of all elements of the random access range [begin, end), computed
+  // in type T.
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Reduce(
+      begin, end, init, std::plus<T>());
+  }
+
+  // Description:
+  // Same as above but combines elements with op, which must be associative.
+  // Partial results are combined in order so op does not need to be
+  // commutative.
+  template <typename Iterator, typename T, typename BinaryOperation>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOperation op)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Reduce(begin, end, init, op);
+  }
+
   // Description:
   // Initialize the underlying libraries for execution. This is
   // not required as it is automatically called before the first
   // execution of any parallel code. However, it can be used to
   // control the maximum number of threads used when the back-end
-  // supports it (currently Simple and TBB only). Make sure to call
+  // supports it (currently Simple, TBB and OpenMP only). Make sure to call
   // it before any other parallel operation.
   // When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
-  // the number of threads used in the thread pool.
+  // the number of threads used in the thread pool. When using OpenMP,
+  // numThreads=0 uses the OpenMP default, which honors OMP_NUM_THREADS.
   static void Initialize(int numThreads=0);
+
+  // Description:
+  // Enable or disable nested parallelism. When enabled, a For() or a
+  // TaskGroup::Wait() issued from within another parallel section creates
+  // its own team of threads. Otherwise it runs serially on the calling
+  // thread. This is only honored
+  // by the OpenMP backend, where it defaults to the value of OMP_NESTED.
+  // The other backends ignore it: TBB, Kaapi and Simple always nest and
+  // Sequential never does.
+  static void SetNestedParallelism(bool isNested);
+  static bool GetNestedParallelism();
 };
 
 #endif
@@ -0,0 +1,376 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsGeneric.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPToolsGeneric - Block-based parallel algorithms for SMP backends.
+// .SECTION Description
+// This header implements Sort, Transform, Fill, Scan and Reduce on top of
+// a backend's vtkSMPTools_Impl_For(). It is meant for backends that have no
+// native version of these algorithms (Simple, Kaapi). The input range is
+// split into a small number of contiguous blocks, each block is processed
+// by one call to Execute() and the blocks are combined in order, which makes
+// the results deterministic for associative operations. It must be included
+// from vtkSMPToolsInternal.h after vtkSMPTools_Impl_For() is declared.
+// All iterators must be random access iterators.
+
+#ifndef __vtkSMPToolsGeneric_h__
+#define __vtkSMPToolsGeneric_h__
+
+#include <algorithm> // For std::sort
+#include <iterator>  // For std::iterator_traits
+#include <vector>    // For std::vector
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+// Anything shorter than this is processed serially.
+static const vtkIdType vtkSMPTools_Generic_MinimumBlockSize = 1024;
+
+//--------------------------------------------------------------------------------
+inline vtkIdType vtkSMPTools_Generic_NumberOfBlocks(
+  vtkIdType n, int numThreads, int blocksPerThread)
+{
+  vtkIdType numBlocks = static_cast<vtkIdType>(numThreads) * blocksPerThread;
+  vtkIdType maxBlocks = n / vtkSMPTools_Generic_MinimumBlockSize;
+  if (numBlocks > maxBlocks)
+    {
+    numBlocks = maxBlocks;
+    }
+  return numBlocks < 1 ? 1 : numBlocks;
+}
+
+//--------------------------------------------------------------------------------
+// Index of the first element of a block when n elements are split into
+// numBlocks blocks whose sizes differ by at most one.
+inline vtkIdType vtkSMPTools_Generic_BlockBegin(
+  vtkIdType n, vtkIdType numBlocks, vtkIdType block)
+{
+  vtkIdType r = n % numBlocks;
+  return (n / numBlocks) * block + (block < r ? block : r);
+}
+
+//--------------------------------------------------------------------------------
+template <typename RandomAccessIterator, typename Compare>
+struct vtkSMPTools_Generic_SortBlocks
+{
+  RandomAccessIterator Begin;
+  vtkIdType N;
+  vtkIdType NumberOfBlocks;
+  Compare Comp;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType b = first; b < last; ++b)
+      {
+      std::sort(
+        this->Begin + vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, b),
+        this->Begin + vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, b + 1),
+        this->Comp);
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Merges pairs of adjacent runs, each made of Width sorted blocks.
+template <typename RandomAccessIterator, typename Compare>
+struct vtkSMPTools_Generic_MergeBlocks
+{
+  RandomAccessIterator Begin;
+  vtkIdType N;
+  vtkIdType NumberOfBlocks;
+  vtkIdType Width;
+  Compare Comp;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType p = first; p < last; ++p)
+      {
+      vtkIdType lo = 2 * p * this->Width;
+      vtkIdType mid = lo + this->Width;
+      if (mid >= this->NumberOfBlocks)
+        {
+        continue;
+        }
+      vtkIdType hi = std::min(mid + this->Width, this->NumberOfBlocks);
+      std::inplace_merge(
+        this->Begin + vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, lo),
+        this->Begin + vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, mid),
+        this->Begin + vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, hi),
+        this->Comp);
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Sorts one block per thread then merges the blocks pairwise. Each merge
+// round runs in parallel and halves the number of sorted runs.
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPTools_Generic_Sort(RandomAccessIterator begin,
+                              RandomAccessIterator end,
+                              Compare comp,
+                              int numThreads)
+{
+  vtkIdType n = static_cast<vtkIdType>(end - begin);
+  vtkIdType numBlocks = vtkSMPTools_Generic_NumberOfBlocks(n, numThreads, 1);
+  if (numBlocks < 2)
+    {
+    std::sort(begin, end, comp);
+    return;
+    }
+
+  vtkSMPTools_Generic_SortBlocks<RandomAccessIterator, Compare> sorter =
+    { begin, n, numBlocks, comp };
+  vtkSMPTools_Impl_For(0, numBlocks, 1, sorter);
+
+  for (vtkIdType width = 1; width < numBlocks; width *= 2)
+    {
+    vtkSMPTools_Generic_MergeBlocks<RandomAccessIterator, Compare> merger =
+      { begin, n, numBlocks, width, comp };
+    vtkIdType numPairs = (numBlocks + 2 * width - 1) / (2 * width);
+    vtkSMPTools_Impl_For(0, numPairs, 1, merger);
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIterator, typename OutputIterator, typename UnaryOperation>
+struct vtkSMPTools_Generic_UnaryTransform
+{
+  InputIterator In;
+  OutputIterator Out;
+  UnaryOperation& Op;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType i = first; i < last; ++i)
+      {
+      this->Out[i] = this->Op(this->In[i]);
+      }
+  }
+};
+
+template <typename InputIterator, typename OutputIterator, typename UnaryOperation>
+void vtkSMPTools_Generic_Transform(InputIterator inBegin,
+                                   InputIterator inEnd,
+                                   OutputIterator outBegin,
+                                   UnaryOperation& op)
+{
+  vtkSMPTools_Generic_UnaryTransform<
+    InputIterator, OutputIterator, UnaryOperation> fi = { inBegin, outBegin, op };
+  vtkSMPTools_Impl_For(0, static_cast<vtkIdType>(inEnd - inBegin), 0, fi);
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIterator1, typename InputIterator2,
+          typename OutputIterator, typename BinaryOperation>
+struct vtkSMPTools_Generic_BinaryTransform
+{
+  InputIterator1 In1;
+  InputIterator2 In2;
+  OutputIterator Out;
+  BinaryOperation& Op;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType i = first; i < last; ++i)
+      {
+      this->Out[i] = this->Op(this->In1[i], this->In2[i]);
+      }
+  }
+};
+
+template <typename InputIterator1, typename InputIterator2,
+          typename OutputIterator, typename BinaryOperation>
+void vtkSMPTools_Generic_Transform(InputIterator1 inBegin1,
+                                   InputIterator1 inEnd1,
+                                   InputIterator2 inBegin2,
+                                   OutputIterator outBegin,
+                                   BinaryOperation& op)
+{
+  vtkSMPTools_Generic_BinaryTransform<InputIterator1, InputIterator2,
+    OutputIterator, BinaryOperation> fi = { inBegin1, inBegin2, outBegin, op };
+  vtkSMPTools_Impl_For(0, static_cast<vtkIdType>(inEnd1 - inBegin1), 0, fi);
+}
+
+//--------------------------------------------------------------------------------
+template <typename Iterator, typename T>
+struct vtkSMPTools_Generic_FillFunctor
+{
+  Iterator Begin;
+  const T& Value;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    std::fill(this->Begin + first, this->Begin + last, this->Value);
+  }
+};
+
+template <typename Iterator, typename T>
+void vtkSMPTools_Generic_Fill(Iterator begin, Iterator end, const T& value)
+{
+  vtkSMPTools_Generic_FillFunctor<Iterator, T> fi = { begin, value };
+  vtkSMPTools_Impl_For(0, static_cast<vtkIdType>(end - begin), 0, fi);
+}
+
+//--------------------------------------------------------------------------------
+// Combines each block into a single value, in order.
+template <typename InputIterator, typename T, typename BinaryOperation>
+struct vtkSMPTools_Generic_ReduceBlocks
+{
+  InputIterator Begin;
+  vtkIdType N;
+  vtkIdType NumberOfBlocks;
+  BinaryOperation& Op;
+  std::vector<T>& Partials;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType b = first; b < last; ++b)
+      {
+      vtkIdType i = vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, b);
+      vtkIdType end = vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, b + 1);
+      T value = this->Begin[i];
+      for (++i; i < end; ++i)
+        {
+        value = this->Op(value, this->Begin[i]);
+        }
+      this->Partials[b] = value;
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIterator, typename T, typename BinaryOperation>
+T vtkSMPTools_Generic_Reduce(InputIterator begin,
+                             InputIterator end,
+                             T init,
+                             BinaryOperation& op,
+                             int numThreads)
+{
+  vtkIdType n = static_cast<vtkIdType>(end - begin);
+  vtkIdType numBlocks = vtkSMPTools_Generic_NumberOfBlocks(n, numThreads, 4);
+  if (numBlocks < 2)
+    {
+    for (; begin != end; ++begin)
+      {
+      init = op(init, *begin);
+      }
+    return init;
+    }
+
+  std::vector<T> partials(numBlocks, init);
+  vtkSMPTools_Generic_ReduceBlocks<InputIterator, T, BinaryOperation> reducer =
+    { begin, n, numBlocks, op, partials };
+  vtkSMPTools_Impl_For(0, numBlocks, 1, reducer);
+
+  for (vtkIdType b = 0; b < numBlocks; ++b)
+    {
+    init = op(init, partials[b]);
+    }
+  return init;
+}
+
+//--------------------------------------------------------------------------------
+// Second pass of a scan: rescans each block starting from the combined
+// value of all the previous blocks. When Exclusive is false, the first block
+// has no carry and starts from its first element.
+template <typename InputIterator, typename OutputIterator,
+          typename T, typename BinaryOperation>
+struct vtkSMPTools_Generic_ScanBlocks
+{
+  InputIterator Begin;
+  OutputIterator Out;
+  vtkIdType N;
+  vtkIdType NumberOfBlocks;
+  BinaryOperation& Op;
+  const std::vector<T>& Carries;
+  bool Exclusive;
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType b = first; b < last; ++b)
+      {
+      vtkIdType i = vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, b);
+      vtkIdType end = vtkSMPTools_Generic_BlockBegin(this->N, this->NumberOfBlocks, b + 1);
+      if (this->Exclusive)
+        {
+        T acc = this->Carries[b];
+        for (; i < end; ++i)
+          {
+          T value = this->Begin[i];
+          this->Out[i] = acc;
+          acc = this->Op(acc, value);
+          }
+        }
+      else
+        {
+        T acc = b == 0 ? T(this->Begin[i]) : this->Op(this->Carries[b], this->Begin[i]);
+        this->Out[i] = acc;
+        for (++i; i < end; ++i)
+          {
+          acc = this->Op(acc, this->Begin[i]);
+          this->Out[i] = acc;
+          }
+        }
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Two pass blocked scan: the first pass reduces each block, a short serial
+// scan over the block values gives each block its carry and the second pass
+// rescans the blocks independently. Input and output may be the same range.
+template <typename InputIterator, typename OutputIterator,
+          typename T, typename BinaryOperation>
+void vtkSMPTools_Generic_Scan(InputIterator begin,
+                              InputIterator end,
+                              OutputIterator out,
+                              const T& init,
+                              bool exclusive,
+                              BinaryOperation& op,
+                              int numThreads)
+{
+  vtkIdType n = static_cast<vtkIdType>(end - begin);
+  if (n == 0)
+    {
+    return;
+    }
+  vtkIdType numBlocks = vtkSMPTools_Generic_NumberOfBlocks(n, numThreads, 4);
+
+  std::vector<T> carries(numBlocks, init);
+  if (numBlocks > 1)
+    {
+    std::vector<T> partials(numBlocks, init);
+    vtkSMPTools_Generic_ReduceBlocks<InputIterator, T, BinaryOperation> reducer =
+      { begin, n, numBlocks, op, partials };
+    vtkSMPTools_Impl_For(0, numBlocks - 1, 1, reducer);
+
+    carries[1] = exclusive ? op(init, partials[0]) : partials[0];
+    for (vtkIdType b = 2; b < numBlocks; ++b)
+      {
+      carries[b] = op(carries[b - 1], partials[b - 1]);
+      }
+    }
+
+  vtkSMPTools_Generic_ScanBlocks<InputIterator, OutputIterator, T, BinaryOperation>
+    scanner = { begin, out, n, numBlocks, op, carries, exclusive };
+  vtkSMPTools_Impl_For(0, numBlocks, 1, scanner);
+}
+}
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsGeneric.h
@@ -0,0 +1,331 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellArrayStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the compact offsets and connectivity storage of vtkCellArray, the
+// conversions from and to the legacy layout, and the conversion done by the
+// legacy accessors.
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+const vtkIdType NumberOfCells = 10000;
+
+// Cell i has (i % 5) + 1 points numbered from i.
+void FillCells(vtkCellArray *cells)
+{
+  vtkIdType pts[5];
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; ++cellId)
+    {
+    vtkIdType npts = cellId % 5 + 1;
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      pts[i] = cellId + i;
+      }
+    cells->InsertNextCell(npts, pts);
+    }
+}
+
+bool CheckCell(vtkIdType cellId, vtkIdType npts, const vtkIdType *pts)
+{
+  if (npts != cellId % 5 + 1)
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    if (pts[i] != cellId + i)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool CheckAllCells(vtkCellArray *cells)
+{
+  if (cells->GetNumberOfCells() != NumberOfCells)
+    {
+    return false;
+    }
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; ++cellId)
+    {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    cells->GetCellAtId(cellId, npts, pts, ptIds.GetPointer());
+    if (!CheckCell(cellId, npts, pts) ||
+        cells->GetCellSize(cellId) != npts)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+class CheckCellsFunctor
+{
+public:
+  vtkCellArray *Cells;
+  std::vector<unsigned char> Valid;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Cells->GetCellAtId(cellId, ptIds.GetPointer());
+      this->Valid[cellId] = CheckCell(cellId, ptIds->GetNumberOfIds(),
+                                      ptIds->GetPointer(0));
+      }
+  }
+};
+
+// Reads the cells of the first batch through the legacy accessors, which
+// convert the compact storage on first use.
+class CheckLegacyAccessFunctor
+{
+public:
+  vtkCellArray *Cells;
+  std::vector<unsigned char> Valid;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType *legacy = this->Cells->GetPointer();
+    vtkIdType loc = 0;
+    for (vtkIdType cellId = 0; cellId < end; ++cellId)
+      {
+      if (cellId >= begin)
+        {
+        this->Valid[cellId] =
+          CheckCell(cellId, legacy[loc], legacy + loc + 1) &&
+          this->Cells->GetData()->GetPointer(0) == legacy;
+        }
+      loc += legacy[loc] + 1;
+      }
+  }
+};
+
+bool CheckAllValid(const std::vector<unsigned char>& valid)
+{
+  for (size_t i = 0; i < valid.size(); ++i)
+    {
+    if (!valid[i])
+      {
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestCellArrayStorage(int, char*[])
+{
+  // Several threads even on a single core, for the parallel accesses.
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkCellArray> cells;
+  FillCells(cells.GetPointer());
+  vtkIdType legacyEntries = cells->GetNumberOfConnectivityEntries();
+  if (cells->GetStorageType() != vtkCellArray::LEGACY_STORAGE ||
+      !CheckAllCells(cells.GetPointer()))
+    {
+    cerr << "Error: legacy GetCellAtId failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Compact storage, 32-bit whenever vtkIdType is wider.
+  cells->ConvertToCompactStorage();
+  if (cells->GetStorageType() != vtkCellArray::COMPACT_STORAGE ||
+      cells->IsStorage32Bit() != (sizeof(vtkIdType) > sizeof(int)) ||
+      cells->GetOffsetsArray()->GetNumberOfTuples() != NumberOfCells + 1 ||
+      cells->GetNumberOfConnectivityEntries() != legacyEntries ||
+      cells->GetMaxCellSize() != 5 ||
+      !CheckAllCells(cells.GetPointer()))
+    {
+    cerr << "Error: conversion to compact storage failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Random access from several threads.
+  CheckCellsFunctor functor;
+  functor.Cells = cells.GetPointer();
+  functor.Valid.resize(NumberOfCells, 0);
+  vtkSMPTools::For(0, NumberOfCells, functor);
+  if (!CheckAllValid(functor.Valid))
+    {
+    cerr << "Error: parallel GetCellAtId failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Random access from several threads with legacy storage, where the
+  // first accesses find the locations of the cells.
+  vtkNew<vtkCellArray> legacyCells;
+  FillCells(legacyCells.GetPointer());
+  CheckCellsFunctor legacyFunctor;
+  legacyFunctor.Cells = legacyCells.GetPointer();
+  legacyFunctor.Valid.resize(NumberOfCells, 0);
+  vtkSMPTools::For(0, NumberOfCells, legacyFunctor);
+  if (!CheckAllValid(legacyFunctor.Valid))
+    {
+    cerr << "Error: parallel legacy GetCellAtId failed." << endl;
+    return EXIT_FAILURE;
+    }
+  // The locations follow the cells inserted afterwards.
+  vtkIdType extra[3] = {7, 8, 9};
+  legacyCells->InsertNextCell(3, extra);
+  legacyCells->InsertNextCell(2);
+  legacyCells->InsertCellPoint(4);
+  legacyCells->InsertCellPoint(5);
+  vtkIdType npts;
+  const vtkIdType *cpts;
+  legacyCells->GetCellAtId(NumberOfCells, npts, cpts, NULL);
+  if (npts != 3 || cpts[2] != 9 ||
+      legacyCells->GetCellSize(NumberOfCells + 1) != 2)
+    {
+    cerr << "Error: legacy GetCellAtId after insertion failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The legacy accessors of compact storage, from several threads at once.
+  vtkNew<vtkCellArray> converted;
+  converted->DeepCopy(cells.GetPointer());
+  CheckLegacyAccessFunctor accessFunctor;
+  accessFunctor.Cells = converted.GetPointer();
+  accessFunctor.Valid.resize(100, 0);
+  vtkSMPTools::For(0, 100, 10, accessFunctor);
+  if (!CheckAllValid(accessFunctor.Valid) ||
+      converted->GetStorageType() != vtkCellArray::LEGACY_STORAGE ||
+      converted->GetOffsetsArray() != NULL ||
+      !CheckAllCells(converted.GetPointer()))
+    {
+    cerr << "Error: parallel conversion by the legacy accessors failed."
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Appending keeps the compact storage.
+  vtkNew<vtkCellArray> appended;
+  appended->ConvertToCompactStorage();
+  FillCells(appended.GetPointer());
+  if (appended->GetStorageType() != vtkCellArray::COMPACT_STORAGE ||
+      !CheckAllCells(appended.GetPointer()))
+    {
+    cerr << "Error: InsertNextCell with compact storage failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Ids that do not fit 32 bits widen the storage.
+  if (sizeof(vtkIdType) > sizeof(int))
+    {
+    vtkIdType big[2] = {0, static_cast<vtkIdType>(VTK_INT_MAX) + 1};
+    vtkNew<vtkCellArray> wide;
+    wide->DeepCopy(appended.GetPointer());
+    wide->InsertNextCell(2, big);
+    vtkNew<vtkIdList> ptIds;
+    wide->GetCellAtId(NumberOfCells, ptIds.GetPointer());
+    if (wide->IsStorage32Bit() || ptIds->GetNumberOfIds() != 2 ||
+        ptIds->GetId(1) != big[1] ||
+        wide->GetNumberOfCells() != NumberOfCells + 1)
+      {
+      cerr << "Error: widening the compact storage failed." << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The legacy accessors convert to legacy storage, and writes through
+  // them are seen by GetCellAtId().
+  vtkNew<vtkCellArray> copy;
+  copy->DeepCopy(cells.GetPointer());
+  if (copy->GetData()->GetNumberOfTuples() != legacyEntries ||
+      copy->GetStorageType() != vtkCellArray::LEGACY_STORAGE ||
+      copy->GetInsertLocation(0) != legacyEntries - 1 ||
+      copy->GetCellSize(1) != 2)
+    {
+    cerr << "Error: GetData did not convert to legacy storage." << endl;
+    return EXIT_FAILURE;
+    }
+  // Turn the first two cells, {0} and {1,2}, into {0,1} and {2}.
+  vtkIdType *legacy = copy->GetPointer();
+  legacy[0] = 2;
+  legacy[2] = 1;
+  legacy[3] = 1;
+  legacy[4] = 2;
+  if (copy->GetCellSize(0) != 2 || copy->GetCellSize(1) != 1 ||
+      copy->GetCellSize(2) != 3)
+    {
+    cerr << "Error: GetCellAtId missed a write through GetPointer." << endl;
+    return EXIT_FAILURE;
+    }
+  vtkIdType *pts;
+  vtkIdType cellId = 0;
+  cells->InitTraversal();
+  while (cells->GetNextCell(npts, pts))
+    {
+    if (!CheckCell(cellId++, npts, pts))
+      {
+      cerr << "Error: traversal of compact storage failed." << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (cellId != NumberOfCells ||
+      cells->GetStorageType() != vtkCellArray::LEGACY_STORAGE)
+    {
+    cerr << "Error: traversal did not visit all cells." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Adopt external arrays.
+  vtkNew<vtkIntArray> offsets;
+  vtkNew<vtkIntArray> connectivity;
+  int offsetValues[3] = {0, 3, 7};
+  int connectivityValues[7] = {0, 1, 2, 2, 1, 3, 4};
+  for (int i = 0; i < 3; ++i)
+    {
+    offsets->InsertNextValue(offsetValues[i]);
+    }
+  for (int i = 0; i < 7; ++i)
+    {
+    connectivity->InsertNextValue(connectivityValues[i]);
+    }
+  vtkNew<vtkCellArray> adopted;
+  vtkNew<vtkIdTypeArray> mismatch;
+  if (adopted->SetData(offsets.GetPointer(), mismatch.GetPointer()) ||
+      !adopted->SetData(offsets.GetPointer(), connectivity.GetPointer()) ||
+      adopted->GetNumberOfCells() != 2 || adopted->GetCellSize(1) != 4 ||
+      adopted->GetNumberOfConnectivityEntries() != 9)
+    {
+    cerr << "Error: SetData failed." << endl;
+    return EXIT_FAILURE;
+    }
+  adopted->ConvertToLegacyStorage();
+  vtkIdType expected[9] = {3, 0, 1, 2, 4, 2, 1, 3, 4};
+  for (int i = 0; i < 9; ++i)
+    {
+    if (adopted->GetPointer()[i] != expected[i])
+      {
+      cerr << "Error: legacy layout of adopted arrays is wrong." << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
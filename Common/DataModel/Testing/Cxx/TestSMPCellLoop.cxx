@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPCellLoop.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkCellIterator::SetCellRange() and vtkSMPCellLoop on unstructured,
+// poly and structured data sets.
+
+#include "vtkSMPCellLoop.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+const vtkIdType NumberOfCells = 5000;
+
+// Records the type and the sum of the point ids of every cell, and counts
+// the ranges.
+class CellSignature
+{
+public:
+  std::vector<vtkIdType> Signatures;
+  vtkSMPThreadLocal<vtkIdType> NumberOfRanges;
+  vtkIdType TotalRanges;
+
+  CellSignature() : TotalRanges(0) {}
+
+  void Initialize()
+  {
+    this->NumberOfRanges.Local() = 0;
+  }
+
+  void operator()(vtkCellIterator *it, vtkGenericCell *cell)
+  {
+    ++this->NumberOfRanges.Local();
+    for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextCell())
+      {
+      it->GetCell(cell);
+      vtkIdType signature = 1000 * cell->GetCellType();
+      for (vtkIdType i = 0; i < cell->GetNumberOfPoints(); ++i)
+        {
+        signature += cell->GetPointId(i);
+        }
+      this->Signatures[it->GetCellId()] = signature;
+      }
+  }
+
+  void Reduce()
+  {
+    this->TotalRanges = 0;
+    vtkSMPThreadLocal<vtkIdType>::iterator iter;
+    for (iter = this->NumberOfRanges.begin();
+         iter != this->NumberOfRanges.end(); ++iter)
+      {
+      this->TotalRanges += *iter;
+      }
+  }
+};
+
+vtkSmartPointer<vtkPoints> MakePoints(vtkIdType numPoints)
+{
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    points->SetPoint(i, i, i % 7, i % 3);
+    }
+  return points;
+}
+
+// Triangles, quads and tetras in turn.
+void FillCells(vtkIdType cellId, int &type, vtkIdType &npts, vtkIdType pts[4])
+{
+  static const int types[3] = {VTK_TRIANGLE, VTK_QUAD, VTK_TETRA};
+  static const vtkIdType sizes[3] = {3, 4, 4};
+  type = types[cellId % 3];
+  npts = sizes[cellId % 3];
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    pts[i] = cellId + i;
+    }
+}
+
+bool CheckDataSet(vtkDataSet *ds, const char *name)
+{
+  vtkIdType numCells = ds->GetNumberOfCells();
+  vtkNew<vtkGenericCell> cell;
+
+  // Serial reference, computed through the data set API.
+  std::vector<vtkIdType> expected(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    ds->GetCell(cellId, cell.GetPointer());
+    expected[cellId] = 1000 * cell->GetCellType();
+    for (vtkIdType i = 0; i < cell->GetNumberOfPoints(); ++i)
+      {
+      expected[cellId] += cell->GetPointId(i);
+      }
+    }
+
+  // An explicit range, including one that ends past the last cell.
+  vtkSmartPointer<vtkCellIterator> it =
+    vtkSmartPointer<vtkCellIterator>::Take(ds->NewCellIterator());
+  CellSignature serial;
+  serial.Signatures.resize(numCells, -1);
+  it->SetCellRange(numCells / 3, numCells + 10);
+  serial(it.GetPointer(), cell.GetPointer());
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    vtkIdType value = cellId < numCells / 3 ? -1 : expected[cellId];
+    if (serial.Signatures[cellId] != value)
+      {
+      cerr << "Error: " << name << " range traversal failed at cell "
+           << cellId << endl;
+      return false;
+      }
+    }
+
+  CellSignature functor;
+  functor.Signatures.resize(numCells, -1);
+  vtkSMPCellLoop::For(ds, functor, 100);
+  if (functor.Signatures != expected)
+    {
+    cerr << "Error: " << name << " parallel loop visited wrong cells." << endl;
+    return false;
+    }
+  if (functor.TotalRanges < 1)
+    {
+    cerr << "Error: " << name << " Initialize/Reduce were not called." << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestSMPCellLoop(int, char*[])
+{
+  vtkSmartPointer<vtkPoints> points = MakePoints(NumberOfCells + 4);
+  int type;
+  vtkIdType npts;
+  vtkIdType pts[4];
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->Allocate(NumberOfCells);
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; ++cellId)
+    {
+    FillCells(cellId, type, npts, pts);
+    grid->InsertNextCell(type, npts, pts);
+    }
+  if (!CheckDataSet(grid.GetPointer(), "vtkUnstructuredGrid"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkCellArray> polys;
+  polyData->SetPoints(points);
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; ++cellId)
+    {
+    FillCells(cellId, type, npts, pts);
+    polys->InsertNextCell(type == VTK_TETRA ? 3 : npts, pts);
+    }
+  polyData->SetPolys(polys.GetPointer());
+  if (!CheckDataSet(polyData.GetPointer(), "vtkPolyData"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 15, 12);
+  if (!CheckDataSet(image.GetPointer(), "vtkImageData"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -13,10 +13,95 @@
 
 =========================================================================*/
 #include "vtkCellArray.h"
+
+#include "vtkCriticalSection.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkCellArray);
 
+namespace
+{
+// Compact storage helpers, templated over vtkIdTypeArray and vtkIntArray.
+
+//----------------------------------------------------------------------------
+template <class TArray, class TValue>
+void vtkCellArrayFromLegacy(const vtkIdType *legacy, vtkIdType numCells,
+                            TArray *offsetsArray, TArray *connArray,
+                            vtkIdType connSize, TValue)
+{
+  TValue *offsets = offsetsArray->WritePointer(0, numCells + 1);
+  TValue *conn = connArray->WritePointer(0, connSize);
+  TValue offset = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    offsets[cellId] = offset;
+    vtkIdType npts = *legacy++;
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      *conn++ = static_cast<TValue>(*legacy++);
+      }
+    offset += static_cast<TValue>(npts);
+    }
+  offsets[numCells] = offset;
+}
+
+//----------------------------------------------------------------------------
+template <class TValue>
+void vtkCellArrayToLegacy(const TValue *offsets, const TValue *conn,
+                          vtkIdType numCells, vtkIdType *legacy)
+{
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    const TValue *pt = conn + offsets[cellId];
+    const TValue *end = conn + offsets[cellId + 1];
+    *legacy++ = static_cast<vtkIdType>(end - pt);
+    for (; pt != end; ++pt)
+      {
+      *legacy++ = static_cast<vtkIdType>(*pt);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class TArray, class TValue>
+void vtkCellArrayAppend(TArray *offsetsArray, TArray *connArray,
+                        vtkIdType npts, const vtkIdType *pts, TValue)
+{
+  vtkIdType connSize = connArray->GetMaxId() + 1;
+  TValue *conn = connArray->WritePointer(connSize, npts);
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    conn[i] = static_cast<TValue>(pts[i]);
+    }
+  offsetsArray->InsertNextValue(static_cast<TValue>(connSize + npts));
+}
+
+//----------------------------------------------------------------------------
+template <class TValue>
+void vtkCellArrayCopyCell(const TValue *offsets, const TValue *conn,
+                          vtkIdType cellId, vtkIdList *pts)
+{
+  vtkIdType begin = static_cast<vtkIdType>(offsets[cellId]);
+  vtkIdType npts = static_cast<vtkIdType>(offsets[cellId + 1]) - begin;
+  pts->SetNumberOfIds(npts);
+  vtkIdType *ptr = pts->GetPointer(0);
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    ptr[i] = static_cast<vtkIdType>(conn[begin + i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+inline bool vtkCellArrayFitsInt(vtkIdType value)
+{
+  return value >= static_cast<vtkIdType>(VTK_INT_MIN) &&
+    value <= static_cast<vtkIdType>(VTK_INT_MAX);
+}
+}
+
 //----------------------------------------------------------------------------
 vtkCellArray::vtkCellArray()
 {
@@ -24,18 +109,40 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->Storage = LEGACY_STORAGE;
+  this->Storage32Bit = 0;
+  this->Offsets = NULL;
+  this->Connectivity = NULL;
+  this->Locations = vtkIdTypeArray::New();
+  this->NumberOfLocations = 0;
+  this->BuildLock = new vtkSimpleCriticalSection;
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::DeepCopy (vtkCellArray *ca)
 {
-  // Do nothing on a NULL input.
-  if (ca == NULL)
+  // Do nothing on a NULL input or when copying onto itself.
+  if (ca == NULL || ca == this)
     {
     return;
     }
 
-  this->Ia->DeepCopy(ca->Ia);
+  this->ReleaseCompactStorage();
+  if (ca->Storage == COMPACT_STORAGE)
+    {
+    this->Offsets = ca->Offsets->NewInstance();
+    this->Offsets->DeepCopy(ca->Offsets);
+    this->Connectivity = ca->Connectivity->NewInstance();
+    this->Connectivity->DeepCopy(ca->Connectivity);
+    this->Storage = COMPACT_STORAGE;
+    this->Storage32Bit = ca->Storage32Bit;
+    this->Ia->Initialize();
+    }
+  else
+    {
+    this->Ia->DeepCopy(ca->Ia);
+    }
+  this->InvalidateLocations();
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
@@ -45,15 +152,388 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->ReleaseCompactStorage();
+  this->Locations->Delete();
+  delete this->BuildLock;
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
   this->Ia->Initialize();
+  this->InvalidateLocations();
+  this->Locations->Initialize();
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    this->Offsets->Initialize();
+    this->Connectivity->Initialize();
+    this->ResetCompactStorage();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::Allocate(const vtkIdType sz, const int ext)
+{
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    // Allocate() discards the values, keep the offsets consistent.
+    this->NumberOfCells = 0;
+    this->ResetCompactStorage();
+    return this->Connectivity->Allocate(sz, ext);
+    }
+  this->InvalidateLocations();
+  return this->Ia->Allocate(sz,ext);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetSize()
+{
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    return this->Offsets->GetSize() + this->Connectivity->GetSize();
+    }
+  return this->Ia->GetSize();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetNumberOfConnectivityEntries()
+{
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    return this->NumberOfCells + this->Connectivity->GetMaxId() + 1;
+    }
+  return this->Ia->GetMaxId()+1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    this->Offsets->Squeeze();
+    this->Connectivity->Squeeze();
+    }
+  this->Ia->Squeeze();
+  this->Locations->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ConvertToCompactStorage(int allow32Bit)
+{
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    return;
+    }
+
+  // Count the cells and find the range of the ids to pick the value type.
+  const vtkIdType *legacy = this->Ia->GetPointer(0);
+  vtkIdType size = this->Ia->GetMaxId() + 1;
+  vtkIdType numCells = 0;
+  vtkIdType connSize = 0;
+  vtkIdType minId = 0;
+  vtkIdType maxId = 0;
+  for (vtkIdType loc = 0; loc < size; loc += legacy[loc] + 1)
+    {
+    vtkIdType npts = legacy[loc];
+    for (vtkIdType i = 1; i <= npts; ++i)
+      {
+      minId = std::min(minId, legacy[loc + i]);
+      maxId = std::max(maxId, legacy[loc + i]);
+      }
+    connSize += npts;
+    ++numCells;
+    }
+
+  this->Storage32Bit = allow32Bit &&
+    sizeof(vtkIdType) > sizeof(int) && vtkCellArrayFitsInt(connSize) &&
+    vtkCellArrayFitsInt(minId) && vtkCellArrayFitsInt(maxId);
+  if (this->Storage32Bit)
+    {
+    vtkIntArray *offsets = vtkIntArray::New();
+    vtkIntArray *conn = vtkIntArray::New();
+    vtkCellArrayFromLegacy(legacy, numCells, offsets, conn, connSize, int());
+    this->Offsets = offsets;
+    this->Connectivity = conn;
+    }
+  else
+    {
+    vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+    vtkIdTypeArray *conn = vtkIdTypeArray::New();
+    vtkCellArrayFromLegacy(legacy, numCells, offsets, conn, connSize,
+                           vtkIdType());
+    this->Offsets = offsets;
+    this->Connectivity = conn;
+    }
+
+  this->Ia->Initialize();
+  this->InvalidateLocations();
+  this->Locations->Initialize();
+  this->Storage = COMPACT_STORAGE;
+  this->NumberOfCells = numCells;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+}
+
+//----------------------------------------------------------------------------
+// Called by the methods that read the legacy layout, possibly from several
+// threads: the first one converts, the others find the legacy storage.
+void vtkCellArray::ConvertToLegacyStorage()
+{
+  this->BuildLock->Lock();
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    vtkIdType size = this->NumberOfCells + this->Connectivity->GetMaxId() + 1;
+    this->Ia->Reset();
+    vtkIdType *legacy = this->Ia->WritePointer(0, size);
+    if (this->Storage32Bit)
+      {
+      vtkCellArrayToLegacy(
+        static_cast<vtkIntArray*>(this->Offsets)->GetPointer(0),
+        static_cast<vtkIntArray*>(this->Connectivity)->GetPointer(0),
+        this->NumberOfCells, legacy);
+      }
+    else
+      {
+      vtkCellArrayToLegacy(
+        static_cast<vtkIdTypeArray*>(this->Offsets)->GetPointer(0),
+        static_cast<vtkIdTypeArray*>(this->Connectivity)->GetPointer(0),
+        this->NumberOfCells, legacy);
+      }
+    this->NumberOfLocations = 0;
+    this->InsertLocation = size;
+    this->ReleaseCompactStorage();
+    }
+  this->BuildLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+// Find the location of the cells of the legacy storage that do not have
+// one yet. Called by the methods that access cells by id, possibly from
+// several threads.
+void vtkCellArray::BuildLocations()
+{
+  this->BuildLock->Lock();
+  vtkIdType first = this->NumberOfLocations;
+  if (first < this->NumberOfCells)
+    {
+    // Cells are only appended between two builds, so the locations found
+    // so far are still valid.
+    const vtkIdType *legacy = this->Ia->GetPointer(0);
+    vtkIdType *locations =
+      this->Locations->WritePointer(first, this->NumberOfCells - first);
+    vtkIdType loc = 0;
+    if (first > 0)
+      {
+      loc = locations[-1] + legacy[locations[-1]] + 1;
+      }
+    for (vtkIdType cellId = first; cellId < this->NumberOfCells; ++cellId)
+      {
+      *locations++ = loc;
+      loc += legacy[loc] + 1;
+      }
+    this->NumberOfLocations = this->NumberOfCells;
+    }
+  this->BuildLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+// Forget the cell locations, called whenever cells may be rearranged.
+void vtkCellArray::InvalidateLocations()
+{
+  this->BuildLock->Lock();
+  this->NumberOfLocations = 0;
+  this->Locations->Reset();
+  this->BuildLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReleaseCompactStorage()
+{
+  if (this->Offsets)
+    {
+    this->Offsets->Delete();
+    this->Offsets = NULL;
+    }
+  if (this->Connectivity)
+    {
+    this->Connectivity->Delete();
+    this->Connectivity = NULL;
+    }
+  this->Storage = LEGACY_STORAGE;
+  this->Storage32Bit = 0;
+}
+
+//----------------------------------------------------------------------------
+// Empty the compact arrays, leaving the single offset of an empty list.
+void vtkCellArray::ResetCompactStorage()
+{
+  this->Offsets->Reset();
+  this->Connectivity->Reset();
+  if (this->Storage32Bit)
+    {
+    static_cast<vtkIntArray*>(this->Offsets)->InsertNextValue(0);
+    }
+  else
+    {
+    static_cast<vtkIdTypeArray*>(this->Offsets)->InsertNextValue(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextCompactCell(vtkIdType npts,
+                                              const vtkIdType *pts)
+{
+  if (this->Storage32Bit)
+    {
+    bool fits =
+      vtkCellArrayFitsInt(this->Connectivity->GetMaxId() + 1 + npts);
+    for (vtkIdType i = 0; fits && i < npts; ++i)
+      {
+      fits = vtkCellArrayFitsInt(pts[i]);
+      }
+    if (fits)
+      {
+      vtkCellArrayAppend(static_cast<vtkIntArray*>(this->Offsets),
+                         static_cast<vtkIntArray*>(this->Connectivity),
+                         npts, pts, int());
+      return this->NumberOfCells++;
+      }
+
+    // Widen the storage to vtkIdType.
+    vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+    vtkIdTypeArray *conn = vtkIdTypeArray::New();
+    offsets->DeepCopy(this->Offsets);
+    conn->DeepCopy(this->Connectivity);
+    this->ReleaseCompactStorage();
+    this->Offsets = offsets;
+    this->Connectivity = conn;
+    this->Storage = COMPACT_STORAGE;
+    }
+
+  vtkCellArrayAppend(static_cast<vtkIdTypeArray*>(this->Offsets),
+                     static_cast<vtkIdTypeArray*>(this->Connectivity),
+                     npts, pts, vtkIdType());
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::SetData(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  if (!offsets || !connectivity ||
+      offsets->GetNumberOfComponents() != 1 ||
+      connectivity->GetNumberOfComponents() != 1 ||
+      offsets->GetNumberOfTuples() < 1)
+    {
+    vtkErrorMacro("Invalid offsets or connectivity array.");
+    return 0;
+    }
+
+  int is32Bit;
+  if (vtkIdTypeArray::SafeDownCast(offsets) &&
+      vtkIdTypeArray::SafeDownCast(connectivity))
+    {
+    is32Bit = 0;
+    }
+  else if (vtkIntArray::SafeDownCast(offsets) &&
+           vtkIntArray::SafeDownCast(connectivity))
+    {
+    is32Bit = 1;
+    }
+  else
+    {
+    vtkErrorMacro("Offsets and connectivity must both be vtkIdTypeArray or "
+                  "both be vtkIntArray.");
+    return 0;
+    }
+
+  offsets->Register(this);
+  connectivity->Register(this);
+  this->ReleaseCompactStorage();
+  this->Ia->Initialize();
+  this->InvalidateLocations();
+  this->Offsets = offsets;
+  this->Connectivity = connectivity;
+  this->Storage = COMPACT_STORAGE;
+  this->Storage32Bit = is32Bit;
+  this->NumberOfCells = offsets->GetNumberOfTuples() - 1;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+  this->Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtIdGeneric(vtkIdType cellId, vtkIdType &npts,
+                                      const vtkIdType* &pts,
+                                      vtkIdList *ptIds)
+{
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    this->GetCellAtId(cellId, ptIds);
+    npts = ptIds->GetNumberOfIds();
+    pts = ptIds->GetPointer(0);
+    return;
+    }
+
+  if (this->NumberOfLocations != this->NumberOfCells)
+    {
+    this->BuildLocations();
+    }
+  const vtkIdType *cell =
+    this->Ia->GetPointer(this->Locations->GetValue(cellId));
+  npts = cell[0];
+  pts = cell + 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *pts)
+{
+  if (this->Storage == LEGACY_STORAGE)
+    {
+    vtkIdType npts;
+    const vtkIdType *ppts;
+    this->GetCellAtIdGeneric(cellId, npts, ppts, NULL);
+    pts->SetNumberOfIds(npts);
+    std::copy(ppts, ppts + npts, pts->GetPointer(0));
+    }
+  else if (this->Storage32Bit)
+    {
+    vtkCellArrayCopyCell(
+      static_cast<vtkIntArray*>(this->Offsets)->GetPointer(0),
+      static_cast<vtkIntArray*>(this->Connectivity)->GetPointer(0),
+      cellId, pts);
+    }
+  else
+    {
+    vtkCellArrayCopyCell(
+      static_cast<vtkIdTypeArray*>(this->Offsets)->GetPointer(0),
+      static_cast<vtkIdTypeArray*>(this->Connectivity)->GetPointer(0),
+      cellId, pts);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->Storage == LEGACY_STORAGE)
+    {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    this->GetCellAtIdGeneric(cellId, npts, pts, NULL);
+    return npts;
+    }
+  if (this->Storage32Bit)
+    {
+    const int *offsets =
+      static_cast<vtkIntArray*>(this->Offsets)->GetPointer(cellId);
+    return offsets[1] - offsets[0];
+    }
+  const vtkIdType *offsets =
+    static_cast<vtkIdTypeArray*>(this->Offsets)->GetPointer(cellId);
+  return offsets[1] - offsets[0];
 }
 
 //----------------------------------------------------------------------------
@@ -63,6 +543,16 @@ int vtkCellArray::GetMaxCellSize()
 {
   int i, npts=0, maxSize=0;
 
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    for (vtkIdType cellId=0; cellId < this->NumberOfCells; cellId++)
+      {
+      maxSize = std::max(maxSize,
+                         static_cast<int>(this->GetCellSize(cellId)));
+      }
+    return maxSize;
+    }
+
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
     {
     if ( (npts=this->Ia->GetValue(i)) > maxSize )
@@ -80,10 +570,12 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
   if ( cells && cells != this->Ia )
     {
     this->Modified();
+    this->ReleaseCompactStorage();
     this->Ia->Delete();
     this->Ia = cells;
     this->Ia->Register(this);
 
+    this->InvalidateLocations();
     this->NumberOfCells = ncells;
     this->InsertLocation = cells->GetMaxId() + 1;
     this->TraversalLocation = 0;
@@ -93,7 +585,14 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize() +
+    this->Locations->GetActualMemorySize();
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    size += this->Offsets->GetActualMemorySize() +
+      this->Connectivity->GetActualMemorySize();
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -115,6 +614,7 @@ int vtkCellArray::GetNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
 {
+  this->UseLegacyStorage();
   vtkIdType npts = this->Ia->GetValue(loc++);
   vtkIdType *ppts = this->Ia->GetPointer(loc);
   pts->SetNumberOfIds(npts);
@@ -132,4 +632,10 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Storage: "
+     << (this->Storage == COMPACT_STORAGE ? "Compact" : "Legacy") << endl;
+  if (this->Storage == COMPACT_STORAGE)
+    {
+    os << indent << "Storage 32 Bit: " << this->Storage32Bit << endl;
+    }
 }
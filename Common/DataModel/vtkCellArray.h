@@ -26,6 +26,26 @@
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of
 // the data structure.
 //
+// The cells may instead be kept in a compact layout made of two arrays (see
+// ConvertToCompactStorage()): an offsets array of NumberOfCells+1 entries
+// and a connectivity array holding only the point ids, so that cell i uses
+// the connectivity entries offsets[i] to offsets[i+1]-1. This layout drops
+// the per-cell counts, stores the ids as 32-bit integers whenever they fit,
+// and gives constant time, thread safe access to any cell through
+// GetCellAtId(). The methods that hand out pointers into the legacy layout
+// (GetData(), GetPointer(), GetNextCell(), GetCell(loc,...)) and the ones
+// that modify cells in that layout (InsertNextCell(int), InsertCellPoint(),
+// UpdateCellCount(), ReverseCell() and ReplaceCell()) convert the cell
+// array back to legacy storage and drop the compact arrays, so the cells
+// are never held in both layouts and writes through the returned pointers
+// are kept. The conversion is done once, under a lock, so these methods
+// may be called from several threads at once; they must not run while
+// another thread reads the compact arrays through GetCellAtId().
+//
+// With legacy storage, GetCellAtId() and GetCellSize() use the location of
+// every cell in the list, found on first use and extended on first use
+// after cells are appended, so they take constant time in both layouts.
+//
 // .SECTION See Also
 // vtkCellTypes vtkCellLinks
 
@@ -38,6 +58,9 @@
 #include "vtkIdTypeArray.h" // Needed for inline methods
 #include "vtkCell.h" // Needed for inline methods
 
+class vtkDataArray;
+class vtkSimpleCriticalSection;
+
 class VTKCOMMONDATAMODEL_EXPORT vtkCellArray : public vtkObject
 {
 public:
@@ -49,9 +72,19 @@ public:
   static vtkCellArray *New();
 
   // Description:
-  // Allocate memory and set the size to extend by.
-  int Allocate(const vtkIdType sz, const int ext=1000)
-    {return this->Ia->Allocate(sz,ext);}
+  // Layouts used to store the cells. LEGACY_STORAGE is the interleaved
+  // (n,id1,id2,...,idn, ...) list, COMPACT_STORAGE the offsets and
+  // connectivity arrays.
+  enum StorageTypes
+  {
+    LEGACY_STORAGE = 0,
+    COMPACT_STORAGE = 1
+  };
+
+  // Description:
+  // Allocate memory and set the size to extend by. The size is expressed
+  // in legacy entries, see EstimateSize().
+  int Allocate(const vtkIdType sz, const int ext=1000);
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -95,16 +128,16 @@ public:
   int GetNextCell(vtkIdList *pts);
 
   // Description:
-  // Get the size of the allocated connectivity array.
-  vtkIdType GetSize()
-    {return this->Ia->GetSize();}
+  // Get the size of the allocated connectivity array. With compact storage
+  // this is the allocated size of the offsets and connectivity arrays.
+  vtkIdType GetSize();
 
   // Description:
   // Get the total number of entries (i.e., data values) in the connectivity
   // array. This may be much less than the allocated size (i.e., return value
-  // from GetSize().)
-  vtkIdType GetNumberOfConnectivityEntries()
-    {return this->Ia->GetMaxId()+1;}
+  // from GetSize().) With compact storage the number of entries the legacy
+  // layout would use is returned.
+  vtkIdType GetNumberOfConnectivityEntries();
 
   // Description:
   // Internal method used to retrieve a cell given an offset into
@@ -116,6 +149,22 @@ public:
   // the internal array.
   void GetCell(vtkIdType loc, vtkIdList* pts);
 
+  // Description:
+  // Retrieve the cell cellId in constant time. This is safe to call from
+  // several threads at once. pts points into the cell array when the ids
+  // are stored as vtkIdType, otherwise the ids are copied into ptIds and
+  // pts points to its storage.
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+                   vtkIdList *ptIds);
+
+  // Description:
+  // Copy the point ids of the cell cellId into pts, see GetCellAtId().
+  void GetCellAtId(vtkIdType cellId, vtkIdList *pts);
+
+  // Description:
+  // Return the number of points of the cell cellId, see GetCellAtId().
+  vtkIdType GetCellSize(vtkIdType cellId);
+
   // Description:
   // Insert a cell object. Return the cell id of the cell.
   vtkIdType InsertNextCell(vtkCell *cell);
@@ -151,7 +200,11 @@ public:
   // Computes the current insertion location within the internal array.
   // Used in conjunction with GetCell(int loc,...).
   vtkIdType GetInsertLocation(int npts)
-    {return (this->InsertLocation - npts - 1);};
+    {
+    vtkIdType end = (this->Storage != LEGACY_STORAGE ?
+      this->GetNumberOfConnectivityEntries() : this->InsertLocation);
+    return (end - npts - 1);
+    };
 
   // Description:
   // Get/Set the current traversal location.
@@ -181,9 +234,10 @@ public:
   int GetMaxCellSize();
 
   // Description:
-  // Get pointer to array of cell data.
+  // Get pointer to array of cell data. With compact storage the cell array
+  // is converted to legacy storage first, see the class description.
   vtkIdType *GetPointer()
-    {return this->Ia->GetPointer(0);}
+    {this->UseLegacyArray(); return this->Ia->GetPointer(0);}
 
   // Description:
   // Get pointer to data array for purpose of direct writes of data. Size is the
@@ -201,14 +255,61 @@ public:
   // list.
   void SetCells(vtkIdType ncells, vtkIdTypeArray *cells);
 
+  // Description:
+  // Use the given offsets and connectivity arrays as compact storage,
+  // without copying them. offsets holds NumberOfCells+1 entries starting at
+  // 0. Both arrays must be vtkIdTypeArray or both vtkIntArray, with a single
+  // component. Returns 0 (and leaves the cell array unchanged) otherwise.
+  int SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
   // Description:
   // Perform a deep copy (no reference counting) of the given cell array.
+  // The storage layout is copied as well.
   void DeepCopy(vtkCellArray *ca);
 
   // Description:
-  // Return the underlying data as a data array.
+  // Return the underlying data as a data array. With compact storage the
+  // cell array is converted to legacy storage first, see the class
+  // description.
   vtkIdTypeArray* GetData()
-    {return this->Ia;}
+    {this->UseLegacyArray(); return this->Ia;}
+
+  // Description:
+  // Convert the cells to compact storage (see the class description). The
+  // offsets and connectivity are stored in vtkIntArray when allow32Bit is
+  // set, vtkIdType is 64 bits and all values fit, and in vtkIdTypeArray
+  // otherwise. Cells inserted with InsertNextCell(npts,pts) afterwards are
+  // appended to the compact arrays, which are widened to vtkIdTypeArray if
+  // a value no longer fits. Does nothing when the storage is already
+  // compact. Neither conversion modifies the cell array's MTime.
+  void ConvertToCompactStorage(int allow32Bit=1);
+
+  // Description:
+  // Convert the cells back to the legacy interleaved layout and release the
+  // compact arrays. Does nothing when the storage is already legacy. This
+  // may be called from several threads at once, the cells are converted
+  // only once.
+  void ConvertToLegacyStorage();
+
+  // Description:
+  // Return the current layout, LEGACY_STORAGE or COMPACT_STORAGE.
+  int GetStorageType()
+    {return this->Storage;}
+
+  // Description:
+  // Return 1 when the compact arrays are vtkIntArray rather than
+  // vtkIdTypeArray.
+  int IsStorage32Bit()
+    {return this->Storage32Bit;}
+
+  // Description:
+  // Return the offsets and connectivity arrays of the compact storage, or
+  // NULL with legacy storage. Values must not be modified in a way that
+  // breaks the offsets invariants.
+  vtkDataArray *GetOffsetsArray()
+    {return this->Offsets;}
+  vtkDataArray *GetConnectivityArray()
+    {return this->Connectivity;}
 
   // Description:
   // Reuse list. Reset to initial condition.
@@ -216,8 +317,7 @@ public:
 
   // Description:
   // Reclaim any extra memory.
-  void Squeeze()
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   // Description:
   // Return the memory in kilobytes consumed by this cell array. Used to
@@ -235,7 +335,47 @@ protected:
   vtkIdType NumberOfCells;
   vtkIdType InsertLocation;     //keep track of current insertion point
   vtkIdType TraversalLocation;   //keep track of traversal position
-  vtkIdTypeArray *Ia;
+  vtkIdTypeArray *Ia;   // the cells with legacy storage, empty otherwise
+
+  int Storage;
+  int Storage32Bit;
+  vtkDataArray *Offsets;       // NumberOfCells+1 entries with compact storage
+  vtkDataArray *Connectivity;  // point ids of all cells with compact storage
+
+  // The location of the first NumberOfLocations cells of the legacy
+  // storage, found on demand, possibly by several threads. BuildLock
+  // serializes the conversion to legacy storage and every write to
+  // NumberOfLocations.
+  vtkIdTypeArray *Locations;
+  vtkIdType NumberOfLocations;
+  vtkSimpleCriticalSection *BuildLock;
+
+  // Description:
+  // Helpers for the compact storage. UseLegacyStorage() is called by the
+  // methods that modify cells in the legacy layout, UseLegacyArray() by the
+  // ones that hand out the legacy array, which may be written through.
+  void UseLegacyStorage()
+    {
+    if (this->Storage != LEGACY_STORAGE)
+      {
+      this->ConvertToLegacyStorage();
+      }
+    }
+  void UseLegacyArray()
+    {
+    this->UseLegacyStorage();
+    if (this->NumberOfLocations > 0)
+      {
+      this->InvalidateLocations();
+      }
+    }
+  void BuildLocations();
+  void InvalidateLocations();
+  void ReleaseCompactStorage();
+  void ResetCompactStorage();
+  vtkIdType InsertNextCompactCell(vtkIdType npts, const vtkIdType *pts);
+  void GetCellAtIdGeneric(vtkIdType cellId, vtkIdType &npts,
+                          const vtkIdType* &pts, vtkIdList *ptIds);
 
 private:
   vtkCellArray(const vtkCellArray&);  // Not implemented.
@@ -247,6 +387,11 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    return this->InsertNextCompactCell(npts, pts);
+    }
+
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
 
@@ -264,6 +409,7 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  this->UseLegacyStorage();
   this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
   this->NumberOfCells++;
 
@@ -273,12 +419,14 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  this->UseLegacyStorage();
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  this->UseLegacyStorage();
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -302,11 +450,17 @@ inline void vtkCellArray::Reset()
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
   this->Ia->Reset();
+  this->InvalidateLocations();
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    this->ResetCompactStorage();
+    }
 }
 
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
+  this->UseLegacyStorage();
   if ( this->Ia->GetMaxId() >= 0 &&
        this->TraversalLocation <= this->Ia->GetMaxId() )
     {
@@ -324,6 +478,7 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  this->UseLegacyStorage();
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
@@ -333,6 +488,7 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
   int i;
   vtkIdType tmp;
+  this->UseLegacyStorage();
   vtkIdType npts=this->Ia->GetValue(loc);
   vtkIdType *pts=this->Ia->GetPointer(loc+1);
   for (i=0; i < (npts/2); i++)
@@ -347,6 +503,7 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  this->UseLegacyStorage();
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
     {
@@ -358,10 +515,41 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  if (this->Storage != LEGACY_STORAGE)
+    {
+    this->ReleaseCompactStorage();
+    }
+  this->InvalidateLocations();
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
   return this->Ia->WritePointer(0,size);
 }
 
+//----------------------------------------------------------------------------
+inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                                      const vtkIdType* &pts,
+                                      vtkIdList *ptIds)
+{
+  if (this->Storage == COMPACT_STORAGE && !this->Storage32Bit)
+    {
+    const vtkIdType *offsets =
+      static_cast<vtkIdTypeArray*>(this->Offsets)->GetPointer(cellId);
+    npts = offsets[1] - offsets[0];
+    pts = static_cast<vtkIdTypeArray*>(this->Connectivity)->GetPointer(
+      offsets[0]);
+    return;
+    }
+  if (this->Storage == LEGACY_STORAGE &&
+      this->NumberOfLocations == this->NumberOfCells)
+    {
+    const vtkIdType *cell =
+      this->Ia->GetPointer(this->Locations->GetValue(cellId));
+    npts = cell[0];
+    pts = cell + 1;
+    return;
+    }
+  this->GetCellAtIdGeneric(cellId, npts, pts, ptIds);
+}
+
 #endif
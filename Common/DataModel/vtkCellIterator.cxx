@@ -60,6 +60,8 @@ void vtkCellIterator::PrintSelf(ostream &os, vtkIndent indent)
     }
 
   os << indent << "CellType: " << this->CellType << endl;
+  os << indent << "CellRange: " << this->CellRangeBegin << " "
+     << this->CellRangeEnd << endl;
   os << indent << "Points:" << endl;
   this->Points->PrintSelf(os, indent.GetNextIndent());
   os << indent << "PointIds:" << endl;
@@ -93,6 +95,8 @@ void vtkCellIterator::GetCell(vtkGenericCell *cell)
 //------------------------------------------------------------------------------
 vtkCellIterator::vtkCellIterator()
   : CellType(VTK_EMPTY_CELL),
+    CellRangeBegin(0),
+    CellRangeEnd(-1),
     CacheFlags(UninitializedFlag)
 {
   this->Points = this->PointsContainer.GetPointer();
@@ -58,6 +58,11 @@
 // (cell type, then point ids, then points/full cell) to prevent wasted cycles
 // fetching unnecessary data. Also note that at the end of the loop, the
 // iterator must be deleted as these iterators are vtkObject subclasses.
+//
+// SetCellRange() restricts the traversal to a contiguous range of cell ids.
+// Iterators of the same data set restricted to disjoint ranges may be used
+// concurrently, which is how vtkSMPCellLoop runs cell loops in parallel with
+// vtkSMPTools.
 
 #ifndef __vtkCellIterator_h
 #define __vtkCellIterator_h
@@ -97,6 +102,18 @@ public:
   // Get the id of the current cell.
   virtual vtkIdType GetCellId() = 0;
 
+  // Description:
+  // Restrict the traversal to the cells with ids in [begin, end). A negative
+  // end means up to the last cell of the data set, which is the default.
+  // The range takes effect at the next InitTraversal().
+  void SetCellRange(vtkIdType begin, vtkIdType end)
+  {
+    this->CellRangeBegin = begin;
+    this->CellRangeEnd = end;
+  }
+  vtkGetMacro(CellRangeBegin, vtkIdType)
+  vtkGetMacro(CellRangeEnd, vtkIdType)
+
   // Description:
   // Get the ids of the points in the current cell.
   // This should only be called when IsDoneWithTraversal() returns false.
@@ -133,7 +150,8 @@ protected:
   ~vtkCellIterator();
 
   // Description:
-  // Update internal state to point to the first cell.
+  // Update internal state to point to the first cell, which is the cell
+  // CellRangeBegin.
   virtual void ResetToFirstCell() = 0;
 
   // Description:
@@ -159,7 +177,19 @@ protected:
   // a description of the layout that Faces should have.
   virtual void FetchFaces() { }
 
+  // Description:
+  // Return the id one past the last cell to traverse for a data set of
+  // numberOfCells cells. IsDoneWithTraversal() implementations compare
+  // against it.
+  vtkIdType ClampCellRangeEnd(vtkIdType numberOfCells)
+  {
+    return (this->CellRangeEnd < 0 || this->CellRangeEnd > numberOfCells) ?
+      numberOfCells : this->CellRangeEnd;
+  }
+
   int CellType;
+  vtkIdType CellRangeBegin;
+  vtkIdType CellRangeEnd;
   vtkPoints *Points;
   vtkIdList *PointIds;
   vtkIdList *Faces;
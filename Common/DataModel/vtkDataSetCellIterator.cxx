@@ -41,7 +41,8 @@ void vtkDataSetCellIterator::SetDataSet(vtkDataSet *ds)
 bool vtkDataSetCellIterator::IsDoneWithTraversal()
 {
   return this->DataSet.GetPointer() == NULL
-      || this->CellId >= this->DataSet->GetNumberOfCells();
+      || this->CellId >=
+         this->ClampCellRangeEnd(this->DataSet->GetNumberOfCells());
 }
 
 //------------------------------------------------------------------------------
@@ -72,7 +73,7 @@ vtkDataSetCellIterator::~vtkDataSetCellIterator()
 //------------------------------------------------------------------------------
 void vtkDataSetCellIterator::ResetToFirstCell()
 {
-  this->CellId = 0;
+  this->CellId = this->CellRangeBegin;
 }
 
 //------------------------------------------------------------------------------
@@ -60,7 +60,7 @@ template <class Implementation>
 bool vtkMappedUnstructuredGridCellIterator<Implementation>
 ::IsDoneWithTraversal()
 {
-  return this->CellId >= this->NumberOfCells;
+  return this->CellId >= this->ClampCellRangeEnd(this->NumberOfCells);
 }
 
 //------------------------------------------------------------------------------
@@ -94,7 +94,7 @@ template <class Implementation>
 void vtkMappedUnstructuredGridCellIterator<Implementation>
 ::ResetToFirstCell()
 {
-  this->CellId = 0;
+  this->CellId = this->CellRangeBegin;
 }
 
 //------------------------------------------------------------------------------
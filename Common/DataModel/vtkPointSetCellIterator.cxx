@@ -41,7 +41,8 @@ void vtkPointSetCellIterator::SetPointSet(vtkPointSet *ds)
 bool vtkPointSetCellIterator::IsDoneWithTraversal()
 {
   return this->PointSet.GetPointer() == NULL
-      || this->CellId >= this->PointSet->GetNumberOfCells();
+      || this->CellId >=
+         this->ClampCellRangeEnd(this->PointSet->GetNumberOfCells());
 }
 
 //------------------------------------------------------------------------------
@@ -73,7 +74,7 @@ vtkPointSetCellIterator::~vtkPointSetCellIterator()
 //------------------------------------------------------------------------------
 void vtkPointSetCellIterator::ResetToFirstCell()
 {
-  this->CellId = 0;
+  this->CellId = this->CellRangeBegin;
 }
 
 //------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCriticalSection.h"
+#include "vtkDataArray.h"
 #include "vtkEmptyCell.h"
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
@@ -578,6 +579,17 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 }
 
 
+//----------------------------------------------------------------------------
+static inline void vtkPolyDataAddToBounds(double bounds[6], const double x[3])
+{
+  bounds[0] = (x[0] < bounds[0] ? x[0] : bounds[0]);
+  bounds[1] = (x[0] > bounds[1] ? x[0] : bounds[1]);
+  bounds[2] = (x[1] < bounds[2] ? x[1] : bounds[2]);
+  bounds[3] = (x[1] > bounds[3] ? x[1] : bounds[3]);
+  bounds[4] = (x[2] < bounds[4] ? x[2] : bounds[4]);
+  bounds[5] = (x[2] > bounds[5] ? x[2] : bounds[5]);
+}
+
 //----------------------------------------------------------------------------
 void vtkPolyData::ComputeBounds()
 {
@@ -608,20 +620,29 @@ void vtkPolyData::ComputeBounds()
     this->Bounds[0] = this->Bounds[2] = this->Bounds[4] =  VTK_DOUBLE_MAX;
     this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = -VTK_DOUBLE_MAX;
 
-    // Iterate over cells's points
+    // Iterate over cells's points. The connectivity array of compact cell
+    // arrays holds the points of all their cells, it is read directly so
+    // that they are not converted to the legacy layout.
     for (t = 0; t < 4; t++)
       {
+      vtkDataArray *conn = cella[t]->GetConnectivityArray();
+      if (conn)
+        {
+        for (vtkIdType k = 0; k < conn->GetNumberOfTuples(); k++)
+          {
+          this->Points->GetPoint(
+            static_cast<vtkIdType>(conn->GetComponent(k, 0)), x);
+          vtkPolyDataAddToBounds(this->Bounds, x);
+          doneOne = 1;
+          }
+        continue;
+        }
       for (cella[t]->InitTraversal(); cella[t]->GetNextCell(npts,pts); )
         {
         for (i = 0;  i < npts; i++)
           {
           this->Points->GetPoint( pts[i], x );
-          this->Bounds[0] = (x[0] < this->Bounds[0] ? x[0] : this->Bounds[0]);
-          this->Bounds[1] = (x[0] > this->Bounds[1] ? x[0] : this->Bounds[1]);
-          this->Bounds[2] = (x[1] < this->Bounds[2] ? x[1] : this->Bounds[2]);
-          this->Bounds[3] = (x[1] > this->Bounds[3] ? x[1] : this->Bounds[3]);
-          this->Bounds[4] = (x[2] < this->Bounds[4] ? x[2] : this->Bounds[4]);
-          this->Bounds[5] = (x[2] > this->Bounds[5] ? x[2] : this->Bounds[5]);
+          vtkPolyDataAddToBounds(this->Bounds, x);
           doneOne = 1;
           }
         }
@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPCellLoop.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPCellLoop - Parallel loop over the cells of a data set.
+//
+// .SECTION Description
+// vtkSMPCellLoop::For() splits the cells of a data set into ranges that are
+// processed in parallel with vtkSMPTools::For(). Each thread owns a
+// vtkCellIterator, created with vtkDataSet::NewCellIterator() and restricted
+// to the range at hand with vtkCellIterator::SetCellRange(), and a
+// vtkGenericCell scratch cell. The functor is called once per range:
+// ~~~
+// class CellVolume
+// {
+// public:
+//   vtkSMPThreadLocal<double> Volume;
+//
+//   void operator()(vtkCellIterator *it, vtkGenericCell *cell)
+//   {
+//     double &volume = this->Volume.Local();
+//     for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextCell())
+//       {
+//       it->GetCell(cell);
+//       /* ... */
+//       }
+//   }
+// };
+//
+// CellVolume functor;
+// vtkSMPCellLoop::For(dataSet, functor);
+// ~~~
+// Like any vtkSMPTools functor, it may also define Initialize() and Reduce(),
+// which are called once per thread and once after the loop.
+//
+// The data set must not be modified during the loop. Some data sets build
+// structures on first access (the cell types and locations of vtkPolyData
+// for example), For() triggers that from the calling thread before going
+// parallel.
+//
+// .SECTION See Also
+// vtkCellIterator vtkSMPTools
+
+#ifndef __vtkSMPCellLoop_h
+#define __vtkSMPCellLoop_h
+
+#include "vtkCellIterator.h" // For vtkCellIterator
+#include "vtkDataSet.h" // For vtkDataSet
+#include "vtkGenericCell.h" // For vtkGenericCell
+#include "vtkSMPThreadLocal.h" // For thread local iterators
+#include "vtkSMPThreadLocalObject.h" // For thread local cells
+#include "vtkSMPTools.h" // For vtkSMPTools
+#include "vtkSmartPointer.h" // For vtkSmartPointer
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+// Adapts a (vtkCellIterator*, vtkGenericCell*) functor to the
+// (begin, end) interface of vtkSMPTools::For().
+template <typename Functor>
+class vtkSMPCellLoopFunctorBase
+{
+public:
+  vtkSMPCellLoopFunctorBase(vtkDataSet *ds, Functor &f)
+    : DataSet(ds), F(f)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSmartPointer<vtkCellIterator> &it = this->Iterators.Local();
+    if (!it)
+      {
+      it.TakeReference(this->DataSet->NewCellIterator());
+      }
+    it->SetCellRange(begin, end);
+    this->F(it.GetPointer(), this->Cells.Local());
+  }
+
+protected:
+  vtkDataSet *DataSet;
+  Functor &F;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellIterator> > Iterators;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cells;
+
+private:
+  vtkSMPCellLoopFunctorBase(const vtkSMPCellLoopFunctorBase&);
+  void operator=(const vtkSMPCellLoopFunctorBase&);
+};
+
+template <typename Functor, bool Init>
+class vtkSMPCellLoopFunctor;
+
+template <typename Functor>
+class vtkSMPCellLoopFunctor<Functor, false>
+  : public vtkSMPCellLoopFunctorBase<Functor>
+{
+public:
+  vtkSMPCellLoopFunctor(vtkDataSet *ds, Functor &f)
+    : vtkSMPCellLoopFunctorBase<Functor>(ds, f)
+  {
+  }
+};
+
+template <typename Functor>
+class vtkSMPCellLoopFunctor<Functor, true>
+  : public vtkSMPCellLoopFunctorBase<Functor>
+{
+public:
+  vtkSMPCellLoopFunctor(vtkDataSet *ds, Functor &f)
+    : vtkSMPCellLoopFunctorBase<Functor>(ds, f)
+  {
+  }
+
+  void Initialize()
+  {
+    this->F.Initialize();
+  }
+
+  void Reduce()
+  {
+    this->F.Reduce();
+  }
+};
+}
+}
+}
+
+class vtkSMPCellLoop
+{
+public:
+  // Description:
+  // Call functor(iterator, cell) over ranges of the cells of ds in
+  // parallel, see the class description. grain is the approximate number of
+  // cells per range, 0 lets the backend choose.
+  template <typename Functor>
+  static void For(vtkDataSet *ds, Functor &functor, vtkIdType grain = 0)
+  {
+    vtkIdType numCells = ds ? ds->GetNumberOfCells() : 0;
+    if (numCells == 0)
+      {
+      return;
+      }
+
+    // Fetch a cell from this thread so that the data set builds what it
+    // builds lazily before the worker threads share it.
+    vtkSmartPointer<vtkCellIterator> it =
+      vtkSmartPointer<vtkCellIterator>::Take(ds->NewCellIterator());
+    it->InitTraversal();
+    it->GetCellType();
+    it->GetPointIds();
+
+    vtk::detail::smp::vtkSMPCellLoopFunctor<Functor,
+      vtkSMPTools::HasInitialize<Functor>::value> loop(ds, functor);
+    vtkSMPTools::For(0, numCells, grain, loop);
+  }
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPCellLoop.h
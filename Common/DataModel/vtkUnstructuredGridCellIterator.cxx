@@ -22,6 +22,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <assert.h>
 
 vtkStandardNewMacro(vtkUnstructuredGridCellIterator)
@@ -38,6 +39,8 @@ void vtkUnstructuredGridCellIterator::PrintSelf(ostream &os, vtkIndent indent)
      << static_cast<void*>(this->CellTypePtr) << endl;
   os << indent << "CellTypeEnd: "
      << static_cast<void*>(this->CellTypeEnd) << endl;
+  os << indent << "NumberOfCells: " << this->NumberOfCells << endl;
+  os << indent << "LocationsBegin: " << this->LocationsBegin << endl;
   os << indent << "ConnectivityBegin: " << this->ConnectivityBegin << endl;
   os << indent << "ConnectivityPtr: " << this->ConnectivityPtr << endl;
   os << indent << "FacesBegin: " << this->FacesBegin<< endl;
@@ -54,17 +57,20 @@ void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
 {
   // If the unstructured grid has not been initialized yet, these may not exist:
   vtkUnsignedCharArray *cellTypeArray = ug ? ug->GetCellTypesArray() : NULL;
+  vtkIdTypeArray *locationArray = ug ? ug->GetCellLocationsArray() : NULL;
   vtkCellArray *cellArray = ug ? ug->GetCells() : NULL;
   vtkPoints *points = ug ? ug->GetPoints() : NULL;
 
-  if (ug && cellTypeArray && cellArray && points)
+  if (ug && cellTypeArray && locationArray && cellArray && points)
     {
     // Cell types
     this->CellTypeBegin = this->CellTypeEnd = this->CellTypePtr
         = cellTypeArray ? cellTypeArray->GetPointer(0) : NULL;
-    this->CellTypeEnd += cellTypeArray ? cellTypeArray->GetNumberOfTuples() : 0;
+    this->NumberOfCells = cellTypeArray->GetNumberOfTuples();
+    this->CellTypeEnd += this->NumberOfCells;
 
-    // CellArray
+    // CellArray, the locations allow starting at any cell.
+    this->LocationsBegin = locationArray->GetPointer(0);
     this->ConnectivityBegin = this->ConnectivityPtr = cellArray->GetPointer();
 
     // Point
@@ -90,6 +96,8 @@ void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
     this->CellTypeBegin = NULL;
     this->CellTypePtr = NULL;
     this->CellTypeEnd = NULL;
+    this->NumberOfCells = 0;
+    this->LocationsBegin = NULL;
     this->FacesBegin = NULL;
     this->FacesLocsBegin = NULL;
     this->FacesLocsPtr = NULL;
@@ -158,6 +166,8 @@ vtkUnstructuredGridCellIterator::vtkUnstructuredGridCellIterator()
     CellTypeBegin(NULL),
     CellTypePtr(NULL),
     CellTypeEnd(NULL),
+    NumberOfCells(0),
+    LocationsBegin(NULL),
     ConnectivityBegin(NULL),
     ConnectivityPtr(NULL),
     FacesBegin(NULL),
@@ -176,9 +186,17 @@ vtkUnstructuredGridCellIterator::~vtkUnstructuredGridCellIterator()
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::ResetToFirstCell()
 {
-  this->CellTypePtr = this->CellTypeBegin;
-  this->FacesLocsPtr = this->FacesLocsBegin;
+  vtkIdType first = std::min(this->CellRangeBegin, this->NumberOfCells);
+  this->CellTypePtr = this->CellTypeBegin + first;
+  this->CellTypeEnd =
+    this->CellTypeBegin + this->ClampCellRangeEnd(this->NumberOfCells);
+  this->FacesLocsPtr =
+    this->FacesLocsBegin ? this->FacesLocsBegin + first : NULL;
   this->ConnectivityPtr = this->ConnectivityBegin;
+  if (first > 0 && first < this->NumberOfCells)
+    {
+    this->ConnectivityPtr += this->LocationsBegin[first];
+    }
   this->SkippedCells = 0;
 }
 
@@ -55,7 +55,9 @@ protected:
   unsigned char *CellTypeBegin;
   unsigned char *CellTypePtr;
   unsigned char *CellTypeEnd;
+  vtkIdType NumberOfCells;
 
+  vtkIdType *LocationsBegin;
   vtkIdType *ConnectivityBegin;
   vtkIdType *ConnectivityPtr;
   vtkIdType *FacesBegin;
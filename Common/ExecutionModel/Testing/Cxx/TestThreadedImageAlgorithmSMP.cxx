@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAlgorithmSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkThreadedImageAlgorithm processes every point of the output
+// exactly once, both with vtkMultiThreader and when the extent is split
+// into small pieces that are scheduled with vtkSMPTools.
+
+#include "vtkDataObject.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <set>
+
+// Make a filter that doubles the input and records the thread id that
+// produced each point in a second component.
+class vtkPieceIdImageFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkPieceIdImageFilter *New();
+  vtkTypeMacro(vtkPieceIdImageFilter,vtkThreadedImageAlgorithm);
+
+protected:
+  vtkPieceIdImageFilter() {};
+  ~vtkPieceIdImageFilter() {};
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector* outputVector)
+    {
+    vtkDataObject::SetPointDataActiveScalarInfo(
+      outputVector->GetInformationObject(0), VTK_INT, 2);
+    return 1;
+    }
+
+  void ThreadedRequestData(vtkInformation*, vtkInformationVector**,
+                           vtkInformationVector*, vtkImageData ***inData,
+                           vtkImageData **outData, int extent[6],
+                           int threadId)
+    {
+    for (int k = extent[4]; k <= extent[5]; ++k)
+      {
+      for (int j = extent[2]; j <= extent[3]; ++j)
+        {
+        int *inPtr = static_cast<int *>(
+          inData[0][0]->GetScalarPointer(extent[0], j, k));
+        int *outPtr = static_cast<int *>(
+          outData[0]->GetScalarPointer(extent[0], j, k));
+        for (int i = extent[0]; i <= extent[1]; ++i)
+          {
+          outPtr[0] = 2*inPtr[0];
+          outPtr[1] = threadId;
+          inPtr++;
+          outPtr += 2;
+          }
+        }
+      }
+    }
+
+private:
+  vtkPieceIdImageFilter(const vtkPieceIdImageFilter&);  // Not implemented.
+  void operator=(const vtkPieceIdImageFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkPieceIdImageFilter);
+
+// Returns the number of pieces the output was computed with, or -1 if a
+// point of the output is wrong.
+static int CheckOutput(vtkImageData *input, vtkImageData *output)
+{
+  vtkIntArray *inScalars =
+    vtkIntArray::SafeDownCast(input->GetPointData()->GetScalars());
+  vtkIntArray *outScalars =
+    vtkIntArray::SafeDownCast(output->GetPointData()->GetScalars());
+  if (!outScalars ||
+      outScalars->GetNumberOfTuples() != inScalars->GetNumberOfTuples())
+    {
+    return -1;
+    }
+  std::set<int> pieces;
+  for (vtkIdType i = 0; i < inScalars->GetNumberOfTuples(); ++i)
+    {
+    if (outScalars->GetValue(2*i) != 2*inScalars->GetValue(i))
+      {
+      return -1;
+      }
+    pieces.insert(outScalars->GetValue(2*i + 1));
+    }
+  return static_cast<int>(pieces.size());
+}
+
+int TestThreadedImageAlgorithmSMP(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-3, 60, 2, 41, 0, 22);
+  vtkNew<vtkIntArray> scalars;
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    scalars->SetValue(i, static_cast<int>(i % 101) - 50);
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkPieceIdImageFilter> filter;
+  filter->SetInputData(image.GetPointer());
+  filter->SetNumberOfThreads(3);
+  if (filter->GetEnableSMP())
+    {
+    cerr << "Error: EnableSMP should be off by default" << endl;
+    return EXIT_FAILURE;
+    }
+  filter->Update();
+  int numPieces = CheckOutput(image.GetPointer(), filter->GetOutput());
+  if (numPieces != 3)
+    {
+    cerr << "Error: wrong output with vtkMultiThreader ("
+         << numPieces << " pieces)" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // 64x40x23 points of 8 bytes make 471040 bytes, so 5 pieces of about
+  // 100000 bytes are asked for, split along the slowest axis.
+  filter->EnableSMPOn();
+  filter->SetDesiredBytesPerPiece(100000);
+  filter->Update();
+  numPieces = CheckOutput(image.GetPointer(), filter->GetOutput());
+  if (numPieces != 5)
+    {
+    cerr << "Error: wrong output with vtkSMPTools ("
+         << numPieces << " pieces)" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // More pieces than slices: the extent is split in single slices.
+  filter->SetDesiredBytesPerPiece(64);
+  filter->Update();
+  numPieces = CheckOutput(image.GetPointer(), filter->GetOutput());
+  if (numPieces != 23)
+    {
+    cerr << "Error: wrong output with small pieces ("
+         << numPieces << " pieces)" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The global default applies to the filters created afterwards.
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(true);
+  vtkNew<vtkPieceIdImageFilter> filter2;
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(false);
+  if (!filter2->GetEnableSMP())
+    {
+    cerr << "Error: the global default of EnableSMP is ignored" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
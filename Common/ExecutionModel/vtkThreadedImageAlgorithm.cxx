@@ -23,14 +23,19 @@
 #include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+// Initial value of EnableSMP.
+static bool vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = false;
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+  this->EnableSMP = vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
+  this->DesiredBytesPerPiece = 65536;
 }
 
 //----------------------------------------------------------------------------
@@ -45,6 +50,21 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
+  os << indent << "DesiredBytesPerPiece: " << this->DesiredBytesPerPiece
+     << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(bool enable)
+{
+  vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = enable;
+}
+
+//----------------------------------------------------------------------------
+bool vtkThreadedImageAlgorithm::GetGlobalDefaultEnableSMP()
+{
+  return vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
 }
 
 struct vtkImageThreadStruct
@@ -121,22 +141,13 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
 }
 
 
-// this mess is really a simple function. All it does is call
-// the ThreadedExecute method after setting the correct
-// extent for this thread. Its just a pain to calculate
-// the correct extent.
-static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+//----------------------------------------------------------------------------
+// Get the extent to split between the threads: the update extent of the
+// output port the request came from, or the one of the first input if
+// there is no output.  Returns false if there is no such extent.
+static bool vtkThreadedImageAlgorithmGetExtent(vtkImageThreadStruct *str,
+                                               int ext[6])
 {
-  vtkImageThreadStruct *str;
-  int ext[6], splitExt[6], total;
-  int threadId, threadCount;
-
-  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
-  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
-
-  str = static_cast<vtkImageThreadStruct *>
-    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
-
   // if we have an output
   if (str->Filter->GetNumberOfOutputPorts())
     {
@@ -148,57 +159,54 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
     // update directly, for now an error
     if (outputPort == -1)
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return false;
       }
 
     // get the update extent from the output port
     vtkInformation *outInfo =
       str->OutputsInfo->GetInformationObject(outputPort);
-    int updateExtent[6];
-    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
-                 updateExtent);
-    memcpy(ext,updateExtent, sizeof(int)*6);
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext);
+    return true;
     }
-  else
+
+  // if there is no output, then use UE from input, use the first input
+  for (int inPort = 0; inPort < str->Filter->GetNumberOfInputPorts();
+       ++inPort)
     {
-    // if there is no output, then use UE from input, use the first input
-    int inPort;
-    for (inPort = 0; inPort < str->Filter->GetNumberOfInputPorts(); ++inPort)
-      {
-      if (str->Filter->GetNumberOfInputConnections(inPort))
-        {
-        int updateExtent[6];
-        str->InputsInfo[inPort]
-          ->GetInformationObject(0)
-          ->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
-                updateExtent);
-        memcpy(ext,updateExtent, sizeof(int)*6);
-        break;
-        }
-      }
-    if (inPort >= str->Filter->GetNumberOfInputPorts())
+    if (str->Filter->GetNumberOfInputConnections(inPort))
       {
-      return VTK_THREAD_RETURN_VALUE;
+      str->InputsInfo[inPort]
+        ->GetInformationObject(0)
+        ->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext);
+      return true;
       }
     }
+  return false;
+}
 
-  // execute the actual method with appropriate extent
-  // first find out how many pieces extent can be split into.
-  total = str->Filter->SplitExtent(splitExt, ext, threadId, threadCount);
+//----------------------------------------------------------------------------
+// Execute piece num of total pieces of the extent, unless the extent
+// cannot be split into that many pieces.
+static void vtkThreadedImageAlgorithmExecutePiece(vtkImageThreadStruct *str,
+                                                  int ext[6], int num,
+                                                  int total)
+{
+  int splitExt[6];
 
-  if (threadId < total)
+  // first find out how many pieces extent can be split into.
+  if (num < str->Filter->SplitExtent(splitExt, ext, num, total))
     {
     // return if nothing to do
     if (splitExt[1] < splitExt[0] ||
         splitExt[3] < splitExt[2] ||
         splitExt[5] < splitExt[4])
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return;
       }
     str->Filter->ThreadedRequestData(str->Request,
                                      str->InputsInfo, str->OutputsInfo,
                                      str->Inputs, str->Outputs,
-                                     splitExt, threadId);
+                                     splitExt, num);
     }
   // else
   //   {
@@ -206,10 +214,111 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
   //   break up very well and it is just as efficient to leave a
   //   few threads idle.
   //   }
+}
+
+// this mess is really a simple function. All it does is call
+// the ThreadedExecute method after setting the correct
+// extent for this thread. Its just a pain to calculate
+// the correct extent.
+static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+{
+  vtkImageThreadStruct *str;
+  int ext[6];
+  int threadId, threadCount;
+
+  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
+  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
+
+  str = static_cast<vtkImageThreadStruct *>
+    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+
+  // execute the actual method with appropriate extent
+  if (vtkThreadedImageAlgorithmGetExtent(str, ext))
+    {
+    vtkThreadedImageAlgorithmExecutePiece(str, ext, threadId, threadCount);
+    }
 
   return VTK_THREAD_RETURN_VALUE;
 }
 
+//----------------------------------------------------------------------------
+// The vtkSMPTools functor executing a range of pieces.
+class vtkThreadedImageAlgorithmFunctor
+{
+public:
+  vtkThreadedImageAlgorithmFunctor(vtkImageThreadStruct *str, int ext[6],
+                                   int numPieces)
+    : Struct(str), NumberOfPieces(numPieces)
+    {
+    memcpy(this->Extent, ext, sizeof(int)*6);
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    int ext[6];
+    memcpy(ext, this->Extent, sizeof(int)*6);
+    for (vtkIdType piece = begin; piece < end; ++piece)
+      {
+      vtkThreadedImageAlgorithmExecutePiece(this->Struct, ext,
+                                            static_cast<int>(piece),
+                                            this->NumberOfPieces);
+      }
+    }
+
+private:
+  vtkImageThreadStruct *Struct;
+  int Extent[6];
+  int NumberOfPieces;
+};
+
+//----------------------------------------------------------------------------
+// Execute the filter on pieces of about DesiredBytesPerPiece bytes of
+// output scalars (input scalars if there is no output) with vtkSMPTools.
+static void vtkThreadedImageAlgorithmSMPExecute(vtkImageThreadStruct *str,
+                                                vtkIdType bytesPerPiece)
+{
+  int ext[6];
+  if (!vtkThreadedImageAlgorithmGetExtent(str, ext) ||
+      ext[1] < ext[0] || ext[3] < ext[2] || ext[5] < ext[4])
+    {
+    return;
+    }
+
+  vtkImageData *image = 0;
+  if (str->Outputs)
+    {
+    image = str->Outputs[0];
+    }
+  else if (str->Inputs && str->Inputs[0])
+    {
+    image = str->Inputs[0][0];
+    }
+  double bytesPerPoint = 1.0;
+  vtkDataArray *scalars =
+    (image ? image->GetPointData()->GetScalars() : 0);
+  if (scalars)
+    {
+    bytesPerPoint = scalars->GetNumberOfComponents()*
+      scalars->GetDataTypeSize();
+    }
+
+  double bytes = bytesPerPoint*(ext[1] - ext[0] + 1)*
+    (ext[3] - ext[2] + 1)*(ext[5] - ext[4] + 1);
+  double pieces = ceil(bytes/bytesPerPiece);
+  int numPieces = (pieces < VTK_INT_MAX ?
+                   static_cast<int>(pieces) : VTK_INT_MAX);
+  if (numPieces < 1)
+    {
+    numPieces = 1;
+    }
+
+  // SplitExtent may give fewer pieces than asked for.
+  int splitExt[6];
+  numPieces = str->Filter->SplitExtent(splitExt, ext, 0, numPieces);
+
+  vtkThreadedImageAlgorithmFunctor functor(str, ext, numPieces);
+  vtkSMPTools::For(0, numPieces, 1, functor);
+}
 
 //----------------------------------------------------------------------------
 // This is the superclasses style of Execute method.  Convert it into
@@ -283,13 +392,20 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
 
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);
-
   // always shut off debugging to avoid threading problems with GetMacros
   int debug = this->Debug;
   this->Debug = 0;
-  this->Threader->SingleMethodExecute();
+  if (this->EnableSMP)
+    {
+    vtkThreadedImageAlgorithmSMPExecute(&str, this->DesiredBytesPerPiece);
+    }
+  else
+    {
+    this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+    this->Threader->SetSingleMethod(
+      vtkThreadedImageAlgorithmThreadedExecute, &str);
+    this->Threader->SingleMethodExecute();
+    }
   this->Debug = debug;
 
   // free up the arrays
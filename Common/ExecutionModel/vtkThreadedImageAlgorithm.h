@@ -19,6 +19,12 @@
 // into smaller extents so that the vtkImageData limits are observed. It
 // also provides support for multithreading. If you don't need any of this
 // functionality, consider using vtkSimpleImageToImageAlgorithm instead.
+//
+// By default the output extent is split into one piece per thread, and
+// each piece is processed by a thread of a vtkMultiThreader.  When
+// EnableSMP is on, it is instead split into many small pieces which are
+// scheduled through vtkSMPTools, so that the threads which finish early
+// take over the remaining work.
 // .SECTION See also
 // vtkSimpleImageToImageAlgorithm
 
@@ -59,6 +65,29 @@ public:
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Use vtkSMPTools instead of vtkMultiThreader.  The output extent is then
+  // split by SplitExtent() into pieces of about DesiredBytesPerPiece bytes
+  // of output scalars, NumberOfThreads is ignored, and the threadId given
+  // to ThreadedRequestData() is the index of the piece.  The default is
+  // given by GetGlobalDefaultEnableSMP().
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+
+  // Description:
+  // Global default value of EnableSMP for the filters created afterwards.
+  // It is off initially.
+  static void SetGlobalDefaultEnableSMP(bool enable);
+  static bool GetGlobalDefaultEnableSMP();
+
+  // Description:
+  // The desired size of the pieces in bytes when EnableSMP is on.  Pieces
+  // fitting in the cache of a core give the best performance.  The
+  // default is 65536.
+  vtkSetClampMacro(DesiredBytesPerPiece, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(DesiredBytesPerPiece, vtkIdType);
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6],
@@ -71,6 +100,9 @@ protected:
   vtkMultiThreader *Threader;
   int NumberOfThreads;
 
+  bool EnableSMP;
+  vtkIdType DesiredBytesPerPiece;
+
   // Description:
   // This is called by the superclass.
   // This is the method you should override.
@@ -13,22 +13,190 @@
 
 =========================================================================*/
 
+#include <vtkCellArray.h>
 #include <vtkCellDataToPointData.h>
 #include <vtkDataArray.h>
 #include <vtkCellData.h>
 #include <vtkDataSet.h>
 #include <vtkDataSetTriangleFilter.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdList.h>
+#include <vtkIntArray.h>
 #include <vtkPointData.h>
 #include <vtkPointDataToCellData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
 #include <vtkRTAnalyticSource.h>
 #include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkThreshold.h>
 #include <vtkTestUtilities.h>
 
+#include <cmath>
+#include <sstream>
+#include <vector>
+
 #define vsp(type, name) \
         vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
 
+namespace
+{
+// Adds a double, an int and a string cell array to ds.
+void AddCellArrays(vtkDataSet* ds)
+{
+  vtkIdType numCells = ds->GetNumberOfCells();
+  vsp(DoubleArray, doubles);
+  doubles->SetName("doubles");
+  doubles->SetNumberOfComponents(2);
+  doubles->SetNumberOfTuples(numCells);
+  vsp(IntArray, ints);
+  ints->SetName("ints");
+  ints->SetNumberOfTuples(numCells);
+  vsp(StringArray, strings);
+  strings->SetName("strings");
+  strings->SetNumberOfTuples(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    doubles->SetComponent(cellId, 0, std::sin(0.1 * cellId));
+    doubles->SetComponent(cellId, 1, 0.5 * cellId);
+    // Odd and negative values, so that averages land on halves.
+    ints->SetValue(cellId, static_cast<int>(cellId % 7) - 2);
+    std::ostringstream name;
+    name << "cell" << cellId;
+    strings->SetValue(cellId, name.str());
+    }
+  ds->GetCellData()->AddArray(doubles);
+  ds->GetCellData()->AddArray(ints);
+  ds->GetCellData()->AddArray(strings);
+}
+
+// Compares the output of vtkCellDataToPointData with averages computed
+// from the cells of every point. Numeric values are the mean of the cell
+// values, rounded half away from zero for integers; strings are taken
+// from the first cell. Points without cells get zeros and empty strings.
+bool CheckAverages(vtkDataSet* input, const char* name)
+{
+  vsp(CellDataToPointData, c2p);
+  c2p->SetInputData(input);
+  c2p->Update();
+  vtkDataSet* output = c2p->GetOutput();
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<std::vector<vtkIdType> > pointCells(numPts);
+  vsp(IdList, ptIds);
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+    {
+    input->GetCellPoints(cellId, ptIds);
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+      pointCells[ptIds->GetId(i)].push_back(cellId);
+      }
+    }
+
+  vtkDataArray* doubles = output->GetPointData()->GetArray("doubles");
+  vtkIntArray* ints = vtkIntArray::SafeDownCast(
+    output->GetPointData()->GetAbstractArray("ints"));
+  vtkStringArray* strings = vtkStringArray::SafeDownCast(
+    output->GetPointData()->GetAbstractArray("strings"));
+  if (!doubles || !ints || !strings ||
+      doubles->GetNumberOfTuples() != numPts ||
+      ints->GetNumberOfTuples() != numPts ||
+      strings->GetNumberOfValues() != numPts)
+    {
+    cerr << "Error: " << name << " is missing point arrays." << endl;
+    return false;
+    }
+
+  vtkDataArray* inDoubles = input->GetCellData()->GetArray("doubles");
+  vtkIntArray* inInts = vtkIntArray::SafeDownCast(
+    input->GetCellData()->GetAbstractArray("ints"));
+  vtkStringArray* inStrings = vtkStringArray::SafeDownCast(
+    input->GetCellData()->GetAbstractArray("strings"));
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    const std::vector<vtkIdType>& cells = pointCells[ptId];
+    double sums[3] = { 0.0, 0.0, 0.0 };
+    for (size_t i = 0; i < cells.size(); ++i)
+      {
+      double weight = 1.0 / cells.size();
+      sums[0] += weight * inDoubles->GetComponent(cells[i], 0);
+      sums[1] += weight * inDoubles->GetComponent(cells[i], 1);
+      sums[2] += weight * inInts->GetValue(cells[i]);
+      }
+    int expectedInt = static_cast<int>(
+      sums[2] >= 0.0 ? sums[2] + 0.5 : sums[2] - 0.5);
+    vtkStdString expectedString =
+      cells.empty() ? vtkStdString() : inStrings->GetValue(cells[0]);
+    if (std::fabs(doubles->GetComponent(ptId, 0) - sums[0]) > 1e-12 ||
+        std::fabs(doubles->GetComponent(ptId, 1) - sums[1]) > 1e-9 ||
+        ints->GetValue(ptId) != expectedInt ||
+        strings->GetValue(ptId) != expectedString)
+      {
+      cerr << "Error: " << name << " point " << ptId << " with "
+           << cells.size() << " cells has (" << doubles->GetComponent(ptId, 0)
+           << ", " << doubles->GetComponent(ptId, 1) << ", "
+           << ints->GetValue(ptId) << ", " << strings->GetValue(ptId)
+           << ") instead of (" << sums[0] << ", " << sums[1] << ", "
+           << expectedInt << ", " << expectedString << ")" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// An unstructured grid of tetrahedra with an unused point.
+bool TestUnstructuredGrid()
+{
+  vsp(RTAnalyticSource, wavelet);
+  wavelet->SetWholeExtent(-3, 3, -3, 3, -3, 3);
+  vsp(DataSetTriangleFilter, tetrahedralize);
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  tetrahedralize->Update();
+
+  vsp(UnstructuredGrid, grid);
+  grid->DeepCopy(tetrahedralize->GetOutput());
+  grid->GetPointData()->Initialize();
+  grid->GetPoints()->InsertNextPoint(10, 10, 10);
+  AddCellArrays(grid);
+  return CheckAverages(grid, "unstructured grid");
+}
+
+// A fan of triangles around a point used by more than 4096 cells, lines,
+// and an unused point.
+bool TestPolyData()
+{
+  const int numTris = 5000;
+  vsp(Points, points);
+  vsp(CellArray, lines);
+  vsp(CellArray, polys);
+  points->InsertNextPoint(0, 0, 0);
+  for (int i = 0; i <= numTris; ++i)
+    {
+    double angle = 2.0 * 3.141592653589793 * i / numTris;
+    points->InsertNextPoint(std::cos(angle), std::sin(angle), 0);
+    }
+  for (vtkIdType i = 1; i <= numTris; ++i)
+    {
+    vtkIdType tri[3] = { 0, i, i + 1 };
+    polys->InsertNextCell(3, tri);
+    }
+  for (vtkIdType i = 1; i <= numTris; i += 10)
+    {
+    vtkIdType line[2] = { i, i + 5 };
+    lines->InsertNextCell(2, line);
+    }
+  points->InsertNextPoint(5, 5, 5);
+
+  vsp(PolyData, polyData);
+  polyData->SetPoints(points);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  AddCellArrays(polyData);
+  return CheckAverages(polyData, "poly data");
+}
+}
+
 int TestCellDataToPointData (int, char*[])
 {
   char const name [] = "RTData";
@@ -82,7 +250,8 @@ int TestCellDataToPointData (int, char*[])
     }
   variance /= nvalues;
 
-  bool const ok = fabs(mean) < 1e-4 && fabs(variance) < 1e-4;
+  bool const ok = fabs(mean) < 1e-4 && fabs(variance) < 1e-4 &&
+    TestUnstructuredGrid() && TestPolyData();
   return !ok; // zero indicates test succeed
 }
 
@@ -15,255 +15,256 @@
 #include "vtkCellDataToPointData.h"
 
 #include "vtkCellData.h"
-#include "vtkCell.h"
+#include "vtkCellLinks.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
-#include "vtkSmartPointer.h"
-#include "vtkUnsignedIntArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkTypeTraits.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
-#include <functional>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellDataToPointData);
 
-//----------------------------------------------------------------------------
-// Instantiate object so that cell data is not passed to output.
-vtkCellDataToPointData::vtkCellDataToPointData()
+namespace
 {
-  this->PassCellData = 0;
-}
-
-#define VTK_MAX_CELLS_PER_POINT 4096
-
 //----------------------------------------------------------------------------
-int vtkCellDataToPointData::RequestData(
-  vtkInformation*,
-  vtkInformationVector** inputVector,
-  vtkInformationVector* outputVector)
+// Gives the cells using a point. Unstructured grids are read through their
+// cell links, other data sets through GetPointCells(). Once constructed it
+// may be used from several threads.
+class vtkCellDataToPointDataPointCells
 {
-  vtkInformation* info = outputVector->GetInformationObject(0);
-  vtkDataSet *output = vtkDataSet::SafeDownCast(
-    info->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkDataSet *input = vtkDataSet::SafeDownCast(
-    inInfo->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkDebugMacro(<<"Mapping cell data to point data");
-
-  // Special traversal algorithm for unstructured grid
-  if (input->IsA("vtkUnstructuredGrid"))
-    {
-    return this->RequestDataForUnstructuredGrid(0, inputVector, outputVector);
-    }
-
-  vtkIdType cellId, ptId;
-  vtkIdType numCells, numPts;
-  vtkCellData *inPD=input->GetCellData();
-  vtkPointData *outPD=output->GetPointData();
-  vtkIdList *cellIds;
-  double weight;
-  double *weights;
-
-  vtkDebugMacro(<<"Mapping cell data to point data");
-
-  // First, copy the input to the output as a starting point
-  output->CopyStructure( input );
-
-  cellIds = vtkIdList::New();
-  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
-
-  if ( (numPts=input->GetNumberOfPoints()) < 1 )
-    {
-    vtkDebugMacro(<<"No input point data!");
-    cellIds->Delete();
-    return 1;
-    }
-  weights = new double[VTK_MAX_CELLS_PER_POINT];
-
-  // Pass the point data first. The fields and attributes
-  // which also exist in the cell data of the input will
-  // be over-written during CopyAllocate
-  output->GetPointData()->CopyGlobalIdsOff();
-  output->GetPointData()->PassData(input->GetPointData());
-  output->GetPointData()->CopyFieldOff("vtkGhostLevels");
-
-  // notice that inPD and outPD are vtkCellData and vtkPointData; respectively.
-  // It's weird, but it works.
-  outPD->InterpolateAllocate(inPD,numPts);
-
-  int abort=0;
-  vtkIdType progressInterval=numPts/20 + 1;
-  for (ptId=0; ptId < numPts && !abort; ptId++)
-    {
-    if ( !(ptId % progressInterval) )
-      {
-      this->UpdateProgress(static_cast<double>(ptId)/numPts);
-      abort = GetAbortExecute();
-      }
-
-    input->GetPointCells(ptId, cellIds);
-    numCells = cellIds->GetNumberOfIds();
-    if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+public:
+  vtkCellDataToPointDataPointCells(vtkDataSet *ds)
+    : DataSet(ds), Links(NULL)
+  {
+    vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds);
+    if (ug)
       {
-      weight = 1.0 / numCells;
-      for (cellId=0; cellId < numCells; cellId++)
+      if (!ug->GetCellLinks())
         {
-        weights[cellId] = weight;
+        ug->BuildLinks();
         }
-      outPD->InterpolatePoint(inPD, ptId, cellIds, weights);
+      this->Links = ug->GetCellLinks();
       }
     else
       {
-      outPD->NullPoint(ptId);
+      // Data sets build their point to cell structures on first use, which
+      // must not happen from several threads.
+      vtkIdList *cellIds = vtkIdList::New();
+      ds->GetPointCells(0, cellIds);
+      cellIds->Delete();
       }
-    }
+  }
 
-  if ( !this->PassCellData )
-    {
-    output->GetCellData()->CopyAllOff();
-    output->GetCellData()->CopyFieldOn("vtkGhostLevels");
-    }
-  output->GetCellData()->PassData(input->GetCellData());
+  // Return the number of cells using ptId and point cells to their ids.
+  // cellIds is used as storage when needed.
+  vtkIdType Get(vtkIdType ptId, vtkIdList *cellIds, vtkIdType *&cells)
+  {
+    if (this->Links)
+      {
+      cells = this->Links->GetCells(ptId);
+      return this->Links->GetNcells(ptId);
+      }
+    this->DataSet->GetPointCells(ptId, cellIds);
+    cells = cellIds->GetPointer(0);
+    return cellIds->GetNumberOfIds();
+  }
 
-  cellIds->Delete();
-  delete [] weights;
+private:
+  vtkDataSet *DataSet;
+  vtkCellLinks *Links;
+};
 
-  return 1;
+//----------------------------------------------------------------------------
+// Round integer types, like vtkDataArray::InterpolateTuple() does.
+template <class T>
+inline void vtkCellDataToPointDataRound(double value, T *result)
+{
+  value = std::max(value, static_cast<double>(vtkTypeTraits<T>::Min()));
+  value = std::min(value, static_cast<double>(vtkTypeTraits<T>::Max()));
+  *result = static_cast<T>((value >= 0.0) ? (value + 0.5) : (value - 0.5));
 }
 
-//----------------------------------------------------------------------------
-void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
+inline void vtkCellDataToPointDataRound(double value, double *result)
 {
-  this->Superclass::PrintSelf(os,indent);
+  *result = value;
+}
 
-  os << indent << "Pass Cell Data: " << (this->PassCellData ? "On\n" : "Off\n");
+inline void vtkCellDataToPointDataRound(double value, float *result)
+{
+  *result = static_cast<float>(value);
 }
 
 //----------------------------------------------------------------------------
-// Helper template function that implement the major part of the algorighm
-// which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
-namespace
+// Average the cell values around each point. Every point is written by a
+// single thread, so no synchronization is needed.
+template <class T>
+class vtkCellDataToPointDataAverage
 {
-  template <typename T>
-  void __spread (vtkUnstructuredGrid* const src, vtkUnsignedIntArray* const num,
-             vtkDataArray* const srcarray, vtkDataArray* const dstarray,
-             vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps)
+public:
+  vtkCellDataToPointDataPointCells *PointCells;
+  const T *Source;
+  T *Destination;
+  int NumberOfComponents;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocal<std::vector<double> > Sums;
+
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    T const* const srcptr = static_cast<T const*>(srcarray->GetVoidPointer(0));
-    T      * const dstptr = static_cast<T      *>(dstarray->GetVoidPointer(0));
+    vtkIdList *cellIds = this->CellIds.Local();
+    std::vector<double> &sums = this->Sums.Local();
+    int numComps = this->NumberOfComponents;
+    sums.resize(numComps);
 
-    // zero initialization
-    std::fill_n(dstptr, npoints*ncomps, T(0));
-
-    // accumulate
-    T const* srcbeg = srcptr;
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid, srcbeg += ncomps)
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-      src->GetCellPoints(cid, pids.GetPointer());
-      for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+      vtkIdType *cells;
+      vtkIdType numCells = this->PointCells->Get(ptId, cellIds, cells);
+      T *out = this->Destination + ptId * numComps;
+      if (numCells < 1)
         {
-        T* const dstbeg = dstptr + pids->GetId(i)*ncomps;
-        // accumulate cell data to point data <==> point_data += cell_data
-        std::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,std::plus<T>());
+        std::fill(out, out + numComps, static_cast<T>(0));
+        continue;
         }
-      }
 
-    // average
-    T* dstbeg = dstptr;
-    for (vtkIdType pid = 0; pid < npoints; ++pid, dstbeg += ncomps)
-      {
-      // guard against divide by zero
-      if (unsigned int const denum = num->GetValue(pid))
+      double weight = 1.0 / numCells;
+      std::fill(sums.begin(), sums.end(), 0.0);
+      for (vtkIdType i = 0; i < numCells; ++i)
+        {
+        const T *in = this->Source + cells[i] * numComps;
+        for (int j = 0; j < numComps; ++j)
+          {
+          sums[j] += weight * static_cast<double>(in[j]);
+          }
+        }
+      for (int j = 0; j < numComps; ++j)
         {
-        // divide point data by the number of cells using it <==>
-        // point_data /= denum
-        std::transform(dstbeg, dstbeg+ncomps, dstbeg,
-          std::bind2nd(std::divides<T>(), denum));
+        vtkCellDataToPointDataRound(sums[j], out + j);
         }
       }
   }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkCellDataToPointDataAverageArray(
+  vtkCellDataToPointDataPointCells *pointCells, T *source, T *destination,
+  int numComps, vtkIdType numPts)
+{
+  vtkCellDataToPointDataAverage<T> average;
+  average.PointCells = pointCells;
+  average.Source = source;
+  average.Destination = destination;
+  average.NumberOfComponents = numComps;
+  vtkSMPTools::For(0, numPts, average);
 }
 
 //----------------------------------------------------------------------------
-int vtkCellDataToPointData::RequestDataForUnstructuredGrid
-  (vtkInformation*,
-   vtkInformationVector** inputVector,
-   vtkInformationVector* outputVector)
+// Serial fallback for the arrays without a plain memory layout (bit arrays,
+// string arrays, mapped arrays, ...).
+void vtkCellDataToPointDataInterpolateArray(
+  vtkCellDataToPointDataPointCells *pointCells, vtkAbstractArray *source,
+  vtkAbstractArray *destination, vtkIdType numPts)
 {
-  vtkUnstructuredGrid* const src = vtkUnstructuredGrid::SafeDownCast(
-    inputVector[0]->GetInformationObject(0)->Get(vtkDataObject::DATA_OBJECT()));
-  vtkUnstructuredGrid* const dst = vtkUnstructuredGrid::SafeDownCast(
-    outputVector->GetInformationObject(0)->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkIdType const ncells  = src->GetNumberOfCells ();
-  vtkIdType const npoints = src->GetNumberOfPoints();
-  if (ncells < 1 || npoints < 1)
+  vtkIdList *cellIds = vtkIdList::New();
+  vtkIdList *ids = vtkIdList::New();
+  std::vector<double> weights;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
     {
-    vtkDebugMacro(<<"No input data!");
-    return 1;
+    vtkIdType *cells;
+    vtkIdType numCells = pointCells->Get(ptId, cellIds, cells);
+    ids->SetNumberOfIds(numCells);
+    std::copy(cells, cells + numCells, ids->GetPointer(0));
+    weights.assign(numCells, numCells > 0 ? 1.0 / numCells : 0.0);
+    destination->InterpolateTuple(ptId, ids, source,
+                                  numCells > 0 ? &weights[0] : NULL);
     }
+  cellIds->Delete();
+  ids->Delete();
+}
+}
 
-  // count the number of cells associated with each point
-  vtkSmartPointer<vtkUnsignedIntArray> num
-    = vtkSmartPointer<vtkUnsignedIntArray>::New();
-  num->SetNumberOfComponents(1);
-  num->SetNumberOfTuples(npoints);
-  std::fill_n(num->GetPointer(0), npoints, 0u);
-  vtkNew<vtkIdList> pids;
-  for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-    src->GetCellPoints(cid, pids.GetPointer());
-    for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-      {
-      vtkIdType const pid = pids->GetId(i);
-      num->SetValue(pid, num->GetValue(pid)+1);
-      }
-    }
+//----------------------------------------------------------------------------
+// Instantiate object so that cell data is not passed to output.
+vtkCellDataToPointData::vtkCellDataToPointData()
+{
+  this->PassCellData = 0;
+}
 
-  // First, copy the input to the output as a starting point
-  dst->CopyStructure(src);
-  vtkPointData* const opd = dst->GetPointData();
+//----------------------------------------------------------------------------
+int vtkCellDataToPointData::RequestData(
+  vtkInformation*,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  vtkInformation* info = outputVector->GetInformationObject(0);
+  vtkDataSet *output = vtkDataSet::SafeDownCast(
+    info->Get(vtkDataObject::DATA_OBJECT()));
 
-  // Pass the point data first. The fields and attributes
-  // which also exist in the cell data of the input will
-  // be over-written during CopyAllocate
-  opd->CopyGlobalIdsOff();
-  opd->PassData(src->GetPointData());
-  opd->CopyFieldOff("vtkGhostLevels");
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  // Copy all existing cell fields into a temporary cell data array
-  vtkSmartPointer<vtkCellData> clean = vtkSmartPointer<vtkCellData>::New();
-  clean->PassData(src->GetCellData());
+  vtkIdType numPts;
+  vtkCellData *inCD=input->GetCellData();
+  vtkPointData *outPD=output->GetPointData();
 
-  // Remove all fields that are not a data array.
-  for (vtkIdType fid = clean->GetNumberOfArrays(); fid--;)
+  vtkDebugMacro(<<"Mapping cell data to point data");
+
+  // First, copy the input to the output as a starting point
+  output->CopyStructure( input );
+
+  if ( (numPts=input->GetNumberOfPoints()) < 1 )
     {
-    if (!clean->GetAbstractArray(fid)->IsA("vtkDataArray"))
-      {
-      clean->RemoveArray(fid);
-      }
+    vtkDebugMacro(<<"No input point data!");
+    return 1;
     }
 
-  // Cell field list constructed from the filtered cell data array
-  vtkDataSetAttributes::FieldList cfl(1);
-  cfl.InitializeFieldList(clean);
-  opd->InterpolateAllocate(cfl, npoints, npoints);
+  // Pass the point data first. The fields and attributes
+  // which also exist in the cell data of the input will
+  // be over-written during CopyAllocate
+  outPD->CopyGlobalIdsOff();
+  outPD->PassData(input->GetPointData());
+  outPD->CopyFieldOff("vtkGhostLevels");
 
-  for (int fid = 0, nfields = cfl.GetNumberOfFields(); fid < nfields; ++fid)
+  // notice that inCD and outPD are vtkCellData and vtkPointData; respectively.
+  // It's weird, but it works.
+  vtkDataSetAttributes::FieldList cfl(1);
+  cfl.InitializeFieldList(inCD);
+  outPD->InterpolateAllocate(cfl, numPts, numPts);
+
+  // Each point averages the values of the cells using it. The points are
+  // processed in parallel, one array at a time.
+  vtkCellDataToPointDataPointCells pointCells(input);
+  int const nfields = cfl.GetNumberOfFields();
+  for (int fid = 0; fid < nfields; ++fid)
     {
-    // update progress and check for an abort request.
-    this->UpdateProgress((fid+1.)/nfields);
+    this->UpdateProgress(static_cast<double>(fid)/nfields);
     if (this->GetAbortExecute())
       {
+      // Drop the arrays that were not computed, so that every array of the
+      // output point data has one tuple per point.
+      std::vector<int> dropped;
+      for (; fid < nfields; ++fid)
+        {
+        if (cfl.GetFieldIndex(fid) >= 0 && cfl.GetDSAIndex(0,fid) >= 0)
+          {
+          dropped.push_back(cfl.GetFieldIndex(fid));
+          }
+        }
+      std::sort(dropped.begin(), dropped.end());
+      for (size_t i = dropped.size(); i > 0; --i)
+        {
+        outPD->RemoveArray(dropped[i - 1]);
+        }
       break;
       }
 
@@ -271,38 +272,59 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     // respectively
     int const dstid = cfl.GetFieldIndex(fid);
     int const srcid = cfl.GetDSAIndex(0,fid);
-    if  (srcid < 0 || dstid < 0)
-      {
-      continue;
-      }
-
-    vtkCellData * const srccelldata  = clean;
-    vtkPointData* const dstpointdata = dst->GetPointData();
-
-    if (!srccelldata || !dstpointdata)
+    if (srcid < 0 || dstid < 0)
       {
       continue;
       }
 
-    vtkDataArray* const srcarray = srccelldata ->GetArray(srcid);
-    vtkDataArray* const dstarray = dstpointdata->GetArray(dstid);
-    dstarray->SetNumberOfTuples(npoints);
+    vtkAbstractArray *srcarray = inCD->GetAbstractArray(srcid);
+    vtkAbstractArray *dstarray = outPD->GetAbstractArray(dstid);
+    dstarray->SetNumberOfTuples(numPts);
 
-    vtkIdType const ncomps = srcarray->GetNumberOfComponents();
-    switch (srcarray->GetDataType())
+    int const ncomps = srcarray->GetNumberOfComponents();
+    bool fast = srcarray->IsA("vtkDataArray") &&
+      srcarray->HasStandardMemoryLayout() &&
+      dstarray->HasStandardMemoryLayout() &&
+      srcarray->GetDataType() == dstarray->GetDataType();
+    switch (fast ? srcarray->GetDataType() : VTK_VOID)
       {
-      vtkTemplateMacro
-        (__spread<VTK_TT>(src,num,srcarray,dstarray,ncells,npoints,ncomps));
+      vtkTemplateMacro(
+        vtkCellDataToPointDataAverageArray(&pointCells,
+          static_cast<VTK_TT*>(srcarray->GetVoidPointer(0)),
+          static_cast<VTK_TT*>(dstarray->GetVoidPointer(0)), ncomps, numPts));
+      default:
+        vtkCellDataToPointDataInterpolateArray(&pointCells, srcarray,
+                                               dstarray, numPts);
       }
     }
 
-  if (!this->PassCellData)
+  if ( !this->PassCellData )
     {
-    dst->GetCellData()->CopyAllOff();
-    dst->GetCellData()->CopyFieldOn("vtkGhostLevels");
+    output->GetCellData()->CopyAllOff();
+    output->GetCellData()->CopyFieldOn("vtkGhostLevels");
     }
-  dst->GetCellData()->PassData(src->GetCellData());
+  output->GetCellData()->PassData(input->GetCellData());
 
   return 1;
 }
 
+//----------------------------------------------------------------------------
+#ifndef VTK_LEGACY_REMOVE
+int vtkCellDataToPointData::RequestDataForUnstructuredGrid(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  VTK_LEGACY_BODY(vtkCellDataToPointData::RequestDataForUnstructuredGrid,
+                  "VTK 6.3");
+  return this->RequestData(request, inputVector, outputVector);
+}
+#endif
+
+//----------------------------------------------------------------------------
+void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Pass Cell Data: " << (this->PassCellData ? "On\n" : "Off\n");
+}
@@ -18,7 +18,8 @@
 // specified per cell) into point data (i.e., data specified at cell
 // points). The method of transformation is based on averaging the data
 // values of all cells using a particular point. Optionally, the input cell
-// data can be passed through to the output as well.
+// data can be passed through to the output as well. The points are
+// processed in parallel with vtkSMPTools.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -61,9 +62,12 @@ protected:
                           vtkInformationVector** inputVector,
                           vtkInformationVector* outputVector);
 
-  // Special traversal algorithm for unstructured grid
-  int RequestDataForUnstructuredGrid
-    (vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  // Description:
+  // Unstructured grids used to be processed by this separate method.
+  // RequestData() now handles every input, and this method forwards to it.
+  // @deprecated Call RequestData() instead.
+  VTK_LEGACY(int RequestDataForUnstructuredGrid(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector*));
 
   int PassCellData;
 private:
@@ -21,9 +21,165 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkTypeTraits.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkPointDataToCellData);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Gives the points of a cell. Unstructured grids hand out their connectivity
+// directly, other data sets go through GetCellPoints(). Once constructed it
+// may be used from several threads.
+class vtkPointDataToCellDataCellPoints
+{
+public:
+  vtkPointDataToCellDataCellPoints(vtkDataSet *ds)
+    : DataSet(ds), Grid(vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    // Data sets build their cell structures on first use, which must not
+    // happen from several threads.
+    vtkIdList *ptIds = vtkIdList::New();
+    ds->GetCellPoints(0, ptIds);
+    ptIds->Delete();
+  }
+
+  // Return the number of points of cellId and point pts to their ids.
+  // ptIds is used as storage when needed.
+  vtkIdType Get(vtkIdType cellId, vtkIdList *ptIds, vtkIdType *&pts)
+  {
+    if (this->Grid)
+      {
+      vtkIdType npts;
+      this->Grid->GetCellPoints(cellId, npts, pts);
+      return npts;
+      }
+    this->DataSet->GetCellPoints(cellId, ptIds);
+    pts = ptIds->GetPointer(0);
+    return ptIds->GetNumberOfIds();
+  }
+
+private:
+  vtkDataSet *DataSet;
+  vtkUnstructuredGrid *Grid;
+};
+
+//----------------------------------------------------------------------------
+// Round integer types, like vtkDataArray::InterpolateTuple() does.
+template <class T>
+inline void vtkPointDataToCellDataRound(double value, T *result)
+{
+  value = std::max(value, static_cast<double>(vtkTypeTraits<T>::Min()));
+  value = std::min(value, static_cast<double>(vtkTypeTraits<T>::Max()));
+  *result = static_cast<T>((value >= 0.0) ? (value + 0.5) : (value - 0.5));
+}
+
+inline void vtkPointDataToCellDataRound(double value, double *result)
+{
+  *result = value;
+}
+
+inline void vtkPointDataToCellDataRound(double value, float *result)
+{
+  *result = static_cast<float>(value);
+}
+
+//----------------------------------------------------------------------------
+// Average the point values of each cell. Every cell is written by a single
+// thread, so no synchronization is needed.
+template <class T>
+class vtkPointDataToCellDataAverage
+{
+public:
+  vtkPointDataToCellDataCellPoints *CellPoints;
+  const T *Source;
+  T *Destination;
+  int NumberOfComponents;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocal<std::vector<double> > Sums;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds = this->PointIds.Local();
+    std::vector<double> &sums = this->Sums.Local();
+    int numComps = this->NumberOfComponents;
+    sums.resize(numComps);
+
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      vtkIdType *pts;
+      vtkIdType numPts = this->CellPoints->Get(cellId, ptIds, pts);
+      T *out = this->Destination + cellId * numComps;
+      if (numPts < 1)
+        {
+        std::fill(out, out + numComps, static_cast<T>(0));
+        continue;
+        }
+
+      double weight = 1.0 / numPts;
+      std::fill(sums.begin(), sums.end(), 0.0);
+      for (vtkIdType i = 0; i < numPts; ++i)
+        {
+        const T *in = this->Source + pts[i] * numComps;
+        for (int j = 0; j < numComps; ++j)
+          {
+          sums[j] += weight * static_cast<double>(in[j]);
+          }
+        }
+      for (int j = 0; j < numComps; ++j)
+        {
+        vtkPointDataToCellDataRound(sums[j], out + j);
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkPointDataToCellDataAverageArray(
+  vtkPointDataToCellDataCellPoints *cellPoints, T *source, T *destination,
+  int numComps, vtkIdType numCells)
+{
+  vtkPointDataToCellDataAverage<T> average;
+  average.CellPoints = cellPoints;
+  average.Source = source;
+  average.Destination = destination;
+  average.NumberOfComponents = numComps;
+  vtkSMPTools::For(0, numCells, average);
+}
+
+//----------------------------------------------------------------------------
+// Serial fallback for the arrays without a plain memory layout (bit arrays,
+// string arrays, mapped arrays, ...).
+void vtkPointDataToCellDataInterpolateArray(
+  vtkPointDataToCellDataCellPoints *cellPoints, vtkAbstractArray *source,
+  vtkAbstractArray *destination, vtkIdType numCells)
+{
+  vtkIdList *ptIds = vtkIdList::New();
+  vtkIdList *ids = vtkIdList::New();
+  std::vector<double> weights;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    vtkIdType *pts;
+    vtkIdType numPts = cellPoints->Get(cellId, ptIds, pts);
+    ids->SetNumberOfIds(numPts);
+    std::copy(pts, pts + numPts, ids->GetPointer(0));
+    weights.assign(numPts, numPts > 0 ? 1.0 / numPts : 0.0);
+    destination->InterpolateTuple(cellId, ids, source,
+                                  numPts > 0 ? &weights[0] : NULL);
+    }
+  ptIds->Delete();
+  ids->Delete();
+}
+}
+
 //----------------------------------------------------------------------------
 // Instantiate object so that point data is not passed to output.
 vtkPointDataToCellData::vtkPointDataToCellData()
@@ -45,14 +201,9 @@ int vtkPointDataToCellData::RequestData(
   vtkDataSet *input = vtkDataSet::SafeDownCast(
     inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, ptId;
-  vtkIdType numCells, numPts;
+  vtkIdType numCells;
   vtkPointData *inPD=input->GetPointData();
   vtkCellData *outCD=output->GetCellData();
-  int maxCellSize=input->GetMaxCellSize();
-  vtkIdList *cellPts;
-  double weight;
-  double *weights;
 
   vtkDebugMacro(<<"Mapping point data to cell data");
 
@@ -64,10 +215,6 @@ int vtkPointDataToCellData::RequestData(
     vtkDebugMacro(<<"No input cells!");
     return 1;
     }
-  weights=new double[maxCellSize];
-
-  cellPts = vtkIdList::New();
-  cellPts->Allocate(maxCellSize);
 
   // Pass the cell data first. The fields and attributes
   // which also exist in the point data of the input will
@@ -78,28 +225,49 @@ int vtkPointDataToCellData::RequestData(
 
   // notice that inPD and outCD are vtkPointData and vtkCellData; respectively.
   // It's weird, but it works.
-  outCD->InterpolateAllocate(inPD,numCells);
+  vtkDataSetAttributes::FieldList pfl(1);
+  pfl.InitializeFieldList(inPD);
+  outCD->InterpolateAllocate(pfl, numCells, numCells);
 
-  int abort=0;
-  vtkIdType progressInterval=numCells/20 + 1;
-  for (cellId=0; cellId < numCells && !abort; cellId++)
+  // Each cell averages the values of its points. The cells are processed in
+  // parallel, one array at a time.
+  vtkPointDataToCellDataCellPoints cellPoints(input);
+  for (int fid = 0, nfields = pfl.GetNumberOfFields(); fid < nfields; ++fid)
     {
-    if ( !(cellId % progressInterval) )
+    this->UpdateProgress(static_cast<double>(fid)/nfields);
+    if (this->GetAbortExecute())
       {
-      this->UpdateProgress((double)cellId/numCells);
-      abort = GetAbortExecute();
+      break;
       }
 
-    input->GetCellPoints(cellId, cellPts);
-    numPts = cellPts->GetNumberOfIds();
-    if ( numPts > 0 )
+    // indices into the field arrays associated with the point and the cell
+    // respectively
+    int const dstid = pfl.GetFieldIndex(fid);
+    int const srcid = pfl.GetDSAIndex(0,fid);
+    if (srcid < 0 || dstid < 0)
       {
-      weight = 1.0 / numPts;
-      for (ptId=0; ptId < numPts; ptId++)
-        {
-        weights[ptId] = weight;
-        }
-      outCD->InterpolatePoint(inPD, cellId, cellPts, weights);
+      continue;
+      }
+
+    vtkAbstractArray *srcarray = inPD->GetAbstractArray(srcid);
+    vtkAbstractArray *dstarray = outCD->GetAbstractArray(dstid);
+    dstarray->SetNumberOfTuples(numCells);
+
+    int const ncomps = srcarray->GetNumberOfComponents();
+    bool fast = srcarray->IsA("vtkDataArray") &&
+      srcarray->HasStandardMemoryLayout() &&
+      dstarray->HasStandardMemoryLayout() &&
+      srcarray->GetDataType() == dstarray->GetDataType();
+    switch (fast ? srcarray->GetDataType() : VTK_VOID)
+      {
+      vtkTemplateMacro(
+        vtkPointDataToCellDataAverageArray(&cellPoints,
+          static_cast<VTK_TT*>(srcarray->GetVoidPointer(0)),
+          static_cast<VTK_TT*>(dstarray->GetVoidPointer(0)), ncomps,
+          numCells));
+      default:
+        vtkPointDataToCellDataInterpolateArray(&cellPoints, srcarray,
+                                               dstarray, numCells);
       }
     }
 
@@ -110,9 +278,6 @@ int vtkPointDataToCellData::RequestData(
     }
   output->GetPointData()->PassData(input->GetPointData());
 
-  cellPts->Delete();
-  delete [] weights;
-
   return 1;
 }
 
@@ -18,7 +18,8 @@
 // specified per point) into cell data (i.e., data specified per cell).
 // The method of transformation is based on averaging the data
 // values of all points defining a particular cell. Optionally, the input point
-// data can be passed through to the output as well.
+// data can be passed through to the output as well. The cells are processed
+// in parallel with vtkSMPTools.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -0,0 +1,309 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkSMPCutter and vtkSMPContourFilter with their serial
+// counterparts on an unstructured grid and on poly data.
+
+#include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPContourFilter.h"
+#include "vtkSMPCutter.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+const int EXTENT = 20;
+
+// Walks the cells of result and expected together and maps the points of
+// result to the ones of expected; the cells must match one to one, only
+// the point ids may differ.
+bool MapPoints(vtkCellArray* result, vtkCellArray* expected,
+               std::vector<vtkIdType>& pointMap,
+               std::vector<vtkIdType>& inverseMap)
+{
+  if (result->GetNumberOfCells() != expected->GetNumberOfCells())
+    {
+    return false;
+    }
+  vtkNew<vtkIdList> resultIds;
+  vtkNew<vtkIdList> expectedIds;
+  for (vtkIdType cellId = 0; cellId < result->GetNumberOfCells(); ++cellId)
+    {
+    result->GetCellAtId(cellId, resultIds.GetPointer());
+    expected->GetCellAtId(cellId, expectedIds.GetPointer());
+    if (resultIds->GetNumberOfIds() != expectedIds->GetNumberOfIds())
+      {
+      return false;
+      }
+    for (vtkIdType i = 0; i < resultIds->GetNumberOfIds(); ++i)
+      {
+      vtkIdType id = resultIds->GetId(i);
+      vtkIdType expectedId = expectedIds->GetId(i);
+      if (pointMap[id] < 0 && inverseMap[expectedId] < 0)
+        {
+        pointMap[id] = expectedId;
+        inverseMap[expectedId] = id;
+        }
+      else if (pointMap[id] != expectedId)
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool CompareTuples(vtkDataArray* result, vtkDataArray* expected,
+                   vtkIdType resultId, vtkIdType expectedId)
+{
+  for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+    {
+    if (result->GetComponent(resultId, c) !=
+        expected->GetComponent(expectedId, c))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool CompareArrays(vtkFieldData* result, vtkFieldData* expected,
+                   const std::vector<vtkIdType>* map)
+{
+  if (result->GetNumberOfArrays() != expected->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray* expectedArray = expected->GetArray(i);
+    vtkDataArray* array = result->GetArray(expectedArray->GetName());
+    if (!array ||
+        array->GetDataType() != expectedArray->GetDataType() ||
+        array->GetNumberOfComponents() !=
+          expectedArray->GetNumberOfComponents() ||
+        array->GetNumberOfTuples() != expectedArray->GetNumberOfTuples())
+      {
+      return false;
+      }
+    for (vtkIdType id = 0; id < array->GetNumberOfTuples(); ++id)
+      {
+      if (!CompareTuples(array, expectedArray, id, map ? (*map)[id] : id))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// The threaded filters must produce the output of the serial ones, except
+// for the order of the points.
+bool Compare(vtkAlgorithm* serial, vtkAlgorithm* parallel,
+             vtkCellArray* compactInput, const char* name)
+{
+  parallel->Update();
+  if (compactInput &&
+      compactInput->GetStorageType() != vtkCellArray::COMPACT_STORAGE)
+    {
+    cerr << "Error: " << name << " modified its input." << endl;
+    return false;
+    }
+  serial->Update();
+  vtkPolyData* expected = vtkPolyData::SafeDownCast(serial->GetOutputDataObject(0));
+  vtkPolyData* result = vtkPolyData::SafeDownCast(parallel->GetOutputDataObject(0));
+
+  vtkIdType numPts = expected->GetNumberOfPoints();
+  if (expected->GetNumberOfCells() == 0 ||
+      result->GetNumberOfPoints() != numPts)
+    {
+    cerr << "Error: " << name << " generated " << result->GetNumberOfPoints()
+         << " points instead of " << numPts << endl;
+    return false;
+    }
+
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  std::vector<vtkIdType> inverseMap(numPts, -1);
+  if (!MapPoints(result->GetVerts(), expected->GetVerts(),
+                 pointMap, inverseMap) ||
+      !MapPoints(result->GetLines(), expected->GetLines(),
+                 pointMap, inverseMap) ||
+      !MapPoints(result->GetPolys(), expected->GetPolys(),
+                 pointMap, inverseMap) ||
+      !MapPoints(result->GetStrips(), expected->GetStrips(),
+                 pointMap, inverseMap))
+    {
+    cerr << "Error: " << name << " generated different cells." << endl;
+    return false;
+    }
+
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    if (pointMap[ptId] < 0 ||
+        !CompareTuples(result->GetPoints()->GetData(),
+                       expected->GetPoints()->GetData(),
+                       ptId, pointMap[ptId]))
+      {
+      cerr << "Error: " << name << " generated different points." << endl;
+      return false;
+      }
+    }
+  if (!CompareArrays(result->GetPointData(), expected->GetPointData(),
+                     &pointMap))
+    {
+    cerr << "Error: " << name << " generated different point data." << endl;
+    return false;
+    }
+  if (!CompareArrays(result->GetCellData(), expected->GetCellData(), NULL))
+    {
+    cerr << "Error: " << name << " generated different cell data." << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestSMPCutter(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkRTAnalyticSource> imageSource;
+  imageSource->SetWholeExtent(-EXTENT, EXTENT, -EXTENT, EXTENT, -EXTENT, EXTENT);
+
+  vtkNew<vtkElevationFilter> ev;
+  ev->SetInputConnection(imageSource->GetOutputPort());
+  ev->SetLowPoint(-EXTENT, -EXTENT, -EXTENT);
+  ev->SetHighPoint(EXTENT, EXTENT, EXTENT);
+
+  vtkNew<vtkPointDataToCellData> p2c;
+  p2c->SetInputConnection(ev->GetOutputPort());
+  p2c->PassPointDataOn();
+
+  vtkNew<vtkDataSetTriangleFilter> tetraFilter;
+  tetraFilter->SetInputConnection(p2c->GetOutputPort());
+  tetraFilter->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->ShallowCopy(tetraFilter->GetOutput());
+
+  // Triangles of a slice of the grid, as poly data, preceded by lines
+  // along the first edge of every other triangle so that the output mixes
+  // vertices and lines. The triangles are kept in compact storage.
+  imageSource->SetWholeExtent(-EXTENT, EXTENT, -EXTENT, EXTENT, 0, 0);
+  tetraFilter->Update();
+  vtkUnstructuredGrid* slice = tetraFilter->GetOutput();
+  vtkIdType numTris = slice->GetNumberOfCells();
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdList> ptIds;
+  vtkCellData* cd = polyData->GetCellData();
+  cd->CopyAllocate(slice->GetCellData(), numTris + numTris / 2);
+  vtkIdType outCellId = 0;
+  for (vtkIdType cellId = 0; cellId < numTris; cellId += 2)
+    {
+    slice->GetCellPoints(cellId, ptIds.GetPointer());
+    ptIds->SetNumberOfIds(2);
+    lines->InsertNextCell(ptIds.GetPointer());
+    cd->CopyData(slice->GetCellData(), cellId, outCellId++);
+    }
+  for (vtkIdType cellId = 0; cellId < numTris; ++cellId)
+    {
+    slice->GetCellPoints(cellId, ptIds.GetPointer());
+    polys->InsertNextCell(ptIds.GetPointer());
+    cd->CopyData(slice->GetCellData(), cellId, outCellId++);
+    }
+  polys->ConvertToCompactStorage();
+  polyData->SetPoints(slice->GetPoints());
+  polyData->SetLines(lines.GetPointer());
+  polyData->SetPolys(polys.GetPointer());
+  polyData->GetPointData()->ShallowCopy(slice->GetPointData());
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.5, 0.25, 0.1);
+  plane->SetNormal(1, 2, 3);
+
+  vtkNew<vtkCutter> cutter;
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->SetValue(0, 0.0);
+  cutter->SetValue(1, 10.0);
+  vtkNew<vtkSMPCutter> smpCutter;
+  smpCutter->SetCutFunction(plane.GetPointer());
+  smpCutter->SetValue(0, 0.0);
+  smpCutter->SetValue(1, 10.0);
+
+  cutter->SetInputData(grid.GetPointer());
+  smpCutter->SetInputData(grid.GetPointer());
+  if (!Compare(cutter.GetPointer(), smpCutter.GetPointer(), NULL,
+               "vtkSMPCutter (unstructured grid)"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  cutter->SetInputData(polyData.GetPointer());
+  smpCutter->SetInputData(polyData.GetPointer());
+  if (!Compare(cutter.GetPointer(), smpCutter.GetPointer(),
+               polys.GetPointer(), "vtkSMPCutter (poly data)"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  contour->SetValue(0, 200);
+  contour->SetValue(1, 220);
+  contour->ComputeNormalsOff();
+  vtkNew<vtkSMPContourFilter> smpContour;
+  smpContour->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  smpContour->SetValue(0, 200);
+  smpContour->SetValue(1, 220);
+  smpContour->ComputeNormalsOff();
+
+  contour->SetInputData(grid.GetPointer());
+  smpContour->SetInputData(grid.GetPointer());
+  if (!Compare(contour.GetPointer(), smpContour.GetPointer(), NULL,
+               "vtkSMPContourFilter (unstructured grid)"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  contour->SetInputData(polyData.GetPointer());
+  smpContour->SetInputData(polyData.GetPointer());
+  polys->ConvertToCompactStorage();
+  polyData->Modified();
+  if (!Compare(contour.GetPointer(), smpContour.GetPointer(),
+               polys.GetPointer(), "vtkSMPContourFilter (poly data)"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,797 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPContourCellsHelper.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPContourCellsHelper.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCutter.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// A vtkMergePoints with the buckets of the locator of the serial filters,
+// which merges the points of one batch at a time: starting a batch only
+// clears the buckets used by the previous one. The bucket of each inserted
+// point is recorded for the final merge, done with the same buckets, so
+// that points are merged exactly as the serial filters merge them.
+class vtkContourBatchLocator : public vtkMergePoints
+{
+public:
+  vtkTypeMacro(vtkContourBatchLocator, vtkMergePoints);
+  static vtkContourBatchLocator* New();
+
+  // Set up the buckets as InitPointInsertion() does for a vtkMergePoints
+  // with the settings of prototype, or the default ones when it is NULL.
+  void InitializeBuckets(vtkPoints* points, vtkMergePoints* prototype,
+                         const double bounds[6], vtkIdType estNumPts)
+  {
+    if (prototype)
+      {
+      this->SetDivisions(prototype->GetDivisions());
+      this->SetNumberOfPointsPerBucket(
+        prototype->GetNumberOfPointsPerBucket());
+      this->SetAutomatic(prototype->GetAutomatic());
+      }
+    this->InitPointInsertion(points, bounds, estNumPts);
+  }
+
+  bool HasBuckets()
+  {
+    return this->HashTable != NULL;
+  }
+
+  // Merge the points of a new batch into points, recording their buckets.
+  void StartBatch(vtkPoints* points, std::vector<vtkIdType>* buckets)
+  {
+    std::vector<vtkIdType>::const_iterator idx;
+    for (idx = this->UsedBuckets.begin(); idx != this->UsedBuckets.end();
+         ++idx)
+      {
+      this->HashTable[*idx]->Delete();
+      this->HashTable[*idx] = NULL;
+      }
+    this->UsedBuckets.clear();
+    points->Register(this);
+    this->Points->UnRegister(this);
+    this->Points = points;
+    this->InsertionPointId = 0;
+    this->Buckets = buckets;
+  }
+
+  virtual int InsertUniquePoint(const double x[3], vtkIdType& id)
+  {
+    vtkIdType idx = this->UseBucket(x);
+    int inserted = this->Superclass::InsertUniquePoint(x, id);
+    if (inserted)
+      {
+      this->Buckets->push_back(idx);
+      }
+    return inserted;
+  }
+
+  virtual vtkIdType InsertNextPoint(const double x[3])
+  {
+    this->Buckets->push_back(this->UseBucket(x));
+    return this->Superclass::InsertNextPoint(x);
+  }
+
+  // Insert the point x of a batch, stored with the precision of the points,
+  // in the bucket idx recorded for it unless an equal point is there.
+  int InsertBatchPoint(vtkIdType idx, const double x[3], vtkIdType& id)
+  {
+    vtkIdList* bucket = this->HashTable[idx];
+    if (bucket)
+      {
+      vtkDataArray* data = this->Points->GetData();
+      double pt[3];
+      for (vtkIdType i = 0; i < bucket->GetNumberOfIds(); ++i)
+        {
+        data->GetTuple(bucket->GetId(i), pt);
+        if (x[0] == pt[0] && x[1] == pt[1] && x[2] == pt[2])
+          {
+          id = bucket->GetId(i);
+          return 0;
+          }
+        }
+      }
+    else
+      {
+      bucket = vtkIdList::New();
+      bucket->Allocate(this->NumberOfPointsPerBucket/2,
+                       this->NumberOfPointsPerBucket/3);
+      this->HashTable[idx] = bucket;
+      }
+    bucket->InsertNextId(this->InsertionPointId);
+    this->Points->InsertPoint(this->InsertionPointId, x);
+    id = this->InsertionPointId++;
+    return 1;
+  }
+
+protected:
+  vtkContourBatchLocator()
+  {
+    this->Buckets = NULL;
+  }
+
+  std::vector<vtkIdType> UsedBuckets;
+  std::vector<vtkIdType>* Buckets;
+
+  vtkIdType UseBucket(const double x[3])
+  {
+    vtkIdType idx = this->GetBucketIndex(x);
+    if (!this->HashTable[idx])
+      {
+      this->UsedBuckets.push_back(idx);
+      }
+    return idx;
+  }
+
+private:
+  vtkContourBatchLocator(const vtkContourBatchLocator&);  // Not implemented.
+  void operator=(const vtkContourBatchLocator&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkContourBatchLocator);
+
+namespace
+{
+
+// Output of the cells of one dimension in one batch. 1D, 2D and 3D cells
+// generate verts, lines and polys respectively.
+struct vtkContourPiece
+{
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkPointData> PointData;
+  vtkSmartPointer<vtkCellArray> Cells[3];
+  vtkSmartPointer<vtkCellData> CellData[3];
+
+  // Locator bucket and output id of each point, and whether this piece is
+  // the first one that generated it (and thus provides its point data).
+  std::vector<vtkIdType> Buckets;
+  std::vector<vtkIdType> PointMap;
+  std::vector<char> OwnsPoint;
+
+  // Where the verts, lines and polys of this piece start in the output.
+  vtkIdType CellOffset[3];
+  vtkIdType ConnectivityOffset[3];
+};
+
+// Reads the cells of the input from several threads without modifying it.
+// The cells of poly data, and of unstructured grids with compact storage,
+// are read from their cell arrays with vtkCellArray::GetCellAtId(): the
+// GetCell() methods of these data sets would build the cell types of the
+// poly data and convert compact cell arrays to the legacy layout.
+class vtkContourCellReader
+{
+public:
+  void Initialize(vtkDataSet* input)
+  {
+    this->Input = input;
+    this->Grid = NULL;
+    this->NumberOfCellArrays = 0;
+    this->FirstCellId[0] = 0;
+
+    vtkPolyData* polyData = vtkPolyData::SafeDownCast(input);
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (polyData)
+      {
+      this->CellArrays[0] = polyData->GetVerts();
+      this->CellArrays[1] = polyData->GetLines();
+      this->CellArrays[2] = polyData->GetPolys();
+      this->CellArrays[3] = polyData->GetStrips();
+      this->NumberOfCellArrays = 4;
+      this->Points = polyData->GetPoints();
+      }
+    else if (grid && grid->GetCells() &&
+             grid->GetCells()->GetStorageType() !=
+               vtkCellArray::LEGACY_STORAGE)
+      {
+      this->Grid = grid;
+      this->CellArrays[0] = grid->GetCells();
+      this->NumberOfCellArrays = 1;
+      this->Points = grid->GetPoints();
+      }
+    else
+      {
+      // Build what the data set computes on demand before the threads
+      // share it.
+      vtkNew<vtkGenericCell> cell;
+      input->GetCell(0, cell.GetPointer());
+      }
+    for (int i = 0; i < this->NumberOfCellArrays; ++i)
+      {
+      vtkIdType numCells = this->CellArrays[i]->GetNumberOfCells();
+      this->FirstCellId[i + 1] = this->FirstCellId[i] + numCells;
+      if (numCells > 0)
+        {
+        // Find the cell locations of legacy storage before the threads
+        // share the cell array.
+        this->CellArrays[i]->GetCellSize(0);
+        }
+      }
+  }
+
+  void GetCellPoints(vtkIdType cellId, vtkIdList* ptIds) const
+  {
+    if (this->NumberOfCellArrays == 0)
+      {
+      this->Input->GetCellPoints(cellId, ptIds);
+      return;
+      }
+    int i = this->FindCellArray(cellId);
+    this->CellArrays[i]->GetCellAtId(cellId - this->FirstCellId[i], ptIds);
+  }
+
+  int GetCellType(vtkIdType cellId) const
+  {
+    if (this->NumberOfCellArrays == 0 || this->Grid)
+      {
+      return this->Input->GetCellType(cellId);
+      }
+    int i = this->FindCellArray(cellId);
+    return vtkContourCellReader::GetPolyCellType(
+      i, this->CellArrays[i]->GetCellSize(cellId - this->FirstCellId[i]));
+  }
+
+  void GetCell(vtkIdType cellId, vtkGenericCell* cell) const
+  {
+    if (this->NumberOfCellArrays == 0)
+      {
+      this->Input->GetCell(cellId, cell);
+      return;
+      }
+    cell->SetCellType(this->GetCellType(cellId));
+    int i = this->FindCellArray(cellId);
+    this->CellArrays[i]->GetCellAtId(cellId - this->FirstCellId[i],
+                                     cell->PointIds);
+    this->Points->GetPoints(cell->PointIds, cell->Points);
+    if (this->Grid && cell->RequiresExplicitFaceRepresentation())
+      {
+      cell->SetFaces(this->Grid->GetFaces(cellId));
+      }
+    if (cell->RequiresInitialization())
+      {
+      cell->Initialize();
+      }
+  }
+
+private:
+  vtkDataSet* Input;
+  vtkUnstructuredGrid* Grid;
+  vtkPoints* Points;
+  vtkCellArray* CellArrays[4];
+  vtkIdType FirstCellId[5];
+  int NumberOfCellArrays;
+
+  int FindCellArray(vtkIdType cellId) const
+  {
+    int i = 0;
+    while (cellId >= this->FirstCellId[i + 1])
+      {
+      ++i;
+      }
+    return i;
+  }
+
+  // The cell types given by vtkPolyData::BuildCells() to the cells of the
+  // verts, lines, polys and strips.
+  static int GetPolyCellType(int cellArray, vtkIdType npts)
+  {
+    switch (cellArray)
+      {
+      case 0:
+        return npts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX;
+      case 1:
+        return npts > 2 ? VTK_POLY_LINE : VTK_LINE;
+      case 2:
+        return npts == 3 ? VTK_TRIANGLE :
+          (npts == 4 ? VTK_QUAD : VTK_POLYGON);
+      default:
+        return VTK_TRIANGLE_STRIP;
+      }
+  }
+};
+
+struct vtkContourParameters
+{
+  vtkDataSet* Input;
+  vtkContourCellReader Reader;
+  vtkDataArray* Scalars;
+  vtkPointData* InPD;
+  vtkCellData* InCD;
+  bool CopyScalars;
+  int NumberOfValues;
+  const double* Values;
+  int PointsType;
+  vtkMergePoints* LocatorPrototype;
+  double Bounds[6];
+  vtkIdType EstimatedNumberOfPoints;
+  unsigned char CellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkIdType NumberOfCells;
+  vtkIdType BatchSize;
+  vtkIdType NumberOfBatches;
+  vtkContourPiece* Pieces;
+};
+
+// Contours the cells of one dimension in one batch per task, each into its
+// own piece. The pieces of 1D cells come first, then the ones of 2D and 3D
+// cells, as the serial filters contour the cells.
+template <class T>
+class vtkContourBatches
+{
+public:
+  const vtkContourParameters* Parameters;
+  const T* ScalarPointer;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocalObject<vtkContourBatchLocator> Locator;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkDataArray> > CellScalars;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > CellIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType task = begin; task < end; ++task)
+      {
+      this->ContourBatch(task);
+      }
+  }
+
+  // Collect the cells of dimension dim in the batch whose scalar range
+  // contains a contour value.
+  bool FindCells(vtkIdType batch, int dim, std::vector<vtkIdType>& cellIds)
+  {
+    const vtkContourParameters& p = *this->Parameters;
+    vtkIdType first = batch * p.BatchSize;
+    vtkIdType last = std::min(first + p.BatchSize, p.NumberOfCells);
+    int numComps = p.Scalars->GetNumberOfComponents();
+    vtkIdList* ptIds = this->PointIds.Local();
+
+    cellIds.clear();
+    for (vtkIdType cellId = first; cellId < last; ++cellId)
+      {
+      int cellType = p.Reader.GetCellType(cellId);
+      if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+          p.CellTypeDimensions[cellType] != dim)
+        {
+        continue;
+        }
+      p.Reader.GetCellPoints(cellId, ptIds);
+      vtkIdType npts = ptIds->GetNumberOfIds();
+      if (npts < 1)
+        {
+        continue;
+        }
+      const vtkIdType* pts = ptIds->GetPointer(0);
+      double range[2];
+      range[0] = range[1] =
+        static_cast<double>(this->ScalarPointer[pts[0] * numComps]);
+      for (vtkIdType i = 1; i < npts; ++i)
+        {
+        double s = static_cast<double>(this->ScalarPointer[pts[i] * numComps]);
+        range[0] = std::min(range[0], s);
+        range[1] = std::max(range[1], s);
+        }
+
+      bool needCell = false;
+      for (int i = 0; i < p.NumberOfValues && !needCell; ++i)
+        {
+        needCell = p.Values[i] >= range[0] && p.Values[i] <= range[1];
+        }
+      if (needCell)
+        {
+        cellIds.push_back(cellId);
+        }
+      }
+    return !cellIds.empty();
+  }
+
+  void ContourBatch(vtkIdType task)
+  {
+    const vtkContourParameters& p = *this->Parameters;
+    vtkIdType batch = task % p.NumberOfBatches;
+    int dim = static_cast<int>(task / p.NumberOfBatches) + 1;
+    std::vector<vtkIdType>& cellIds = this->CellIds.Local();
+    if (!this->FindCells(batch, dim, cellIds))
+      {
+      return;
+      }
+
+    vtkIdType estimatedSize =
+      static_cast<vtkIdType>(cellIds.size()) * p.NumberOfValues;
+    vtkContourPiece& piece = p.Pieces[task];
+    piece.Points = vtkSmartPointer<vtkPoints>::New();
+    piece.Points->SetDataType(p.PointsType);
+    piece.Points->Allocate(estimatedSize, estimatedSize);
+    piece.PointData = vtkSmartPointer<vtkPointData>::New();
+    if (!p.CopyScalars)
+      {
+      piece.PointData->CopyScalarsOff();
+      }
+    piece.PointData->InterpolateAllocate(p.InPD, estimatedSize, estimatedSize);
+    for (int i = 0; i < 3; ++i)
+      {
+      piece.Cells[i] = vtkSmartPointer<vtkCellArray>::New();
+      piece.Cells[i]->Allocate(estimatedSize, estimatedSize);
+      piece.CellData[i] = vtkSmartPointer<vtkCellData>::New();
+      piece.CellData[i]->CopyAllocate(p.InCD, estimatedSize, estimatedSize);
+      }
+
+    vtkContourBatchLocator* locator = this->Locator.Local();
+    if (!locator->HasBuckets())
+      {
+      vtkNew<vtkPoints> points;
+      locator->InitializeBuckets(points.GetPointer(), p.LocatorPrototype,
+                                 p.Bounds, p.EstimatedNumberOfPoints);
+      }
+    locator->StartBatch(piece.Points, &piece.Buckets);
+
+    vtkSmartPointer<vtkDataArray>& cellScalars = this->CellScalars.Local();
+    if (!cellScalars)
+      {
+      cellScalars.TakeReference(p.Scalars->NewInstance());
+      cellScalars->SetNumberOfComponents(p.Scalars->GetNumberOfComponents());
+      }
+    vtkGenericCell* cell = this->Cell.Local();
+
+    std::vector<vtkIdType>::const_iterator cellIter;
+    for (cellIter = cellIds.begin(); cellIter != cellIds.end(); ++cellIter)
+      {
+      p.Reader.GetCell(*cellIter, cell);
+      vtkIdList* cellPtIds = cell->GetPointIds();
+      cellScalars->SetNumberOfTuples(cellPtIds->GetNumberOfIds());
+      p.Scalars->GetTuples(cellPtIds, cellScalars);
+
+      vtkCellData* outCD = piece.CellData[dim - 1];
+      for (int i = 0; i < p.NumberOfValues; ++i)
+        {
+        cell->Contour(p.Values[i], cellScalars, locator,
+                      piece.Cells[0], piece.Cells[1], piece.Cells[2],
+                      p.InPD, piece.PointData, p.InCD, *cellIter, outCD);
+        }
+      }
+  }
+};
+
+template <class T>
+void vtkContourAllBatches(const vtkContourParameters& parameters,
+                          const T* scalars, vtkIdType numPieces)
+{
+  vtkContourBatches<T> contour;
+  contour.Parameters = &parameters;
+  contour.ScalarPointer = scalars;
+  vtkSMPTools::For(0, numPieces, 1, contour);
+}
+
+// Copies the cells, point data and cell data of the pieces to their place
+// in the output. Each piece writes its own part of the output arrays. Bit
+// arrays pack several values per byte and are copied in a separate serial
+// pass.
+class vtkMergePieces
+{
+public:
+  vtkContourPiece* Pieces;
+  vtkIdType* Connectivity[3];
+  vtkIdType FirstCellId[3];
+  vtkPointData* OutPD;
+  vtkCellData* OutCD;
+  bool BitArrays;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (this->Pieces[i].Points)
+        {
+        this->MergePiece(this->Pieces[i]);
+        }
+      }
+  }
+
+  void MergePiece(vtkContourPiece& piece)
+  {
+    const vtkIdType* pointMap = &piece.PointMap[0];
+
+    if (!this->BitArrays)
+      {
+      for (int i = 0; i < 3; ++i)
+        {
+        vtkIdType numEntries = piece.Cells[i]->GetNumberOfConnectivityEntries();
+        const vtkIdType* in = piece.Cells[i]->GetPointer();
+        vtkIdType* out = this->Connectivity[i] + piece.ConnectivityOffset[i];
+        for (vtkIdType loc = 0; loc < numEntries; )
+          {
+          vtkIdType npts = in[loc];
+          out[loc++] = npts;
+          for (vtkIdType j = 0; j < npts; ++j, ++loc)
+            {
+            out[loc] = pointMap[in[loc]];
+            }
+          }
+        }
+      }
+
+    vtkIdType numPts = static_cast<vtkIdType>(piece.PointMap.size());
+    for (int k = 0, n = this->OutPD->GetNumberOfArrays(); k < n; ++k)
+      {
+      vtkAbstractArray* dst = this->OutPD->GetAbstractArray(k);
+      if ((dst->GetDataType() == VTK_BIT) != this->BitArrays)
+        {
+        continue;
+        }
+      vtkAbstractArray* src = piece.PointData->GetAbstractArray(k);
+      for (vtkIdType i = 0; i < numPts; ++i)
+        {
+        if (piece.OwnsPoint[i])
+          {
+          dst->SetTuple(pointMap[i], i, src);
+          }
+        }
+      }
+
+    for (int i = 0; i < 3; ++i)
+      {
+      vtkIdType first = this->FirstCellId[i] + piece.CellOffset[i];
+      vtkIdType numCells = piece.Cells[i]->GetNumberOfCells();
+      for (int k = 0, n = this->OutCD->GetNumberOfArrays(); k < n; ++k)
+        {
+        vtkAbstractArray* dst = this->OutCD->GetAbstractArray(k);
+        if ((dst->GetDataType() == VTK_BIT) != this->BitArrays)
+          {
+          continue;
+          }
+        vtkAbstractArray* src = piece.CellData[i]->GetAbstractArray(k);
+        for (vtkIdType j = 0; j < numCells; ++j)
+          {
+          dst->SetTuple(first + j, j, src);
+          }
+        }
+      }
+  }
+};
+
+bool vtkHasTuples(vtkFieldData* fd, vtkIdType numTuples)
+{
+  for (int k = 0, n = fd->GetNumberOfArrays(); k < n; ++k)
+    {
+    if (fd->GetAbstractArray(k)->GetNumberOfTuples() != numTuples)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool vtkHasBitArray(vtkFieldData* fd)
+{
+  for (int k = 0, n = fd->GetNumberOfArrays(); k < n; ++k)
+    {
+    if (fd->GetAbstractArray(k)->GetDataType() == VTK_BIT)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+void vtkSetNumberOfTuples(vtkFieldData* fd, vtkIdType numTuples)
+{
+  for (int k = 0, n = fd->GetNumberOfArrays(); k < n; ++k)
+    {
+    fd->GetAbstractArray(k)->SetNumberOfTuples(numTuples);
+    }
+}
+
+}
+
+//----------------------------------------------------------------------------
+vtkSMPContourCellsHelper::vtkSMPContourCellsHelper()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSMPContourCellsHelper::~vtkSMPContourCellsHelper()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMPContourCellsHelper::GetBatchSize(vtkIdType numCells)
+{
+  // Independent of the number of threads so that the output is too.
+  return std::max(static_cast<vtkIdType>(512), numCells / 1024);
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPContourCellsHelper::Contour(vtkDataSet* input,
+                                      vtkDataArray* scalars,
+                                      vtkPointData* inPD,
+                                      bool copyScalars,
+                                      int numValues,
+                                      const double* values,
+                                      int pointsType,
+                                      vtkMergePoints* locator,
+                                      vtkIdType estimatedNumberOfPoints,
+                                      vtkPolyData* output)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (numCells < 1 || numValues < 1)
+    {
+    return 1;
+    }
+
+  vtkIdType batchSize = vtkSMPContourCellsHelper::GetBatchSize(numCells);
+  vtkIdType numBatches = (numCells + batchSize - 1) / batchSize;
+  vtkIdType numPieces = 3 * numBatches;
+  std::vector<vtkContourPiece> pieces(numPieces);
+
+  vtkContourParameters parameters;
+  parameters.Input = input;
+  parameters.Reader.Initialize(input);
+  parameters.Scalars = scalars;
+  parameters.InPD = inPD;
+  parameters.InCD = input->GetCellData();
+  parameters.CopyScalars = copyScalars;
+  parameters.NumberOfValues = numValues;
+  parameters.Values = values;
+  parameters.PointsType = pointsType;
+  parameters.LocatorPrototype = locator;
+  input->GetBounds(parameters.Bounds);
+  parameters.EstimatedNumberOfPoints = estimatedNumberOfPoints;
+  vtkCutter::GetCellTypeDimensions(parameters.CellTypeDimensions);
+  parameters.NumberOfCells = numCells;
+  parameters.BatchSize = batchSize;
+  parameters.NumberOfBatches = numBatches;
+  parameters.Pieces = &pieces[0];
+
+  switch (scalars->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkContourAllBatches(parameters,
+        static_cast<VTK_TT*>(scalars->GetVoidPointer(0)), numPieces));
+    }
+
+  // Every output cell must have its cell data.
+  vtkIdType numPiecePts = 0;
+  std::vector<vtkContourPiece>::iterator piece;
+  for (piece = pieces.begin(); piece != pieces.end(); ++piece)
+    {
+    if (!piece->Points)
+      {
+      continue;
+      }
+    numPiecePts += piece->Points->GetNumberOfPoints();
+    for (int i = 0; i < 3; ++i)
+      {
+      if (!vtkHasTuples(piece->CellData[i],
+                        piece->Cells[i]->GetNumberOfCells()))
+        {
+        return 0;
+        }
+      }
+    }
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(pointsType);
+  newPts->Allocate(numPiecePts);
+  output->SetPoints(newPts.GetPointer());
+  if (numPiecePts == 0)
+    {
+    return 1;
+    }
+
+  // Merge the points of the pieces in order, in the buckets where the
+  // pieces found them. A point gets the id of its first occurrence, as in
+  // the serial filters. This is the only serial part of the merge.
+  vtkNew<vtkContourBatchLocator> merger;
+  merger->InitializeBuckets(newPts.GetPointer(), locator, parameters.Bounds,
+                            estimatedNumberOfPoints);
+  vtkIdType numTypeCells[3] = {0, 0, 0};
+  vtkIdType numTypeEntries[3] = {0, 0, 0};
+  for (piece = pieces.begin(); piece != pieces.end(); ++piece)
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      piece->CellOffset[i] = numTypeCells[i];
+      piece->ConnectivityOffset[i] = numTypeEntries[i];
+      }
+    if (!piece->Points)
+      {
+      continue;
+      }
+    for (int i = 0; i < 3; ++i)
+      {
+      numTypeCells[i] += piece->Cells[i]->GetNumberOfCells();
+      numTypeEntries[i] += piece->Cells[i]->GetNumberOfConnectivityEntries();
+      }
+
+    vtkIdType numPts = piece->Points->GetNumberOfPoints();
+    piece->PointMap.resize(numPts);
+    piece->OwnsPoint.resize(numPts);
+    double x[3];
+    for (vtkIdType i = 0; i < numPts; ++i)
+      {
+      piece->Points->GetPoint(i, x);
+      piece->OwnsPoint[i] = static_cast<char>(merger->InsertBatchPoint(
+        piece->Buckets[i], x, piece->PointMap[i]));
+      }
+    }
+  vtkIdType numOutPts = newPts->GetNumberOfPoints();
+  vtkIdType numOutCells = numTypeCells[0] + numTypeCells[1] + numTypeCells[2];
+
+  // Allocate the output and copy the pieces to it in parallel.
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
+  if (!copyScalars)
+    {
+    outPD->CopyScalarsOff();
+    }
+  outPD->InterpolateAllocate(inPD, numOutPts);
+  outCD->CopyAllocate(input->GetCellData(), numOutCells);
+  vtkSetNumberOfTuples(outPD, numOutPts);
+  vtkSetNumberOfTuples(outCD, numOutCells);
+
+  vtkMergePieces merge;
+  merge.Pieces = &pieces[0];
+  merge.OutPD = outPD;
+  merge.OutCD = outCD;
+  merge.BitArrays = false;
+  vtkSmartPointer<vtkCellArray> newCells[3];
+  vtkIdType firstCellId = 0;
+  for (int i = 0; i < 3; ++i)
+    {
+    newCells[i] = vtkSmartPointer<vtkCellArray>::New();
+    merge.Connectivity[i] =
+      newCells[i]->WritePointer(numTypeCells[i], numTypeEntries[i]);
+    merge.FirstCellId[i] = firstCellId;
+    firstCellId += numTypeCells[i];
+    }
+  vtkSMPTools::For(0, numPieces, 1, merge);
+  if (vtkHasBitArray(outPD) || vtkHasBitArray(outCD))
+    {
+    merge.BitArrays = true;
+    merge(0, numPieces);
+    }
+
+  if (numTypeCells[0])
+    {
+    output->SetVerts(newCells[0]);
+    }
+  if (numTypeCells[1])
+    {
+    output->SetLines(newCells[1]);
+    }
+  if (numTypeCells[2])
+    {
+    output->SetPolys(newCells[2]);
+    }
+  output->Squeeze();
+  return 1;
+}
@@ -0,0 +1,80 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPContourCellsHelper.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPContourCellsHelper - Utility class for contouring cells in parallel
+// This class is used by vtkSMPCutter and vtkSMPContourFilter to contour the
+// cells of unstructured data sets with multiple threads. The cells are split
+// into batches whose size only depends on the number of cells. The cells of
+// each dimension in each batch are contoured by one thread into their own
+// poly data, merging their points with a locator that has the buckets of the
+// locator of the serial filters. The pieces are then merged in the order in
+// which vtkContourFilter and vtkCutter contour the cells, so the output is
+// the same as theirs, for any number of threads and any scheduling.
+
+#ifndef __vtkSMPContourCellsHelper_h
+#define __vtkSMPContourCellsHelper_h
+
+#include "vtkFiltersSMPModule.h" // For export macro
+#include "vtkType.h" // For vtkIdType
+
+class vtkDataArray;
+class vtkDataSet;
+class vtkMergePoints;
+class vtkPointData;
+class vtkPolyData;
+
+class VTKFILTERSSMP_EXPORT vtkSMPContourCellsHelper
+{
+public:
+  // Description:
+  // Contour the cells of input at the given values of the first component
+  // of the point scalars and store the result in output. inPD is the point
+  // data interpolated on the output points, usually input->GetPointData().
+  // If copyScalars is false, the active scalars of inPD are not passed to
+  // the output. pointsType is the data type of the output points. scalars
+  // must have the standard memory layout, and input must support concurrent
+  // reads once its cell structures are built (vtkUnstructuredGrid and
+  // vtkPolyData do). The cells of vtkPolyData, and of vtkUnstructuredGrid
+  // with compact cell storage, are read from their cell arrays so that the
+  // input is not modified.
+  //
+  // As in the serial filters, 0D cells are skipped, 1D cells are contoured
+  // first, then 2D and 3D cells, each in order with all values per cell, and
+  // the points are merged as a vtkMergePoints with the settings of locator
+  // (the default ones when NULL) merges them once initialized with the
+  // bounds of input and estimatedNumberOfPoints. Returns 0, with an
+  // incomplete output, if the cell data could not be copied to every
+  // output cell.
+  static int Contour(vtkDataSet* input, vtkDataArray* scalars,
+                     vtkPointData* inPD, bool copyScalars,
+                     int numValues, const double* values,
+                     int pointsType, vtkMergePoints* locator,
+                     vtkIdType estimatedNumberOfPoints, vtkPolyData* output);
+
+  // Description:
+  // Return the number of cells contoured by one task for an input with
+  // numCells cells.
+  static vtkIdType GetBatchSize(vtkIdType numCells);
+
+protected:
+  vtkSMPContourCellsHelper();
+  ~vtkSMPContourCellsHelper();
+
+private:
+  vtkSMPContourCellsHelper(const vtkSMPContourCellsHelper&);  // Not implemented.
+  void operator=(const vtkSMPContourCellsHelper&);  // Not implemented.
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPContourCellsHelper.h
@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPContourFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPContourFilter.h"
+
+#include "vtkDataArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMergePoints.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkSMPContourCellsHelper.h"
+
+vtkStandardNewMacro(vtkSMPContourFilter);
+
+//----------------------------------------------------------------------------
+vtkSMPContourFilter::vtkSMPContourFilter()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSMPContourFilter::~vtkSMPContourFilter()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPContourFilter::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet *input = vtkDataSet::GetData(inputVector[0]);
+  vtkPolyData *output = vtkPolyData::GetData(outputVector);
+
+  int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  vtkDataArray *inScalars =
+    this->GetInputArrayToProcess(0, inputVector, association);
+  // -1 == uninitialized, see vtkContourFilter: vtkContourGrid computes
+  // normals then, the poly data path does not.
+  bool computeNormals = this->ComputeNormals != 0 &&
+    (this->ComputeNormals != -1 ||
+     (input && input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID));
+  if (!input || !output || !inScalars ||
+      association != vtkDataObject::FIELD_ASSOCIATION_POINTS ||
+      inScalars->GetDataType() == VTK_BIT ||
+      !inScalars->HasStandardMemoryLayout() ||
+      !this->GenerateTriangles || computeNormals ||
+      (this->Locator && !this->Locator->IsA("vtkMergePoints")) ||
+      (this->UseScalarTree &&
+       input->GetDataObjectType() == VTK_POLY_DATA) ||
+      (input->GetDataObjectType() != VTK_UNSTRUCTURED_GRID &&
+       input->GetDataObjectType() != VTK_POLY_DATA))
+    {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  int numContours = this->ContourValues->GetNumberOfContours();
+  if (input->GetNumberOfPoints() < 1 || numContours < 1)
+    {
+    return 1;
+    }
+
+  // set precision for the points in the output
+  int pointsType = vtkPointSet::SafeDownCast(input)->GetPoints()->GetDataType();
+  if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    pointsType = VTK_FLOAT;
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    pointsType = VTK_DOUBLE;
+    }
+
+  // if we did not ask for scalars to be computed, don't copy them
+  if (!vtkSMPContourCellsHelper::Contour(input, inScalars,
+                                         input->GetPointData(),
+                                         this->ComputeScalars != 0,
+                                         numContours,
+                                         this->ContourValues->GetValues(),
+                                         pointsType,
+                                         vtkMergePoints::SafeDownCast(
+                                           this->Locator),
+                                         input->GetNumberOfPoints(), output))
+    {
+    vtkErrorMacro("Cell data could not be copied to every output cell.");
+    return 0;
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPContourFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
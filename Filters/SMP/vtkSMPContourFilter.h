@@ -0,0 +1,56 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPContourFilter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPContourFilter - a subclass of vtkContourFilter that works in parallel
+// .SECTION Description
+// vtkSMPContourFilter performs the same function as vtkContourFilter but
+// contours vtkUnstructuredGrid and vtkPolyData inputs using multiple
+// threads, see vtkSMPContourCellsHelper. Unlike vtkSMPContourGrid, the
+// output is the same as the one of vtkContourFilter for any number of
+// threads. Other inputs, non point scalars, bit scalars, GenerateTriangles
+// off, normals (ComputeNormals on, or left unset with vtkUnstructuredGrid
+// input), UseScalarTree on with vtkPolyData input and a Locator that is
+// not a vtkMergePoints are handled by vtkContourFilter.
+//
+// .SECTION See Also
+// vtkContourFilter vtkSMPCutter vtkSMPContourGrid
+
+#ifndef __vtkSMPContourFilter_h
+#define __vtkSMPContourFilter_h
+
+#include "vtkFiltersSMPModule.h" // For export macro
+#include "vtkContourFilter.h"
+
+class VTKFILTERSSMP_EXPORT vtkSMPContourFilter : public vtkContourFilter
+{
+public:
+  vtkTypeMacro(vtkSMPContourFilter,vtkContourFilter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Constructor.
+  static vtkSMPContourFilter *New();
+
+protected:
+  vtkSMPContourFilter();
+  ~vtkSMPContourFilter();
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
+private:
+  vtkSMPContourFilter(const vtkSMPContourFilter&);  // Not implemented.
+  void operator=(const vtkSMPContourFilter&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPCutter.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkImplicitFunction.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkSMPContourCellsHelper.h"
+#include "vtkSMPTools.h"
+
+vtkStandardNewMacro(vtkSMPCutter);
+
+namespace
+{
+// Evaluates the cut function at the points of the input.
+class vtkSMPCutterEvaluate
+{
+public:
+  vtkImplicitFunction* Function;
+  vtkDataSet* Input;
+  double* Scalars;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetPoint(i, x);
+      this->Scalars[i] = this->Function->FunctionValue(x);
+      }
+  }
+};
+
+// Implicit functions whose evaluation only reads their parameters, see the
+// class description.
+bool vtkSMPCutterIsThreadSafe(vtkImplicitFunction* function)
+{
+  return function->IsA("vtkPlane") || function->IsA("vtkPlanes") ||
+    function->IsA("vtkSphere") || function->IsA("vtkBox") ||
+    function->IsA("vtkCylinder") || function->IsA("vtkCone") ||
+    function->IsA("vtkQuadric");
+}
+}
+
+//----------------------------------------------------------------------------
+vtkSMPCutter::vtkSMPCutter()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSMPCutter::~vtkSMPCutter()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPCutter::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet *input = vtkDataSet::GetData(inputVector[0]);
+  vtkPolyData *output = vtkPolyData::GetData(outputVector);
+
+  // The threaded path merges points as vtkMergePoints does, and orders the
+  // output cells as vtkCutter does when sorting by value.
+  if (!this->CutFunction || !input || !this->GenerateTriangles ||
+      this->SortBy != VTK_SORT_BY_VALUE ||
+      (this->Locator && !this->Locator->IsA("vtkMergePoints")) ||
+      (input->GetDataObjectType() != VTK_UNSTRUCTURED_GRID &&
+       input->GetDataObjectType() != VTK_POLY_DATA))
+    {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  int numContours = this->ContourValues->GetNumberOfContours();
+  if (numPts < 1 || numContours < 1)
+    {
+    return 1;
+    }
+
+  vtkNew<vtkDoubleArray> cutScalars;
+  cutScalars->SetNumberOfTuples(numPts);
+  vtkSMPCutterEvaluate evaluate;
+  evaluate.Function = this->CutFunction;
+  evaluate.Input = input;
+  evaluate.Scalars = cutScalars->GetPointer(0);
+  if (vtkSMPCutterIsThreadSafe(this->CutFunction))
+    {
+    // The first evaluation updates the transform of the function, if any.
+    evaluate(0, 1);
+    vtkSMPTools::For(1, numPts, evaluate);
+    }
+  else
+    {
+    evaluate(0, numPts);
+    }
+
+  // Interpolate data along edge. If generating cut scalars, do necessary setup
+  vtkPointData *inPD = input->GetPointData();
+  vtkNew<vtkPointData> cutPD;
+  if ( this->GenerateCutScalars )
+    {
+    cutPD->ShallowCopy(inPD);//copies original attributes
+    cutPD->SetScalars(cutScalars.GetPointer());
+    inPD = cutPD.GetPointer();
+    }
+
+  // set precision for the points in the output
+  int pointsType = vtkPointSet::SafeDownCast(input)->GetPoints()->GetDataType();
+  if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    pointsType = VTK_FLOAT;
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    pointsType = VTK_DOUBLE;
+    }
+
+  // vtkCutter initializes its locator without an estimated number of
+  // points.
+  if (!vtkSMPContourCellsHelper::Contour(input, cutScalars.GetPointer(), inPD,
+                                         true, numContours,
+                                         this->ContourValues->GetValues(),
+                                         pointsType,
+                                         vtkMergePoints::SafeDownCast(
+                                           this->Locator),
+                                         0, output))
+    {
+    vtkErrorMacro("Cell data could not be copied to every output cell.");
+    return 0;
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPCutter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
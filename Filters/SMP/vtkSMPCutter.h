@@ -0,0 +1,58 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPCutter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPCutter - a subclass of vtkCutter that works in parallel
+// .SECTION Description
+// vtkSMPCutter performs the same function as vtkCutter but cuts
+// vtkUnstructuredGrid and vtkPolyData inputs using multiple threads. The
+// cut function is evaluated in parallel when it is a vtkPlane, vtkPlanes,
+// vtkSphere, vtkBox, vtkCylinder, vtkCone or vtkQuadric, whose evaluation
+// only reads their parameters (subclasses of these must keep it so), and
+// serially otherwise. The cells are then cut in batches, see
+// vtkSMPContourCellsHelper. The output is the same as the one of vtkCutter,
+// for any number of threads. Other inputs, GenerateTriangles off, SortBy
+// set to VTK_SORT_BY_CELL and a Locator that is not a vtkMergePoints are
+// handled by vtkCutter.
+//
+// .SECTION See Also
+// vtkCutter vtkSMPContourFilter vtkSMPContourGrid
+
+#ifndef __vtkSMPCutter_h
+#define __vtkSMPCutter_h
+
+#include "vtkFiltersSMPModule.h" // For export macro
+#include "vtkCutter.h"
+
+class VTKFILTERSSMP_EXPORT vtkSMPCutter : public vtkCutter
+{
+public:
+  vtkTypeMacro(vtkSMPCutter,vtkCutter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Constructor.
+  static vtkSMPCutter *New();
+
+protected:
+  vtkSMPCutter();
+  ~vtkSMPCutter();
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
+private:
+  vtkSMPCutter(const vtkSMPCutter&);  // Not implemented.
+  void operator=(const vtkSMPCutter&);  // Not implemented.
+};
+
+#endif
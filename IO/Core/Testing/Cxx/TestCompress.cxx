@@ -12,52 +12,115 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-// .NAME Test of vtkZLibDataCompressor
+// .NAME Test of vtkZLibDataCompressor, vtkLZ4DataCompressor and vtkZstdDataCompressor
 // .SECTION Description
-//
+// Round trips constant, periodic, text and random buffers through the
+// compressors at several levels.
 
+#include "vtkLZ4DataCompressor.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #include "vtkOutputWindow.h"
 #include "vtkObjectFactory.h"
 
+#include <cstring>
+#include <vector>
 
-int TestCompress(int argc, char *argv[])
+namespace
+{
+const size_t BufferSize = 100024;
+
+bool RoundTrip(vtkDataCompressor* compressor, const unsigned char* buffer,
+               size_t size, size_t& compressedSize)
 {
-  int res = 1;
-  const unsigned int start_size = 100024;
-  unsigned int cc;
-  unsigned char buffer[start_size];
-  unsigned char* cbuffer;
-  unsigned char* ucbuffer;
-  size_t nlen;
-  size_t rlen;
-
-  vtkZLibDataCompressor* compressor = vtkZLibDataCompressor::New();
-  for ( cc = 0; cc < start_size; cc ++ )
+  size_t nlen = compressor->GetMaximumCompressionSpace(size);
+  std::vector<unsigned char> cbuffer(nlen + 1);
+  compressedSize = compressor->Compress(buffer, size, &cbuffer[0], nlen);
+  if (compressedSize == 0 || compressedSize > nlen)
+    {
+    return false;
+    }
+  std::vector<unsigned char> ucbuffer(size + 1);
+  size_t rlen = compressor->Uncompress(&cbuffer[0], compressedSize,
+                                       &ucbuffer[0], size);
+  return rlen == size && memcmp(buffer, &ucbuffer[0], size) == 0;
+}
+
+bool TestCompressor(vtkDataCompressor* compressor, int minLevel,
+                    int maxLevel)
+{
+  std::vector<unsigned char> zeros(BufferSize, 0);
+  zeros[0] = 'v';
+  zeros[1] = 't';
+  zeros[2] = 'k';
+
+  std::vector<unsigned char> periodic(BufferSize);
+  std::vector<unsigned char> text(BufferSize);
+  std::vector<unsigned char> random(BufferSize);
+  const char sentence[] = "The Visualization Toolkit compresses data. ";
+  unsigned int seed = 12345;
+  for (size_t cc = 0; cc < BufferSize; ++cc)
     {
-    buffer[cc] = static_cast<unsigned char>(cc % sizeof(unsigned char));
+    periodic[cc] = static_cast<unsigned char>((cc * cc) % 251);
+    text[cc] = static_cast<unsigned char>(
+      sentence[(cc + cc / 1000) % (sizeof(sentence) - 1)]);
+    seed = seed * 1103515245 + 12345;
+    random[cc] = static_cast<unsigned char>(seed >> 16);
     }
-  buffer[0] = 'v';
-  buffer[1] = 't';
-  buffer[2] = 'k';
-
-  nlen = compressor->GetMaximumCompressionSpace(start_size);
-  cbuffer = new unsigned char[ nlen ];
-  rlen = compressor->Compress(buffer, start_size, cbuffer, nlen);
-  if ( rlen > 0 )
+
+  const std::vector<unsigned char>* buffers[4] =
+    { &zeros, &periodic, &text, &random };
+  for (int level = minLevel; level <= maxLevel; ++level)
     {
-    ucbuffer = new unsigned char[ start_size ];
-    rlen = compressor->Uncompress(cbuffer, rlen, ucbuffer, start_size);
-    if ( rlen == start_size )
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level)
+      {
+      cerr << compressor->GetClassName() << " ignored level " << level
+           << endl;
+      return false;
+      }
+    for (int b = 0; b < 4; ++b)
       {
-      cout << argv[0] << " Works " << argc << endl;
-      cout << ucbuffer[0] << ucbuffer[1] << ucbuffer[2] << endl;
-      res = 0;
+      // Also cover the short blocks that are only made of literals.
+      size_t sizes[4] = { 1, 13, 4099, BufferSize };
+      for (int s = 0; s < 4; ++s)
+        {
+        size_t compressedSize;
+        if (!RoundTrip(compressor, &(*buffers[b])[0], sizes[s],
+                       compressedSize))
+          {
+          cerr << compressor->GetClassName() << " failed on buffer " << b
+               << " of size " << sizes[s] << " at level " << level << endl;
+          return false;
+          }
+        // zlib level 0 stores the data.
+        if (level > 0 && b == 0 && s == 3 &&
+            compressedSize > BufferSize / 50)
+          {
+          cerr << compressor->GetClassName() << " did not compress "
+               << "constant data: " << compressedSize << " bytes." << endl;
+          return false;
+          }
+        }
       }
-    delete [] ucbuffer;
     }
-  delete [] cbuffer;
+  return true;
+}
+}
 
-  compressor->Delete();
-  return res;
+int TestCompress(int argc, char *argv[])
+{
+  vtkZLibDataCompressor* zlib = vtkZLibDataCompressor::New();
+  vtkLZ4DataCompressor* lz4 = vtkLZ4DataCompressor::New();
+  vtkZstdDataCompressor* zstd = vtkZstdDataCompressor::New();
+  bool ok = TestCompressor(zlib, 0, 9) && TestCompressor(lz4, 1, 9) &&
+    TestCompressor(zstd, 1, 22);
+  zlib->Delete();
+  lz4->Delete();
+  zstd->Delete();
+  if (ok)
+    {
+    cout << argv[0] << " Works " << argc << endl;
+    }
+  return ok ? 0 : 1;
 }
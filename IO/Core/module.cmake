@@ -6,7 +6,9 @@ vtk_module(vtkIOCore
     vtkCommonExecutionModel
     vtkCommonMisc
   PRIVATE_DEPENDS
+    vtklz4
     vtkzlib
+    vtkzstd
     vtksys
   TEST_DEPENDS
     vtkTestingCore
@@ -18,6 +18,10 @@
 // compression.  Subclasses provide one compression method and one
 // decompression method.  The public interface to all compressors
 // remains the same, and is defined by this class.
+//
+// The XML readers and writers compress and uncompress independent blocks
+// with one compressor from several threads at once, so subclasses must
+// not modify their state in CompressBuffer and UncompressBuffer.
 
 #ifndef __vtkDataCompressor_h
 #define __vtkDataCompressor_h
@@ -75,6 +79,13 @@ public:
   vtkUnsignedCharArray* Uncompress(unsigned char const* compressedData,
                                    size_t compressedSize,
                                    size_t uncompressedSize);
+
+  // Description:
+  // Get/Set the compression level.  The range and meaning of the level
+  // depend on the subclass, higher levels trade speed for smaller
+  // output.  Compressors without levels ignore it and return 0.
+  virtual void SetCompressionLevel(int) {}
+  virtual int GetCompressionLevel() { return 0; }
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor();
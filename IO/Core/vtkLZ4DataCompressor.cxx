@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtk_lz4.h"
+
+vtkStandardNewMacro(vtkLZ4DataCompressor);
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::vtkLZ4DataCompressor()
+{
+  this->CompressionLevel = 9;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::~vtkLZ4DataCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                     size_t uncompressedSize,
+                                     unsigned char* compressedData,
+                                     size_t compressionSpace)
+{
+  if(uncompressedSize > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+    {
+    vtkErrorMacro("LZ4 cannot compress blocks of " << uncompressedSize
+                  << " bytes.");
+    return 0;
+    }
+  int cs = compressionSpace > static_cast<size_t>(VTK_INT_MAX) ?
+    VTK_INT_MAX : static_cast<int>(compressionSpace);
+
+  // Call lz4's compress function.
+  int result = LZ4_compress_fast(
+    reinterpret_cast<const char*>(uncompressedData),
+    reinterpret_cast<char*>(compressedData),
+    static_cast<int>(uncompressedSize), cs, 10 - this->CompressionLevel);
+  if(result <= 0)
+    {
+    vtkErrorMacro("LZ4 error while compressing data.");
+    return 0;
+    }
+
+  return static_cast<size_t>(result);
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                       size_t compressedSize,
+                                       unsigned char* uncompressedData,
+                                       size_t uncompressedSize)
+{
+  if(compressedSize > static_cast<size_t>(VTK_INT_MAX) ||
+     uncompressedSize > static_cast<size_t>(VTK_INT_MAX))
+    {
+    vtkErrorMacro("LZ4 cannot uncompress blocks of " << uncompressedSize
+                  << " bytes.");
+    return 0;
+    }
+
+  // Call lz4's uncompress function.
+  int result = LZ4_decompress_safe(
+    reinterpret_cast<const char*>(compressedData),
+    reinterpret_cast<char*>(uncompressedData),
+    static_cast<int>(compressedSize), static_cast<int>(uncompressedSize));
+  if(result < 0)
+    {
+    vtkErrorMacro("LZ4 error while uncompressing data.");
+    return 0;
+    }
+
+  // Make sure the output size matched that expected.
+  if(static_cast<size_t>(result) != uncompressedSize)
+    {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected " << uncompressedSize << " and got " << result);
+    return 0;
+    }
+
+  return uncompressedSize;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // LZ4_COMPRESSBOUND, computed in size_t.
+  return size + size/255 + 16;
+}
@@ -0,0 +1,73 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkLZ4DataCompressor - Data compression using the LZ4 block format.
+// .SECTION Description
+// vtkLZ4DataCompressor provides a concrete vtkDataCompressor class
+// using lz4 for compressing and uncompressing data.  It writes raw LZ4
+// blocks (no frame header) with LZ4_compress_fast() and reads them with
+// LZ4_decompress_safe().  LZ4 compresses less than zlib but decompresses
+// several times faster, which suits data that is read much more often
+// than it is written.  Blocks are limited to LZ4_MAX_INPUT_SIZE bytes.
+
+#ifndef __vtkLZ4DataCompressor_h
+#define __vtkLZ4DataCompressor_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkDataCompressor.h"
+
+class VTKIOCORE_EXPORT vtkLZ4DataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkLZ4DataCompressor,vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkLZ4DataCompressor* New();
+
+  // Description:
+  // Get the maximum space that may be needed to store data of the
+  // given uncompressed size after compression.  This is the minimum
+  // size of the output buffer that can be passed to the four-argument
+  // Compress method.
+  size_t GetMaximumCompressionSpace(size_t size);
+
+  // Description:
+  // Get/Set the compression level, from 1 to 9.  Level 9, the default,
+  // is the standard LZ4 compression.  Lower levels correspond to the LZ4
+  // acceleration 10 - level: they skip faster over data that does not
+  // compress, trading ratio for speed.
+  vtkSetClampMacro(CompressionLevel, int, 1, 9);
+  vtkGetMacro(CompressionLevel, int);
+
+protected:
+  vtkLZ4DataCompressor();
+  ~vtkLZ4DataCompressor();
+
+  int CompressionLevel;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData,
+                        size_t uncompressedSize,
+                        unsigned char* compressedData,
+                        size_t compressionSpace);
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData,
+                          size_t compressedSize,
+                          unsigned char* uncompressedData,
+                          size_t uncompressedSize);
+private:
+  vtkLZ4DataCompressor(const vtkLZ4DataCompressor&);  // Not implemented.
+  void operator=(const vtkLZ4DataCompressor&);  // Not implemented.
+};
+
+#endif
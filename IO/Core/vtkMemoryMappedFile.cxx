@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMappedFile.h"
+
+#include "vtkDataArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkObjectFactory.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# include "vtkWindows.h" // For CreateFileMapping
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+
+namespace
+{
+// The arrays reference the mapping they point into.  Their copies own
+// their values, so the reference is not copied.
+class vtkMemoryMappedFileKey : public vtkInformationObjectBaseKey
+{
+public:
+  vtkMemoryMappedFileKey(const char* name, const char* location) :
+    vtkInformationObjectBaseKey(name, location, "vtkMemoryMappedFile") {}
+
+  virtual void ShallowCopy(vtkInformation*, vtkInformation*) {}
+};
+
+static vtkMemoryMappedFileKey* vtkMemoryMappedFile_MAPPED_FILE =
+  new vtkMemoryMappedFileKey("MAPPED_FILE", "vtkMemoryMappedFile");
+}
+
+//----------------------------------------------------------------------------
+vtkInformationObjectBaseKey* vtkMemoryMappedFile::MAPPED_FILE()
+{
+  return vtkMemoryMappedFile_MAPPED_FILE;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::vtkMemoryMappedFile()
+{
+  this->Data = 0;
+  this->Size = 0;
+  this->FileMapping = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::~vtkMemoryMappedFile()
+{
+  if(!this->Data)
+    {
+    return;
+    }
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  UnmapViewOfFile(this->Data);
+  CloseHandle(static_cast<HANDLE>(this->FileMapping));
+#else
+  munmap(this->Data, this->Size);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Size: " << this->Size << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::Open(const char* fileName)
+{
+  if(this->Data)
+    {
+    vtkErrorMacro("A file is already mapped.");
+    return 0;
+    }
+  if(!fileName)
+    {
+    return 0;
+    }
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, 0,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if(file == INVALID_HANDLE_VALUE)
+    {
+    return 0;
+    }
+  LARGE_INTEGER fileSize;
+  if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 ||
+     static_cast<vtkTypeUInt64>(fileSize.QuadPart) >
+     static_cast<vtkTypeUInt64>(static_cast<size_t>(-1)))
+    {
+    CloseHandle(file);
+    return 0;
+    }
+  // The mapping keeps the file open.
+  HANDLE mapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+  CloseHandle(file);
+  if(!mapping)
+    {
+    return 0;
+    }
+  void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+  if(!data)
+    {
+    CloseHandle(mapping);
+    return 0;
+    }
+  this->FileMapping = mapping;
+  this->Size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if(fd < 0)
+    {
+    return 0;
+    }
+  struct stat fs;
+  if(fstat(fd, &fs) != 0 || fs.st_size <= 0 ||
+     static_cast<vtkTypeUInt64>(fs.st_size) >
+     static_cast<vtkTypeUInt64>(static_cast<size_t>(-1)))
+    {
+    close(fd);
+    return 0;
+    }
+  // The mapping keeps the file open.
+  size_t size = static_cast<size_t>(fs.st_size);
+  void* data = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    {
+    return 0;
+    }
+  this->Size = size;
+#endif
+
+  this->Data = static_cast<unsigned char*>(data);
+  this->Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::MapArray(vtkDataArray* array, void* data,
+                                   vtkIdType numValues)
+{
+  array->SetVoidArray(data, numValues, 1);
+  array->GetInformation()->Set(vtkMemoryMappedFile::MAPPED_FILE(), this);
+  array->DataChanged();
+}
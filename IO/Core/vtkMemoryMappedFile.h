@@ -0,0 +1,86 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryMappedFile - Copy-on-write memory mapping of a file.
+// .SECTION Description
+// vtkMemoryMappedFile maps a whole file in memory so that readers can use
+// its contents without copying them.  The mapping is private: its pages
+// are shared with the system page cache, and with the other processes
+// mapping the same file, until they are written to.  Writes are never
+// propagated to the file.
+//
+// Data arrays can use values stored in the mapping as their own storage,
+// see MapArray().  Such arrays hold a reference to the vtkMemoryMappedFile,
+// so the file stays mapped as long as one of them exists.  The file must
+// not be truncated while it is mapped.
+
+#ifndef __vtkMemoryMappedFile_h
+#define __vtkMemoryMappedFile_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataArray;
+class vtkInformationObjectBaseKey;
+
+class VTKIOCORE_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  static vtkMemoryMappedFile* New();
+  vtkTypeMacro(vtkMemoryMappedFile,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Map the file with the given name.  Returns 1 for success and 0 if the
+  // file cannot be mapped, for example when it is empty.  A file can only
+  // be mapped once by a given instance.
+  int Open(const char* fileName);
+
+  // Description:
+  // Get the size in bytes of the mapped file, 0 if none is mapped.
+  size_t GetSize() { return this->Size; }
+
+  //BTX
+  // Description:
+  // Get the address of the mapped file, 0 if none is mapped.
+  unsigned char* GetData() { return this->Data; }
+
+  // Description:
+  // Make the array use the numValues values starting at data as its
+  // storage without copying them.  data must lie in the mapping and be
+  // aligned for the value type of the array.  The array keeps this
+  // mapping alive until it is deleted.
+  void MapArray(vtkDataArray* array, void* data, vtkIdType numValues);
+  //ETX
+
+  // Description:
+  // Key under which the arrays given to MapArray() reference the mapping
+  // in their information.  It is not copied with the information, copies
+  // of an array own their values.
+  static vtkInformationObjectBaseKey* MAPPED_FILE();
+
+protected:
+  vtkMemoryMappedFile();
+  ~vtkMemoryMappedFile();
+
+  unsigned char* Data;
+  size_t Size;
+  void* FileMapping;
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&);  // Not implemented.
+  void operator=(const vtkMemoryMappedFile&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusIIReaderPrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a file with moving points and time-dependent arrays, then steps
+// through its time steps with a reader that prefetches them and one that
+// does not, and checks that the outputs are the same and that the
+// prefetching reader finds all its arrays in the cache. The reader that
+// does not prefetch reads while the other one prefetches, so that both
+// use the Exodus library at once.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimeSourceExample.h"
+
+#include <string>
+
+namespace
+{
+void SetUp(vtkExodusIIReader* reader, const std::string& fileName)
+{
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::GLOBAL, 1);
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* output)
+{
+  bool same = (expected && output &&
+               expected->GetNumberOfTuples() == output->GetNumberOfTuples() &&
+               expected->GetNumberOfComponents() ==
+               output->GetNumberOfComponents());
+  for (vtkIdType i = 0; same && i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < expected->GetNumberOfComponents(); ++j)
+      {
+      same &= (expected->GetComponent(i, j) == output->GetComponent(i, j));
+      }
+    }
+  return same;
+}
+
+bool CompareData(vtkDataSetAttributes* expected, vtkDataSetAttributes* output)
+{
+  bool same = (expected->GetNumberOfArrays() == output->GetNumberOfArrays());
+  for (int i = 0; same && i < expected->GetNumberOfArrays(); ++i)
+    {
+    const char* name = expected->GetArrayName(i);
+    same = (name && CompareArrays(expected->GetArray(i),
+                                  output->GetArray(name)));
+    }
+  return same;
+}
+
+bool Compare(vtkMultiBlockDataSet* expected, vtkMultiBlockDataSet* output)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> it;
+  it.TakeReference(expected->NewIterator());
+  int numBlocks = 0;
+  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextItem())
+    {
+    vtkPointSet* block = vtkPointSet::SafeDownCast(it->GetCurrentDataObject());
+    vtkPointSet* outputBlock =
+      vtkPointSet::SafeDownCast(output->GetDataSet(it));
+    if (!block || !outputBlock || !block->GetPoints() ||
+        !outputBlock->GetPoints() ||
+        !CompareArrays(block->GetPoints()->GetData(),
+                       outputBlock->GetPoints()->GetData()) ||
+        !CompareData(block->GetPointData(), outputBlock->GetPointData()) ||
+        !CompareData(block->GetCellData(), outputBlock->GetCellData()))
+      {
+      return false;
+      }
+    ++numBlocks;
+    }
+  return (numBlocks > 0);
+}
+}
+
+int TestExodusIIReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestExodusIIReaderPrefetch.ex2";
+  delete [] tempDir;
+
+  vtkNew<vtkTimeSourceExample> source;
+  source->SetXAmplitude(1.0);
+  source->SetYAmplitude(0.5);
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->WriteAllTimeStepsOn();
+  writer->Write();
+
+  vtkNew<vtkExodusIIReader> expected;
+  vtkNew<vtkExodusIIReader> reader;
+  SetUp(expected.GetPointer(), fileName);
+  SetUp(reader.GetPointer(), fileName);
+  reader->SetCacheSize(100.0);
+  reader->SetPrefetchTimeSteps(3);
+
+  int numSteps = reader->GetNumberOfTimeSteps();
+  if (numSteps < 6)
+    {
+    cerr << "Error: " << numSteps << " time steps were written" << endl;
+    return EXIT_FAILURE;
+    }
+  for (int step = 0; step < numSteps; ++step)
+    {
+    expected->SetTimeStep(step);
+    expected->Update();
+    reader->WaitForPrefetch();
+    reader->SetTimeStep(step);
+    reader->Update();
+    if (!Compare(expected->GetOutput(), reader->GetOutput()))
+      {
+      cerr << "Error: the outputs are different at time step " << step
+           << endl;
+      return EXIT_FAILURE;
+      }
+    // only the first time step reads from the file
+    if ((step > 0) != (reader->GetNumberOfCacheMisses() == 0) ||
+        (step > 0) != (reader->GetNumberOfCacheHits() > 0))
+      {
+      cerr << "Error: " << reader->GetNumberOfCacheHits() << " hits and "
+           << reader->GetNumberOfCacheMisses() << " misses at time step "
+           << step << endl;
+      return EXIT_FAILURE;
+      }
+    reader->ResetCacheStatistics();
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "vtkCPExodusIIResultsArrayTemplate.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkDoubleArray.h"
+#include "vtkExodusIILibraryGuard.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -162,8 +163,8 @@ bool vtkCPExodusIIInSituReader::ExOpen()
   int fileRealSize = 0;
   float exodusVersion;
 
-  this->FileId = ex_open(this->FileName, EX_READ, &doubleSize, &fileRealSize,
-                         &exodusVersion);
+  this->FileId = VTK_EXO_LOCKED( ex_open(this->FileName, EX_READ, &doubleSize, &fileRealSize,
+                                         &exodusVersion) );
 
   if (this->FileId < 0)
     {
@@ -180,13 +181,13 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
   int numElem, numNodeSets, numSideSets;
   std::string title(MAX_LINE_LENGTH + 1, '\0');
 
-  int error = ex_get_init(this->FileId,
-                          &title[0],
-                          &this->NumberOfDimensions,
-                          &this->NumberOfNodes,
-                          &numElem,
-                          &NumberOfElementBlocks,
-                          &numNodeSets, &numSideSets);
+  int error = VTK_EXO_LOCKED( ex_get_init(this->FileId,
+                                          &title[0],
+                                          &this->NumberOfDimensions,
+                                          &this->NumberOfNodes,
+                                          &numElem,
+                                          &NumberOfElementBlocks,
+                                          &numNodeSets, &numSideSets) );
 
   // Trim excess null characters from string:
   title.resize(strlen(title.c_str()));
@@ -200,7 +201,7 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
   // Number of nodal variables
   int numNodalVars;
 
-  error = ex_get_var_param(this->FileId, "n", &numNodalVars);
+  error = VTK_EXO_LOCKED( ex_get_var_param(this->FileId, "n", &numNodalVars) );
 
   if (error < 0)
     {
@@ -214,8 +215,8 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
 
   for (int i = 0; i < numNodalVars; ++i)
     {
-    error = ex_get_var_name(this->FileId, "n", i + 1,
-                            &(this->NodalVariableNames[i][0]));
+    error = VTK_EXO_LOCKED( ex_get_var_name(this->FileId, "n", i + 1,
+                                            &(this->NodalVariableNames[i][0])) );
     if (error < 0)
       {
       vtkErrorMacro("Error retrieving nodal variable name at index" << i);
@@ -229,7 +230,7 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
   // Number of element variables
   int numElemVars;
 
-  error = ex_get_var_param(this->FileId, "e", &numElemVars);
+  error = VTK_EXO_LOCKED( ex_get_var_param(this->FileId, "e", &numElemVars) );
 
   if (error < 0)
     {
@@ -243,8 +244,8 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
 
   for (int i = 0; i < numElemVars; ++i)
     {
-    error = ex_get_var_name(this->FileId, "e", i + 1,
-                            &(this->ElementVariableNames[i][0]));
+    error = VTK_EXO_LOCKED( ex_get_var_name(this->FileId, "e", i + 1,
+                                            &(this->ElementVariableNames[i][0])) );
     if (error < 0)
       {
       vtkErrorMacro("Error retrieving element variable name at index" << i);
@@ -258,7 +259,7 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
   // Element block ids:
   this->ElementBlockIds.resize(this->NumberOfElementBlocks);
 
-  error = ex_get_elem_blk_ids(this->FileId, &(this->ElementBlockIds[0]));
+  error = VTK_EXO_LOCKED( ex_get_elem_blk_ids(this->FileId, &(this->ElementBlockIds[0])) );
 
   if (error < 0)
     {
@@ -269,8 +270,8 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
   // Timesteps
   int numTimeSteps;
 
-  error = ex_inquire(this->FileId, EX_INQ_TIME,
-                     &numTimeSteps, NULL, NULL);
+  error = VTK_EXO_LOCKED( ex_inquire(this->FileId, EX_INQ_TIME,
+                                     &numTimeSteps, NULL, NULL) );
   if (error < 0)
     {
     vtkErrorMacro("Error retrieving the number of timesteps.");
@@ -283,7 +284,7 @@ bool vtkCPExodusIIInSituReader::ExGetMetaData()
 
   if (numTimeSteps > 0)
     {
-    error = ex_get_all_times(this->FileId, &(this->TimeSteps[0]));
+    error = VTK_EXO_LOCKED( ex_get_all_times(this->FileId, &(this->TimeSteps[0])) );
 
     if (error < 0)
       {
@@ -307,7 +308,7 @@ bool vtkCPExodusIIInSituReader::ExGetCoords()
             ? new double[this->NumberOfNodes]
             : NULL);
 
-  int error = ex_get_coord(this->FileId, x, y, z);
+  int error = VTK_EXO_LOCKED( ex_get_coord(this->FileId, x, y, z) );
 
   if (error < 0)
     {
@@ -332,9 +333,9 @@ bool vtkCPExodusIIInSituReader::ExGetNodalVars()
   for (int nodalVarIndex = 0; nodalVarIndex < numNodalVars; ++nodalVarIndex)
     {
     double *nodalVars = new double[this->NumberOfNodes];
-    int error = ex_get_nodal_var(this->FileId, this->CurrentTimeStep + 1,
-                                 nodalVarIndex + 1, this->NumberOfNodes,
-                                 nodalVars);
+    int error = VTK_EXO_LOCKED( ex_get_nodal_var(this->FileId, this->CurrentTimeStep + 1,
+                                                 nodalVarIndex + 1, this->NumberOfNodes,
+                                                 nodalVars) );
     std::vector<double*> varsVector(1, nodalVars);
     vtkNew<vtkCPExodusIIResultsArrayTemplate<double> > nodalVarArray;
     nodalVarArray->SetExodusScalarArrays(varsVector, this->NumberOfNodes);
@@ -366,10 +367,10 @@ bool vtkCPExodusIIInSituReader::ExGetElemBlocks()
     int nodesPerElem;
     int numAttributes;
 
-    int error = ex_get_elem_block(this->FileId,
-                                  this->ElementBlockIds[blockInd],
-                                  &(elemType[0]), &numElem, &nodesPerElem,
-                                  &numAttributes);
+    int error = VTK_EXO_LOCKED( ex_get_elem_block(this->FileId,
+                                                  this->ElementBlockIds[blockInd],
+                                                  &(elemType[0]), &numElem, &nodesPerElem,
+                                                  &numAttributes) );
 
     // Trim excess null chars from the type string:
     elemType.resize(strlen(elemType.c_str()));
@@ -384,8 +385,8 @@ bool vtkCPExodusIIInSituReader::ExGetElemBlocks()
     // Get element block connectivity
     vtkNew<vtkCPExodusIIElementBlock> block;
     int *connect = new int[numElem * nodesPerElem];
-    error = ex_get_elem_conn(this->FileId, this->ElementBlockIds[blockInd],
-                             connect);
+    error = VTK_EXO_LOCKED( ex_get_elem_conn(this->FileId, this->ElementBlockIds[blockInd],
+                                             connect) );
     if (!block->GetImplementation()->SetExodusConnectivityArray(
           connect, elemType, numElem, nodesPerElem))
       {
@@ -409,9 +410,9 @@ bool vtkCPExodusIIInSituReader::ExGetElemBlocks()
     for (int elemVarIndex = 0; elemVarIndex < numElemVars; ++elemVarIndex)
       {
       double *elemVars = new double[numElem];
-      error = ex_get_elem_var(this->FileId, this->CurrentTimeStep + 1,
-                              elemVarIndex + 1, this->ElementBlockIds[blockInd],
-                              numElem, elemVars);
+      error = VTK_EXO_LOCKED( ex_get_elem_var(this->FileId, this->CurrentTimeStep + 1,
+                                              elemVarIndex + 1, this->ElementBlockIds[blockInd],
+                                              numElem, elemVars) );
       std::vector<double*> varsVector(1, elemVars);
       vtkNew<vtkCPExodusIIResultsArrayTemplate<double> > elemVarArray;
       elemVarArray->SetExodusScalarArrays(varsVector, numElem);
@@ -437,6 +438,6 @@ bool vtkCPExodusIIInSituReader::ExGetElemBlocks()
 //------------------------------------------------------------------------------
 void vtkCPExodusIIInSituReader::ExClose()
 {
-  ex_close(this->FileId);
+  VTK_EXO_LOCKED( ex_close(this->FileId) );
   this->FileId = -1;
 }
@@ -0,0 +1,38 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExodusIILibraryGuard.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkExodusIILibraryGuard - serializes calls into the Exodus library
+// .SECTION Description
+// The Exodus and netCDF libraries keep global state and are not thread
+// safe, even on different files. Every call into them, from the main
+// thread or from the prefetch thread of a vtkExodusIIReader, holds a
+// process-wide lock, taken for as long as a vtkExodusIILibraryGuard
+// exists. This is only for use inside this module.
+
+// VTK-HeaderTest-Exclude: vtkExodusIILibraryGuard.h
+
+#ifndef __vtkExodusIILibraryGuard_h
+#define __vtkExodusIILibraryGuard_h
+
+class vtkExodusIILibraryGuard
+{
+public:
+  vtkExodusIILibraryGuard();
+  ~vtkExodusIILibraryGuard();
+};
+
+// Evaluate an Exodus call with the library lock held.
+#define VTK_EXO_LOCKED(funcall) ( vtkExodusIILibraryGuard(), (funcall) )
+
+#endif
@@ -18,10 +18,12 @@
 ----------------------------------------------------------------------------*/
 #include "vtkExodusIIReader.h"
 #include "vtkExodusIICache.h"
+#include "vtkExodusIILibraryGuard.h"
 
 #include "vtkCellData.h"
 #include "vtkCellType.h"
 #include "vtkCharArray.h"
+#include "vtkCriticalSection.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
@@ -30,7 +32,9 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkMutableDirectedGraph.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -55,6 +59,7 @@
 #include "vtksys/SystemTools.hxx"
 
 #include "vtksys/RegularExpression.hxx"
+#include "vtksys/ios/sstream"
 
 #include "vtk_exodusII.h"
 #include <stdio.h>
@@ -77,12 +82,31 @@
 #undef VTK_DBG_GLOM
 
 #define VTK_EXO_FUNC(funcall,errmsg)\
-  if ( (funcall) < 0 ) \
+  if ( VTK_EXO_LOCKED( funcall ) < 0 ) \
     { \
       vtkErrorMacro( errmsg ); \
       return 1; \
     }
 
+// Errors of GetCacheOrRead(). The prefetch thread must not call observers
+// or the output window, so it only records its first error.
+#define vtkExodusIIReadErrorMacro(x) \
+  { \
+  if ( this->Prefetching ) \
+    { \
+    if ( this->PrefetchError.empty() ) \
+      { \
+      vtksys_ios::ostringstream vtkmsg; \
+      vtkmsg << x; \
+      this->PrefetchError = vtkmsg.str(); \
+      } \
+    } \
+  else \
+    { \
+    vtkErrorMacro( x ); \
+    } \
+  }
+
 // ------------------------------------------------------------------- CONSTANTS
 static int obj_types[] = {
   EX_EDGE_BLOCK,
@@ -206,6 +230,18 @@ extern "C" { typedef int (*vtkExodusIIGetMapFunc)( int, int* ); }
 #include "vtkExodusIIReaderVariableCheck.h"
 
 // --------------------------------------------------- PRIVATE CLASS Implementations
+static vtkSimpleCriticalSection vtkExodusIILibraryLock;
+
+vtkExodusIILibraryGuard::vtkExodusIILibraryGuard()
+{
+  vtkExodusIILibraryLock.Lock();
+}
+
+vtkExodusIILibraryGuard::~vtkExodusIILibraryGuard()
+{
+  vtkExodusIILibraryLock.Unlock();
+}
+
 vtkExodusIIReaderPrivate::BlockSetInfoType::BlockSetInfoType(
   const vtkExodusIIReaderPrivate::BlockSetInfoType &block):
   vtkExodusIIReaderPrivate::ObjectInfoType(block),
@@ -386,6 +422,17 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
 
+  this->PrefetchTimeSteps = 0;
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+  this->PrefetchThreader = vtkMultiThreader::New();
+  this->PrefetchThreadId = -1;
+  this->PrefetchLock = vtkMutexLock::New();
+  this->PrefetchAbort = 0;
+  this->PrefetchRange[0] = 0;
+  this->PrefetchRange[1] = -1;
+  this->Prefetching = 0;
+
   this->TimeStep = 0;
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -415,6 +462,8 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
   this->CloseFile();
+  this->PrefetchThreader->Delete();
+  this->PrefetchLock->Delete();
   this->Cache->Delete();
   this->CacheSize = 0;
   this->ClearConnectivityCaches();
@@ -1514,7 +1563,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
 
   if ( arr )
     {
-    //
+    if ( ! this->Prefetching )
+      {
+      ++this->CacheHits;
+      }
+    this->AddTimeStepArray( key, arr );
     return arr;
     }
 
@@ -1533,10 +1586,10 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfComponents( 1 );
     arr->SetNumberOfTuples( this->ArrayInfo[ vtkExodusIIReader::GLOBAL ].size() );
 
-    if ( ex_get_glob_vars( exoid, key.Time + 1, arr->GetNumberOfTuples(),
-        arr->GetVoidPointer( 0 ) ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_glob_vars( exoid, key.Time + 1, arr->GetNumberOfTuples(),
+        arr->GetVoidPointer( 0 ) ) ) < 0 )
       {
-      vtkErrorMacro( "Could not read global variable " << this->GetGlobalVariableValuesArrayName() << "." );
+      vtkExodusIIReadErrorMacro( "Could not read global variable " << this->GetGlobalVariableValuesArrayName() << "." );
       arr->Delete();
       arr = 0;
       }
@@ -1556,11 +1609,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       }
     if ( ncomps == 1 )
       {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+      if ( VTK_EXO_LOCKED( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
           ainfop->OriginalIndices[0], 0, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0 )
+          arr->GetVoidPointer( 0 ) ) ) < 0 )
         {
-        vtkErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
+        vtkExodusIIReadErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
         arr->Delete();
         arr = 0;
         }
@@ -1575,11 +1628,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         {
         vtkIdType N = this->ModelParameters.num_nodes;
         tmpVal[c].resize( N );
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+        if ( VTK_EXO_LOCKED( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
             ainfop->OriginalIndices[c], 0, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
+            &tmpVal[c][0] ) ) < 0)
           {
-          vtkErrorMacro( "Could not read nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
+          vtkExodusIIReadErrorMacro( "Could not read nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
           arr->Delete();
           arr = 0;
           return 0;
@@ -1618,11 +1671,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         {
         vtkIdType N = this->GetNumberOfTimeSteps();
         tmpVal[c].resize( N );
-        if ( ex_get_var_time( exoid, EX_GLOBAL,
+        if ( VTK_EXO_LOCKED( ex_get_var_time( exoid, EX_GLOBAL,
             ainfop->OriginalIndices[c], key.ObjectId,
-            1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) < 0 )
+            1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) ) < 0 )
           {
-          vtkErrorMacro(
+          vtkExodusIIReadErrorMacro(
             "Could not read temporal global result variable "
             << ainfop->OriginalNames[c].c_str() << "." );
           arr->Delete();
@@ -1642,11 +1695,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         arr->SetTuple( t, &tmpTuple[0] );
         }
       }
-    else if ( ex_get_var_time( exoid, EX_GLOBAL,
+    else if ( VTK_EXO_LOCKED( ex_get_var_time( exoid, EX_GLOBAL,
         ainfop->OriginalIndices[0], key.ObjectId,
-        1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) < 0 )
+        1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) ) < 0 )
       {
-      vtkErrorMacro(
+      vtkExodusIIReadErrorMacro(
         "Could not read global result variable "
         << ainfop->Name.c_str() << "." );
       arr->Delete();
@@ -1664,11 +1717,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfTuples( this->GetNumberOfTimeSteps() );
     if ( ainfop->Components == 1 )
       {
-      if ( ex_get_var_time( exoid, EX_NODAL,
+      if ( VTK_EXO_LOCKED( ex_get_var_time( exoid, EX_NODAL,
           ainfop->OriginalIndices[0], key.ObjectId,
-          1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) < 0 )
+          1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) ) < 0 )
         {
-        vtkErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
+        vtkExodusIIReadErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
         arr->Delete();
         arr = 0;
         }
@@ -1683,11 +1736,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         {
         vtkIdType N = this->GetNumberOfTimeSteps();
         tmpVal[c].resize( N );
-        if ( ex_get_var_time( exoid, EX_NODAL,
+        if ( VTK_EXO_LOCKED( ex_get_var_time( exoid, EX_NODAL,
             ainfop->OriginalIndices[c], key.ObjectId,
-            1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) < 0 )
+            1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read temporal nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
+          vtkExodusIIReadErrorMacro( "Could not read temporal nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
           arr->Delete();
           arr = 0;
           return 0;
@@ -1717,11 +1770,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfTuples( this->GetNumberOfTimeSteps() );
     if ( ainfop->Components == 1 )
       {
-      if ( ex_get_var_time( exoid, EX_ELEM_BLOCK,
+      if ( VTK_EXO_LOCKED( ex_get_var_time( exoid, EX_ELEM_BLOCK,
           ainfop->OriginalIndices[0], key.ObjectId,
-          1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) < 0 )
+          1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) ) < 0 )
         {
-        vtkErrorMacro( "Could not read element result variable " << ainfop->Name.c_str() << "." );
+        vtkExodusIIReadErrorMacro( "Could not read element result variable " << ainfop->Name.c_str() << "." );
         arr->Delete();
         arr = 0;
         }
@@ -1736,11 +1789,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         {
         vtkIdType N = this->GetNumberOfTimeSteps();
         tmpVal[c].resize( N );
-        if ( ex_get_var_time( exoid, EX_ELEM_BLOCK,
+        if ( VTK_EXO_LOCKED( ex_get_var_time( exoid, EX_ELEM_BLOCK,
             ainfop->OriginalIndices[c], key.ObjectId,
-            1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) < 0 )
+            1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read temporal element result variable " << ainfop->OriginalNames[c].c_str() << "." );
+          vtkExodusIIReadErrorMacro( "Could not read temporal element result variable " << ainfop->OriginalNames[c].c_str() << "." );
           arr->Delete();
           arr = 0;
           return 0;
@@ -1788,11 +1841,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfTuples( oinfop->Size );
     if ( ainfop->Components == 1 )
       {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+      if ( VTK_EXO_LOCKED( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
           ainfop->OriginalIndices[0], oinfop->Id, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0)
+          arr->GetVoidPointer( 0 ) ) ) < 0)
         {
-        vtkErrorMacro( "Could not read result variable " << ainfop->Name.c_str() <<
+        vtkExodusIIReadErrorMacro( "Could not read result variable " << ainfop->Name.c_str() <<
           " for " << objtype_names[otypidx] << " " << oinfop->Id << "." );
         arr->Delete();
         arr = 0;
@@ -1809,11 +1862,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         vtkIdType N = arr->GetNumberOfTuples();
         tmpVal[c].resize( N+1 ); // + 1 to avoid errors when N == 0.
                                  // BUG #8746.
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+        if ( VTK_EXO_LOCKED( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
             ainfop->OriginalIndices[c], oinfop->Id, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
+            &tmpVal[c][0] ) ) < 0)
           {
-          vtkErrorMacro( "Could not read result variable " << ainfop->OriginalNames[c].c_str() <<
+          vtkExodusIIReadErrorMacro( "Could not read result variable " << ainfop->OriginalNames[c].c_str() <<
             " for " << objtype_names[otypidx] << " " << oinfop->Id << "." );
           arr->Delete();
           arr = 0;
@@ -1865,9 +1918,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
 #ifdef VTK_USE_64BIT_IDS
       {
       std::vector<int> tmpMap( arr->GetNumberOfTuples() );
-      if ( ex_get_num_map( exoid, static_cast<ex_entity_type>( key.ObjectType ), minfop->Id, &tmpMap[0] ) < 0 )
+      if ( VTK_EXO_LOCKED( ex_get_num_map( exoid, static_cast<ex_entity_type>( key.ObjectType ), minfop->Id, &tmpMap[0] ) ) < 0 )
         {
-        vtkErrorMacro( "Could not read map \"" << minfop->Name.c_str() << "\" (" << minfop->Id << ") from disk." );
+        vtkExodusIIReadErrorMacro( "Could not read map \"" << minfop->Name.c_str() << "\" (" << minfop->Id << ") from disk." );
         arr->Delete();
         arr = 0;
         return 0;
@@ -1878,9 +1931,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         }
       }
 #else
-    if ( ex_get_num_map( exoid, static_cast<ex_entity_type>( key.ObjectType ), minfop->Id, (int*)arr->GetVoidPointer( 0 ) ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_num_map( exoid, static_cast<ex_entity_type>( key.ObjectType ), minfop->Id, (int*)arr->GetVoidPointer( 0 ) ) ) < 0 )
       {
-      vtkErrorMacro( "Could not read nodal map variable " << minfop->Name.c_str() << "." );
+      vtkExodusIIReadErrorMacro( "Could not read nodal map variable " << minfop->Name.c_str() << "." );
       arr->Delete();
       arr = 0;
       }
@@ -1962,9 +2015,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       {
 #ifdef VTK_USE_64BIT_IDS
         std::vector<int> tmpMap( src->GetNumberOfTuples() );
-        if ( ex_get_id_map( exoid, static_cast<ex_entity_type>( ckey.ObjectType ), &tmpMap[0] ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_id_map( exoid, static_cast<ex_entity_type>( ckey.ObjectType ), &tmpMap[0] ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read elem num map for global implicit id" );
+          vtkExodusIIReadErrorMacro( "Could not read elem num map for global implicit id" );
           src->Delete();
           return 0;
           }
@@ -1976,9 +2029,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
             }
           }
 #else
-        if ( ex_get_id_map( exoid, static_cast<ex_entity_type>( ckey.ObjectType ), (int*)src->GetPointer( 0 ) ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_id_map( exoid, static_cast<ex_entity_type>( ckey.ObjectType ), (int*)src->GetPointer( 0 ) ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read elem num map for global implicit id" );
+          vtkExodusIIReadErrorMacro( "Could not read elem num map for global implicit id" );
           src->Delete();
           return 0;
           }
@@ -2046,9 +2099,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       {
 #ifdef VTK_USE_64BIT_IDS
         std::vector<int> tmpMap( src->GetNumberOfTuples() );
-        if ( ex_get_id_map( exoid, (ex_entity_type)( vtkExodusIIReader::NODE_MAP ), &tmpMap[0] ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_id_map( exoid, (ex_entity_type)( vtkExodusIIReader::NODE_MAP ), &tmpMap[0] ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read node num map for global implicit id" );
+          vtkExodusIIReadErrorMacro( "Could not read node num map for global implicit id" );
           src->Delete();
           return 0;
           }
@@ -2060,9 +2113,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
             }
           }
 #else
-        if ( ex_get_id_map( exoid, (ex_entity_type)( vtkExodusIIReader::NODE_MAP ), (int*)src->GetPointer( 0 ) ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_id_map( exoid, (ex_entity_type)( vtkExodusIIReader::NODE_MAP ), (int*)src->GetPointer( 0 ) ) ) < 0 )
           {
-          vtkErrorMacro( "Could not node node num map for global implicit id" );
+          vtkExodusIIReadErrorMacro( "Could not node node num map for global implicit id" );
           src->Delete();
           return 0;
           }
@@ -2141,9 +2194,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         {
 #ifdef VTK_USE_64BIT_IDS
         std::vector<int> tmpMap( iarr->GetNumberOfTuples() );
-        if ( ex_get_id_map( exoid, static_cast<ex_entity_type>( ktmp.ObjectType ), &tmpMap[0] ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_id_map( exoid, static_cast<ex_entity_type>( ktmp.ObjectType ), &tmpMap[0] ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read old-style node or element map." );
+          vtkExodusIIReadErrorMacro( "Could not read old-style node or element map." );
           iarr->Delete();
           iarr = 0;
           }
@@ -2155,9 +2208,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
             }
           }
 #else
-        if ( ex_get_id_map( exoid, static_cast<ex_entity_type>( ktmp.ObjectType ), (int*)iarr->GetPointer( 0 ) ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_id_map( exoid, static_cast<ex_entity_type>( ktmp.ObjectType ), (int*)iarr->GetPointer( 0 ) ) ) < 0 )
           {
-          vtkErrorMacro( "Could not read old-style node or element map." );
+          vtkExodusIIReadErrorMacro( "Could not read old-style node or element map." );
           iarr->Delete();
           iarr = 0;
           }
@@ -2174,7 +2227,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     }
   else if ( key.ObjectType == vtkExodusIIReader::GLOBAL_CONN )
     {
-    vtkErrorMacro(
+    vtkExodusIIReadErrorMacro(
       "Global connectivity is created in AssembleOutputConnectivity since it can't be cached\n"
       "with a single vtkDataArray. Who told you to call this routine to get it?"
       );
@@ -2196,10 +2249,10 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     vtkIntArray* iarr = vtkIntArray::New();
     iarr->SetNumberOfComponents (1);
     iarr->SetNumberOfTuples (binfop->Size);
-    if ( ex_get_entity_count_per_polyhedra ( exoid, static_cast<ex_entity_type>( otyp ), binfop->Id,
-                                             iarr->GetPointer(0)) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_entity_count_per_polyhedra ( exoid, static_cast<ex_entity_type>( otyp ), binfop->Id,
+                                             iarr->GetPointer(0)) ) < 0 )
       {
-      vtkErrorMacro( "Unable to read " << binfop->Id << " (index " << key.ObjectId <<
+      vtkExodusIIReadErrorMacro( "Unable to read " << binfop->Id << " (index " << key.ObjectId <<
         ") entity count per polyhedra" );
       iarr->Delete();
       iarr = 0;
@@ -2229,9 +2282,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       iarr->SetNumberOfTuples( binfop->Size );
       }
 
-    if ( ex_get_conn( exoid, static_cast<ex_entity_type>( otyp ), binfop->Id, iarr->GetPointer(0), 0, 0 ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_conn( exoid, static_cast<ex_entity_type>( otyp ), binfop->Id, iarr->GetPointer(0), 0, 0 ) ) < 0 )
       {
-      vtkErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << binfop->Id << " (index " << key.ObjectId <<
+      vtkExodusIIReadErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << binfop->Id << " (index " << key.ObjectId <<
         ") nodal connectivity." );
       iarr->Delete();
       iarr = 0;
@@ -2333,9 +2386,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     iarr->SetNumberOfTuples( sinfop->Size );
     int* iptr = iarr->GetPointer( 0 );
 
-    if ( ex_get_set( exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iptr, 0 ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_set( exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iptr, 0 ) ) < 0 )
       {
-      vtkErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << sinfop->Id << " (index " << key.ObjectId <<
+      vtkExodusIIReadErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << sinfop->Id << " (index " << key.ObjectId <<
         ") nodal connectivity." );
       iarr->Delete();
       iarr = 0;
@@ -2360,9 +2413,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     std::vector<int> tmpOrient; // hold the edge/face orientation information until we can interleave it.
     tmpOrient.resize( sinfop->Size );
 
-    if ( ex_get_set( exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iarr->GetPointer(0), &tmpOrient[0] ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_set( exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iarr->GetPointer(0), &tmpOrient[0] ) ) < 0 )
       {
-      vtkErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << sinfop->Id << " (index " << key.ObjectId <<
+      vtkExodusIIReadErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << sinfop->Id << " (index " << key.ObjectId <<
         ") nodal connectivity." );
       iarr->Delete();
       iarr = 0;
@@ -2387,9 +2440,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       // let InsertSetSides() figure it all out. Except for 0-based indexing
       SetInfoType* sinfop = &this->SetInfo[vtkExodusIIReader::SIDE_SET][key.ObjectId];
       int ssnllen; // side set node list length
-      if ( ex_get_side_set_node_list_len( exoid, sinfop->Id, &ssnllen ) < 0 )
+      if ( VTK_EXO_LOCKED( ex_get_side_set_node_list_len( exoid, sinfop->Id, &ssnllen ) ) < 0 )
         {
-        vtkErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list length" );
+        vtkExodusIIReadErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list length" );
         arr = 0;
         return 0;
         }
@@ -2398,9 +2451,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       iarr->SetNumberOfComponents( 1 );
       iarr->SetNumberOfTuples( ilen );
       int* dat = iarr->GetPointer( 0 );
-      if ( ex_get_side_set_node_list( exoid, sinfop->Id, dat, dat + sinfop->Size ) < 0 )
+      if ( VTK_EXO_LOCKED( ex_get_side_set_node_list( exoid, sinfop->Id, dat, dat + sinfop->Size ) ) < 0 )
         {
-        vtkErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list" );
+        vtkExodusIIReadErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list" );
         iarr->Delete();
         arr = 0;
         return 0;
@@ -2419,9 +2472,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       SetInfoType* sinfop = &this->SetInfo[vtkExodusIIReader::SIDE_SET][key.ObjectId];
       std::vector<int> side_set_elem_list(sinfop->Size);
       std::vector<int> side_set_side_list(sinfop->Size);
-      if ( ex_get_side_set( exoid, sinfop->Id, &side_set_elem_list[0], &side_set_side_list[0]) < 0 )
+      if ( VTK_EXO_LOCKED( ex_get_side_set( exoid, sinfop->Id, &side_set_elem_list[0], &side_set_side_list[0]) ) < 0 )
         {
-        vtkErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list" );
+        vtkExodusIIReadErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list" );
         arr = 0;
         return 0;
         }
@@ -2474,12 +2527,12 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         yc = 0;
         break;
       default:
-        vtkErrorMacro( "Bad coordinate index " << c << " when reading point coordinates." );
+        vtkExodusIIReadErrorMacro( "Bad coordinate index " << c << " when reading point coordinates." );
         xc = yc = zc = 0;
         }
-      if ( ex_get_coord( exoid, xc, yc, zc ) < 0 )
+      if ( VTK_EXO_LOCKED( ex_get_coord( exoid, xc, yc, zc ) ) < 0 )
         {
-        vtkErrorMacro( "Unable to read node coordinates for index " << c << "." );
+        vtkExodusIIReadErrorMacro( "Unable to read node coordinates for index " << c << "." );
         arr->Delete();
         arr = 0;
         break;
@@ -2559,10 +2612,10 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     darr->SetName( binfop->AttributeNames[key.ArrayId].c_str() );
     darr->SetNumberOfComponents( 1 );
     darr->SetNumberOfTuples( binfop->Size );
-    if ( ex_get_one_attr(
-        exoid, static_cast<ex_entity_type>(blkType), binfop->Id, key.ArrayId + 1, darr->GetVoidPointer( 0 ) ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_get_one_attr(
+        exoid, static_cast<ex_entity_type>(blkType), binfop->Id, key.ArrayId + 1, darr->GetVoidPointer( 0 ) ) ) < 0 )
       { // NB: The error message references the file-order object id, not the numerically sorted index presented to users.
-      vtkErrorMacro( "Unable to read attribute " << key.ArrayId
+      vtkExodusIIReadErrorMacro( "Unable to read attribute " << key.ArrayId
         << " for object " << key.ObjectId << " of type " << key.ObjectType  << " block type " << blkType << "." );
       arr->Delete();
       arr = 0;
@@ -2580,9 +2633,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     carr->SetName("Info_Records");
     carr->SetNumberOfComponents( MAX_LINE_LENGTH+1 );
 
-    if( ex_inquire( exoid, EX_INQ_INFO, &num_info, &fdum, cdum ) < 0 )
+    if( VTK_EXO_LOCKED( ex_inquire( exoid, EX_INQ_INFO, &num_info, &fdum, cdum ) ) < 0 )
       {
-      vtkErrorMacro( "Unable to get number of INFO records from ex_inquire" );
+      vtkExodusIIReadErrorMacro( "Unable to get number of INFO records from ex_inquire" );
       carr->Delete();
       arr = 0;
       }
@@ -2596,9 +2649,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         for ( i = 0; i < num_info; ++i )
           info[i] = (char *) calloc ( ( MAX_LINE_LENGTH + 1 ), sizeof(char) );
 
-        if ( ex_get_info( exoid, info ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_info( exoid, info ) ) < 0 )
           {
-          vtkErrorMacro( "Unable to read INFO records from ex_get_info");
+          vtkExodusIIReadErrorMacro( "Unable to read INFO records from ex_get_info");
           carr->Delete();
           arr = 0;
           }
@@ -2636,9 +2689,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     carr->SetName( "QA_Records" );
     carr->SetNumberOfComponents( MAX_STR_LENGTH + 1 );
 
-    if ( ex_inquire( exoid, EX_INQ_QA, &num_qa_rec, &fdum, cdum ) < 0 )
+    if ( VTK_EXO_LOCKED( ex_inquire( exoid, EX_INQ_QA, &num_qa_rec, &fdum, cdum ) ) < 0 )
       {
-      vtkErrorMacro( "Unable to get number of QA records from ex_inquire" );
+      vtkExodusIIReadErrorMacro( "Unable to get number of QA records from ex_inquire" );
       carr->Delete();
       arr = 0;
       }
@@ -2657,9 +2710,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
             }
           }
 
-        if ( ex_get_qa( exoid, qa_record ) < 0 )
+        if ( VTK_EXO_LOCKED( ex_get_qa( exoid, qa_record ) ) < 0 )
           {
-          vtkErrorMacro( "Unable to read QA records from ex_get_qa");
+          vtkExodusIIReadErrorMacro( "Unable to read QA records from ex_get_qa");
           carr->Delete();
           arr = 0;
           }
@@ -2693,8 +2746,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     }
   else
     {
-    vtkWarningMacro( "You requested an array for objects of type " << key.ObjectType <<
-      " which I know nothing about" );
+    if ( ! this->Prefetching )
+      {
+      vtkWarningMacro( "You requested an array for objects of type " << key.ObjectType <<
+        " which I know nothing about" );
+      }
     arr = 0;
     }
 
@@ -2706,11 +2762,25 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     {
     this->Cache->Insert( key, arr );
     arr->FastDelete();
+    if ( ! this->Prefetching )
+      {
+      ++this->CacheMisses;
+      }
+    this->AddTimeStepArray( key, arr );
     }
   return arr;
 }
 
 //-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::AddTimeStepArray(
+  const vtkExodusIICacheKey& key, vtkDataArray* arr )
+{
+  if ( ! this->Prefetching && key.Time >= 0 )
+    {
+    this->TimeStepArrays[key] = arr->GetActualMemorySize() / 1024.;
+    }
+}
+
 int vtkExodusIIReaderPrivate::GetConnTypeIndexFromConnType( int ctyp )
 {
   int i;
@@ -3498,8 +3568,12 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
       }
     }
 
+  this->StopPrefetch();
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf( os, inden2 );
+  os << indent << "PrefetchTimeSteps: " << this->PrefetchTimeSteps << "\n";
+  os << indent << "CacheHits: " << this->CacheHits << "\n";
+  os << indent << "CacheMisses: " << this->CacheMisses << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3517,13 +3591,14 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
     return 0;
     }
 
+  this->StopPrefetch();
   if ( this->Exoid >= 0 )
     {
     this->CloseFile();
     }
 
-  this->Exoid = ex_open( filename, EX_READ,
-    &this->AppWordSize, &this->DiskWordSize, &this->ExodusVersion );
+  this->Exoid = VTK_EXO_LOCKED( ex_open( filename, EX_READ,
+    &this->AppWordSize, &this->DiskWordSize, &this->ExodusVersion ) );
 
   if ( this->Exoid <= 0 )
     {
@@ -3534,13 +3609,17 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
   int numNodesInFile;
   char dummyChar;
   float dummyFloat;
-  ex_inquire(this->Exoid, EX_INQ_NODES, &numNodesInFile, &dummyFloat, &dummyChar);
+  VTK_EXO_LOCKED( ex_inquire(this->Exoid, EX_INQ_NODES, &numNodesInFile, &dummyFloat, &dummyChar) );
+
+  // The prefetch thread opens the file again after RequestData().
+  this->PrefetchFileName = filename;
 
   return 1;
 }
 
 int vtkExodusIIReaderPrivate::CloseFile()
 {
+  this->StopPrefetch();
   if ( this->Exoid >= 0 )
     {
     VTK_EXO_FUNC( ex_close( this->Exoid ), "Could not close an open file (" << this->Exoid << ")" );
@@ -3666,7 +3745,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
   VTK_EXO_FUNC( ex_get_init_ext( exoid, &this->ModelParameters ),
     "Unable to read database parameters." );
 
-  VTK_EXO_FUNC( this->UpdateTimeInformation(), "" );
+  this->UpdateTimeInformation();
 
   //VTK_EXO_FUNC( ex_inquire( exoid, EX_INQ_TIME,       itmp, 0, 0 ), "Inquire for EX_INQ_TIME failed" );
   //num_timesteps = itmp[0];
@@ -4119,6 +4198,17 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     vtkErrorMacro( "You must specify an output mesh" );
     }
 
+  // The prefetch thread of the previous time step has been joined by
+  // OpenFile(), so its error can be reported from this thread.
+  if ( ! this->PrefetchError.empty() )
+    {
+    vtkErrorMacro( "Prefetching failed: " << this->PrefetchError.c_str() );
+    this->PrefetchError.clear();
+    }
+
+  // Record which time-dependent arrays this time step uses.
+  this->TimeStepArrays.clear();
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4204,6 +4294,9 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
 
   this->CloseFile();
 
+  // Read the same arrays for the next time steps while the output is used.
+  this->StartPrefetch( static_cast<int>( timeStep ) );
+
   return 0;
 }
 
@@ -4341,6 +4434,8 @@ void vtkExodusIIReaderPrivate::Reset()
 {
   this->CloseFile();
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
+  this->TimeStepArrays.clear();
+  this->ResetCacheStatistics();
   this->BlockInfo.clear();
   this->SetInfo.clear();
   this->MapInfo.clear();
@@ -4387,6 +4482,7 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->StopPrefetch();
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
   this->ClearConnectivityCaches();
@@ -4396,12 +4492,144 @@ void vtkExodusIIReaderPrivate::SetCacheSize( double size )
 {
   if (this->CacheSize != size)
     {
+    this->StopPrefetch();
     this->CacheSize = size;
     this->Cache->SetCacheCapacity(this->CacheSize);
     this->Modified();
     }
 }
 
+// Prefetching does not change the output, so it does not call Modified().
+void vtkExodusIIReaderPrivate::SetPrefetchTimeSteps( int n )
+{
+  n = ( n < 0 ? 0 : n );
+  if ( this->PrefetchTimeSteps != n )
+    {
+    this->StopPrefetch();
+    this->PrefetchTimeSteps = n;
+    }
+}
+
+void vtkExodusIIReaderPrivate::ResetCacheStatistics()
+{
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+}
+
+static VTK_THREAD_RETURN_TYPE vtkExodusIIReaderPrefetchThread( void* arg )
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>( arg );
+  static_cast<vtkExodusIIReaderPrivate*>( info->UserData )->Prefetch();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+void vtkExodusIIReaderPrivate::StartPrefetch( int timeStep )
+{
+  this->StopPrefetch();
+  if ( this->PrefetchTimeSteps <= 0 || this->HasModeShapes ||
+    this->TimeStepArrays.empty() || this->PrefetchFileName.empty() )
+    {
+    return;
+    }
+
+  // Read no more time steps than the cache holds along with this one, or
+  // the prefetched arrays would evict each other.
+  double stepSize = 0.;
+  std::map<vtkExodusIICacheKey,double>::iterator it;
+  for ( it = this->TimeStepArrays.begin(); it != this->TimeStepArrays.end(); ++it )
+    {
+    stepSize += it->second;
+    }
+  int numSteps = this->PrefetchTimeSteps;
+  if ( stepSize > 0. && this->CacheSize / stepSize - 1. < numSteps )
+    {
+    numSteps = static_cast<int>( this->CacheSize / stepSize ) - 1;
+    }
+  this->PrefetchError.clear();
+  this->PrefetchRange[0] = timeStep + 1;
+  this->PrefetchRange[1] = timeStep + numSteps;
+  if ( this->PrefetchRange[1] >= this->GetNumberOfTimeSteps() )
+    {
+    this->PrefetchRange[1] = this->GetNumberOfTimeSteps() - 1;
+    }
+  if ( this->PrefetchRange[0] > this->PrefetchRange[1] )
+    {
+    return;
+    }
+
+  this->PrefetchThreadId = this->PrefetchThreader->SpawnThread(
+    vtkExodusIIReaderPrefetchThread, this );
+}
+
+void vtkExodusIIReaderPrivate::StopPrefetch()
+{
+  if ( this->PrefetchThreadId >= 0 )
+    {
+    this->PrefetchLock->Lock();
+    this->PrefetchAbort = 1;
+    this->PrefetchLock->Unlock();
+    this->WaitForPrefetch();
+    }
+}
+
+void vtkExodusIIReaderPrivate::WaitForPrefetch()
+{
+  if ( this->PrefetchThreadId >= 0 )
+    {
+    // The thread only checks PrefetchAbort, so this just joins it.
+    this->PrefetchThreader->TerminateThread( this->PrefetchThreadId );
+    this->PrefetchThreadId = -1;
+    this->PrefetchAbort = 0;
+    }
+}
+
+// The main thread does not use the file or the cache until StopPrefetch()
+// returns, so the thread can use them without locking, except for the
+// Exodus library itself which other readers may be using.
+void vtkExodusIIReaderPrivate::Prefetch()
+{
+  int appWordSize = this->AppWordSize;
+  int diskWordSize = this->DiskWordSize;
+  float exodusVersion;
+  this->Exoid = VTK_EXO_LOCKED( ex_open( this->PrefetchFileName.c_str(), EX_READ,
+    &appWordSize, &diskWordSize, &exodusVersion ) );
+  if ( this->Exoid <= 0 )
+    {
+    this->PrefetchError = "Unable to open \"" + this->PrefetchFileName + "\" for reading";
+    this->Exoid = -1;
+    return;
+    }
+
+  this->Prefetching = 1;
+  int active = 1;
+  for ( int t = this->PrefetchRange[0]; t <= this->PrefetchRange[1] && active; ++t )
+    {
+    std::map<vtkExodusIICacheKey,double>::iterator it;
+    for ( it = this->TimeStepArrays.begin(); it != this->TimeStepArrays.end(); ++it )
+      {
+      this->PrefetchLock->Lock();
+      active = ! this->PrefetchAbort;
+      this->PrefetchLock->Unlock();
+      if ( ! active )
+        {
+        break;
+        }
+      vtkExodusIICacheKey key( it->first );
+      key.Time = t;
+      if ( ! this->GetCacheOrRead( key ) )
+        {
+        active = 0;
+        break;
+        }
+      }
+    }
+  this->Prefetching = 0;
+
+  VTK_EXO_LOCKED( ex_close( this->Exoid ) );
+  this->Exoid = -1;
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -4681,6 +4909,7 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus( int otyp, int i, int stat )
     // it was any faster before.
     //vtkExodusIICacheKey key( 0, GLOBAL, 0, i );
     //vtkExodusIICacheKey pattern( 0, 1, 0, 1 );
+    this->StopPrefetch();
     this->Cache->Invalidate(
       vtkExodusIICacheKey( 0, vtkExodusIIReader::GLOBAL, otyp, i ),
       vtkExodusIICacheKey( 0, 1, 1, 1 ) );
@@ -4846,6 +5075,7 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements( int d )
   this->Modified();
 
   // Require the coordinates to be recomputed:
+  this->StopPrefetch();
   this->Cache->Invalidate(
     vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
     vtkExodusIICacheKey( 0, 1, 0, 0 ) );
@@ -4860,6 +5090,7 @@ void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
   this->Modified();
 
   // Require the coordinates to be recomputed:
+  this->StopPrefetch();
   this->Cache->Invalidate(
     vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
     vtkExodusIICacheKey( 0, 1, 0, 0 ) );
@@ -4925,11 +5156,11 @@ int vtkExodusIIReader::CanReadFile( const char* fname )
   int diskWordSize = 8;
   float version;
 
-  if ( (exoid = ex_open( fname, EX_READ, &appWordSize, &diskWordSize, &version )) < 0 )
+  if ( (exoid = VTK_EXO_LOCKED( ex_open( fname, EX_READ, &appWordSize, &diskWordSize, &version ) )) < 0 )
     {
     return 0;
     }
-  if ( ex_close( exoid ) != 0 )
+  if ( VTK_EXO_LOCKED( ex_close( exoid ) ) != 0 )
     {
     vtkWarningMacro( "Unable to close \"" << fname << "\" opened for testing." );
     return 0;
@@ -6079,6 +6310,36 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+void vtkExodusIIReader::SetPrefetchTimeSteps(int n)
+{
+  this->Metadata->SetPrefetchTimeSteps(n);
+}
+
+int vtkExodusIIReader::GetPrefetchTimeSteps()
+{
+  return this->Metadata->GetPrefetchTimeSteps();
+}
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheHits()
+{
+  return this->Metadata->GetCacheHits();
+}
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheMisses()
+{
+  return this->Metadata->GetCacheMisses();
+}
+
+void vtkExodusIIReader::ResetCacheStatistics()
+{
+  this->Metadata->ResetCacheStatistics();
+}
+
+void vtkExodusIIReader::WaitForPrefetch()
+{
+  this->Metadata->WaitForPrefetch();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
@@ -658,6 +658,39 @@ public:
   // Get the size of the cache in MiB.
   double GetCacheSize();
 
+  // Description:
+  // Set the number of time steps after the current one to read into the
+  // cache on a background thread once RequestData has finished, so that
+  // stepping forward through time finds its arrays already loaded. Only
+  // the arrays of the current time step are read, and no more steps than
+  // the cache can hold along with the current one. The thread stops after
+  // the array it is reading at the next update or change of settings.
+  // The ExodusII and netCDF libraries are not thread safe, even on
+  // different files. The ExodusII readers and vtkExodusIIWriter share a
+  // lock with the prefetch thread, but the readers and writers that call
+  // netCDF directly (vtkNetCDFReader, vtkNetCDFCFReader,
+  // vtkNetCDFPOPReader, vtkNetCDFCAMReader, vtkSLACReader,
+  // vtkSLACParticleReader, vtkMPASReader, vtkPNetCDFPOPReader,
+  // vtkMINCImageReader and vtkMINCImageWriter) do not: they must not
+  // update while a prefetch is active. Call WaitForPrefetch() or
+  // SetPrefetchTimeSteps(0) before updating them. The default is 0, which
+  // disables prefetching.
+  void SetPrefetchTimeSteps(int n);
+  int GetPrefetchTimeSteps();
+
+  // Description:
+  // Wait until the background thread has read all the time steps to
+  // prefetch. This is mostly useful for testing.
+  void WaitForPrefetch();
+
+  // Description:
+  // Get the number of arrays that the reader found in the cache and the
+  // number that it read from the file since the file was opened or the
+  // statistics were reset. The arrays read ahead are not counted.
+  vtkIdType GetNumberOfCacheHits();
+  vtkIdType GetNumberOfCacheMisses();
+  void ResetCacheStatistics();
+
   // Description:
   // Should the reader output only points used by elements in the output mesh,
   // or all the points. Outputting all the points is much faster since the
@@ -9,11 +9,14 @@
 #include "vtksys/RegularExpression.hxx"
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include "vtk_exodusII.h"
 #include "vtkIOExodusModule.h" // For export macro
 class vtkExodusIIReaderParser;
+class vtkMultiThreader;
+class vtkMutexLock;
 class vtkMutableDirectedGraph;
 
 /** This class holds metadata for an Exodus file.
@@ -77,6 +80,43 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Set the number of time steps after the one of the last RequestData()
+    * whose arrays are read into the cache by a background thread.
+    * Zero (the default) disables prefetching.
+    */
+  void SetPrefetchTimeSteps( int n );
+
+  /// Get the number of time steps read ahead into the cache.
+  vtkGetMacro(PrefetchTimeSteps, int);
+
+  /** Return the number of arrays that RequestData() found in the cache
+    * and the number that it read from the file. Arrays that are not in
+    * the file are not counted.
+    */
+  vtkGetMacro(CacheHits, vtkIdType);
+  vtkGetMacro(CacheMisses, vtkIdType);
+
+  /// Set the cache hit and miss counts back to zero.
+  void ResetCacheStatistics();
+
+  /** Start reading the time-dependent arrays of the last RequestData() for
+    * the time steps after \a timeStep into the cache on a background thread.
+    * The number of time steps is limited so that they fit in the cache along
+    * with the arrays of \a timeStep.
+    */
+  void StartPrefetch( int timeStep );
+
+  /** Wait for the prefetch thread to finish the array it is reading and
+    * stop. This must be called before the file or the cache is used.
+    */
+  void StopPrefetch();
+
+  /// Wait for the prefetch thread to read all its time steps.
+  void WaitForPrefetch();
+
+  /// The body of the prefetch thread.
+  void Prefetch();
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -601,6 +641,12 @@ protected:
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
+  /** Remember the size of an array returned by GetCacheOrRead() if it
+    * depends on the time step, so that StartPrefetch() reads it again for
+    * the following time steps.
+    */
+  void AddTimeStepArray( const vtkExodusIICacheKey& key, vtkDataArray* arr );
+
   /** Return the index of an object type (in a private list of all object types).
     * This returns a 0-based index if the object type was found and -1 if it
     * was not.
@@ -789,6 +835,40 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// The number of time steps read ahead into the cache.
+  int PrefetchTimeSteps;
+
+  /// The number of arrays found in the cache and read from the file.
+  vtkIdType CacheHits;
+  vtkIdType CacheMisses;
+
+  /** The time-dependent arrays read by the last RequestData() and their
+    * sizes in MiB. These are the arrays that get prefetched.
+    */
+  std::map<vtkExodusIICacheKey,double> TimeStepArrays;
+
+  /// The thread that reads the following time steps into the cache.
+  vtkMultiThreader* PrefetchThreader;
+  int PrefetchThreadId;
+
+  /// Set by StopPrefetch() to make the thread stop after its current array.
+  vtkMutexLock* PrefetchLock;
+  int PrefetchAbort;
+
+  /// The time steps that the prefetch thread reads, and from which file.
+  int PrefetchRange[2];
+  std::string PrefetchFileName;
+
+  /** Nonzero while the prefetch thread is running, so that its lookups
+    * are not counted and not recorded in TimeStepArrays.
+    */
+  int Prefetching;
+
+  /** The first error of the prefetch thread. The thread must not call
+    * observers or the output window, so RequestData() reports it.
+    */
+  std::string PrefetchError;
+
   int ApplyDisplacements;
   float DisplacementMagnitude;
   int HasModeShapes;
@@ -19,6 +19,7 @@
 ----------------------------------------------------------------------------*/
 
 #include "vtkExodusIIWriter.h"
+#include "vtkExodusIILibraryGuard.h"
 #include "vtkObjectFactory.h"
 #include "vtkModelMetadata.h"
 #include "vtkInformation.h"
@@ -514,7 +515,7 @@ int vtkExodusIIWriter::CreateNewExodusFile()
     {
     if (this->CurrentTimeIndex == 0)
       {
-      this->fid = ex_create(this->FileName, EX_CLOBBER, &compWordSize, &IOWordSize);
+      this->fid = VTK_EXO_LOCKED( ex_create(this->FileName, EX_CLOBBER, &compWordSize, &IOWordSize) );
       if (fid <= 0)
         {
         vtkErrorMacro (
@@ -526,7 +527,7 @@ int vtkExodusIIWriter::CreateNewExodusFile()
       {
       char *myFileName = new char [1024];
       sprintf(myFileName, "%s_%06d", this->FileName, this->CurrentTimeIndex);
-      this->fid = ex_create(myFileName, EX_CLOBBER, &compWordSize, &IOWordSize);
+      this->fid = VTK_EXO_LOCKED( ex_create(myFileName, EX_CLOBBER, &compWordSize, &IOWordSize) );
       if (fid <= 0)
         {
         vtkErrorMacro (
@@ -548,7 +549,7 @@ int vtkExodusIIWriter::CreateNewExodusFile()
       sprintf(myFileName, "%s_%06d.%d.%d",
           this->FileName, this->CurrentTimeIndex, this->NumberOfProcesses, this->MyRank);
       }
-    this->fid = ex_create(myFileName, EX_CLOBBER, &compWordSize, &IOWordSize);
+    this->fid = VTK_EXO_LOCKED( ex_create(myFileName, EX_CLOBBER, &compWordSize, &IOWordSize) );
     if (fid <= 0)
       {
       vtkErrorMacro (
@@ -570,7 +571,7 @@ void vtkExodusIIWriter::CloseExodusFile()
 {
   if (this->fid >= 0)
     {
-    ex_close(this->fid);
+    VTK_EXO_LOCKED( ex_close(this->fid) );
     this->fid = -1;
     return;
     }
@@ -1426,8 +1427,8 @@ int vtkExodusIIWriter::WriteInitializationParameters()
   int nssets = em->GetNumberOfSideSets();
   const char *title = em->GetTitle();
   int numBlocks = em->GetNumberOfBlocks();
-  int rc = ex_put_init(this->fid, title, dim, this->NumPoints, this->NumCells,
-                       numBlocks, nnsets, nssets);
+  int rc = VTK_EXO_LOCKED( ex_put_init(this->fid, title, dim, this->NumPoints, this->NumCells,
+                                       numBlocks, nnsets, nssets) );
   return rc >= 0;
 }
 
@@ -1445,7 +1446,7 @@ int vtkExodusIIWriter::WriteInformationRecords()
 
     em->GetInformationLines(&lines);
 
-    ex_put_info(this->fid, nlines, lines);
+    VTK_EXO_LOCKED( ex_put_info(this->fid, nlines, lines) );
     }
 
   return 1;
@@ -1478,7 +1479,7 @@ int vtkExodusIIWriterWritePoints (
         }
       }
 
-    int rc = ex_put_coord(fid, px, py, pz);
+    int rc = VTK_EXO_LOCKED( ex_put_coord(fid, px, py, pz) );
 
     delete [] px;
     delete [] py;
@@ -1509,7 +1510,7 @@ int vtkExodusIIWriter::WriteCoordinateNames()
 {
   vtkModelMetadata *em = this->GetModelMetadata();
 
-  int rc = ex_put_coord_names(this->fid, em->GetCoordinateNames());
+  int rc = VTK_EXO_LOCKED( ex_put_coord_names(this->fid, em->GetCoordinateNames()) );
 
   return rc >= 0;
 }
@@ -1543,7 +1544,7 @@ int vtkExodusIIWriter::WriteGlobalPointIds()
         }
       }
     }
-  int rc = ex_put_node_num_map(this->fid, copyOfIds);
+  int rc = VTK_EXO_LOCKED( ex_put_node_num_map(this->fid, copyOfIds) );
   delete [] copyOfIds;
 
   return rc >= 0;
@@ -1703,19 +1704,19 @@ int vtkExodusIIWriter::WriteBlockInformation()
       int numElts = blockIter->second.NumElements;
       int numPoints = blockIter->second.EntityNodeOffsets[numElts - 1]
                     + blockIter->second.EntityCounts[numElts - 1];
-      rc = ex_put_elem_block(this->fid, blockIter->first,
-                  name,
-                  blockIter->second.NumElements,
-                  numPoints,
-                  blockIter->second.NumAttributes);
+      rc = VTK_EXO_LOCKED( ex_put_elem_block(this->fid, blockIter->first,
+                                  name,
+                                  blockIter->second.NumElements,
+                                  numPoints,
+                                  blockIter->second.NumAttributes) );
       }
     else
       {
-      rc = ex_put_elem_block(this->fid, blockIter->first,
-                  name,
-                  blockIter->second.NumElements,
-                  blockIter->second.NodesPerElement,
-                  blockIter->second.NumAttributes);
+      rc = VTK_EXO_LOCKED( ex_put_elem_block(this->fid, blockIter->first,
+                                  name,
+                                  blockIter->second.NumElements,
+                                  blockIter->second.NodesPerElement,
+                                  blockIter->second.NumAttributes) );
       }
     delete [] name;
     if (rc < 0)
@@ -1726,8 +1727,8 @@ int vtkExodusIIWriter::WriteBlockInformation()
 
     if (blockIter->second.NumElements > 0)
       {
-      rc = ex_put_elem_conn(this->fid, blockIter->first,
-                      connectivity[blockIter->second.OutputIndex]);
+      rc = VTK_EXO_LOCKED( ex_put_elem_conn(this->fid, blockIter->first,
+                                      connectivity[blockIter->second.OutputIndex]) );
 
       if (rc < 0)
         {
@@ -1739,15 +1740,15 @@ int vtkExodusIIWriter::WriteBlockInformation()
         {
         if (this->PassDoubles)
           {
-          rc = ex_put_elem_attr(this->fid, blockIter->first,
-                          attributesD[blockIter->second.OutputIndex]);
+          rc = VTK_EXO_LOCKED( ex_put_elem_attr(this->fid, blockIter->first,
+                                          attributesD[blockIter->second.OutputIndex]) );
           }
         else
           {
           // TODO verify the assumption that ModelMetadata stores
           // elements in the same order we do
-          rc = ex_put_elem_attr(this->fid, blockIter->first,
-                            blockIter->second.BlockAttributes);
+          rc = VTK_EXO_LOCKED( ex_put_elem_attr(this->fid, blockIter->first,
+                                            blockIter->second.BlockAttributes) );
           }
 
         if (rc < 0)
@@ -1758,8 +1759,8 @@ int vtkExodusIIWriter::WriteBlockInformation()
 
       if (blockIter->second.NodesPerElement == 0)
         {
-        rc = ex_put_entity_count_per_polyhedra (this->fid, EX_ELEM_BLOCK,
-                     blockIter->first, &(blockIter->second.EntityCounts[0]));
+        rc = VTK_EXO_LOCKED( ex_put_entity_count_per_polyhedra (this->fid, EX_ELEM_BLOCK,
+                                     blockIter->first, &(blockIter->second.EntityCounts[0])) );
         }
       }
     }
@@ -1808,7 +1809,7 @@ int vtkExodusIIWriter::WriteGlobalElementIds()
           }
         }
       }
-    rc = ex_put_elem_num_map(this->fid, copyOfIds);
+    rc = VTK_EXO_LOCKED( ex_put_elem_num_map(this->fid, copyOfIds) );
     delete [] copyOfIds;
     }
 
@@ -1841,7 +1842,7 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
         }
       }
 
-    rc = ex_put_var_param(this->fid, "G", this->NumberOfScalarGlobalArrays);
+    rc = VTK_EXO_LOCKED( ex_put_var_param(this->fid, "G", this->NumberOfScalarGlobalArrays) );
     if (rc < 0)
       {
       vtkErrorMacro(<<
@@ -1849,8 +1850,8 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
       return 0;
       }
 
-    rc = ex_put_var_names(this->fid, "G", this->NumberOfScalarGlobalArrays,
-                          (char **)outputArrayNames);
+    rc = VTK_EXO_LOCKED( ex_put_var_names(this->fid, "G", this->NumberOfScalarGlobalArrays,
+                                          (char **)outputArrayNames) );
                           // This should be treating this read only... hopefully
     if (rc < 0)
       {
@@ -1879,7 +1880,7 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
         }
       }
 
-    rc = ex_put_var_param(this->fid, "E", this->NumberOfScalarElementArrays);
+    rc = VTK_EXO_LOCKED( ex_put_var_param(this->fid, "E", this->NumberOfScalarElementArrays) );
     if (rc < 0)
       {
       vtkErrorMacro(<<
@@ -1887,8 +1888,8 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
       return 0;
       }
 
-    rc = ex_put_var_names(this->fid, "E", this->NumberOfScalarElementArrays,
-                          (char **)outputArrayNames);
+    rc = VTK_EXO_LOCKED( ex_put_var_names(this->fid, "E", this->NumberOfScalarElementArrays,
+                                          (char **)outputArrayNames) );
                           // This should be treating this read only... hopefully
     if (rc < 0)
       {
@@ -1897,10 +1898,10 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
       return 0;
       }
 
-    rc = ex_put_elem_var_tab(this->fid,
-                             static_cast<int>(this->BlockInfoMap.size ()),
-                             this->NumberOfScalarElementArrays,
-                             this->BlockElementVariableTruthTable);
+    rc = VTK_EXO_LOCKED( ex_put_elem_var_tab(this->fid,
+                                             static_cast<int>(this->BlockInfoMap.size ()),
+                                             this->NumberOfScalarElementArrays,
+                                             this->BlockElementVariableTruthTable) );
     if (rc < 0)
       {
       vtkErrorMacro(<<
@@ -1936,7 +1937,7 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
         }
       }
 
-    rc = ex_put_var_param(this->fid, "N", this->NumberOfScalarNodeArrays);
+    rc = VTK_EXO_LOCKED( ex_put_var_param(this->fid, "N", this->NumberOfScalarNodeArrays) );
 
     if (rc < 0)
       {
@@ -1946,8 +1947,8 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
       return 0;
       }
 
-    rc = ex_put_var_names(this->fid, "N", this->NumberOfScalarNodeArrays,
-                          (char **)outputArrayNames);
+    rc = VTK_EXO_LOCKED( ex_put_var_names(this->fid, "N", this->NumberOfScalarNodeArrays,
+                                          (char **)outputArrayNames) );
                           // This should not save references... hopefully
     if (rc < 0)
       {
@@ -1968,11 +1969,11 @@ int vtkExodusIIWriter::WriteVariableArrayNames()
     {
     char **names = mmd->GetGlobalVariableNames();
 
-    rc = ex_put_var_param(this->fid, "G", ngvars);
+    rc = VTK_EXO_LOCKED( ex_put_var_param(this->fid, "G", ngvars) );
 
     if (rc == 0)
       {
-      rc = ex_put_var_names(this->fid, "G", ngvars, names);
+      rc = VTK_EXO_LOCKED( ex_put_var_names(this->fid, "G", ngvars, names) );
       }
 
     if (rc < 0)
@@ -2203,8 +2204,8 @@ int vtkExodusIIWriter::WriteNodeSetInformation()
 
     memset(buf, 0, sizeof(int) * nnsets);
 
-    rc = ex_put_concat_node_sets(this->fid, em->GetNodeSetIds(),
-              buf, buf, buf, buf, NULL, NULL);
+    rc = VTK_EXO_LOCKED( ex_put_concat_node_sets(this->fid, em->GetNodeSetIds(),
+                              buf, buf, buf, buf, NULL, NULL) );
 
     delete [] buf;
 
@@ -2283,13 +2284,13 @@ int vtkExodusIIWriter::WriteNodeSetInformation()
 
   if (this->PassDoubles)
     {
-    rc = ex_put_concat_node_sets(this->fid, em->GetNodeSetIds(),
-              nsSize, nsNumDF, nsIdIdx, nsDFIdx, idBuf, dfBufD);
+    rc = VTK_EXO_LOCKED( ex_put_concat_node_sets(this->fid, em->GetNodeSetIds(),
+                              nsSize, nsNumDF, nsIdIdx, nsDFIdx, idBuf, dfBufD) );
     }
   else
     {
-    rc = ex_put_concat_node_sets(this->fid, em->GetNodeSetIds(),
-              nsSize, nsNumDF, nsIdIdx, nsDFIdx, idBuf, dfBuf);
+    rc = VTK_EXO_LOCKED( ex_put_concat_node_sets(this->fid, em->GetNodeSetIds(),
+                              nsSize, nsNumDF, nsIdIdx, nsDFIdx, idBuf, dfBuf) );
     }
 
   delete [] nsSize;
@@ -2363,8 +2364,8 @@ int vtkExodusIIWriter::WriteSideSetInformation()
 
     memset(buf, 0, sizeof(int) * nssets);
 
-    rc = ex_put_concat_side_sets(this->fid, em->GetSideSetIds(),
-              buf, buf, buf, buf, NULL, NULL, NULL);
+    rc = VTK_EXO_LOCKED( ex_put_concat_side_sets(this->fid, em->GetSideSetIds(),
+                              buf, buf, buf, buf, NULL, NULL, NULL) );
 
     delete [] buf;
 
@@ -2466,13 +2467,13 @@ int vtkExodusIIWriter::WriteSideSetInformation()
 
   if (this->PassDoubles)
     {
-    rc = ex_put_concat_side_sets(this->fid, em->GetSideSetIds(),
-            ssSize, ssNumDF, ssIdIdx, ssDFIdx, idBuf, sideBuf, dfBufD);
+    rc = VTK_EXO_LOCKED( ex_put_concat_side_sets(this->fid, em->GetSideSetIds(),
+                            ssSize, ssNumDF, ssIdIdx, ssDFIdx, idBuf, sideBuf, dfBufD) );
     }
   else
     {
-    rc = ex_put_concat_side_sets(this->fid, em->GetSideSetIds(),
-            ssSize, ssNumDF, ssIdIdx, ssDFIdx, idBuf, sideBuf, dfBuf);
+    rc = VTK_EXO_LOCKED( ex_put_concat_side_sets(this->fid, em->GetSideSetIds(),
+                            ssSize, ssNumDF, ssIdIdx, ssDFIdx, idBuf, sideBuf, dfBuf) );
     }
 
   delete [] ssSize;
@@ -2550,7 +2551,7 @@ int vtkExodusIIWriter::WriteProperties()
 
       for (i=0; i<nbprop; i++)
         {
-        rc = ex_put_prop_array(this->fid, EX_ELEM_BLOCK, names[i], values);
+        rc = VTK_EXO_LOCKED( ex_put_prop_array(this->fid, EX_ELEM_BLOCK, names[i], values) );
         if (rc) break;
         // TODO Handle the addition of Blocks not known by the metadata
         values += this->BlockInfoMap.size ();
@@ -2571,7 +2572,7 @@ int vtkExodusIIWriter::WriteProperties()
 
       for (i=0; i<nnsprop; i++)
         {
-        rc = ex_put_prop_array(this->fid, EX_NODE_SET, names[i], values);
+        rc = VTK_EXO_LOCKED( ex_put_prop_array(this->fid, EX_NODE_SET, names[i], values) );
         if (rc) break;
         values += nnsets;
         }
@@ -2591,7 +2592,7 @@ int vtkExodusIIWriter::WriteProperties()
 
       for (i=0; i<nssprop; i++)
         {
-        rc = ex_put_prop_array(this->fid, EX_SIDE_SET, names[i], values);
+        rc = VTK_EXO_LOCKED( ex_put_prop_array(this->fid, EX_SIDE_SET, names[i], values) );
         if (rc) break;
         values += nssets;
         }
@@ -2755,14 +2756,14 @@ int vtkExodusIIWriter::WriteGlobalData (int timestep, vtkDataArray *buffer)
   if (buffer->IsA ("vtkDoubleArray"))
     {
     vtkDoubleArray *da = vtkDoubleArray::SafeDownCast (buffer);
-    rc = ex_put_glob_vars (this->fid, timestep + 1,
-                  this->NumberOfScalarGlobalArrays, da->GetPointer (0));
+    rc = VTK_EXO_LOCKED( ex_put_glob_vars (this->fid, timestep + 1,
+                                  this->NumberOfScalarGlobalArrays, da->GetPointer (0)) );
     }
   else /* (buffer->IsA ("vtkFloatArray")) */
     {
     vtkFloatArray *fa = vtkFloatArray::SafeDownCast (buffer);
-    rc = ex_put_glob_vars (this->fid, timestep + 1,
-                  this->NumberOfScalarGlobalArrays, fa->GetPointer (0));
+    rc = VTK_EXO_LOCKED( ex_put_glob_vars (this->fid, timestep + 1,
+                                  this->NumberOfScalarGlobalArrays, fa->GetPointer (0)) );
     }
   if (rc < 0)
     {
@@ -2808,14 +2809,14 @@ int vtkExodusIIWriter::WriteCellData (int timestep, vtkDataArray *buffer)
         if (buffer->IsA ("vtkDoubleArray"))
           {
           vtkDoubleArray *da = vtkDoubleArray::SafeDownCast (buffer);
-          rc = ex_put_elem_var(this->fid, timestep + 1, varOutIndex + 1, id,
-                                   numElts, da->GetPointer(start));
+          rc = VTK_EXO_LOCKED( ex_put_elem_var(this->fid, timestep + 1, varOutIndex + 1, id,
+                                                   numElts, da->GetPointer(start)) );
           }
         else /* (buffer->IsA ("vtkFloatArray")) */
           {
           vtkFloatArray *fa = vtkFloatArray::SafeDownCast (buffer);
-          rc = ex_put_elem_var(this->fid, timestep + 1, varOutIndex + 1, id,
-                                   numElts, fa->GetPointer(start));
+          rc = VTK_EXO_LOCKED( ex_put_elem_var(this->fid, timestep + 1, varOutIndex + 1, id,
+                                                   numElts, fa->GetPointer(start)) );
           }
 
         if (rc < 0)
@@ -2852,14 +2853,14 @@ int vtkExodusIIWriter::WritePointData (int timestep, vtkDataArray *buffer)
       if (buffer->IsA ("vtkDoubleArray"))
         {
         vtkDoubleArray *da = vtkDoubleArray::SafeDownCast (buffer);
-        rc = ex_put_nodal_var(this->fid, timestep + 1, varOutIndex + 1,
-                                  this->NumPoints, da->GetPointer (0));
+        rc = VTK_EXO_LOCKED( ex_put_nodal_var(this->fid, timestep + 1, varOutIndex + 1,
+                                                  this->NumPoints, da->GetPointer (0)) );
         }
       else /* (buffer->IsA ("vtkFloatArray")) */
         {
         vtkFloatArray *fa = vtkFloatArray::SafeDownCast (buffer);
-        rc = ex_put_nodal_var(this->fid, timestep + 1, varOutIndex + 1,
-                                  this->NumPoints, fa->GetPointer (0));
+        rc = VTK_EXO_LOCKED( ex_put_nodal_var(this->fid, timestep + 1, varOutIndex + 1,
+                                                  this->NumPoints, fa->GetPointer (0)) );
         }
 
       if (rc < 0)
@@ -2886,7 +2887,7 @@ int vtkExodusIIWriter::WriteNextTimeStep()
   if (this->PassDoubles)
     {
     double dtsv = (double)tsv;
-    rc = ex_put_time(this->fid, ts + 1, &dtsv);
+    rc = VTK_EXO_LOCKED( ex_put_time(this->fid, ts + 1, &dtsv) );
     if (rc < 0)
       {
       vtkErrorMacro(<< "vtkExodusIIWriter::WriteNextTimeStep time step values"
@@ -2897,7 +2898,7 @@ int vtkExodusIIWriter::WriteNextTimeStep()
     }
   else
     {
-    rc = ex_put_time(this->fid, ts + 1, &tsv);
+    rc = VTK_EXO_LOCKED( ex_put_time(this->fid, ts + 1, &tsv) );
     if (rc < 0)
       {
       vtkErrorMacro(<< "vtkExodusIIWriter::WriteNextTimeStep time step values"
@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBJReaderMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads OBJ files large enough to be parsed in several chunks, with and
+// without memory mapping, and checks that the outputs are the same.  The
+// files have all the kinds of faces, continuation lines and comments, and
+// their normals either match their points or the points are duplicated.
+// The errors must also be reported at the same line.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+const int NumberOfFaces = 30000;
+
+// Write a file where the faces use vertex i/tcoord i/normal n, with n = i
+// unless duplicate is set.  error is the face with an error, if any.
+void WriteFile(const std::string& fileName, bool duplicate, int error)
+{
+  FILE* fp = fopen(fileName.c_str(), "wb");
+  fprintf(fp, "# a comment\r\n");
+  for (int i = 0; i < NumberOfFaces + 2; ++i)
+    {
+    fprintf(fp, "v %g %.9g %d%s", i*0.1, i/7.0, -i, (i % 3 ? "\n" : "\r\n"));
+    fprintf(fp, "vt %g\t%g\n", i*0.5, 1.0 - i*0.25);
+    fprintf(fp, "vn 0 0 %d\n", (i % 2 ? 1 : -1));
+    }
+  for (int i = 0; i < NumberOfFaces; ++i)
+    {
+    int n = (duplicate ? (i*13) % NumberOfFaces + 1 : i + 1);
+    switch (i % 7)
+      {
+      case 0:
+        fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", i + 1, i + 1, n,
+                i + 2, i + 2, n + 1, i + 3, i + 3, n + 2);
+        break;
+      case 1:
+        // a face on two lines
+        fprintf(fp, "f %d//%d %d//%d \\\n %d//%d\n", i + 1, n, i + 2,
+                n + 1, i + 3, n + 2);
+        break;
+      case 2:
+        fprintf(fp, "  f %d/%d %d/%d %d/%d %d/%d\n", i + 1, i + 1, i + 2,
+                i + 2, i + 3, i + 3, i + 3, i + 3);
+        break;
+      case 3:
+        fprintf(fp, "f %d %d %d\n", i + 1, i + 2, i + 3);
+        break;
+      case 4:
+        fprintf(fp, "l %d/%d %d\np %d\n", i + 1, i + 1, i + 2, i + 3);
+        break;
+      case 5:
+        fprintf(fp, "\n#f 1 2\ng group\nusemtl %d\n", i);
+        break;
+      default:
+        fprintf(fp, "p %d %d %d %d\n", i + 1, i + 2, i + 3, i + 1);
+        break;
+      }
+    if (i == error)
+      {
+      fprintf(fp, "f 1 2\n");
+      }
+    }
+  // no newline at the end
+  fprintf(fp, "l 1 2");
+  fclose(fp);
+}
+
+vtkSmartPointer<vtkPolyData> Read(const std::string& fileName, bool mapped,
+                                  std::string& error)
+{
+  vtkNew<vtkOBJReader> reader;
+  vtkNew<vtkTest::ErrorObserver> observer;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapFile(mapped);
+  reader->AddObserver(vtkCommand::ErrorEvent, observer.GetPointer());
+  reader->Update();
+  error.clear();
+  if (observer->GetError())
+    {
+    // remove the address of the reader
+    error = observer->GetErrorMessage();
+    error = error.substr(error.rfind("): ") + 3);
+    }
+  return reader->GetOutput();
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* output,
+                   const char* name)
+{
+  if (!expected && !output)
+    {
+    return true;
+    }
+  bool same = (expected && output &&
+               expected->GetNumberOfTuples() == output->GetNumberOfTuples() &&
+               expected->GetNumberOfComponents() ==
+               output->GetNumberOfComponents() &&
+               expected->GetDataType() == output->GetDataType());
+  for (vtkIdType i = 0; same && i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < expected->GetNumberOfComponents(); ++j)
+      {
+      same &= (expected->GetComponent(i, j) == output->GetComponent(i, j));
+      }
+    }
+  if (!same)
+    {
+    cerr << "Error: the " << name << " are different" << endl;
+    }
+  return same;
+}
+
+bool Compare(vtkPolyData* expected, vtkPolyData* output)
+{
+  vtkCellArray* expectedCells[3] = {
+    expected->GetVerts(), expected->GetLines(), expected->GetPolys() };
+  vtkCellArray* outputCells[3] = {
+    output->GetVerts(), output->GetLines(), output->GetPolys() };
+  bool same = CompareArrays(expected->GetPoints()->GetData(),
+                            output->GetPoints()->GetData(), "points");
+  for (int i = 0; i < 3; ++i)
+    {
+    // the verts and lines are dropped when points are duplicated
+    same = same &&
+      expectedCells[i]->GetNumberOfCells() ==
+      outputCells[i]->GetNumberOfCells() &&
+      (expectedCells[i]->GetNumberOfCells() > 0 || i < 2) &&
+      CompareArrays(expectedCells[i]->GetData(), outputCells[i]->GetData(),
+                    "cells");
+    }
+  return same &&
+    CompareArrays(expected->GetPointData()->GetTCoords(),
+                  output->GetPointData()->GetTCoords(), "tcoords") &&
+    CompareArrays(expected->GetPointData()->GetNormals(),
+                  output->GetPointData()->GetNormals(), "normals");
+}
+}
+
+int TestOBJReaderMemoryMap(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestOBJReaderMemoryMap.obj";
+  delete [] tempDir;
+
+  std::string expectedError, error;
+  for (int duplicate = 0; duplicate < 2; ++duplicate)
+    {
+    WriteFile(fileName, duplicate != 0, -1);
+    vtkSmartPointer<vtkPolyData> expected =
+      Read(fileName, false, expectedError);
+    vtkSmartPointer<vtkPolyData> output = Read(fileName, true, error);
+    if (!expectedError.empty() || !error.empty() ||
+        !Compare(expected, output))
+      {
+      cerr << "Error: the outputs are different with "
+           << (duplicate ? "duplicated" : "the same") << " points" << endl;
+      return EXIT_FAILURE;
+      }
+    if (duplicate != (expected->GetNumberOfPoints() != NumberOfFaces + 2))
+      {
+      cerr << "Error: wrong number of points" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // errors in the last chunk and in one of the first
+  for (int errorFace = NumberOfFaces - 3; errorFace > 0; errorFace /= 4)
+    {
+    WriteFile(fileName, false, errorFace);
+    Read(fileName, false, expectedError);
+    Read(fileName, true, error);
+    if (expectedError.empty() || error != expectedError)
+      {
+      cerr << "Error: \"" << error << "\" instead of \"" << expectedError
+           << "\"" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
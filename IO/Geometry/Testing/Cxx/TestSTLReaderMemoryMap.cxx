@@ -0,0 +1,188 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads a binary STL file with and without memory mapping, with merging
+// on and off and with a locator, and checks that the points and the
+// triangles are the same.  The facets of a grid are shuffled, some are
+// degenerate and some vertices are written as -0 instead of 0.
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int GridSize = 71;
+
+void WriteFloat(FILE* fp, float f)
+{
+  vtkByteSwap::Swap4LE(&f);
+  fwrite(&f, 4, 1, fp);
+}
+
+// Write the facets of a grid in a shuffled order, plus bytes that do not
+// make a whole facet.
+void WriteFile(const std::string& fileName, int extraBytes)
+{
+  FILE* fp = fopen(fileName.c_str(), "wb");
+  char header[80];
+  memset(header, ' ', 80);
+  fwrite(header, 1, 80, fp);
+  int numCells = (GridSize - 1)*(GridSize - 1);
+  // the count is wrong on purpose, it is ignored
+  unsigned int count = 12;
+  vtkByteSwap::Swap4LE(&count);
+  fwrite(&count, 4, 1, fp);
+  for (int c = 0; c < 2*numCells; ++c)
+    {
+    int k = static_cast<int>((static_cast<long>(c)*7919) % (2*numCells));
+    int i = (k/2) % (GridSize - 1);
+    int j = (k/2) / (GridSize - 1);
+    int corners[2][3][2] = {
+      { { 0, 0 }, { 1, 0 }, { 1, 1 } }, { { 0, 0 }, { 1, 1 }, { 0, 1 } } };
+    for (int n = 0; n < 3; ++n)
+      {
+      WriteFloat(fp, 0.0f);
+      }
+    for (int v = 0; v < 3; ++v)
+      {
+      // some triangles collapse to an edge
+      int w = (k % 37 == 0 && v == 2 ? 1 : v);
+      int x = i + corners[k % 2][w][0];
+      int y = j + corners[k % 2][w][1];
+      WriteFloat(fp, (x == 0 && c % 3 == 0 ? -0.0f : 0.25f*x));
+      WriteFloat(fp, 0.5f*y - 7.0f);
+      WriteFloat(fp, static_cast<float>((x*y) % 5));
+      }
+    unsigned short attribute = 0;
+    fwrite(&attribute, 2, 1, fp);
+    }
+  fwrite(header, 1, extraBytes, fp);
+  fclose(fp);
+}
+
+vtkSmartPointer<vtkPolyData> Read(const std::string& fileName, bool mapped,
+                                  bool merging, bool locator,
+                                  vtkTest::ErrorObserver* observer)
+{
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapBinaryFile(mapped);
+  reader->SetMerging(merging);
+  if (locator)
+    {
+    vtkNew<vtkMergePoints> mergePoints;
+    reader->SetLocator(mergePoints.GetPointer());
+    }
+  reader->AddObserver(vtkCommand::ErrorEvent, observer);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool Compare(vtkPolyData* expected, vtkPolyData* output)
+{
+  vtkIdType numPoints = expected->GetNumberOfPoints();
+  vtkIdType numPolys = expected->GetNumberOfPolys();
+  if (output->GetNumberOfPoints() != numPoints ||
+      output->GetNumberOfPolys() != numPolys || numPolys == 0)
+    {
+    cerr << "Error: " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfPolys() << " triangles instead of "
+         << numPoints << " and " << numPolys << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    double p[3], q[3];
+    expected->GetPoint(i, p);
+    output->GetPoint(i, q);
+    // compare the bits, to tell -0 from 0
+    if (memcmp(p, q, sizeof(p)) != 0)
+      {
+      cerr << "Error: point " << i << " is " << q[0] << " " << q[1] << " "
+           << q[2] << " instead of " << p[0] << " " << p[1] << " " << p[2]
+           << endl;
+      return false;
+      }
+    }
+  vtkIdType npts, *pts, mnpts, *mpts;
+  vtkCellArray* polys = expected->GetPolys();
+  vtkCellArray* mpolys = output->GetPolys();
+  polys->InitTraversal();
+  mpolys->InitTraversal();
+  for (vtkIdType i = 0; i < numPolys; ++i)
+    {
+    polys->GetNextCell(npts, pts);
+    mpolys->GetNextCell(mnpts, mpts);
+    if (mnpts != 3 || npts != 3 || mpts[0] != pts[0] || mpts[1] != pts[1] ||
+        mpts[2] != pts[2])
+      {
+      cerr << "Error: wrong triangle " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestSTLReaderMemoryMap(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestSTLReaderMemoryMap.stl";
+  delete [] tempDir;
+
+  vtkNew<vtkTest::ErrorObserver> observer;
+  bool ok = true;
+  for (int extra = 0; extra < 48 && ok; extra += 47)
+    {
+    WriteFile(fileName, extra);
+    for (int merging = 0; merging < 2 && ok; ++merging)
+      {
+      vtkSmartPointer<vtkPolyData> expected =
+        Read(fileName, false, merging != 0, false, observer.GetPointer());
+      vtkSmartPointer<vtkPolyData> mapped =
+        Read(fileName, true, merging != 0, false, observer.GetPointer());
+      vtkSmartPointer<vtkPolyData> located =
+        Read(fileName, true, merging != 0, true, observer.GetPointer());
+      ok = (!observer->GetError() &&
+            Compare(expected, mapped) && Compare(expected, located));
+      }
+    }
+
+  // a facet without its attribute byte count is an error
+  WriteFile(fileName, 48);
+  vtkSmartPointer<vtkPolyData> output =
+    Read(fileName, true, true, false, observer.GetPointer());
+  if (!observer->GetError() || output->GetNumberOfPoints() != 0)
+    {
+    cerr << "Error: a truncated facet was read" << endl;
+    ok = false;
+    }
+
+  return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
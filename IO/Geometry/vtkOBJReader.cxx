@@ -17,11 +17,18 @@
 #include "vtkCellArray.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
 #include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkOBJReader);
 
@@ -30,6 +37,7 @@ vtkStandardNewMacro(vtkOBJReader);
 vtkOBJReader::vtkOBJReader()
 {
   this->FileName = NULL;
+  this->MemoryMapFile = 0;
 
   this->SetNumberOfInputPorts(0);
 }
@@ -100,6 +108,406 @@ p <v_a> <v_b> ...
 
 \*---------------------------------------------------------------------------*/
 
+// Files are parsed in parallel in chunks of about this many bytes.
+#define VTK_OBJ_CHUNK_SIZE (1 << 20)
+
+// The lines of a chunk of a mapped file and what they define.  The cells
+// are in the legacy layout of vtkCellArray.
+struct vtkOBJReaderChunk
+{
+  enum { POINTS, TCOORDS, NORMALS, NUMBER_OF_VALUES };
+  enum { VERTS, LINES, POLYS, TCOORD_POLYS, NORMAL_POLYS, NUMBER_OF_CELLS };
+
+  const char *Begin;
+  const char *End;
+  vtkIdType NumberOfLines;
+
+  std::vector<float> Values[NUMBER_OF_VALUES];
+  std::vector<vtkIdType> Cells[NUMBER_OF_CELLS];
+  vtkIdType NumberOfCells[NUMBER_OF_CELLS];
+  bool HasTCoords;
+  bool HasNormals;
+  bool TCoordsSameAsVerts;
+  bool NormalsSameAsVerts;
+
+  // The first error, at ErrorLine (1-based in the chunk) or 0 if none.
+  vtkIdType ErrorLine;
+  const char *Error;
+  const char *ErrorSuffix;
+
+  // Where the values and cells of this chunk go in the output.
+  vtkIdType ValueOffsets[NUMBER_OF_VALUES];
+  vtkIdType CellOffsets[NUMBER_OF_CELLS];
+};
+
+// Cut the file in chunks of whole lines.  A line continued with a
+// backslash stays in the same chunk as the next one.
+static void vtkOBJReaderSplitLines(const char *data, size_t size,
+                                   std::vector<vtkOBJReaderChunk>& chunks)
+{
+  const char *end = data + size;
+  const char *begin = data;
+  while (begin < end)
+    {
+    const char *chunkEnd = end;
+    if (static_cast<size_t>(end - begin) > VTK_OBJ_CHUNK_SIZE)
+      {
+      const char *p = begin + VTK_OBJ_CHUNK_SIZE;
+      while (p < end)
+        {
+        p = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (p == NULL)
+          {
+          p = end;
+          }
+        else if (p[-1] != '\\')
+          {
+          chunkEnd = p + 1;
+          break;
+          }
+        else
+          {
+          ++p;
+          }
+        }
+      }
+    chunks.resize(chunks.size() + 1);
+    chunks.back().Begin = begin;
+    chunks.back().End = chunkEnd;
+    begin = chunkEnd;
+    }
+}
+
+// Read a number from the line at p like sscanf() does, skipping the spaces
+// in front of it.  p is moved after the number if there is one.
+static bool vtkOBJReaderParseFloat(const char *&p, const char *end,
+                                   float &value)
+{
+  while (p < end && isspace(static_cast<unsigned char>(*p)))
+    {
+    ++p;
+    }
+  char token[64];
+  int n = 0;
+  while (p + n < end && n < 63 && !isspace(static_cast<unsigned char>(p[n])))
+    {
+    token[n] = p[n];
+    ++n;
+    }
+  token[n] = '\0';
+  char *tokenEnd;
+  value = static_cast<float>(strtod(token, &tokenEnd));
+  p += tokenEnd - token;
+  return (tokenEnd != token);
+}
+
+static bool vtkOBJReaderParseInt(const char *&p, const char *end, int &value)
+{
+  while (p < end && isspace(static_cast<unsigned char>(*p)))
+    {
+    ++p;
+    }
+  char token[64];
+  int n = 0;
+  while (p + n < end && n < 63 && !isspace(static_cast<unsigned char>(p[n])))
+    {
+    token[n] = p[n];
+    ++n;
+    }
+  token[n] = '\0';
+  char *tokenEnd;
+  value = static_cast<int>(strtol(token, &tokenEnd, 10));
+  p += tokenEnd - token;
+  return (tokenEnd != token);
+}
+
+// Parse the lines of each chunk the same way as RequestData() parses the
+// lines of the file.
+class vtkOBJReaderParseFunctor
+{
+public:
+  vtkOBJReaderChunk *Chunks;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Parse(this->Chunks[i]);
+      }
+  }
+
+  static void SetError(vtkOBJReaderChunk& chunk, vtkIdType lineNr,
+                       const char *error, const char *suffix = "")
+  {
+    chunk.ErrorLine = lineNr;
+    chunk.Error = error;
+    chunk.ErrorSuffix = suffix;
+  }
+
+  static void Parse(vtkOBJReaderChunk& chunk)
+  {
+    for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_CELLS; ++j)
+      {
+      chunk.NumberOfCells[j] = 0;
+      }
+    chunk.HasTCoords = false;
+    chunk.HasNormals = false;
+    chunk.TCoordsSameAsVerts = true;
+    chunk.NormalsSameAsVerts = true;
+    chunk.ErrorLine = 0;
+
+    vtkIdType lineNr = 0;
+    const char *next = chunk.Begin;
+    while (next < chunk.End && chunk.ErrorLine == 0)
+      {
+      lineNr++;
+      const char *pLine = next;
+      const char *pEnd = static_cast<const char *>(
+        memchr(pLine, '\n', chunk.End - pLine));
+      pEnd = (pEnd ? pEnd : chunk.End);
+      next = pEnd + 1;
+
+      // find the command
+      while (pLine < pEnd && isspace(static_cast<unsigned char>(*pLine)))
+        {
+        pLine++;
+        }
+      const char *cmd = pLine;
+      while (pLine < pEnd && !isspace(static_cast<unsigned char>(*pLine)))
+        {
+        pLine++;
+        }
+      size_t cmdLength = pLine - cmd;
+
+      int type = -1;
+      if (cmdLength == 1 && cmd[0] == 'v')
+        {
+        float xyz[3];
+        if (vtkOBJReaderParseFloat(pLine, pEnd, xyz[0]) &&
+            vtkOBJReaderParseFloat(pLine, pEnd, xyz[1]) &&
+            vtkOBJReaderParseFloat(pLine, pEnd, xyz[2]))
+          {
+          chunk.Values[vtkOBJReaderChunk::POINTS].insert(
+            chunk.Values[vtkOBJReaderChunk::POINTS].end(), xyz, xyz + 3);
+          }
+        else
+          {
+          SetError(chunk, lineNr, "Error reading 'v' at line ");
+          }
+        }
+      else if (cmdLength == 2 && cmd[0] == 'v' && cmd[1] == 't')
+        {
+        float xy[2];
+        if (vtkOBJReaderParseFloat(pLine, pEnd, xy[0]) &&
+            vtkOBJReaderParseFloat(pLine, pEnd, xy[1]))
+          {
+          chunk.Values[vtkOBJReaderChunk::TCOORDS].insert(
+            chunk.Values[vtkOBJReaderChunk::TCOORDS].end(), xy, xy + 2);
+          }
+        else
+          {
+          SetError(chunk, lineNr, "Error reading 'vt' at line ");
+          }
+        }
+      else if (cmdLength == 2 && cmd[0] == 'v' && cmd[1] == 'n')
+        {
+        float xyz[3];
+        if (vtkOBJReaderParseFloat(pLine, pEnd, xyz[0]) &&
+            vtkOBJReaderParseFloat(pLine, pEnd, xyz[1]) &&
+            vtkOBJReaderParseFloat(pLine, pEnd, xyz[2]))
+          {
+          chunk.Values[vtkOBJReaderChunk::NORMALS].insert(
+            chunk.Values[vtkOBJReaderChunk::NORMALS].end(), xyz, xyz + 3);
+          chunk.HasNormals = true;
+          }
+        else
+          {
+          SetError(chunk, lineNr, "Error reading 'vn' at line ");
+          }
+        }
+      else if (cmdLength == 1 && cmd[0] == 'p')
+        {
+        type = vtkOBJReaderChunk::VERTS;
+        }
+      else if (cmdLength == 1 && cmd[0] == 'l')
+        {
+        type = vtkOBJReaderChunk::LINES;
+        }
+      else if (cmdLength == 1 && cmd[0] == 'f')
+        {
+        type = vtkOBJReaderChunk::POLYS;
+        }
+      if (type < 0)
+        {
+        continue;
+        }
+
+      // the cells, with their number of points set when they are complete
+      std::vector<vtkIdType>& cells = chunk.Cells[type];
+      std::vector<vtkIdType>& tcoordCells =
+        chunk.Cells[vtkOBJReaderChunk::TCOORD_POLYS];
+      std::vector<vtkIdType>& normalCells =
+        chunk.Cells[vtkOBJReaderChunk::NORMAL_POLYS];
+      size_t cellLoc = cells.size();
+      size_t tcoordLoc = tcoordCells.size();
+      size_t normalLoc = normalCells.size();
+      cells.push_back(0);
+      if (type == vtkOBJReaderChunk::POLYS)
+        {
+        tcoordCells.push_back(0);
+        normalCells.push_back(0);
+        }
+      chunk.NumberOfCells[type]++;
+
+      int nVerts = 0, nTCoords = 0, nNormals = 0;
+      while (chunk.ErrorLine == 0 && pLine < pEnd)
+        {
+        while (pLine < pEnd && isspace(static_cast<unsigned char>(*pLine)))
+          {
+          pLine++;
+          }
+        if (pLine == pEnd)
+          {
+          break;
+          }
+
+        // v, v/t, v/t/n or v//n, where only v is used by 'p' and 'l'
+        const char *p = pLine;
+        int iVert, iTCoord, iNormal;
+        bool hasTCoord = false, hasNormal = false;
+        if (vtkOBJReaderParseInt(p, pEnd, iVert))
+          {
+          if (p < pEnd && *p == '/')
+            {
+            ++p;
+            if (p < pEnd && *p == '/')
+              {
+              ++p;
+              hasNormal = vtkOBJReaderParseInt(p, pEnd, iNormal);
+              }
+            else if (vtkOBJReaderParseInt(p, pEnd, iTCoord))
+              {
+              hasTCoord = true;
+              if (p < pEnd && *p == '/')
+                {
+                ++p;
+                hasNormal = vtkOBJReaderParseInt(p, pEnd, iNormal);
+                }
+              }
+            }
+          cells.push_back(iVert - 1);
+          nVerts++;
+          if (type == vtkOBJReaderChunk::POLYS && hasTCoord)
+            {
+            tcoordCells.push_back(iTCoord - 1);
+            nTCoords++;
+            chunk.TCoordsSameAsVerts &= (iTCoord == iVert);
+            }
+          if (type == vtkOBJReaderChunk::POLYS && hasNormal)
+            {
+            normalCells.push_back(iNormal - 1);
+            nNormals++;
+            chunk.NormalsSameAsVerts &= (iNormal == iVert);
+            }
+          }
+        else if (*pLine == '\\' && pLine + 1 == pEnd && pEnd < chunk.End)
+          {
+          // handle backslash-newline continuation
+          if (next < chunk.End)
+            {
+            lineNr++;
+            pLine = next;
+            pEnd = static_cast<const char *>(
+              memchr(pLine, '\n', chunk.End - pLine));
+            pEnd = (pEnd ? pEnd : chunk.End);
+            next = pEnd + 1;
+            continue;
+            }
+          else
+            {
+            SetError(chunk, lineNr,
+                     "Error reading continuation line at line ");
+            }
+          }
+        else
+          {
+          const char *errors[3] = { "Error reading 'p' at line ",
+            "Error reading 'l' at line ", "Error reading 'f' at line " };
+          SetError(chunk, lineNr, errors[type]);
+          }
+        // skip over what we just read
+        while (pLine < pEnd && !isspace(static_cast<unsigned char>(*pLine)))
+          {
+          pLine++;
+          }
+        }
+
+      if (chunk.ErrorLine == 0)
+        {
+        if (type == vtkOBJReaderChunk::VERTS && nVerts < 1)
+          {
+          SetError(chunk, lineNr, "Error reading file near line ",
+                   " while processing the 'p' command");
+          }
+        else if (type == vtkOBJReaderChunk::LINES && nVerts < 2)
+          {
+          SetError(chunk, lineNr, "Error reading file near line ",
+                   " while processing the 'l' command");
+          }
+        else if (type == vtkOBJReaderChunk::POLYS &&
+                 (nVerts < 3 || (nTCoords > 0 && nTCoords != nVerts) ||
+                  (nNormals > 0 && nNormals != nVerts)))
+          {
+          SetError(chunk, lineNr, "Error reading file near line ",
+                   " while processing the 'f' command");
+          }
+        }
+
+      cells[cellLoc] = nVerts;
+      if (type == vtkOBJReaderChunk::POLYS)
+        {
+        tcoordCells[tcoordLoc] = nTCoords;
+        normalCells[normalLoc] = nNormals;
+        chunk.HasTCoords |= (nTCoords > 0);
+        chunk.HasNormals |= (nNormals > 0);
+        }
+      }
+    chunk.NumberOfLines = lineNr;
+  }
+};
+
+// Copy the values and cells of each chunk to the output.
+class vtkOBJReaderMergeFunctor
+{
+public:
+  const vtkOBJReaderChunk *Chunks;
+  float *Values[vtkOBJReaderChunk::NUMBER_OF_VALUES];
+  vtkIdType *Cells[vtkOBJReaderChunk::NUMBER_OF_CELLS];
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const vtkOBJReaderChunk& chunk = this->Chunks[i];
+      for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_VALUES; ++j)
+        {
+        if (!chunk.Values[j].empty())
+          {
+          memcpy(this->Values[j] + chunk.ValueOffsets[j], &chunk.Values[j][0],
+                 chunk.Values[j].size()*sizeof(float));
+          }
+        }
+      for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_CELLS; ++j)
+        {
+        if (!chunk.Cells[j].empty())
+          {
+          memcpy(this->Cells[j] + chunk.CellOffsets[j], &chunk.Cells[j][0],
+                 chunk.Cells[j].size()*sizeof(vtkIdType));
+          }
+        }
+      }
+  }
+};
 
 int vtkOBJReader::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -150,6 +558,90 @@ int vtkOBJReader::RequestData(
 
   // -- work through the file line by line, assigning into the above 7 structures as appropriate --
 
+  vtkMemoryMappedFile *mappedFile = NULL;
+  if (this->MemoryMapFile)
+    {
+    mappedFile = vtkMemoryMappedFile::New();
+    if (!mappedFile->Open(this->FileName))
+      {
+      // empty files cannot be mapped, they are read as usual
+      mappedFile->Delete();
+      mappedFile = NULL;
+      }
+    }
+
+  if (mappedFile)
+    {
+    vtkDebugMacro(<<"Parsing the mapped file in parallel");
+
+    std::vector<vtkOBJReaderChunk> chunks;
+    vtkOBJReaderSplitLines(reinterpret_cast<const char *>(mappedFile->GetData()),
+                           mappedFile->GetSize(), chunks);
+    vtkOBJReaderParseFunctor parser;
+    parser.Chunks = &chunks[0];
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1, parser);
+
+    // report the first error as if the lines were read in order, and
+    // find where each chunk goes in the structures
+    vtkIdType lineNr = 0;
+    vtkIdType numValues[vtkOBJReaderChunk::NUMBER_OF_VALUES] = { 0, 0, 0 };
+    vtkIdType numEntries[vtkOBJReaderChunk::NUMBER_OF_CELLS] = { 0, 0, 0, 0, 0 };
+    vtkIdType numCells[vtkOBJReaderChunk::NUMBER_OF_CELLS] = { 0, 0, 0, 0, 0 };
+    for (size_t i = 0; i < chunks.size() && everything_ok; ++i)
+      {
+      vtkOBJReaderChunk& chunk = chunks[i];
+      if (chunk.ErrorLine)
+        {
+        vtkErrorMacro(<< chunk.Error << lineNr + chunk.ErrorLine
+                      << chunk.ErrorSuffix);
+        everything_ok = false;
+        }
+      lineNr += chunk.NumberOfLines;
+      hasTCoords |= chunk.HasTCoords;
+      hasNormals |= chunk.HasNormals;
+      tcoords_same_as_verts &= chunk.TCoordsSameAsVerts;
+      normals_same_as_verts &= chunk.NormalsSameAsVerts;
+      for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_VALUES; ++j)
+        {
+        chunk.ValueOffsets[j] = numValues[j];
+        numValues[j] += static_cast<vtkIdType>(chunk.Values[j].size());
+        }
+      for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_CELLS; ++j)
+        {
+        chunk.CellOffsets[j] = numEntries[j];
+        numEntries[j] += static_cast<vtkIdType>(chunk.Cells[j].size());
+        numCells[j] += chunk.NumberOfCells[j];
+        }
+      }
+
+    if (everything_ok)
+      {
+      vtkOBJReaderMergeFunctor merger;
+      merger.Chunks = &chunks[0];
+      vtkFloatArray *values[vtkOBJReaderChunk::NUMBER_OF_VALUES] = {
+        vtkFloatArray::SafeDownCast(points->GetData()), tcoords, normals };
+      for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_VALUES; ++j)
+        {
+        values[j]->SetNumberOfTuples(
+          numValues[j]/values[j]->GetNumberOfComponents());
+        merger.Values[j] = values[j]->GetPointer(0);
+        }
+      vtkCellArray *cells[vtkOBJReaderChunk::NUMBER_OF_CELLS] = {
+        pointElems, lineElems, polys, tcoord_polys, normal_polys };
+      for (int j = 0; j < vtkOBJReaderChunk::NUMBER_OF_CELLS; ++j)
+        {
+        vtkIdTypeArray *ids = vtkIdTypeArray::New();
+        ids->SetNumberOfValues(numEntries[j]);
+        merger.Cells[j] = ids->GetPointer(0);
+        cells[j]->SetCells(numCells[j], ids);
+        ids->Delete();
+        }
+      vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1, merger);
+      }
+
+    mappedFile->Delete();
+    }
+  else
   { // (make a local scope section to emphasise that the variables below are only used here)
 
   const int MAX_LINE = 1024;
@@ -612,6 +1104,8 @@ void vtkOBJReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "File Name: "
      << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "MemoryMapFile: "
+     << (this->MemoryMapFile ? "On\n" : "Off\n");
 
 }
 
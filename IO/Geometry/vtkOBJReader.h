@@ -16,6 +16,10 @@
 // .SECTION Description
 // vtkOBJReader is a source object that reads Wavefront .obj
 // files. The output of this source object is polygonal data.
+//
+// With MemoryMapFile on, the file is mapped in memory and cut into chunks
+// of whole lines that are parsed in parallel, then the chunks are
+// concatenated in order.
 // .SECTION See Also
 // vtkOBJImporter
 
@@ -37,6 +41,15 @@ public:
   vtkSetStringMacro(FileName);
   vtkGetStringMacro(FileName);
 
+  // Description:
+  // Turn on/off parsing a memory mapping of the file in parallel with
+  // vtkSMPTools.  The output is the same as when the file is read line
+  // by line, except that lines are not limited in length.  Off by
+  // default.
+  vtkSetMacro(MemoryMapFile,int);
+  vtkGetMacro(MemoryMapFile,int);
+  vtkBooleanMacro(MemoryMapFile,int);
+
 protected:
   vtkOBJReader();
   ~vtkOBJReader();
@@ -44,6 +57,7 @@ protected:
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
   char *FileName;
+  int MemoryMapFile;
 private:
   vtkOBJReader(const vtkOBJReader&);  // Not implemented.
   void operator=(const vtkOBJReader&);  // Not implemented.
@@ -19,16 +19,21 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <ctype.h>
+#include <string.h>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -44,6 +49,7 @@ vtkSTLReader::vtkSTLReader()
   this->FileName = NULL;
   this->Merging = 1;
   this->ScalarTags = 0;
+  this->MemoryMapBinaryFile = 0;
   this->Locator = NULL;
 
   this->SetNumberOfInputPorts(0);
@@ -87,6 +93,7 @@ int vtkSTLReader::RequestData(
   vtkPoints *newPts, *mergedPts;
   vtkCellArray *newPolys, *mergedPolys;
   vtkFloatArray *newScalars=0, *mergedScalars=0;
+  bool merged = false;
 
   // All of the data in the first piece.
   if (outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) > 0)
@@ -129,6 +136,18 @@ int vtkSTLReader::RequestData(
       return 0;
       }
     }
+  else if ( this->MemoryMapBinaryFile )
+    {
+    // without a locator the points are merged while they are mapped
+    merged = (this->Merging && this->Locator == NULL);
+    if ( !this->ReadMappedBinarySTL(newPts,newPolys,merged) )
+      {
+      fclose(fp);
+      newPts->Delete();
+      newPolys->Delete();
+      return 0;
+      }
+    }
   else
     {
     fclose(fp);
@@ -147,7 +166,7 @@ int vtkSTLReader::RequestData(
   //
   // If merging is on, create hash table and merge points/triangles.
   //
-  if ( this->Merging )
+  if ( this->Merging && !merged )
     {
     int i;
     vtkIdType *pts = 0;
@@ -330,6 +349,326 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
   return true;
 }
 
+// The size in bytes of the header and of a facet of a binary file.
+#define VTK_STL_HEADER_SIZE 84
+#define VTK_STL_FACET_SIZE 50
+
+// Copy the vertices of the facets, which are not aligned in the file.
+class vtkSTLReaderDecodeFunctor
+{
+public:
+  const unsigned char *Facets;
+  float *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      // skip the normal, and the attribute byte count at the end
+      memcpy(this->Points + 9*i, this->Facets + VTK_STL_FACET_SIZE*i + 12,
+             9*sizeof(float));
+      }
+    vtkByteSwap::Swap4LERange(this->Points + 9*begin, 9*(end - begin));
+  }
+};
+
+// A vertex of the file, sorted by its coordinates then by its index.
+struct vtkSTLReaderVertex
+{
+  unsigned int Key[3];
+  vtkIdType Id;
+
+  bool operator<(const vtkSTLReaderVertex& other) const
+  {
+    if (this->Key[0] != other.Key[0])
+      {
+      return (this->Key[0] < other.Key[0]);
+      }
+    if (this->Key[1] != other.Key[1])
+      {
+      return (this->Key[1] < other.Key[1]);
+      }
+    if (this->Key[2] != other.Key[2])
+      {
+      return (this->Key[2] < other.Key[2]);
+      }
+    return (this->Id < other.Id);
+  }
+};
+
+// Whether two vertices are merged, which is when their coordinates compare
+// equal as floats like in vtkMergePoints: -0 is equal to 0 and NaN is
+// never equal to anything.
+static inline bool vtkSTLReaderSamePoint(const vtkSTLReaderVertex& a,
+                                         const vtkSTLReaderVertex& b)
+{
+  for (int j = 0; j < 3; ++j)
+    {
+    if (a.Key[j] != b.Key[j] || (a.Key[j] & 0x7fffffffu) > 0x7f800000u)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+class vtkSTLReaderKeyFunctor
+{
+public:
+  const float *Points;
+  vtkSTLReaderVertex *Vertices;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkSTLReaderVertex& v = this->Vertices[i];
+      memcpy(v.Key, this->Points + 3*i, 3*sizeof(float));
+      for (int j = 0; j < 3; ++j)
+        {
+        v.Key[j] = (v.Key[j] == 0x80000000u ? 0u : v.Key[j]);
+        }
+      v.Id = i;
+      }
+  }
+};
+
+// For each sorted vertex, store the index of the first vertex of the file
+// that it is merged with, and flag the vertices that are the first.
+class vtkSTLReaderFirstFunctor
+{
+public:
+  const vtkSTLReaderVertex *Vertices;
+  vtkIdType *First;
+  vtkIdType *IsFirst;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    // the group of the first vertex can start in the previous range
+    vtkIdType start = begin;
+    while (start > 0 &&
+           vtkSTLReaderSamePoint(this->Vertices[start - 1],
+                                 this->Vertices[begin]))
+      {
+      --start;
+      }
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (i > begin &&
+          !vtkSTLReaderSamePoint(this->Vertices[i - 1], this->Vertices[i]))
+        {
+        start = i;
+        }
+      vtkIdType id = this->Vertices[i].Id;
+      this->First[id] = this->Vertices[start].Id;
+      this->IsFirst[id] = (start == i);
+      }
+  }
+};
+
+// Give each vertex the id of the merged point, and copy the first vertex
+// of each point to the merged points.  The ids of the first vertices are
+// already in PointIds.
+class vtkSTLReaderMergeFunctor
+{
+public:
+  const float *Points;
+  const vtkIdType *First;
+  vtkIdType *PointIds;
+  float *MergedPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType first = this->First[i];
+      if (first == i)
+        {
+        memcpy(this->MergedPoints + 3*this->PointIds[i], this->Points + 3*i,
+               3*sizeof(float));
+        }
+      else
+        {
+        this->PointIds[i] = this->PointIds[first];
+        }
+      }
+  }
+};
+
+// Flag the triangles whose three points are different.
+class vtkSTLReaderKeepFunctor
+{
+public:
+  const vtkIdType *PointIds;
+  vtkIdType *Keep;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const vtkIdType *ids = this->PointIds + 3*i;
+      this->Keep[i] = (ids[0] != ids[1] && ids[0] != ids[2] &&
+                       ids[1] != ids[2]);
+      }
+  }
+};
+
+// Write the triangles to the legacy cell array layout.  Without Offsets
+// all the triangles are kept, otherwise the kept triangle i is at
+// Offsets[i].
+class vtkSTLReaderCellsFunctor
+{
+public:
+  const vtkIdType *PointIds;
+  const vtkIdType *Offsets;
+  vtkIdType *Cells;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType j = i;
+      if (this->Offsets)
+        {
+        j = this->Offsets[i];
+        if (j == this->Offsets[i + 1])
+          {
+          continue;
+          }
+        }
+      vtkIdType *cell = this->Cells + 4*j;
+      cell[0] = 3;
+      if (this->PointIds)
+        {
+        const vtkIdType *ids = this->PointIds + 3*i;
+        cell[1] = ids[0];
+        cell[2] = ids[1];
+        cell[3] = ids[2];
+        }
+      else
+        {
+        cell[1] = 3*i;
+        cell[2] = 3*i + 1;
+        cell[3] = 3*i + 2;
+        }
+      }
+  }
+};
+
+bool vtkSTLReader::ReadMappedBinarySTL(vtkPoints *newPts,
+                                       vtkCellArray *newPolys, bool merge)
+{
+  vtkDebugMacro(<< " Reading BINARY STL file from a memory mapping");
+
+  vtkMemoryMappedFile *mappedFile = vtkMemoryMappedFile::New();
+  if (!mappedFile->Open(this->FileName) ||
+      mappedFile->GetSize() < VTK_STL_HEADER_SIZE)
+    {
+    vtkErrorMacro ("STLReader error reading file: " << this->FileName
+                   << " Premature EOF while reading header.");
+    mappedFile->Delete();
+    return false;
+    }
+
+  // Like ReadBinarySTL(), ignore the count of the header and read the
+  // facets up to the end of the file.
+  size_t size = mappedFile->GetSize() - VTK_STL_HEADER_SIZE;
+  if (size % VTK_STL_FACET_SIZE >= 48)
+    {
+    vtkErrorMacro ("STLReader error reading file: " << this->FileName
+                   << " Premature EOF while reading extra junk.");
+    mappedFile->Delete();
+    return false;
+    }
+  vtkIdType numTris = static_cast<vtkIdType>(size / VTK_STL_FACET_SIZE);
+  vtkIdType numVerts = 3*numTris;
+
+  vtkFloatArray *points = vtkFloatArray::New();
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(numVerts);
+  vtkSTLReaderDecodeFunctor decode;
+  decode.Facets = mappedFile->GetData() + VTK_STL_HEADER_SIZE;
+  decode.Points = points->GetPointer(0);
+  vtkSMPTools::For(0, numTris, decode);
+  mappedFile->Delete();
+  this->UpdateProgress(0.25);
+
+  vtkIdTypeArray *cells = vtkIdTypeArray::New();
+  vtkSTLReaderCellsFunctor write;
+  write.PointIds = 0;
+  write.Offsets = 0;
+  if (!merge)
+    {
+    newPts->SetData(points);
+    cells->SetNumberOfValues(4*numTris);
+    write.Cells = cells->GetPointer(0);
+    vtkSMPTools::For(0, numTris, write);
+    }
+  else
+    {
+    // Sort the vertices to find the first one of each point, then number
+    // the points in the order of their first vertex like vtkMergePoints.
+    std::vector<vtkIdType> pointIds(numVerts + 1);
+    std::vector<vtkIdType> first(numVerts);
+    std::vector<vtkSTLReaderVertex> vertices(numVerts);
+    vtkSTLReaderKeyFunctor keys;
+    keys.Points = points->GetPointer(0);
+    keys.Vertices = numVerts ? &vertices[0] : 0;
+    vtkSMPTools::For(0, numVerts, keys);
+    vtkSMPTools::Sort(vertices.begin(), vertices.end());
+    this->UpdateProgress(0.5);
+
+    vtkSTLReaderFirstFunctor firsts;
+    firsts.Vertices = keys.Vertices;
+    firsts.First = numVerts ? &first[0] : 0;
+    firsts.IsFirst = &pointIds[0];
+    vtkSMPTools::For(0, numVerts, firsts);
+    std::vector<vtkSTLReaderVertex>().swap(vertices);
+
+    pointIds[numVerts] = 0;
+    vtkSMPTools::ExclusiveScan(pointIds.begin(), pointIds.end(),
+                               pointIds.begin(), static_cast<vtkIdType>(0));
+    vtkIdType numPoints = pointIds[numVerts];
+
+    vtkFloatArray *mergedPoints = vtkFloatArray::New();
+    mergedPoints->SetNumberOfComponents(3);
+    mergedPoints->SetNumberOfTuples(numPoints);
+    vtkSTLReaderMergeFunctor merger;
+    merger.Points = points->GetPointer(0);
+    merger.First = numVerts ? &first[0] : 0;
+    merger.PointIds = &pointIds[0];
+    merger.MergedPoints = mergedPoints->GetPointer(0);
+    vtkSMPTools::For(0, numVerts, merger);
+    newPts->SetData(mergedPoints);
+    mergedPoints->Delete();
+    this->UpdateProgress(0.75);
+
+    // drop the degenerate triangles like RequestData()
+    std::vector<vtkIdType> offsets(numTris + 1);
+    vtkSTLReaderKeepFunctor keep;
+    keep.PointIds = &pointIds[0];
+    keep.Keep = &offsets[0];
+    vtkSMPTools::For(0, numTris, keep);
+    offsets[numTris] = 0;
+    vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(),
+                               offsets.begin(), static_cast<vtkIdType>(0));
+    cells->SetNumberOfValues(4*offsets[numTris]);
+    write.PointIds = &pointIds[0];
+    write.Offsets = &offsets[0];
+    write.Cells = cells->GetPointer(0);
+    vtkSMPTools::For(0, numTris, write);
+
+    vtkDebugMacro(<< "Merged to: "
+                  << numPoints << " points, "
+                  << offsets[numTris] << " triangles");
+    }
+  newPolys->SetCells(cells->GetNumberOfTuples()/4, cells);
+  cells->Delete();
+  points->Delete();
+
+  return true;
+}
+
 bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
                                 vtkCellArray *newPolys, vtkFloatArray *scalars)
 {
@@ -513,6 +852,8 @@ void vtkSTLReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Merging: " << (this->Merging ? "On\n" : "Off\n");
   os << indent << "ScalarTags: " << (this->ScalarTags ? "On\n" : "Off\n");
+  os << indent << "MemoryMapBinaryFile: "
+     << (this->MemoryMapBinaryFile ? "On\n" : "Off\n");
   os << indent << "Locator: ";
   if ( this->Locator )
     {
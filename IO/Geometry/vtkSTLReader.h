@@ -24,6 +24,11 @@
 // point data is merged after reading. Merging is performed by default,
 // however, merging requires a large amount of temporary storage since a
 // 3D hash table must be constructed.
+//
+// Binary files can also be read from a memory mapping of the file, see
+// MemoryMapBinaryFile.  The triangles are then decoded in parallel, and
+// the points are merged by sorting them in parallel instead of inserting
+// them one at a time in the locator.
 
 // .SECTION Caveats
 // Binary files written on one system may not be readable on other systems.
@@ -78,6 +83,17 @@ public:
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
+  // Description:
+  // Turn on/off reading binary files from a memory mapping of the file.
+  // The triangles are decoded in parallel with vtkSMPTools and, unless a
+  // Locator is specified, the points with exactly the same coordinates
+  // are merged with a parallel sort.  The points, the triangles and their
+  // order are the same as with the default vtkMergePoints locator.  ASCII
+  // files are read as usual.  Off by default.
+  vtkSetMacro(MemoryMapBinaryFile,int);
+  vtkGetMacro(MemoryMapBinaryFile,int);
+  vtkBooleanMacro(MemoryMapBinaryFile,int);
+
 protected:
   vtkSTLReader();
   ~vtkSTLReader();
@@ -89,10 +105,12 @@ protected:
   char *FileName;
   int Merging;
   int ScalarTags;
+  int MemoryMapBinaryFile;
   vtkIncrementalPointLocator *Locator;
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   bool ReadBinarySTL(FILE *fp, vtkPoints*, vtkCellArray*);
+  bool ReadMappedBinarySTL(vtkPoints*, vtkCellArray*, bool merge);
   bool ReadASCIISTL(FILE *fp, vtkPoints*, vtkCellArray*,
                     vtkFloatArray* scalars=0);
   int GetSTLFileType(const char *filename);
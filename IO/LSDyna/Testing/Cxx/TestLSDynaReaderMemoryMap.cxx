@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLSDynaReaderMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Steps through the states of a database made of several files with and
+// without memory mapping, and checks that the outputs are the same.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkLSDynaReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+
+namespace
+{
+// Whether the arrays hold the same values, bit for bit.
+bool SameValues(vtkDataArray* expected, vtkDataArray* output)
+{
+  if (!expected || !output ||
+      expected->GetDataType() != output->GetDataType() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents() ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples())
+    {
+    return false;
+    }
+  size_t size = static_cast<size_t>(expected->GetDataTypeSize()) *
+    expected->GetNumberOfComponents() * expected->GetNumberOfTuples();
+  return memcmp(expected->GetVoidPointer(0), output->GetVoidPointer(0),
+                size) == 0;
+}
+
+// Memory mapping only changes where the values of a state are read from,
+// so only the point coordinates and the point and cell arrays are compared.
+bool SameState(vtkPointSet* expected, vtkPointSet* output)
+{
+  if (!expected || !output || !expected->GetPoints() ||
+      !output->GetPoints() ||
+      !SameValues(expected->GetPoints()->GetData(),
+                  output->GetPoints()->GetData()))
+    {
+    return false;
+    }
+  vtkDataSetAttributes* attributes[2][2] = {
+    { expected->GetPointData(), output->GetPointData() },
+    { expected->GetCellData(), output->GetCellData() } };
+  for (int a = 0; a < 2; ++a)
+    {
+    vtkDataSetAttributes* expectedData = attributes[a][0];
+    vtkDataSetAttributes* outputData = attributes[a][1];
+    if (expectedData->GetNumberOfArrays() != outputData->GetNumberOfArrays())
+      {
+      return false;
+      }
+    for (int i = 0; i < expectedData->GetNumberOfArrays(); ++i)
+      {
+      const char* name = expectedData->GetArrayName(i);
+      if (!name || !SameValues(expectedData->GetArray(i),
+                               outputData->GetArray(name)))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestLSDynaReaderMemoryMap(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Data/LSDyna/foam/foam.d3plot");
+
+  vtkNew<vtkLSDynaReader> expected;
+  vtkNew<vtkLSDynaReader> reader;
+  expected->SetFileName(fname);
+  reader->SetFileName(fname);
+  reader->MemoryMapFilesOn();
+  delete [] fname;
+  expected->UpdateInformation();
+  reader->UpdateInformation();
+  for (int i = 0; i < reader->GetNumberOfPointArrays(); ++i)
+    {
+    expected->SetPointArrayStatus(i, 1);
+    reader->SetPointArrayStatus(i, 1);
+    }
+
+  vtkIdType numSteps = reader->GetNumberOfTimeSteps();
+  if (numSteps < 2)
+    {
+    cerr << "Error: " << numSteps << " time steps were read" << endl;
+    return EXIT_FAILURE;
+    }
+  // the last state first, so that the files are not mapped in order
+  for (vtkIdType step = numSteps - 1; step >= 0; --step)
+    {
+    expected->SetTimeStep(step);
+    expected->Update();
+    reader->SetTimeStep(step);
+    reader->Update();
+    vtkMultiBlockDataSet* output = reader->GetOutput();
+    vtkSmartPointer<vtkCompositeDataIterator> it;
+    it.TakeReference(expected->GetOutput()->NewIterator());
+    int numBlocks = 0;
+    for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextItem())
+      {
+      if (!SameState(vtkPointSet::SafeDownCast(it->GetCurrentDataObject()),
+                     vtkPointSet::SafeDownCast(output->GetDataSet(it))))
+        {
+        cerr << "Error: the outputs are different at time step " << step
+             << endl;
+        return EXIT_FAILURE;
+        }
+      ++numBlocks;
+      }
+    if (numBlocks == 0)
+      {
+      cerr << "Error: no block was read at time step " << step << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@ vtk_module(vtkIOLSDyna
     StandAlone
   DEPENDS
     vtkCommonExecutionModel
+    vtkIOCore
     vtkIOXML
   PRIVATE_DEPENDS
     vtksys
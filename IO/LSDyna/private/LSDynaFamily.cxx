@@ -18,6 +18,7 @@
 ----------------------------------------------------------------------------*/
 
 #include "LSDynaFamily.h"
+#include "vtkMemoryMappedFile.h"
 //#include "vtksys/SystemTools.hxx"
 
 #include <errno.h>
@@ -170,6 +171,11 @@ LSDynaFamily::LSDynaFamily()
 
     this->FileHandlesClosed = false;
 
+    this->MemoryMapFiles = false;
+    this->MappedFile = NULL;
+    this->MappedFileNumber = -1;
+    this->ChunkMapped = false;
+
     this->BufferInfo = new LSDynaFamily::BufferingInfo();
     }
 
@@ -181,6 +187,7 @@ LSDynaFamily::~LSDynaFamily()
       VTK_LSDYNA_CLOSEFILE(this->FD);
       }
 
+    this->UnmapFile();
     if ( this->Chunk )
       {
       delete [] this->Chunk;
@@ -413,6 +420,20 @@ int LSDynaFamily::BufferChunk( WordType wType, vtkIdType chunkSizeInWords )
   if ( chunkSizeInWords == 0 )
     return 0;
 
+  // Characters are never swapped
+  if ( this->MemoryMapFiles &&
+       ( this->SwapEndian == 0 || wType == LSDynaFamily::Char ) &&
+       this->MapChunk( chunkSizeInWords ) )
+    {
+    return 0;
+    }
+  if ( this->ChunkMapped )
+    {
+    this->Chunk = NULL;
+    this->ChunkAlloc = 0;
+    this->ChunkMapped = false;
+    }
+
   if ( this->ChunkAlloc < chunkSizeInWords )
     {
     if ( this->Chunk )
@@ -510,6 +531,77 @@ int LSDynaFamily::BufferChunk( WordType wType, vtkIdType chunkSizeInWords )
   return 0;
   }
 
+//-----------------------------------------------------------------------------
+bool LSDynaFamily::MapChunk( vtkIdType chunkSizeInWords )
+  {
+  if ( this->FNum < 0 || VTK_LSDYNA_ISBADFILE(this->FD) )
+    {
+    return false;
+    }
+
+  if ( this->MappedFileNumber != this->FNum )
+    {
+    this->UnmapFile();
+    // A file that cannot be mapped keeps an empty mapping, so that it is
+    // read without trying again for every chunk.
+    this->MappedFile = vtkMemoryMappedFile::New();
+    this->MappedFile->Open( this->Files[this->FNum].c_str() );
+    this->MappedFileNumber = this->FNum;
+    }
+
+  // The words must be aligned in the mapping to be used as values, and the
+  // chunks that span two files are read
+  vtkLSDynaOff_t offset = VTK_LSDYNA_TELL(this->FD);
+  vtkIdType numBytes = chunkSizeInWords*this->WordSize;
+  if ( offset < 0 || offset % this->WordSize != 0 ||
+       static_cast<size_t>( offset + numBytes ) > this->MappedFile->GetSize() )
+    {
+    return false;
+    }
+  VTK_LSDYNA_SEEK(this->FD,offset + numBytes,SEEK_SET);
+
+  if ( this->Chunk && ! this->ChunkMapped )
+    {
+    delete [] this->Chunk;
+    }
+  this->Chunk = this->MappedFile->GetData() + offset;
+  this->ChunkMapped = true;
+  this->ChunkAlloc = chunkSizeInWords;
+  this->ChunkValid = numBytes;
+  this->ChunkWord = 0;
+  this->FWord = offset + numBytes;
+  return true;
+  }
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::UnmapFile()
+  {
+  if ( this->ChunkMapped )
+    {
+    this->Chunk = NULL;
+    this->ChunkAlloc = 0;
+    this->ChunkWord = 0;
+    this->ChunkValid = 0;
+    this->ChunkMapped = false;
+    }
+  if ( this->MappedFile )
+    {
+    this->MappedFile->Delete();
+    this->MappedFile = NULL;
+    }
+  this->MappedFileNumber = -1;
+  }
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::SetMemoryMapFiles( bool mapFiles )
+  {
+  if ( ! mapFiles )
+    {
+    this->UnmapFile();
+    }
+  this->MemoryMapFiles = mapFiles;
+  }
+
 //-----------------------------------------------------------------------------
 int LSDynaFamily::ClearBuffer()
 {
@@ -518,8 +610,12 @@ int LSDynaFamily::ClearBuffer()
     this->ChunkAlloc = 0;
     this->ChunkWord = 0;
     this->ChunkValid = 0;
-    delete [] this->Chunk;
+    if ( ! this->ChunkMapped )
+      {
+      delete [] this->Chunk;
+      }
     this->Chunk = NULL;
+    this->ChunkMapped = false;
     }
 
   return 0;
@@ -744,6 +840,7 @@ void LSDynaFamily::Reset()
     VTK_LSDYNA_CLOSEFILE(this->FD);
     this->FD = VTK_LSDYNA_BADFILE;
     }
+  this->UnmapFile();
 
   this->DatabaseDirectory = "";
   this->DatabaseBaseName = "";
@@ -808,6 +905,7 @@ void LSDynaFamily::CloseFileHandles()
     VTK_LSDYNA_CLOSEFILE(this->FD);
     this->FD = VTK_LSDYNA_BADFILE;
     this->ClearBuffer();
+    this->UnmapFile();
     this->FileHandlesClosed=true;
     }
 }
@@ -68,6 +68,8 @@ typedef FILE* vtkLSDynaFile_t;
 #  include <errno.h>
 #endif
 
+class vtkMemoryMappedFile;
+
 class LSDynaFamily
 {
 public:
@@ -201,7 +203,21 @@ public:
 
   void OpenFileHandles();
 
+  //Description:
+  //When set, the files are memory mapped and BufferChunk makes the
+  //buffer point into the mapping instead of reading a copy of the words,
+  //as long as they need no byte swapping and lie in a single file.
+  //The buffer must then not be modified. Off by default.
+  void SetMemoryMapFiles( bool mapFiles );
+  bool GetMemoryMapFiles() const { return this->MemoryMapFiles; }
+
 protected:
+  //Point the buffer at the next chunk of the current file in its mapping
+  //and advance past it. Returns false when the chunk cannot be mapped.
+  bool MapChunk( vtkIdType chunkSizeInWords );
+  //Release the mapping of the current file
+  void UnmapFile();
+
   /// The directory containing d3plot files
   std::string DatabaseDirectory;
   /// The name (title string) of the database. This is the first 10 words
@@ -253,10 +269,20 @@ protected:
   // How much of the the allocated space is filled with valid data (assert
   // ChunkValid <= ChunkAlloc).
   vtkIdType ChunkValid;
-  /// The allocated size (in words) of Chunk.
+  /// The allocated size (in words) of Chunk, or the length of the mapped
+  /// range when ChunkMapped is set.  Only an allocated Chunk is freed.
   vtkIdType ChunkAlloc;
 
   bool FileHandlesClosed;
+
+  /// Whether files are memory mapped, see SetMemoryMapFiles
+  bool MemoryMapFiles;
+  /// The mapping of file MappedFileNumber, if any.
+  vtkMemoryMappedFile* MappedFile;
+  vtkIdType MappedFileNumber;
+  /// Whether Chunk points into MappedFile instead of owning its memory.
+  bool ChunkMapped;
+
   struct BufferingInfo;
   BufferingInfo* BufferInfo;
 };
@@ -526,6 +526,7 @@ vtkLSDynaReader::vtkLSDynaReader()
   this->DeformedMesh = 1;
   this->RemoveDeletedCells = 1;
   this->DeletedCellsAsGhostArray = 0;
+  this->MemoryMapFiles = 0;
   this->InputDeck = 0;
   this->Parts = NULL;
 }
@@ -558,6 +559,7 @@ void vtkLSDynaReader::PrintSelf( ostream &os, vtkIndent indent )
     }
   os << indent << "Show Deleted Cells as Ghost Cells: "<<
         (this->DeletedCellsAsGhostArray ? "On" : "Off") << endl;
+  os << indent << "MemoryMapFiles: " << (this->MemoryMapFiles ? "On" : "Off") << endl;
 
   os << indent << "Dimensionality: " << this->GetDimensionality() << endl;
   os << indent << "Nodes: " << this->GetNumberOfNodes() << endl;
@@ -3415,6 +3417,7 @@ int vtkLSDynaReader::RequestData(
     }
   p->Fam.ClearBuffer();
   p->Fam.OpenFileHandles();
+  p->Fam.SetMemoryMapFiles( this->MemoryMapFiles != 0 );
 
   vtkMultiBlockDataSet* mbds = 0;
   vtkInformation* oi = oinfo->GetInformationObject(0);
@@ -426,6 +426,17 @@ public:
   vtkGetMacro(DeletedCellsAsGhostArray,int);
   vtkBooleanMacro(DeletedCellsAsGhostArray,int);
 
+  // Description:
+  // Should the database files be memory mapped?  The words that need no
+  // byte swapping are then read from the mapping rather than through an
+  // intermediate buffer; the output arrays still own a copy of the values,
+  // so this saves a pass over the data, not the memory of the output.  The
+  // mapping of the current file is kept between updates.  By default, this
+  // is false.
+  vtkSetMacro(MemoryMapFiles,int);
+  vtkGetMacro(MemoryMapFiles,int);
+  vtkBooleanMacro(MemoryMapFiles,int);
+
   // Description:
   // The name of the input deck corresponding to the current database.
   // This is used to determine the part names associated with each material ID.
@@ -470,6 +481,11 @@ protected:
   int RemoveDeletedCells;
   int DeletedCellsAsGhostArray;
 
+  // Description:
+  // Should the database files be memory mapped?
+  // By default, this is false.
+  int MemoryMapFiles;
+
   // Description:
   // The range of time steps available within a database.
   // Only valid after UpdateInformation() is called on the reader.
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads an ASCII legacy file whose values are written in many formats,
+// with enough values to be parsed in parallel chunks, and compares them
+// with the stream extraction in the classic locale.  The cells that
+// follow the points check that no more than the values is read.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkTestErrorObserver.h"
+
+#include <vtksys/ios/sstream>
+
+#include <locale>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Numbers for the fast and the slow paths of the parser.
+std::string Number(int i)
+{
+  char text[64];
+  double x = ((i % 100003)*7919 % 100003)/7.0 - 5000.0;
+  switch (i % 9)
+    {
+    case 0:
+      sprintf(text, "%d", i - 30000);
+      break;
+    case 1:
+      sprintf(text, "%g", x);
+      break;
+    case 2:
+      sprintf(text, "%.9g", x);
+      break;
+    case 3:
+      sprintf(text, "%.17g", x*1e-7);
+      break;
+    case 4:
+      sprintf(text, "%E", x*1e25);
+      break;
+    case 5:
+      sprintf(text, "%s", (i % 2 ? "-0" : "+0.0e+0"));
+      break;
+    case 6:
+      sprintf(text, (i % 2 ? ".%d" : "%d."), i % 1000);
+      break;
+    case 7:
+      sprintf(text, "%.3e", x*1e-30);
+      break;
+    default:
+      sprintf(text, "0.000000000000000000000001%d", i % 10);
+      break;
+    }
+  return text;
+}
+
+vtkPolyData* Read(const std::string& text, vtkTest::ErrorObserver* observer)
+{
+  vtkPolyDataReader* reader = vtkPolyDataReader::New();
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(text);
+  reader->AddObserver(vtkCommand::ErrorEvent, observer);
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  output->Register(0);
+  reader->Delete();
+  return output;
+}
+}
+
+int TestLegacyASCIIReader(int, char*[])
+{
+  const int numPoints = 100000;
+  std::vector<std::string> numbers(3*numPoints);
+  vtksys_ios::ostringstream file;
+  file << "# vtk DataFile Version 3.0\nnumbers\nASCII\n"
+       << "DATASET POLYDATA\nPOINTS " << numPoints << " float\n";
+  for (int i = 0; i < 3*numPoints; i++)
+    {
+    numbers[i] = Number(i);
+    // several separators, and several values on each line
+    file << numbers[i] << (i % 5 == 4 ? "\r\n" : (i % 3 ? " " : "\t  "));
+    }
+  file << "POLYGONS 2 9\n3 0 1 2\n4 3 4 5 99999\n";
+  file << "POINT_DATA " << numPoints << "\nSCALARS values double 3\n"
+       << "LOOKUP_TABLE default\n";
+  for (int i = 0; i < 3*numPoints; i++)
+    {
+    file << numbers[i] << "\n";
+    }
+
+  vtkNew<vtkTest::ErrorObserver> observer;
+  vtkPolyData* output = Read(file.str(), observer.GetPointer());
+  vtkPoints* points = output->GetPoints();
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  if (observer->GetError() || !points || !scalars ||
+      points->GetNumberOfPoints() != numPoints ||
+      scalars->GetNumberOfTuples() != numPoints ||
+      output->GetNumberOfPolys() != 2)
+    {
+    cerr << "Error: could not read the file" << endl;
+    output->Delete();
+    return EXIT_FAILURE;
+    }
+
+  float *p = static_cast<float*>(points->GetVoidPointer(0));
+  double *s = static_cast<double*>(scalars->GetVoidPointer(0));
+  for (int i = 0; i < 3*numPoints; i++)
+    {
+    float f;
+    double d;
+    vtksys_ios::istringstream fs(numbers[i]);
+    vtksys_ios::istringstream ds(numbers[i]);
+    fs.imbue(std::locale::classic());
+    ds.imbue(std::locale::classic());
+    fs >> f;
+    ds >> d;
+    if (p[i] != f || s[i] != d)
+      {
+      cerr << "Error: " << numbers[i] << " is read as " << p[i] << " and "
+           << s[i] << " instead of " << f << " and " << d << endl;
+      output->Delete();
+      return EXIT_FAILURE;
+      }
+    }
+
+  vtkIdType npts, *pts;
+  vtkCellArray* polys = output->GetPolys();
+  polys->InitTraversal();
+  polys->GetNextCell(npts, pts);
+  polys->GetNextCell(npts, pts);
+  bool cellsOk = (npts == 4 && pts[0] == 3 && pts[3] == 99999);
+  output->Delete();
+  if (!cellsOk)
+    {
+    cerr << "Error: wrong cells" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -53,8 +54,17 @@
 #endif
 
 #include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <string.h>
 #include <sys/stat.h>
 
+#include <limits>
+#include <locale>
+#include <vector>
+
 // I need a safe way to read a line of arbitrary length.  It exists on
 // some platforms but not others so I'm afraid I have to write it
 // myself.
@@ -268,156 +278,326 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
-// Internal function to read in an integer value.
-// Returns zero if there was an error.
-int vtkDataReader::Read(char *result)
+// The whitespace of the C locale, which separates the values.
+static inline bool vtkDataReaderIsSpace(int c)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  return (c == ' ' || (c >= '\t' && c <= '\r'));
+}
+
+// Parse an integer without the stream locale.  Like the stream, a
+// negative value is wrapped for unsigned types.
+template <class T>
+static bool vtkDataReaderParseValue(const char *s, const char *end, T *result)
+{
+  bool negative = false;
+  if (s != end && (*s == '-' || *s == '+'))
     {
-    return 0;
+    negative = (*s++ == '-');
+    }
+  if (s == end)
+    {
+    return false;
+    }
+  vtkTypeUInt64 maxValue = static_cast<vtkTypeUInt64>(
+    std::numeric_limits<T>::max());
+  if (negative && std::numeric_limits<T>::is_signed)
+    {
+    maxValue += 1;
     }
+  vtkTypeUInt64 value = 0;
+  for (; s != end; ++s)
+    {
+    unsigned int digit = static_cast<unsigned int>(*s - '0');
+    if (digit > 9 || value > (maxValue - digit)/10)
+      {
+      return false;
+      }
+    value = value*10 + digit;
+    }
+  if (negative)
+    {
+    value = ~value + 1;
+    }
+  *result = static_cast<T>(value);
+  return true;
+}
 
-  *result = (char) intData;
-  return 1;
+// The characters are read as integers.
+static bool vtkDataReaderParseValue(const char *s, const char *end,
+                                    char *result)
+{
+  int value;
+  bool ok = vtkDataReaderParseValue(s, end, &value);
+  *result = static_cast<char>(value);
+  return ok;
 }
 
-int vtkDataReader::Read(unsigned char *result)
+static bool vtkDataReaderParseValue(const char *s, const char *end,
+                                    signed char *result)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
+  int value;
+  bool ok = vtkDataReaderParseValue(s, end, &value);
+  *result = static_cast<signed char>(value);
+  return ok;
+}
 
-  *result = (unsigned char) intData;
-  return 1;
+static bool vtkDataReaderParseValue(const char *s, const char *end,
+                                    unsigned char *result)
+{
+  int value;
+  bool ok = vtkDataReaderParseValue(s, end, &value);
+  *result = static_cast<unsigned char>(value);
+  return ok;
 }
 
-int vtkDataReader::Read(short *result)
+// The powers of ten that are exact in each type.
+static const double vtkDataReaderDoublePowers[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+  1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+static const float vtkDataReaderFloatPowers[11] = {
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+// Parse a real number with a mantissa and a power of ten that are both
+// exact in the type, which gives the correctly rounded value.  Returns
+// false for the other numbers, which need the slow path.
+template <class T>
+static bool vtkDataReaderParseExactReal(
+  const char *s, const char *end, int maxDigits, int maxPower,
+  const T *powers, T *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  bool negative = false;
+  if (s != end && (*s == '-' || *s == '+'))
     {
-    return 0;
+    negative = (*s++ == '-');
     }
-  return 1;
+  vtkTypeUInt64 mantissa = 0;
+  int digits = 0;
+  int power = 0;
+  bool hasDigits = false;
+  for (; s != end && *s >= '0' && *s <= '9'; ++s)
+    {
+    hasDigits = true;
+    mantissa = mantissa*10 + (*s - '0');
+    digits += (mantissa != 0);
+    }
+  if (s != end && *s == '.')
+    {
+    for (++s; s != end && *s >= '0' && *s <= '9'; ++s)
+      {
+      hasDigits = true;
+      mantissa = mantissa*10 + (*s - '0');
+      digits += (mantissa != 0);
+      power--;
+      }
+    }
+  if (!hasDigits || digits > maxDigits)
+    {
+    return false;
+    }
+  if (s != end && (*s == 'e' || *s == 'E'))
+    {
+    int exponent;
+    if (!vtkDataReaderParseValue(s + 1, end, &exponent))
+      {
+      return false;
+      }
+    power = (exponent > 1000 ? 1000 :
+             (exponent < -1000 ? -1000 : exponent)) + power;
+    s = end;
+    }
+  // the limit on the digits keeps the mantissa below 2^53 or 2^24
+  if (s != end || power > maxPower || power < -maxPower)
+    {
+    return false;
+    }
+  T value = static_cast<T>(mantissa);
+  value = (power < 0 ? value/powers[-power] : value*powers[power]);
+  *result = (negative ? -value : value);
+  return true;
 }
 
-int vtkDataReader::Read(unsigned short *result)
+// Parse with strtod when the C library uses the same decimal point as the
+// file, or else with a stream in the classic locale.
+static bool vtkDataReaderParseSlowReal(const char *s, const char *end,
+                                       double *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  char token[256];
+  size_t length = end - s;
+  if (length == 0 || length > 255)
     {
-    return 0;
+    return false;
     }
-  return 1;
+  memcpy(token, s, length);
+  token[length] = '\0';
+  if (localeconv()->decimal_point[0] == '.')
+    {
+    char *tokenEnd;
+    errno = 0;
+    *result = strtod(token, &tokenEnd);
+    // like the stream, fail on overflow but keep the denormal numbers
+    return (tokenEnd == token + length &&
+            !(errno == ERANGE && fabs(*result) == HUGE_VAL));
+    }
+  vtksys_ios::istringstream is(token);
+  is.imbue(std::locale::classic());
+  is >> *result;
+  return (!is.fail() && is.eof());
 }
 
-int vtkDataReader::Read(int *result)
+static bool vtkDataReaderParseSlowReal(const char *s, const char *end,
+                                       float *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  vtksys_ios::istringstream is(std::string(s, end));
+  is.imbue(std::locale::classic());
+  is >> *result;
+  return (!is.fail() && is.eof());
+}
+
+static bool vtkDataReaderParseValue(const char *s, const char *end,
+                                    double *result)
+{
+  return (vtkDataReaderParseExactReal(
+            s, end, 15, 22, vtkDataReaderDoublePowers, result) ||
+          vtkDataReaderParseSlowReal(s, end, result));
+}
+
+static bool vtkDataReaderParseValue(const char *s, const char *end,
+                                    float *result)
+{
+  if (vtkDataReaderParseExactReal(
+        s, end, 7, 10, vtkDataReaderFloatPowers, result))
     {
-    return 0;
+    return true;
     }
-  return 1;
+  // rounding the double to float is the same as rounding the number,
+  // except when the double is halfway between two normal floats
+  double value;
+  if (!vtkDataReaderParseSlowReal(s, end, &value))
+    {
+    return false;
+    }
+  vtkTypeUInt64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (fabs(value) < FLT_MIN || fabs(value) > FLT_MAX ||
+      (bits & 0x1FFFFFFF) == 0x10000000)
+    {
+    return vtkDataReaderParseSlowReal(s, end, result);
+    }
+  *result = static_cast<float>(value);
+  return true;
 }
 
-int vtkDataReader::Read(unsigned int *result)
+// Read the next value directly from the stream buffer, which avoids the
+// cost of the stream sentry and locale for each value.  The stream state
+// is set like the extraction operator does.
+template <class T>
+static int vtkDataReaderReadValue(istream *IS, T *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  if (!IS->good())
     {
+    IS->setstate(ios::failbit);
+    return 0;
+    }
+  std::streambuf *sb = IS->rdbuf();
+  int c = sb->sgetc();
+  while (c != EOF && vtkDataReaderIsSpace(c))
+    {
+    c = sb->snextc();
+    }
+  char token[256];
+  size_t length = 0;
+  while (c != EOF && !vtkDataReaderIsSpace(c) && length < 255)
+    {
+    token[length++] = static_cast<char>(c);
+    c = sb->snextc();
+    }
+  if (c == EOF)
+    {
+    IS->setstate(ios::eofbit);
+    }
+  if (length == 0 || length == 255 ||
+      !vtkDataReaderParseValue(token, token + length, result))
+    {
+    IS->setstate(ios::failbit);
     return 0;
     }
   return 1;
 }
 
+// Internal function to read in an integer value.
+// Returns zero if there was an error.
+int vtkDataReader::Read(char *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned char *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(short *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned short *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(int *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned int *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
 int vtkDataReader::Read(long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 #if defined(VTK_TYPE_USE___INT64)
 int vtkDataReader::Read(__int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned __int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 #if defined(VTK_TYPE_USE_LONG_LONG)
 int vtkDataReader::Read(long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 int vtkDataReader::Read(float *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(double *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 
@@ -1372,23 +1552,183 @@ int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
   return 1;
 }
 
-// General templated function to read data of various types.
+// Parse the values of a chunk of text, one chunk per task.
 template <class T>
-int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
+class vtkDataReaderParseFunctor
 {
-  int i, j;
+public:
+  vtkDataReaderParseFunctor(const std::vector<char> *text,
+                            const std::vector<size_t> *chunkStarts,
+                            const std::vector<vtkIdType> *chunkValues,
+                            T *data, std::vector<char> *chunkErrors) :
+    Text(text), ChunkStarts(chunkStarts), ChunkValues(chunkValues),
+    Data(data), ChunkErrors(chunkErrors) {}
 
-  for (i=0; i<numTuples; i++)
+  void operator()(vtkIdType begin, vtkIdType end) const
     {
-    for (j=0; j<numComp; j++)
+    for (vtkIdType i = begin; i < end; i++)
       {
-      if ( !self->Read(data++) )
+      const char *s = &(*this->Text)[0] + (*this->ChunkStarts)[i];
+      T *data = this->Data + (*this->ChunkValues)[i];
+      T *dataEnd = this->Data + (*this->ChunkValues)[i + 1];
+      // a value that crosses the start of the chunk belongs to the
+      // previous chunk
+      if ((*this->ChunkStarts)[i] > 0 && !vtkDataReaderIsSpace(s[-1]))
+        {
+        while (*s != '\0' && !vtkDataReaderIsSpace(*s))
+          {
+          ++s;
+          }
+        }
+      while (data != dataEnd)
+        {
+        while (vtkDataReaderIsSpace(*s))
+          {
+          ++s;
+          }
+        const char *tokenEnd = s;
+        while (*tokenEnd != '\0' && !vtkDataReaderIsSpace(*tokenEnd))
+          {
+          ++tokenEnd;
+          }
+        if (!vtkDataReaderParseValue(s, tokenEnd, data++))
+          {
+          (*this->ChunkErrors)[i] = 1;
+          break;
+          }
+        s = tokenEnd;
+        }
+      }
+    }
+
+private:
+  const std::vector<char> *Text;
+  const std::vector<size_t> *ChunkStarts;
+  const std::vector<vtkIdType> *ChunkValues;
+  T *Data;
+  std::vector<char> *ChunkErrors;
+};
+
+// Read the text of many values from the stream buffer and parse it in
+// parallel.  The stream cannot be rewound, so the text is read in pieces
+// that are too short to go past the last value: each of the remaining
+// values takes at least one character plus a separator.  At most
+// VTK_DATA_READER_WINDOW values are held as text at once.
+#define VTK_DATA_READER_WINDOW 4194304
+#define VTK_DATA_READER_CHUNK 262144
+template <class T>
+static int vtkDataReaderReadValues(istream *IS, T *data, vtkIdType n)
+{
+  if (n < 1024)
+    {
+    for (vtkIdType i = 0; i < n; i++)
+      {
+      if (!vtkDataReaderReadValue(IS, data + i))
         {
-        vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
         return 0;
         }
       }
+    return 1;
+    }
+  if (!IS->good())
+    {
+    IS->setstate(ios::failbit);
+    return 0;
+    }
+  std::streambuf *sb = IS->rdbuf();
+  std::vector<char> text;
+  std::vector<size_t> chunkStarts;
+  std::vector<vtkIdType> chunkValues;
+  std::vector<char> chunkErrors;
+
+  while (n > 0)
+    {
+    vtkIdType numValues = (n < VTK_DATA_READER_WINDOW ?
+                           n : VTK_DATA_READER_WINDOW);
+    text.clear();
+    chunkStarts.assign(1, 0);
+    chunkValues.assign(1, 0);
+    vtkIdType count = 0;
+    bool inToken = false;
+    bool atEnd = false;
+    while (count < numValues && !atEnd)
+      {
+      vtkIdType remaining = numValues - count;
+      size_t size = static_cast<size_t>(2*remaining - (inToken ? 0 : 1));
+      size = (size < VTK_DATA_READER_CHUNK ? size : VTK_DATA_READER_CHUNK);
+      size_t pos = text.size();
+      text.resize(pos + size);
+      size_t got = static_cast<size_t>(sb->sgetn(&text[pos], size));
+      text.resize(pos + got);
+      atEnd = (got < size);
+      // count the starts of the values without branches
+      const char *q = &text[0] + pos;
+      const char *qEnd = q + got;
+      if (q != qEnd)
+        {
+        count += (!inToken && !vtkDataReaderIsSpace(*q));
+        for (++q; q != qEnd; ++q)
+          {
+          count += (vtkDataReaderIsSpace(q[-1]) && !vtkDataReaderIsSpace(*q));
+          }
+        inToken = !vtkDataReaderIsSpace(qEnd[-1]);
+        }
+      if (text.size() - chunkStarts.back() >= VTK_DATA_READER_CHUNK)
+        {
+        chunkStarts.push_back(text.size());
+        chunkValues.push_back(count);
+        }
+      }
+    // finish the last value
+    int c = (atEnd ? EOF : sb->sgetc());
+    while (c != EOF && !vtkDataReaderIsSpace(c))
+      {
+      text.push_back(static_cast<char>(c));
+      c = sb->snextc();
+      }
+    if (c == EOF)
+      {
+      IS->setstate(ios::eofbit);
+      }
+    if (count < numValues)
+      {
+      IS->setstate(ios::failbit);
+      return 0;
+      }
+    chunkStarts.push_back(text.size());
+    chunkValues.push_back(count);
+    // the parsing stops at the null character after the last value
+    text.push_back('\0');
+
+    vtkIdType numChunks = static_cast<vtkIdType>(chunkStarts.size()) - 1;
+    chunkErrors.assign(numChunks, 0);
+    vtkDataReaderParseFunctor<T> functor(
+      &text, &chunkStarts, &chunkValues, data, &chunkErrors);
+    vtkSMPTools::For(0, numChunks, 1, functor);
+    for (vtkIdType i = 0; i < numChunks; i++)
+      {
+      if (chunkErrors[i])
+        {
+        IS->setstate(ios::failbit);
+        return 0;
+        }
+      }
+    data += numValues;
+    n -= numValues;
+    }
+  return 1;
+}
+
+// General templated function to read data of various types.
+template <class T>
+int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
+{
+  vtkIdType n = static_cast<vtkIdType>(numTuples)*numComp;
+  if (!vtkDataReaderReadValues(self->GetIStream(), data, n))
+    {
+    vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+      "datasize with declaration.");
+    return 0;
     }
   return 1;
 }
@@ -2590,7 +2930,6 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(int size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
     {
@@ -2607,14 +2946,11 @@ int vtkDataReader::ReadCells(int size, int *data)
     }
   else // ascii
     {
-    for (i=0; i<size; i++)
+    if (!vtkDataReaderReadValues(this->IS, data, size))
       {
-      if (!this->Read(data+i))
-        {
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
-                      << (this->FileName?this->FileName:"(Null FileName)"));
-        return 0;
-        }
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
+                    << (this->FileName?this->FileName:"(Null FileName)"));
+      return 0;
       }
     }
 
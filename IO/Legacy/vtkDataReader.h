@@ -19,6 +19,9 @@
 // scalars, vectors, normals, etc.) from a vtk data file.  See text for
 // the format of the various vtk file types.
 //
+// The values of ASCII files are parsed without the stream locale, and the
+// large arrays and cell lists are parsed in parallel with vtkSMPTools.
+//
 // .SECTION See Also
 // vtkPolyDataReader vtkStructuredPointsReader vtkStructuredGridReader
 // vtkUnstructuredGridReader vtkRectilinearGridReader
@@ -288,7 +291,8 @@ public:
 //BTX
   // Description:
   // Internal function to read in a value.  Returns zero if there was an
-  // error.
+  // error.  The value is read directly from the stream buffer, and the
+  // stream state is set like the extraction operator does.
   int Read(char *);
   int Read(unsigned char *);
   int Read(short *);
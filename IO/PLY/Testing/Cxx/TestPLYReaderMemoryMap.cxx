@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads an ASCII PLY file large enough to be parsed in several chunks,
+// with and without memory mapping, and checks that the outputs are the
+// same.  The vertices have normals, texture coordinates, colors and
+// properties that are not read, the faces have colors and several sizes.
+// Then checks that truncated files are reported.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+const int NumberOfVertices = 40000;
+const int NumberOfFaces = 25000;
+
+// Write the file, without the last lines if truncate is set.
+void WriteFile(const std::string& fileName, int truncate)
+{
+  FILE* fp = fopen(fileName.c_str(), "wb");
+  fprintf(fp, "ply\nformat ascii 1.0\ncomment a comment\n"
+          "element vertex %d\n"
+          "property float x\nproperty float y\nproperty double z\n"
+          "property float confidence\nproperty list uchar int ignored\n"
+          "property float nx\nproperty float ny\nproperty float nz\n"
+          "property float u\nproperty float v\n"
+          "property uchar red\nproperty uchar green\nproperty int blue\n"
+          "element face %d\n"
+          "property list uchar int vertex_index\n"
+          "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+          "element edge 2\nproperty int vertex1\nproperty int vertex2\n"
+          "end_header\n", NumberOfVertices, NumberOfFaces);
+  for (int i = 0; i < NumberOfVertices; ++i)
+    {
+    fprintf(fp, "%g %.9g %.17g 0.5 %d", i*0.1, i/7.0, -i/3.0, i % 3);
+    for (int j = 0; j < i % 3; ++j)
+      {
+      fprintf(fp, " %d", j);
+      }
+    fprintf(fp, " %g %g %g\t%g %g%s%d %d %d\n", (i % 3)*0.5, 0.25, -1.0,
+            0.0, i*1e-3, (i % 2 ? " " : " \t "), i % 256, (3*i) % 256,
+            i % 300);
+    }
+  for (int i = 0; i < NumberOfFaces - truncate; ++i)
+    {
+    int n = 3 + i % 3;
+    fprintf(fp, "%d", n);
+    for (int j = 0; j < n; ++j)
+      {
+      fprintf(fp, " %d", (i + 7*j) % NumberOfVertices);
+      }
+    fprintf(fp, " %d %d %d%s", i % 256, 255, 0, (i % 5 ? "\n" : "\r\n"));
+    }
+  if (!truncate)
+    {
+    fprintf(fp, "0 1\n1 2");
+    }
+  else
+    {
+    // the last face misses a vertex
+    fprintf(fp, "4 1 2 3\n");
+    }
+  fclose(fp);
+}
+
+vtkSmartPointer<vtkPolyData> Read(const std::string& fileName, bool mapped,
+                                  vtkTest::ErrorObserver* observer)
+{
+  vtkNew<vtkPLYReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapASCIIFile(mapped);
+  reader->AddObserver(vtkCommand::ErrorEvent, observer);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* output)
+{
+  bool same = (expected && output &&
+               expected->GetNumberOfTuples() == output->GetNumberOfTuples() &&
+               expected->GetNumberOfComponents() ==
+               output->GetNumberOfComponents() &&
+               expected->GetDataType() == output->GetDataType() &&
+               expected->GetNumberOfTuples() > 0);
+  for (vtkIdType i = 0; same && i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < expected->GetNumberOfComponents(); ++j)
+      {
+      same &= (expected->GetComponent(i, j) == output->GetComponent(i, j));
+      }
+    }
+  return same;
+}
+}
+
+int TestPLYReaderMemoryMap(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestPLYReaderMemoryMap.ply";
+  delete [] tempDir;
+
+  WriteFile(fileName, 0);
+  vtkNew<vtkTest::ErrorObserver> observer;
+  vtkSmartPointer<vtkPolyData> expected =
+    Read(fileName, false, observer.GetPointer());
+  vtkSmartPointer<vtkPolyData> output =
+    Read(fileName, true, observer.GetPointer());
+  if (observer->GetError() ||
+      expected->GetNumberOfPoints() != NumberOfVertices ||
+      expected->GetNumberOfPolys() != NumberOfFaces ||
+      output->GetNumberOfPolys() != NumberOfFaces)
+    {
+    cerr << "Error: could not read the file" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkDataArray* expectedArrays[6] = {
+    expected->GetPoints()->GetData(), expected->GetPointData()->GetNormals(),
+    expected->GetPointData()->GetTCoords(),
+    expected->GetPointData()->GetScalars(),
+    expected->GetCellData()->GetScalars(), expected->GetPolys()->GetData() };
+  vtkDataArray* outputArrays[6] = {
+    output->GetPoints()->GetData(), output->GetPointData()->GetNormals(),
+    output->GetPointData()->GetTCoords(),
+    output->GetPointData()->GetScalars(),
+    output->GetCellData()->GetScalars(), output->GetPolys()->GetData() };
+  for (int i = 0; i < 6; ++i)
+    {
+    if (!CompareArrays(expectedArrays[i], outputArrays[i]))
+      {
+      cerr << "Error: the arrays "
+           << (expectedArrays[i] ? expectedArrays[i]->GetName() : "(none)")
+           << " are different" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // a face that misses a vertex, then faces that are missing
+  for (int truncate = 1; truncate < 3; ++truncate)
+    {
+    WriteFile(fileName, truncate);
+    observer->Clear();
+    Read(fileName, true, observer.GetPointer());
+    if (!observer->GetError())
+      {
+      cerr << "Error: the truncated file was read" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -4,6 +4,7 @@ vtk_module(vtkIOPLY
   DEPENDS
     vtkCommonMisc
     vtkCommonExecutionModel
+    vtkIOCore
     vtkIOGeometry
   TEST_DEPENDS
     vtkRendering${VTK_RENDERING_BACKEND}
@@ -18,15 +18,22 @@
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPLY.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
 #include <ctype.h>
 #include <stddef.h>
+#include <string.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
 
@@ -35,6 +42,7 @@ vtkStandardNewMacro(vtkPLYReader);
 vtkPLYReader::vtkPLYReader()
 {
   this->FileName = NULL;
+  this->MemoryMapASCIIFile = 0;
 
   this->SetNumberOfInputPorts(0);
 }
@@ -176,7 +184,7 @@ int vtkPLYReader::RequestData(
        vtkPLY::find_property (elem, "green", &index) != NULL &&
        vtkPLY::find_property (elem, "blue", &index) != NULL )
     {
-    RGBPoints = vtkUnsignedCharArray::New();
+    RGBPoints = vtkSmartPointer<vtkUnsignedCharArray>::New();
     RGBPointsAvailable = true;
     RGBPoints->SetName("RGB");
     RGBPoints->SetNumberOfComponents(3);
@@ -210,6 +218,18 @@ int vtkPLYReader::RequestData(
     output->GetPointData()->SetTCoords(TexCoordsPoints);
     }
 
+  if ( this->MemoryMapASCIIFile && fileType == PLY_ASCII )
+    {
+    for (int i = 0; i < nelems; i++)
+      {
+      free(elist[i]); //allocated by ply_open_for_reading
+      }
+    free(elist);
+    int result = this->ReadMappedASCIIFile(ply, output);
+    vtkPLY::ply_close (ply);
+    return result;
+    }
+
   // Okay, now we can grab the data
   int numPts = 0, numPolys = 0;
   for (int i = 0; i < nelems; i++)
@@ -345,6 +365,425 @@ int vtkPLYReader::RequestData(
   return 1;
 }
 
+// Files are parsed in parallel in chunks of about this many bytes.
+#define VTK_PLY_CHUNK_SIZE (1 << 20)
+
+// Where a property of the lines of an element is stored, if it is.
+struct vtkPLYReaderProperty
+{
+  PlyProperty *Property;
+  float *Floats;
+  unsigned char *UChars;
+  int Stride;
+  bool VertexIndices;
+};
+
+struct vtkPLYReaderElement
+{
+  vtkIdType FirstLine;
+  vtkIdType NumberOfLines;
+  std::vector<vtkPLYReaderProperty> Properties;
+};
+
+// A chunk of whole lines of the file, and the faces it defines in the
+// legacy layout of vtkCellArray.
+struct vtkPLYReaderChunk
+{
+  const char *Begin;
+  const char *End;
+  vtkIdType FirstLine;
+  vtkIdType NumberOfLines;
+  std::vector<vtkIdType> Cells;
+  vtkIdType NumberOfCells;
+  vtkIdType CellOffset;
+  // the first line that cannot be parsed, or -1
+  vtkIdType ErrorLine;
+};
+
+class vtkPLYReaderCountFunctor
+{
+public:
+  vtkPLYReaderChunk *Chunks;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkPLYReaderChunk& chunk = this->Chunks[i];
+      chunk.NumberOfLines = std::count(chunk.Begin, chunk.End, '\n');
+      // the last line may have no end of line
+      chunk.NumberOfLines += (chunk.End[-1] != '\n');
+      }
+  }
+};
+
+// Get the next word of a line, the words being separated by the spaces,
+// tabs and carriage returns like in vtkPLY::get_words().
+static bool vtkPLYReaderNextWord(const char *&p, const char *end,
+                                 char word[256])
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    {
+    ++p;
+    }
+  int n = 0;
+  while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+    {
+    if (n < 255)
+      {
+      word[n++] = *p;
+      }
+    ++p;
+    }
+  word[n] = '\0';
+  return (n > 0);
+}
+
+// Parse the lines of each chunk like vtkPLY::ascii_get_element().
+class vtkPLYReaderParseFunctor
+{
+public:
+  vtkPLYReaderElement *Elements;
+  int NumberOfElements;
+  vtkPLYReaderChunk *Chunks;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Parse(this->Chunks[i]);
+      }
+  }
+
+  void Parse(vtkPLYReaderChunk& chunk) const
+  {
+    chunk.NumberOfCells = 0;
+    chunk.ErrorLine = -1;
+    int e = 0;
+    vtkIdType line = chunk.FirstLine;
+    char word[256];
+    for (const char *next = chunk.Begin; next < chunk.End; ++line)
+      {
+      const char *p = next;
+      const char *lineEnd = static_cast<const char *>(
+        memchr(p, '\n', chunk.End - p));
+      lineEnd = (lineEnd ? lineEnd : chunk.End);
+      next = lineEnd + 1;
+
+      while (e < this->NumberOfElements &&
+             line >= this->Elements[e].FirstLine +
+                     this->Elements[e].NumberOfLines)
+        {
+        ++e;
+        }
+      if (e == this->NumberOfElements)
+        {
+        // the lines after the elements are ignored
+        break;
+        }
+      const vtkPLYReaderElement& element = this->Elements[e];
+      vtkIdType index = line - element.FirstLine;
+
+      int intVal;
+      unsigned int uintVal;
+      double doubleVal;
+      bool ok = true;
+      size_t numProps = element.Properties.size();
+      for (size_t j = 0; j < numProps && ok; ++j)
+        {
+        const vtkPLYReaderProperty& prop = element.Properties[j];
+        PlyProperty *plyProp = prop.Property;
+        if (!vtkPLYReaderNextWord(p, lineEnd, word))
+          {
+          ok = false;
+          break;
+          }
+        if (plyProp->is_list)
+          {
+          vtkPLY::get_ascii_item(word, plyProp->count_external,
+                                 &intVal, &uintVal, &doubleVal);
+          int count = intVal;
+          if (count < 0)
+            {
+            ok = false;
+            break;
+            }
+          if (prop.VertexIndices)
+            {
+            chunk.Cells.push_back(count);
+            chunk.NumberOfCells++;
+            }
+          for (int k = 0; k < count && ok; ++k)
+            {
+            ok = vtkPLYReaderNextWord(p, lineEnd, word);
+            if (ok && prop.VertexIndices)
+              {
+              vtkPLY::get_ascii_item(word, plyProp->external_type,
+                                     &intVal, &uintVal, &doubleVal);
+              chunk.Cells.push_back(intVal);
+              }
+            }
+          }
+        else if (prop.Floats || prop.UChars)
+          {
+          vtkPLY::get_ascii_item(word, plyProp->external_type,
+                                 &intVal, &uintVal, &doubleVal);
+          if (prop.Floats)
+            {
+            prop.Floats[prop.Stride*index] = static_cast<float>(doubleVal);
+            }
+          else
+            {
+            prop.UChars[prop.Stride*index] =
+              static_cast<unsigned char>(uintVal);
+            }
+          }
+        }
+      if (!ok)
+        {
+        chunk.ErrorLine = line;
+        break;
+        }
+      }
+  }
+};
+
+class vtkPLYReaderMergeFunctor
+{
+public:
+  const vtkPLYReaderChunk *Chunks;
+  vtkIdType *Cells;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const vtkPLYReaderChunk& chunk = this->Chunks[i];
+      if (!chunk.Cells.empty())
+        {
+        memcpy(this->Cells + chunk.CellOffset, &chunk.Cells[0],
+               chunk.Cells.size()*sizeof(vtkIdType));
+        }
+      }
+  }
+};
+
+int vtkPLYReader::ReadMappedASCIIFile(PlyFile *ply, vtkPolyData *output)
+{
+  vtkDebugMacro(<< "Parsing the mapped file in parallel");
+
+  // the elements start after the header
+  long headerSize = ftell(ply->fp);
+  vtkMemoryMappedFile *mappedFile = vtkMemoryMappedFile::New();
+  if (headerSize < 0 || !mappedFile->Open(this->FileName) ||
+      mappedFile->GetSize() < static_cast<size_t>(headerSize))
+    {
+    vtkErrorMacro(<< "Could not map the file " << this->FileName);
+    mappedFile->Delete();
+    return 0;
+    }
+  const char *data = reinterpret_cast<const char *>(mappedFile->GetData());
+  const char *dataEnd = data + mappedFile->GetSize();
+  vtkIdType numHeaderLines = std::count(data, data + headerSize, '\n');
+  data += headerSize;
+
+  // Create the arrays of the vertices and faces, and find where their
+  // properties go.
+  vtkPointData *pd = output->GetPointData();
+  vtkCellData *cd = output->GetCellData();
+  vtkFloatArray *tcoords = vtkFloatArray::SafeDownCast(pd->GetTCoords());
+  vtkFloatArray *normals = vtkFloatArray::SafeDownCast(pd->GetNormals());
+  vtkUnsignedCharArray *rgbPoints =
+    vtkUnsignedCharArray::SafeDownCast(pd->GetScalars());
+  vtkUnsignedCharArray *intensity =
+    vtkUnsignedCharArray::SafeDownCast(cd->GetArray("intensity"));
+  vtkUnsignedCharArray *rgbCells =
+    vtkUnsignedCharArray::SafeDownCast(cd->GetArray("RGB"));
+  vtkPoints *pts = NULL;
+  bool hasFaces = false;
+  vtkIdType numPts = 0, numPolys = 0;
+  std::vector<vtkPLYReaderElement> elements(ply->nelems);
+  vtkIdType numLines = 0;
+  for (int i = 0; i < ply->nelems; ++i)
+    {
+    PlyElement *elem = ply->elems[i];
+    vtkPLYReaderElement& element = elements[i];
+    element.FirstLine = numLines;
+    element.NumberOfLines = elem->num;
+    numLines += elem->num;
+
+    // the properties of the vertices and faces are read only once
+    bool isVertex = (strcmp(elem->name, "vertex") == 0 && !pts);
+    bool isFace = (strcmp(elem->name, "face") == 0 && !hasFaces);
+    if (isVertex)
+      {
+      numPts = elem->num;
+      pts = vtkPoints::New();
+      pts->SetDataTypeToFloat();
+      pts->SetNumberOfPoints(numPts);
+      vtkDataArray *arrays[3] = { tcoords, normals, rgbPoints };
+      for (int j = 0; j < 3; ++j)
+        {
+        if (arrays[j])
+          {
+          arrays[j]->SetNumberOfTuples(numPts);
+          }
+        }
+      }
+    else if (isFace)
+      {
+      hasFaces = true;
+      numPolys = elem->num;
+      if (intensity)
+        {
+        intensity->SetNumberOfTuples(numPolys);
+        }
+      if (rgbCells)
+        {
+        rgbCells->SetNumberOfComponents(3);
+        rgbCells->SetNumberOfTuples(numPolys);
+        }
+      }
+
+    element.Properties.resize(elem->nprops);
+    for (int j = 0; j < elem->nprops; ++j)
+      {
+      vtkPLYReaderProperty& prop = element.Properties[j];
+      prop.Property = elem->props[j];
+      prop.Floats = NULL;
+      prop.UChars = NULL;
+      prop.Stride = 1;
+      prop.VertexIndices = false;
+      const char *name = prop.Property->name;
+      if (prop.Property->is_list)
+        {
+        prop.VertexIndices = (isFace && strcmp(name, "vertex_indices") == 0);
+        continue;
+        }
+      const char *names[3] = { "red", "green", "blue" };
+      for (int k = 0; k < 3; ++k)
+        {
+        const char *coords[3] = { "x", "y", "z" };
+        const char *normalCoords[3] = { "nx", "ny", "nz" };
+        const char *tcoordCoords[2] = { "u", "v" };
+        if (isVertex && strcmp(name, coords[k]) == 0)
+          {
+          prop.Floats = static_cast<float *>(pts->GetVoidPointer(0)) + k;
+          prop.Stride = 3;
+          }
+        else if (isVertex && normals && strcmp(name, normalCoords[k]) == 0)
+          {
+          prop.Floats = normals->GetPointer(0) + k;
+          prop.Stride = 3;
+          }
+        else if (isVertex && tcoords && k < 2 &&
+                 strcmp(name, tcoordCoords[k]) == 0)
+          {
+          prop.Floats = tcoords->GetPointer(0) + k;
+          prop.Stride = 2;
+          }
+        else if (isVertex && rgbPoints && strcmp(name, names[k]) == 0)
+          {
+          prop.UChars = rgbPoints->GetPointer(0) + k;
+          prop.Stride = 3;
+          }
+        else if (isFace && rgbCells && strcmp(name, names[k]) == 0)
+          {
+          prop.UChars = rgbCells->GetPointer(0) + k;
+          prop.Stride = 3;
+          }
+        }
+      if (isFace && intensity && strcmp(name, "intensity") == 0)
+        {
+        prop.UChars = intensity->GetPointer(0);
+        }
+      }
+    }
+
+  // Cut the lines in chunks, find the first line of each chunk, then
+  // parse them.
+  std::vector<vtkPLYReaderChunk> chunks;
+  for (const char *begin = data; begin < dataEnd; )
+    {
+    const char *end = dataEnd;
+    if (dataEnd - begin > VTK_PLY_CHUNK_SIZE)
+      {
+      end = static_cast<const char *>(
+        memchr(begin + VTK_PLY_CHUNK_SIZE, '\n',
+               dataEnd - begin - VTK_PLY_CHUNK_SIZE));
+      end = (end ? end + 1 : dataEnd);
+      }
+    chunks.resize(chunks.size() + 1);
+    chunks.back().Begin = begin;
+    chunks.back().End = end;
+    begin = end;
+    }
+  vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  vtkPLYReaderCountFunctor counter;
+  counter.Chunks = (numChunks ? &chunks[0] : NULL);
+  vtkSMPTools::For(0, numChunks, 1, counter);
+  vtkIdType line = 0;
+  for (vtkIdType i = 0; i < numChunks; ++i)
+    {
+    chunks[i].FirstLine = line;
+    line += chunks[i].NumberOfLines;
+    }
+
+  vtkPLYReaderParseFunctor parser;
+  parser.Elements = (ply->nelems ? &elements[0] : NULL);
+  parser.NumberOfElements = ply->nelems;
+  parser.Chunks = counter.Chunks;
+  vtkSMPTools::For(0, numChunks, 1, parser);
+  mappedFile->Delete();
+
+  // Report the first error, then concatenate the faces.
+  int result = 1;
+  vtkIdType numCells = 0, numEntries = 0;
+  for (vtkIdType i = 0; i < numChunks && result; ++i)
+    {
+    if (chunks[i].ErrorLine >= 0)
+      {
+      vtkErrorMacro(<< "Error reading line "
+                    << numHeaderLines + chunks[i].ErrorLine + 1 << " of "
+                    << this->FileName);
+      result = 0;
+      }
+    chunks[i].CellOffset = numEntries;
+    numEntries += static_cast<vtkIdType>(chunks[i].Cells.size());
+    numCells += chunks[i].NumberOfCells;
+    }
+  if (result && line < numLines)
+    {
+    vtkErrorMacro(<< "Premature end of file " << this->FileName);
+    result = 0;
+    }
+
+  if (pts)
+    {
+    output->SetPoints(pts);
+    pts->Delete();
+    }
+  if (result && hasFaces)
+    {
+    vtkIdTypeArray *cells = vtkIdTypeArray::New();
+    cells->SetNumberOfValues(numEntries);
+    vtkPLYReaderMergeFunctor merger;
+    merger.Chunks = counter.Chunks;
+    merger.Cells = cells->GetPointer(0);
+    vtkSMPTools::For(0, numChunks, 1, merger);
+    vtkCellArray *polys = vtkCellArray::New();
+    polys->SetCells(numCells, cells);
+    output->SetPolys(polys);
+    polys->Delete();
+    cells->Delete();
+    }
+
+  vtkDebugMacro( <<"Read: " << numPts << " points, "
+                 << numPolys << " polygons");
+
+  return result;
+}
+
 int vtkPLYReader::CanReadFile(const char *filename)
 {
   FILE *fd = fopen(filename, "rb");
@@ -362,4 +801,6 @@ void vtkPLYReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "File Name: "
      << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "MemoryMapASCIIFile: "
+     << (this->MemoryMapASCIIFile ? "On\n" : "Off\n");
 }
@@ -23,6 +23,10 @@
 // element has the properties "intensity" and/or the triplet "red",
 // "green", and "blue"; these are read and added as scalars to the
 // output data.
+//
+// ASCII files can also be read from a memory mapping of the file, which is
+// cut into chunks of whole lines that are parsed in parallel, see
+// MemoryMapASCIIFile.
 
 // .SECTION See Also
 // vtkPLYWriter
@@ -33,6 +37,8 @@
 #include "vtkIOPLYModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+struct PlyFile;
+
 class VTKIOPLY_EXPORT vtkPLYReader : public vtkPolyDataAlgorithm
 {
 public:
@@ -52,13 +58,29 @@ public:
   // A simple, non-exhaustive check to see if a file is a valid ply file.
   static int CanReadFile(const char *filename);
 
+  // Description:
+  // Turn on/off reading ASCII files from a memory mapping of the file.
+  // The lines of the vertices and faces are then parsed in parallel with
+  // vtkSMPTools, each vertex being stored directly at its index and the
+  // faces of each chunk of lines being concatenated in order.  Binary
+  // files are read as usual.  Off by default.
+  vtkSetMacro(MemoryMapASCIIFile,int);
+  vtkGetMacro(MemoryMapASCIIFile,int);
+  vtkBooleanMacro(MemoryMapASCIIFile,int);
+
 protected:
   vtkPLYReader();
   ~vtkPLYReader();
 
   char *FileName;
+  int MemoryMapASCIIFile;
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
+  // Description:
+  // Read the elements of an ASCII file whose header has been read, in
+  // parallel, into the output whose arrays have been created.
+  int ReadMappedASCIIFile(PlyFile *ply, vtkPolyData *output);
 private:
   vtkPLYReader(const vtkPLYReader&);  // Not implemented.
   void operator=(const vtkPLYReader&);  // Not implemented.
@@ -0,0 +1,154 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompression.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Round trips compressed image data through vtkXMLImageDataWriter and
+// vtkXMLImageDataReader with every compressor and data mode.  The arrays
+// span several hundred compression blocks so that they are compressed and
+// uncompressed in several parallel batches, and a sub-extent is read to
+// cover the partial first and last blocks.
+
+#include "vtkDataCompressor.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+const int Dimension = 120;
+
+bool CheckOutput(vtkImageData* input, vtkImageData* output)
+{
+  vtkDataArray* inScalars = input->GetPointData()->GetArray("scalars");
+  vtkDataArray* inIds = input->GetPointData()->GetArray("ids");
+  vtkDataArray* outScalars = output->GetPointData()->GetArray("scalars");
+  vtkDataArray* outIds = output->GetPointData()->GetArray("ids");
+  if (!outScalars || !outIds)
+    {
+    return false;
+    }
+  int* extent = output->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        int ijk[3] = {i, j, k};
+        vtkIdType inId = input->ComputePointId(ijk);
+        vtkIdType outId = output->ComputePointId(ijk);
+        if (inScalars->GetTuple1(inId) != outScalars->GetTuple1(outId) ||
+            inIds->GetTuple1(inId) != outIds->GetTuple1(outId))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLCompression(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLCompression.vti";
+  delete [] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dimension, Dimension, Dimension);
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    scalars->SetValue(i, static_cast<float>(
+      std::floor(100 * std::sin(i * 0.001))));
+    ids->SetValue(i, i / 7);
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+  image->GetPointData()->AddArray(ids.GetPointer());
+
+  int compressors[3] =
+    { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::ZSTD };
+  int modes[2] = { vtkXMLWriter::Binary, vtkXMLWriter::Appended };
+  for (int c = 0; c < 3; ++c)
+    {
+    for (int m = 0; m < 2; ++m)
+      {
+      for (int byteOrder = 0; byteOrder < 2; ++byteOrder)
+        {
+        vtkNew<vtkXMLImageDataWriter> writer;
+        writer->SetInputData(image.GetPointer());
+        writer->SetFileName(fileName.c_str());
+        writer->SetCompressorType(compressors[c]);
+        writer->SetCompressionLevel(1);
+        writer->SetDataMode(modes[m]);
+        writer->SetByteOrder(byteOrder);
+        writer->SetIdTypeToInt32();
+        if (!writer->Write() ||
+            writer->GetCompressor()->GetCompressionLevel() != 1)
+          {
+          cerr << "Error: writing with compressor " << compressors[c]
+               << " and mode " << modes[m] << " failed." << endl;
+          return EXIT_FAILURE;
+          }
+
+        vtkNew<vtkXMLImageDataReader> reader;
+        reader->SetFileName(fileName.c_str());
+        reader->Update();
+        if (!CheckOutput(image.GetPointer(), reader->GetOutput()))
+          {
+          cerr << "Error: reading with compressor " << compressors[c]
+               << " and mode " << modes[m] << " failed." << endl;
+          return EXIT_FAILURE;
+          }
+
+        vtkNew<vtkXMLImageDataReader> subReader;
+        subReader->SetFileName(fileName.c_str());
+        subReader->UpdateInformation();
+        int extent[6] = {3, 110, 5, 101, 17, 90};
+        subReader->GetOutputInformation(0)->Set(
+          vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+        subReader->Update();
+        int* outExtent = subReader->GetOutput()->GetExtent();
+        if (outExtent[4] != extent[4] || outExtent[5] != extent[5] ||
+            !CheckOutput(image.GetPointer(), subReader->GetOutput()))
+          {
+          cerr << "Error: reading a sub-extent with compressor "
+               << compressors[c] << " and mode " << modes[m]
+               << " failed." << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads raw appended image data with memory mapping enabled.  Arrays
+// stored in the byte order of this machine must use the mapped file and
+// stay valid after the reader is deleted, the others must be copied.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <string>
+
+namespace
+{
+const char* ArrayNames[3] = { "bytes", "scalars", "vectors" };
+
+bool CheckOutput(vtkImageData* input, vtkImageData* output, bool swapped)
+{
+  for (int a = 0; a < 3; ++a)
+    {
+    // Byte swapped arrays cannot be used in place, except the bytes.
+    bool mapped = !swapped || a == 0;
+    vtkDataArray* in = input->GetPointData()->GetArray(ArrayNames[a]);
+    vtkDataArray* out = output->GetPointData()->GetArray(ArrayNames[a]);
+    if (!out || out->GetNumberOfTuples() != in->GetNumberOfTuples() ||
+        out->GetNumberOfComponents() != in->GetNumberOfComponents())
+      {
+      cerr << "Error: array " << ArrayNames[a] << " is missing." << endl;
+      return false;
+      }
+    if (out->GetInformation()->Has(vtkMemoryMappedFile::MAPPED_FILE()) !=
+        mapped)
+      {
+      cerr << "Error: array " << ArrayNames[a]
+           << (mapped? " is not" : " is") << " memory mapped." << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < in->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < in->GetNumberOfComponents(); ++c)
+        {
+        if (in->GetComponent(i, c) != out->GetComponent(i, c))
+          {
+          cerr << "Error: array " << ArrayNames[a] << " differs at tuple "
+               << i << "." << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLMemoryMap(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLMemoryMap.vti";
+  delete [] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(31, 17, 13);
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  // An odd number of bytes comes first so the following arrays need
+  // padding to be aligned.
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetName(ArrayNames[0]);
+  bytes->SetNumberOfTuples(numPoints);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName(ArrayNames[1]);
+  scalars->SetNumberOfTuples(numPoints);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName(ArrayNames[2]);
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    bytes->SetValue(i, static_cast<unsigned char>(i % 251));
+    scalars->SetValue(i, 0.5f * i);
+    vectors->SetTuple3(i, i, -0.25 * i, 1.0 / (i + 1));
+    }
+  image->GetPointData()->AddArray(bytes.GetPointer());
+  image->GetPointData()->AddArray(scalars.GetPointer());
+  image->GetPointData()->AddArray(vectors.GetPointer());
+
+  for (int headerType = 0; headerType < 2; ++headerType)
+    {
+    for (int swap = 0; swap < 2; ++swap)
+      {
+      vtkNew<vtkXMLImageDataWriter> writer;
+      writer->SetInputData(image.GetPointer());
+      writer->SetFileName(fileName.c_str());
+      writer->SetCompressorTypeToNone();
+      writer->SetDataModeToAppended();
+      writer->EncodeAppendedDataOff();
+      writer->AlignAppendedDataOn();
+      writer->SetHeaderType(headerType? vtkXMLWriter::UInt64 :
+                            vtkXMLWriter::UInt32);
+      if (swap)
+        {
+        writer->SetByteOrder(!writer->GetByteOrder());
+        }
+      if (!writer->Write())
+        {
+        cerr << "Error: writing " << fileName << " failed." << endl;
+        return EXIT_FAILURE;
+        }
+
+      vtkSmartPointer<vtkImageData> output;
+      vtkXMLImageDataReader* reader = vtkXMLImageDataReader::New();
+      reader->SetFileName(fileName.c_str());
+      reader->MemoryMapAppendedDataOn();
+      reader->Update();
+      output = reader->GetOutput();
+      reader->Delete();
+
+      if (!CheckOutput(image.GetPointer(), output, swap != 0))
+        {
+        cerr << "Error: reading with header type " << headerType
+             << " and byte swap " << swap << " failed." << endl;
+        return EXIT_FAILURE;
+        }
+
+      // Copies own their values.
+      vtkNew<vtkDoubleArray> copy;
+      copy->DeepCopy(output->GetPointData()->GetArray(ArrayNames[2]));
+      if (copy->GetInformation()->Has(vtkMemoryMappedFile::MAPPED_FILE()))
+        {
+        cerr << "Error: a copy references the mapped file." << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
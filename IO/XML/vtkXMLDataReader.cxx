@@ -20,6 +20,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkPointData.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
@@ -566,16 +567,35 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da,
   // For all contiguous arrays (except vtkBitArray).
   size_t num = numValues;
   int result;
-  void* data = array->GetVoidPointer(arrayIndex);
   if(da->GetAttribute("offset"))
     {
     vtkTypeInt64 offset = 0;
     da->GetScalarAttribute("offset", offset);
+
+    // Use the values in place when the whole array is read from a
+    // memory mapped file.
+    vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+    vtkMemoryMappedFile* mappedFile = xmlparser->GetMappedFile();
+    if(mappedFile && dataArray && array->GetDataType() != VTK_BIT &&
+       arrayIndex == 0 && startIndex == 0 &&
+       numValues == array->GetNumberOfComponents()*array->GetNumberOfTuples())
+      {
+      void* mapped = xmlparser->GetMappedAppendedData(offset, num,
+        array->GetDataType());
+      if(mapped)
+        {
+        mappedFile->MapArray(dataArray, mapped, numValues);
+        return 1;
+        }
+      }
+
+    void* data = array->GetVoidPointer(arrayIndex);
     result = (xmlparser->ReadAppendedData(offset, data, startIndex,
         numValues, array->GetDataType()) == num);
     }
   else
     {
+    void* data = array->GetVoidPointer(arrayIndex);
     int isAscii = 1;
     const char* format = da->GetAttribute("format");
     if(format && (strcmp(format, "binary") == 0))
@@ -20,11 +20,14 @@
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkInstantiator.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -87,6 +90,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = 0;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapAppendedData = 0;
   this->XMLParser = 0;
   this->FieldDataElement = 0;
   this->PointDataArraySelection = vtkDataArraySelection::New();
@@ -163,6 +167,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Stream: (none)\n";
     }
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData
+     << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -382,12 +388,20 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
 
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the compressors of vtkIOCore may not have been
+  // registered with the vtkInstantiator.  Check for them here.
   if(!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  else if(!compressor && (strcmp(type, "vtkLZ4DataCompressor") == 0))
+    {
+    compressor = vtkLZ4DataCompressor::New();
+    }
+  else if(!compressor && (strcmp(type, "vtkZstdDataCompressor") == 0))
+    {
+    compressor = vtkZstdDataCompressor::New();
+    }
 
   if(!compressor)
     {
@@ -575,6 +589,18 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   (*this->Stream).imbue(std::locale::classic());
   this->XMLParser->SetStream(this->Stream);
 
+  // Map the file so that raw appended arrays can use it in place.  The
+  // arrays keep the mapping alive once the parser releases it.
+  if(this->MemoryMapAppendedData && this->Stream == this->FileStream)
+    {
+    vtkMemoryMappedFile* mappedFile = vtkMemoryMappedFile::New();
+    if(mappedFile->Open(this->FileName))
+      {
+      this->XMLParser->SetMappedFile(mappedFile);
+      }
+    mappedFile->Delete();
+    }
+
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
   this->UpdateProgress(0);
@@ -608,6 +634,7 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   this->UpdateProgressDiscrete(1);
 
   // Close the input stream to prevent resource leaks.
+  this->XMLParser->SetMappedFile(0);
   this->CloseStream();
   if( this->TimeSteps )
     {
@@ -54,6 +54,17 @@ public:
   vtkBooleanMacro(ReadFromInputString,int);
   void SetInputString(std::string s) { this->InputString = s; }
 
+  // Description:
+  // Enable memory mapping the file to read raw appended data.  Arrays
+  // stored uncompressed, in the byte order of this machine and aligned
+  // for their type (see vtkXMLWriter::AlignAppendedData) then use the
+  // mapped file as their storage instead of copying it, and the file
+  // stays mapped until they are deleted.  Other arrays are read as usual.  The file
+  // must not be modified while it is mapped.  Off by default.
+  vtkSetMacro(MemoryMapAppendedData,int);
+  vtkGetMacro(MemoryMapAppendedData,int);
+  vtkBooleanMacro(MemoryMapAppendedData,int);
+
   // Description:
   // Test whether the file with the given name can be read by this
   // reader.
@@ -233,6 +244,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether raw appended data is read from a memory mapping of the file.
+  int MemoryMapAppendedData;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -25,13 +25,16 @@
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLZ4DataCompressor.h"
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef  vtkXMLOffsetsManager_DoNotInclude
@@ -47,6 +50,7 @@
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -284,6 +288,56 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
   vtkXMLWriterHelper::SetProgressPartial(writer, 1);
   return result;
 }
+
+//----------------------------------------------------------------------------
+// Blocks of an array given to WriteCompressionBlock are copied here and
+// compressed in parallel once MaximumNumberOfBlocks are waiting, which
+// bounds the memory used whatever the size of the array.  The buffers are
+// reused from one batch to the next.
+class vtkXMLWriterCompressionQueue
+{
+public:
+  enum { MaximumNumberOfBlocks = 128 };
+
+  struct Block
+  {
+    std::vector<unsigned char> Input;
+    std::vector<unsigned char> Output;
+    size_t OutputSize;
+  };
+
+  vtkXMLWriterCompressionQueue() :
+    Blocks(MaximumNumberOfBlocks), NumberOfBlocks(0) {}
+
+  std::vector<Block> Blocks;
+  size_t NumberOfBlocks;
+};
+
+namespace
+{
+class vtkXMLWriterCompressBlocks
+{
+public:
+  vtkDataCompressor* Compressor;
+  vtkXMLWriterCompressionQueue::Block* Blocks;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      vtkXMLWriterCompressionQueue::Block& block = this->Blocks[i];
+      size_t size = block.Input.size();
+      size_t space = this->Compressor->GetMaximumCompressionSpace(size);
+      if(block.Output.size() < space)
+        {
+        block.Output.resize(space);
+        }
+      block.OutputSize = this->Compressor->Compress(
+        &block.Input[0], size, &block.Output[0], space);
+      }
+  }
+};
+}
 //*****************************************************************************
 
 vtkCxxSetObjectMacro(vtkXMLWriter, Compressor, vtkDataCompressor);
@@ -315,11 +369,14 @@ vtkXMLWriter::vtkXMLWriter()
   // Initialize compression data.
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
+  this->CompressionLevel = -1;
   this->CompressionHeader = 0;
+  this->CompressionQueue = 0;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
   this->EncodeAppendedData = 1;
+  this->AlignAppendedData = 0;
   this->AppendedDataPosition = 0;
   this->DataMode = vtkXMLWriter::Appended;
   this->ProgressRange[0] = 0;
@@ -359,6 +416,7 @@ vtkXMLWriter::~vtkXMLWriter()
     this->OutStringStream = 0;
     }
 
+  delete this->CompressionQueue;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
 }
@@ -366,28 +424,72 @@ vtkXMLWriter::~vtkXMLWriter()
 //----------------------------------------------------------------------------
 void vtkXMLWriter::SetCompressorType(int compressorType)
 {
-  if (compressorType == NONE)
+  const char* className = 0;
+  if (compressorType == ZLIB)
     {
-    if (this->Compressor)
-      {
-      this->Compressor->Delete();
-      this->Compressor = 0;
-      this->Modified();
-      }
+    className = "vtkZLibDataCompressor";
+    }
+  else if (compressorType == LZ4)
+    {
+    className = "vtkLZ4DataCompressor";
+    }
+  else if (compressorType == ZSTD)
+    {
+    className = "vtkZstdDataCompressor";
+    }
+  else if (compressorType != NONE)
+    {
+    vtkErrorMacro("Unknown compressor type " << compressorType);
     return;
     }
 
-  if (compressorType == ZLIB)
+  if (this->Compressor && className && this->Compressor->IsA(className))
     {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
-      {
-      this->Compressor->Delete();
-      }
+    return;
+    }
+  if (this->Compressor)
+    {
+    this->Compressor->Delete();
+    this->Compressor = 0;
+    this->Modified();
+    }
+  if (!className)
+    {
+    return;
+    }
 
+  if (compressorType == ZLIB)
+    {
     this->Compressor = vtkZLibDataCompressor::New();
-    this->Modified();
+    }
+  else if (compressorType == LZ4)
+    {
+    this->Compressor = vtkLZ4DataCompressor::New();
+    }
+  else
+    {
+    this->Compressor = vtkZstdDataCompressor::New();
+    }
+  if (this->CompressionLevel >= 0)
+    {
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLWriter::SetCompressionLevel(int compressionLevel)
+{
+  if (this->CompressionLevel == compressionLevel)
+    {
     return;
     }
+  this->CompressionLevel = compressionLevel;
+  if (this->Compressor && compressionLevel >= 0)
+    {
+    this->Compressor->SetCompressionLevel(compressionLevel);
+    }
+  this->Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -432,7 +534,9 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Compressor: (none)\n";
     }
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
+  os << indent << "AlignAppendedData: " << this->AlignAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
   if(this->Stream)
     {
@@ -1148,6 +1252,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
+    // Compress and write the blocks still in the queue.
+    if(result && !this->FlushCompressionBlocks())
+      {
+      result = 0;
+      }
+
     // Finish writing the data.
     if(result && !this->DataStream->EndWriting())
       {
@@ -1160,12 +1270,14 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
-    // Destroy the compression header if it was used.
+    // Destroy the compression header and queue if they were used.
     if(this->CompressionHeader)
       {
       delete this->CompressionHeader;
       this->CompressionHeader = 0;
       }
+    delete this->CompressionQueue;
+    this->CompressionQueue = 0;
 
     return result;
     }
@@ -1470,6 +1582,11 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
+  if(!this->CompressionQueue)
+    {
+    this->CompressionQueue = new vtkXMLWriterCompressionQueue;
+    }
+  this->CompressionQueue->NumberOfBlocks = 0;
 
   return result;
 }
@@ -1477,26 +1594,58 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Queue a copy of the data, the caller reuses its buffer.
+  vtkXMLWriterCompressionQueue* queue = this->CompressionQueue;
+  vtkXMLWriterCompressionQueue::Block& block =
+    queue->Blocks[queue->NumberOfBlocks++];
+  block.Input.assign(data, data+size);
+
+  if(queue->NumberOfBlocks < queue->Blocks.size())
+    {
+    return 1;
+    }
+  return this->FlushCompressionBlocks();
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLWriterCompressionQueue* queue = this->CompressionQueue;
+  size_t numBlocks = queue->NumberOfBlocks;
+  queue->NumberOfBlocks = 0;
+  if(numBlocks == 0)
+    {
+    return 1;
+    }
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  // The blocks are independent, compress them in parallel.
+  vtkXMLWriterCompressBlocks compress;
+  compress.Compressor = this->Compressor;
+  compress.Blocks = &queue->Blocks[0];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, compress);
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
+  // Write the compressed data in order and store the compressed sizes in
+  // the compression header.
+  int result = 1;
+  for(size_t i = 0; i < numBlocks && result; ++i)
+    {
+    vtkXMLWriterCompressionQueue::Block& block = queue->Blocks[i];
+    if(!block.OutputSize)
+      {
+      vtkErrorMacro("Error compressing block "
+                    << this->CompressionBlockNumber << ".");
+      return 0;
+      }
+    result = this->DataStream->Write(&block.Output[0], block.OutputSize);
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++,
+                                 block.OutputSize);
+    }
   this->Stream->flush();
   if (this->Stream->fail())
     {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
     }
-
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
-
   return result;
 }
 
@@ -1988,6 +2137,18 @@ void vtkXMLWriter::WriteArrayAppendedData(vtkAbstractArray* a,
                                           vtkTypeInt64 pos,
                                           vtkTypeInt64& lastoffset)
 {
+  // Raw uncompressed values may be aligned to 8 bytes in the file so that
+  // readers can memory map them in place.  Readers honor the offsets, so
+  // the padding is skipped.
+  if(this->AlignAppendedData && !this->Compressor &&
+     !this->EncodeAppendedData)
+    {
+    ostream& os = *(this->Stream);
+    vtkTypeInt64 headerSize = this->HeaderType == vtkXMLWriter::UInt64? 8:4;
+    vtkTypeInt64 dataPos = static_cast<vtkTypeInt64>(os.tellp()) + headerSize;
+    const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    os.write(padding, (8 - dataPos % 8) % 8);
+    }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
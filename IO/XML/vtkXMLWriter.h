@@ -41,6 +41,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
 class vtkXMLDataHeader;
+class vtkXMLWriterCompressionQueue;
 //BTX
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -129,7 +130,9 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    LZ4,
+    ZSTD
     };
 //ETX
 
@@ -144,6 +147,22 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToLZ4()
+    {
+    this->SetCompressorType(LZ4);
+    }
+  void SetCompressorTypeToZstd()
+    {
+    this->SetCompressorType(ZSTD);
+    }
+
+  // Description:
+  // Get/Set the compression level passed to the compressor, see
+  // vtkDataCompressor::SetCompressionLevel.  It is also applied to the
+  // compressors created by SetCompressorType.  The default, -1, keeps the
+  // default level of each compressor.
+  virtual void SetCompressionLevel(int compressionLevel);
+  vtkGetMacro(CompressionLevel, int);
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -173,6 +192,17 @@ public:
   vtkGetMacro(EncodeAppendedData, int);
   vtkBooleanMacro(EncodeAppendedData, int);
 
+  // Description:
+  // Get/Set whether raw appended arrays are aligned in the file.  When on,
+  // and the appended data section is neither encoded nor compressed,
+  // padding is written before each array so that its values start at a
+  // multiple of 8 bytes in the file.  vtkXMLReader can then use them in
+  // place with MemoryMapAppendedData.  Readers skip the padding.  The
+  // default is off.
+  vtkSetMacro(AlignAppendedData, int);
+  vtkGetMacro(AlignAppendedData, int);
+  vtkBooleanMacro(AlignAppendedData, int);
+
   // Description:
   // Assign a data object as input. Note that this method does not
   // establish a pipeline connection. Use SetInputConnection() to
@@ -257,6 +287,9 @@ protected:
   // Whether to base64-encode the appended data section.
   int EncodeAppendedData;
 
+  // Whether to align raw appended arrays for memory mapping.
+  int AlignAppendedData;
+
   // The stream position at which appended data starts.
   vtkTypeInt64 AppendedDataPosition;
 
@@ -286,11 +319,15 @@ protected:
 
   // Compression information.
   vtkDataCompressor* Compressor;
+  int CompressionLevel;
   size_t BlockSize;
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // Blocks waiting to be compressed, see WriteCompressionBlock.
+  vtkXMLWriterCompressionQueue* CompressionQueue;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -422,6 +459,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
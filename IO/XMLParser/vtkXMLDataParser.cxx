@@ -19,7 +19,9 @@
 #include "vtkCommand.h"
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -28,11 +30,44 @@
 #include <vtksys/auto_ptr.hxx>
 #include <vtksys/ios/sstream>
 
+#include <vector>
+
 #include "vtkXMLUtilities.h"
 
 
+namespace
+{
+// Number of full compression blocks read and uncompressed at once.
+const size_t vtkXMLDataParserBlocksPerRead = 128;
+
+class vtkXMLDataParserUncompressBlocks
+{
+public:
+  vtkDataCompressor* Compressor;
+  const unsigned char* CompressedData;
+  const vtkTypeInt64* CompressedOffsets;
+  const size_t* CompressedSizes;
+  unsigned char* Output;
+  size_t BlockSize;
+  unsigned char* Success;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      size_t result = this->Compressor->Uncompress(
+        this->CompressedData + this->CompressedOffsets[i],
+        this->CompressedSizes[i], this->Output + i*this->BlockSize,
+        this->BlockSize);
+      this->Success[i] = result > 0;
+      }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
+vtkCxxSetObjectMacro(vtkXMLDataParser, MappedFile, vtkMemoryMappedFile);
 
 //----------------------------------------------------------------------------
 vtkXMLDataParser::vtkXMLDataParser()
@@ -50,6 +85,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
   this->Compressor = 0;
+  this->MappedFile = 0;
 
   this->AsciiDataBuffer = 0;
   this->AsciiDataBufferLength = 0;
@@ -84,6 +120,7 @@ vtkXMLDataParser::~vtkXMLDataParser()
   delete [] this->BlockCompressedSizes;
   delete [] this->BlockStartOffsets;
   this->SetCompressor(0);
+  this->SetMappedFile(0);
   if(this->AsciiDataBuffer) { this->FreeAsciiBuffer(); }
 }
 
@@ -105,6 +142,14 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Compressor: (none)\n";
     }
+  if(this->MappedFile)
+    {
+    os << indent << "MappedFile: " << this->MappedFile << "\n";
+    }
+  else
+    {
+    os << indent << "MappedFile: (none)\n";
+    }
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
@@ -587,6 +632,52 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadFullBlocks(vtkTypeUInt64 block, size_t numBlocks,
+                                     unsigned char* buffer)
+{
+  // The compressed blocks are contiguous in the stream, read them at once.
+  vtkTypeInt64 start = this->BlockStartOffsets[block];
+  size_t compressedSize = static_cast<size_t>(
+    this->BlockStartOffsets[block+numBlocks-1] - start +
+    this->BlockCompressedSizes[block+numBlocks-1]);
+  if(compressedSize == 0 || !this->DataStream->Seek(start))
+    {
+    return 0;
+    }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if(this->DataStream->Read(&readBuffer[0], compressedSize) < compressedSize)
+    {
+    return 0;
+    }
+
+  // Then uncompress them in parallel.
+  std::vector<vtkTypeInt64> offsets(numBlocks);
+  for(size_t i = 0; i < numBlocks; ++i)
+    {
+    offsets[i] = this->BlockStartOffsets[block+i] - start;
+    }
+  std::vector<unsigned char> success(numBlocks, 0);
+  vtkXMLDataParserUncompressBlocks uncompress;
+  uncompress.Compressor = this->Compressor;
+  uncompress.CompressedData = &readBuffer[0];
+  uncompress.CompressedOffsets = &offsets[0];
+  uncompress.CompressedSizes = this->BlockCompressedSizes + block;
+  uncompress.Output = buffer;
+  uncompress.BlockSize = this->BlockUncompressedSize;
+  uncompress.Success = &success[0];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, uncompress);
+
+  for(size_t i = 0; i < numBlocks; ++i)
+    {
+    if(!success[i])
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(unsigned char* data,
                                               vtkTypeUInt64 startWord,
@@ -755,18 +846,28 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Report progress.
     this->UpdateProgress(float(outputPointer-data)/length);
 
-    unsigned int currentBlock = firstBlock+1;
-    for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in between, several at a time.
+    vtkTypeUInt64 currentBlock = firstBlock+1;
+    while(currentBlock < lastBlock && !this->Abort)
       {
-      // Read this block.
-      if(!this->ReadBlock(currentBlock, outputPointer)) { return 0; }
+      size_t numBlocks = vtkXMLDataParserBlocksPerRead;
+      if(lastBlock - currentBlock < numBlocks)
+        {
+        numBlocks = static_cast<size_t>(lastBlock - currentBlock);
+        }
+      if(!this->ReadFullBlocks(currentBlock, numBlocks, outputPointer))
+        {
+        return 0;
+        }
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      n = numBlocks*blockSize;
+      this->PerformByteSwap(outputPointer, n / wordSize, wordSize);
 
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += n;
+      currentBlock += numBlocks;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer-data)/length);
@@ -911,6 +1012,56 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+void* vtkXMLDataParser::GetMappedAppendedData(vtkTypeInt64 offset,
+                                              size_t numWords,
+                                              int wordType)
+{
+  // Only raw uncompressed data can be used in place.
+  if(!this->MappedFile || !this->MappedFile->GetData() || this->Compressor ||
+     this->AppendedDataStream->IsA("vtkBase64InputStream"))
+    {
+    return 0;
+    }
+  size_t wordSize = this->GetWordTypeSize(wordType);
+#ifdef VTK_WORDS_BIGENDIAN
+  if(this->ByteOrder != vtkXMLDataParser::BigEndian && wordSize > 1)
+#else
+  if(this->ByteOrder != vtkXMLDataParser::LittleEndian && wordSize > 1)
+#endif
+    {
+    return 0;
+    }
+
+  // Read the length of the data from the header preceding it.
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  vtkTypeUInt64 const fileSize = this->MappedFile->GetSize();
+  vtkTypeInt64 const position = this->AppendedDataPosition + offset;
+  if(position < 0 ||
+     static_cast<vtkTypeUInt64>(position) + headerSize > fileSize)
+    {
+    return 0;
+    }
+  unsigned char* header = this->MappedFile->GetData() + position;
+  memcpy(uh->Data(), header, headerSize);
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  vtkTypeUInt64 const length = static_cast<vtkTypeUInt64>(numWords)*wordSize;
+  if(uh->Get(0) < length ||
+     fileSize - position - headerSize < length)
+    {
+    return 0;
+    }
+
+  unsigned char* data = header + headerSize;
+  if(reinterpret_cast<size_t>(data) % wordSize != 0)
+    {
+    return 0;
+    }
+  return data;
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -32,6 +32,7 @@
 
 class vtkInputStream;
 class vtkDataCompressor;
+class vtkMemoryMappedFile;
 
 class VTKIOXMLPARSER_EXPORT vtkXMLDataParser : public vtkXMLParser
 {
@@ -84,6 +85,16 @@ public:
   // stream.  Returns the number of words read.
   size_t ReadBinaryData(void* buffer, vtkTypeUInt64 startWord,
                         size_t maxWords, int wordType);
+
+  // Description:
+  // Get the address of the first numWords words of the appended data
+  // array starting at the given appended data offset in the MappedFile.
+  // Returns 0 unless the array is stored raw, uncompressed, in the byte
+  // order of this machine, is aligned for its word type and holds at
+  // least numWords words.  The data must then be read with
+  // ReadAppendedData.
+  void* GetMappedAppendedData(vtkTypeInt64 offset, size_t numWords,
+                              int wordType);
   //ETX
 
   // Description:
@@ -92,6 +103,12 @@ public:
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // Get/Set the memory mapping of the file being parsed, used by
+  // GetMappedAppendedData.  It must map the file the stream reads.
+  virtual void SetMappedFile(vtkMemoryMappedFile*);
+  vtkGetObjectMacro(MappedFile, vtkMemoryMappedFile);
+
   // Description:
   // Get the size of a word of the given type.
   size_t GetWordTypeSize(int wordType);
@@ -166,6 +183,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadFullBlocks(vtkTypeUInt64 block, size_t numBlocks,
+                     unsigned char* buffer);
   size_t ReadUncompressedData(unsigned char* data,
                               vtkTypeUInt64 startWord,
                               size_t numWords,
@@ -224,6 +243,9 @@ protected:
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
 
+  // Mapping of the file for zero-copy reads of raw appended data.
+  vtkMemoryMappedFile* MappedFile;
+
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
   size_t AsciiDataBufferLength;
@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageResliceOptimization.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the output of vtkImageReslice on its optimized path, where
+// whole rows of the input are interpolated at once when they are
+// contiguous in memory, with its generic path, for every interpolation
+// mode and several scalar types, numbers of components and offsets.
+// Then checks vtkImageResliceToColors against vtkLookupTable::MapValue().
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReslice.h"
+#include "vtkImageResliceToColors.h"
+#include "vtkLookupTable.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <math.h>
+
+static bool CompareReslice(int scalarType, int numComponents, int mode,
+                           const double offset[3], bool permute)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 36, 0, 20, 0, 9);
+  image->AllocateScalars(scalarType, numComponents);
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < numComponents; c++)
+      {
+      scalars->SetComponent(i, c, ((i + 31*c)*37) % 101 + 0.25*(i % 3));
+      }
+    }
+
+  vtkNew<vtkMatrix4x4> axes;
+  if (permute)
+    { // swap the y and z axes
+    axes->Zero();
+    axes->SetElement(0, 0, 1.0);
+    axes->SetElement(1, 2, 1.0);
+    axes->SetElement(2, 1, 1.0);
+    axes->SetElement(3, 3, 1.0);
+    }
+  for (int j = 0; j < 3; j++)
+    {
+    axes->SetElement(j, 3, offset[j]);
+    }
+
+  vtkImageData *outputs[2];
+  vtkNew<vtkImageReslice> reslice[2];
+  for (int k = 0; k < 2; k++)
+    {
+    reslice[k]->SetInputData(image.GetPointer());
+    reslice[k]->SetResliceAxes(axes.GetPointer());
+    reslice[k]->SetInterpolationMode(mode);
+    reslice[k]->SetOptimization(k == 0);
+    reslice[k]->SetOutputSpacing(1.0, 1.0, 1.0);
+    reslice[k]->SetOutputOrigin(0.0, 0.0, 0.0);
+    reslice[k]->SetOutputExtent(-2, 38, -1, 21, 0, 8);
+    reslice[k]->Update();
+    outputs[k] = reslice[k]->GetOutput();
+    }
+
+  vtkDataArray *optimized = outputs[0]->GetPointData()->GetScalars();
+  vtkDataArray *generic = outputs[1]->GetPointData()->GetScalars();
+  double tol = ((scalarType == VTK_FLOAT || scalarType == VTK_DOUBLE) ?
+                1e-4 : 0.0);
+  for (vtkIdType i = 0; i < optimized->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < numComponents; c++)
+      {
+      double a = optimized->GetComponent(i, c);
+      double b = generic->GetComponent(i, c);
+      // integer results may round differently at half-integers
+      if (fabs(a - b) > tol && (tol != 0.0 || fabs(a - b) > 1.0))
+        {
+        cerr << "Error: mode " << mode << ", type "
+             << vtkImageScalarTypeNameMacro(scalarType) << ", "
+             << numComponents << " components, offset (" << offset[0]
+             << ", " << offset[1] << ", " << offset[2] << "): value " << a
+             << " at " << i << " should be " << b << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+static bool TestResliceToColors()
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 300, 0, 3, 0, 2);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    {
+    scalars->SetComponent(i, 0, (i % 3 == 0 ? vtkMath::Nan() : i - 600.5));
+    }
+
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(-500.0, 500.0);
+  table->SetNanColor(0.0, 1.0, 0.0, 1.0);
+  table->Build();
+
+  int formats[4] = { VTK_LUMINANCE, VTK_LUMINANCE_ALPHA, VTK_RGB, VTK_RGBA };
+  for (int f = 0; f < 4; f++)
+    {
+    vtkNew<vtkImageResliceToColors> reslice;
+    reslice->SetInputData(image.GetPointer());
+    reslice->SetLookupTable(table.GetPointer());
+    reslice->SetOutputFormat(formats[f]);
+    reslice->Update();
+    vtkDataArray *colors = reslice->GetOutput()->GetPointData()->GetScalars();
+    for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+      {
+      unsigned char expected[4];
+      table->MapScalarsThroughTable(scalars->GetVoidPointer(i), expected,
+                                    VTK_FLOAT, 1, 1, formats[f]);
+      if (scalars->GetComponent(i, 0) == scalars->GetComponent(i, 0))
+        {
+        unsigned char *rgba = table->MapValue(scalars->GetComponent(i, 0));
+        if (formats[f] == VTK_RGBA &&
+            (rgba[0] != expected[0] || rgba[1] != expected[1] ||
+             rgba[2] != expected[2] || rgba[3] != expected[3]))
+          {
+          cerr << "Error: MapScalarsThroughTable disagrees with MapValue"
+               << " at " << i << endl;
+          return false;
+          }
+        }
+      else if (expected[0] != (formats[f] > VTK_LUMINANCE_ALPHA ? 0 : 150))
+        {
+        cerr << "Error: wrong color for NaN at " << i << endl;
+        return false;
+        }
+      for (int c = 0; c < formats[f]; c++)
+        {
+        if (colors->GetComponent(i, c) != expected[c])
+          {
+          cerr << "Error: wrong color for format " << formats[f]
+               << " at " << i << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+int TestImageResliceOptimization(int, char *[])
+{
+  int types[4] = { VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_FLOAT, VTK_DOUBLE };
+  double offsets[4][3] = {
+    { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.375 }, { 0.0, 1.25, -0.75 },
+    { 0.625, 0.25, 0.0 } };
+  for (int mode = 0; mode < 3; mode++)
+    {
+    for (int t = 0; t < 4; t++)
+      {
+      for (int nc = 1; nc <= 3; nc += 2)
+        {
+        for (int o = 0; o < 4; o++)
+          {
+          for (int p = 0; p < 2; p++)
+            {
+            if (!CompareReslice(types[t], nc, mode, offsets[o], p != 0))
+              {
+              return EXIT_FAILURE;
+              }
+            }
+          }
+        }
+      }
+    }
+
+  if (!TestResliceToColors())
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -159,6 +159,22 @@ int vtkImageDifference::RequestUpdateExtent(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkImageDifference::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // The errors are accumulated per thread id, so the extent must be split
+  // into at most NumberOfThreads pieces.
+  bool enableSMP = this->EnableSMP;
+  this->EnableSMP = false;
+  int result = this->Superclass::RequestData(request, inputVector,
+                                             outputVector);
+  this->EnableSMP = enableSMP;
+  return result;
+}
+
 //----------------------------------------------------------------------------
 void vtkImageDifference::ThreadedRequestData(
   vtkInformation * vtkNotUsed( request ),
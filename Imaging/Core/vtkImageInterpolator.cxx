@@ -544,6 +544,17 @@ void vtkImageNLCRowInterpolate<F, T>::Nearest(
   // get the number of components per pixel
   int numscalars = weights->NumberOfComponents;
 
+  if (weights->ContiguousX)
+    { // a simple loop that the compiler can vectorize
+    const T *tmpPtr = &inPtr0[iX[0]];
+    int m = n*numscalars;
+    for (int i = 0; i < m; i++)
+      {
+      outPtr[i] = tmpPtr[i];
+      }
+    return;
+    }
+
   // This is a hot loop.
   for (int i = n; i > 0; --i)
     {
@@ -619,7 +630,38 @@ void vtkImageNLCRowInterpolate<F, T>::Trilinear(
   F fyrz = fy*rz;
   F fyfz = fy*fz;
 
-  if (stepX == 1)
+  if (stepX == 1 && weights->ContiguousX)
+    { // interpolate whole rows with loops that the compiler can vectorize
+    const T *inPtr0 = inPtr + iX[0];
+    const T *inPtr00 = inPtr0 + i00;
+    const T *inPtr01 = inPtr0 + i01;
+    const T *inPtr10 = inPtr0 + i10;
+    const T *inPtr11 = inPtr0 + i11;
+    int m = n*numscalars;
+    if (fy == 0 && fz == 0)
+      { // no interpolation needed at all
+      for (int i = 0; i < m; i++)
+        {
+        outPtr[i] = inPtr00[i];
+        }
+      }
+    else if (fy == 0)
+      { // only need linear z interpolation
+      for (int i = 0; i < m; i++)
+        {
+        outPtr[i] = (rz*inPtr00[i] + fz*inPtr01[i]);
+        }
+      }
+    else
+      { // interpolate in y and z but not in x
+      for (int i = 0; i < m; i++)
+        {
+        outPtr[i] = (ryrz*inPtr00[i] + ryfz*inPtr01[i] +
+                     fyrz*inPtr10[i] + fyfz*inPtr11[i]);
+        }
+      }
+    }
+  else if (stepX == 1)
     {
     if (fy == 0 && fz == 0)
       { // no interpolation needed at all
@@ -743,6 +785,54 @@ void vtkImageNLCRowInterpolate<F, T>::Tricubic(
   // get the number of components per pixel
   int numscalars = weights->NumberOfComponents;
 
+  if (stepX == 1 && weights->ContiguousX)
+    { // sum whole rows with loops that the compiler can vectorize
+    const T *inPtr0 = inPtr + iX[0];
+    int m = n*numscalars;
+    bool first = true;
+    int k = 0;
+    do
+      { // loop over z
+      F fz = fZ[k];
+      if (fz != 0)
+        {
+        vtkIdType iz = iZ[k];
+        int j = 0;
+        do
+          { // loop over y
+          F fzy = fz*fY[j];
+          const T *tmpPtr = inPtr0 + iz + iY[j];
+          if (first)
+            {
+            for (int i = 0; i < m; i++)
+              {
+              outPtr[i] = fzy*tmpPtr[i];
+              }
+            first = false;
+            }
+          else
+            {
+            for (int i = 0; i < m; i++)
+              {
+              outPtr[i] += fzy*tmpPtr[i];
+              }
+            }
+          }
+        while (++j < stepY);
+        }
+      }
+    while (++k < stepZ);
+
+    if (first)
+      {
+      for (int i = 0; i < m; i++)
+        {
+        outPtr[i] = 0;
+        }
+      }
+    return;
+    }
+
   for (int i = n; i > 0; --i)
     {
     vtkIdType iX0 = iX[0];
@@ -1040,6 +1130,20 @@ void vtkImageInterpolatorPrecomputeWeights(
       { // never entered input extent!
       clipExt[2*j] = clipExt[2*j+1] + 1;
       }
+
+    // check whether consecutive output pixels along x within the clipped
+    // extent are consecutive input pixels, so that the row functions can
+    // use vectorized loops
+    if (j == 0 && step == 1)
+      {
+      int contiguous = 1;
+      for (int i = clipExt[0]; i < clipExt[1] && contiguous; i++)
+        {
+        contiguous = (positions[i + 1] - positions[i] ==
+                      weights->NumberOfComponents);
+        }
+      weights->ContiguousX = contiguous;
+      }
     }
 }
 
@@ -40,10 +40,11 @@ struct vtkInterpolationWeights : public vtkInterpolationInfo
   int WeightExtent[6];
   int KernelSize[3];
   int WeightType; // VTK_FLOAT or VTK_DOUBLE
+  int ContiguousX; // set if rows within clip extent are contiguous
 
   // partial copy contstructor from superclass
   vtkInterpolationWeights(const vtkInterpolationInfo &info) :
-    vtkInterpolationInfo(info) {}
+    vtkInterpolationInfo(info), ContiguousX(0) {}
 };
 
 // The internal math functions for the interpolators
@@ -39,6 +39,7 @@
 #include <limits.h>
 #include <float.h>
 #include <math.h>
+#include <string.h>
 
 // for uintptr_t
 #ifdef _MSC_VER
@@ -1224,11 +1225,21 @@ int vtkImageReslice::RequestInformation(
 
 namespace {
 
+// Round a value within the range of the 8-bit and 16-bit types.  Unlike
+// the 64-bit conversion in vtkInterpolationMath::Round(), the 32-bit
+// conversion used here can be vectorized by the compiler.
+template <class F>
+inline int vtkInterpolateRound16(F val)
+{
+  return static_cast<int>(
+    val + (32768.5 + VTK_INTERPOLATE_FLOOR_TOL)) - 32768;
+}
+
 #if (VTK_USE_INT8 != 0)
 template <class F>
 inline void vtkInterpolateRound(F val, vtkTypeInt8& rnd)
 {
-  rnd = vtkInterpolationMath::Round(val);
+  rnd = vtkInterpolateRound16(val);
 }
 #endif
 
@@ -1236,7 +1247,7 @@ inline void vtkInterpolateRound(F val, vtkTypeInt8& rnd)
 template <class F>
 inline void vtkInterpolateRound(F val, vtkTypeUInt8& rnd)
 {
-  rnd = vtkInterpolationMath::Round(val);
+  rnd = vtkInterpolateRound16(val);
 }
 #endif
 
@@ -1244,7 +1255,7 @@ inline void vtkInterpolateRound(F val, vtkTypeUInt8& rnd)
 template <class F>
 inline void vtkInterpolateRound(F val, vtkTypeInt16& rnd)
 {
-  rnd = vtkInterpolationMath::Round(val);
+  rnd = vtkInterpolateRound16(val);
 }
 #endif
 
@@ -1252,7 +1263,7 @@ inline void vtkInterpolateRound(F val, vtkTypeInt16& rnd)
 template <class F>
 inline void vtkInterpolateRound(F val, vtkTypeUInt16& rnd)
 {
-  rnd = vtkInterpolationMath::Round(val);
+  rnd = vtkInterpolateRound16(val);
 }
 #endif
 
@@ -2385,6 +2396,10 @@ struct vtkImageResliceRowInterpolate
   static void Nearest4(
     void *&outPtr0, int idX, int idY, int idZ, int, int n,
     vtkInterpolationWeights *weights);
+
+  static void Copy(
+    void *&outPtr0, int idX, int idY, int idZ, int, int n,
+    vtkInterpolationWeights *weights);
 };
 
 //----------------------------------------------------------------------------
@@ -2521,17 +2536,45 @@ void vtkImageResliceRowInterpolate<T>::Nearest4(
   outPtr0 = outPtr;
 }
 
+//----------------------------------------------------------------------------
+// for when the input pixels are contiguous in memory
+template<class T>
+void vtkImageResliceRowInterpolate<T>::Copy(
+  void *&outPtr0, int idX, int idY, int idZ, int numscalars, int n,
+  vtkInterpolationWeights *weights)
+{
+  const T *inPtr = static_cast<const T *>(weights->Pointer) +
+    weights->Positions[0][idX] + weights->Positions[1][idY] +
+    weights->Positions[2][idZ];
+  T *outPtr = static_cast<T *>(outPtr0);
+
+  size_t m = static_cast<size_t>(n)*numscalars;
+  memcpy(outPtr, inPtr, m*sizeof(T));
+  outPtr0 = outPtr + m;
+}
+
 //----------------------------------------------------------------------------
 // get row interpolation function for different interpolation modes
 // and different scalar types
 void vtkGetSummationFunc(
   void (**summation)(void *&outPtr, int idX, int idY, int idZ, int numscalars,
                      int n, vtkInterpolationWeights *weights),
-  int scalarType, int numScalars)
+  int scalarType, int numScalars, bool contiguous)
 {
   *summation = 0;
 
-  if (numScalars == 1)
+  if (contiguous)
+    {
+    switch (scalarType)
+      {
+      vtkTemplateAliasMacro(
+        *summation = &(vtkImageResliceRowInterpolate<VTK_TT>::Copy)
+        );
+      default:
+        *summation = 0;
+      }
+    }
+  else if (numScalars == 1)
     {
     switch (scalarType)
       {
@@ -2845,7 +2888,8 @@ void vtkReslicePermuteExecute(vtkImageReslice *self,
                     int n, vtkInterpolationWeights *weights) = 0;
   void (*conversion)(void *&out, const F *in, int numscalars, int n) = 0;
   void (*setpixels)(void *&out, const void *in, int numscalars, int n) = 0;
-  vtkGetSummationFunc(&summation, scalarType, outComponents);
+  vtkGetSummationFunc(&summation, scalarType, outComponents,
+                      weights->ContiguousX != 0);
   bool forceClamping = (interpolationMode > VTK_RESLICE_LINEAR ||
     (nsamples > 1 && self->GetSlabMode() == VTK_IMAGE_SLAB_SUM));
   vtkGetConversionFunc(&conversion,
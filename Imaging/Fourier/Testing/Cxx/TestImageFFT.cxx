@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageFFT.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkImageFFT with a direct discrete Fourier transform for volumes
+// whose dimensions use every kind of butterfly, with real and complex
+// inputs, then checks that vtkImageRFFT and vtkTableFFT agree with it.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkShortArray.h"
+#include "vtkTable.h"
+#include "vtkTableFFT.h"
+
+#include <cmath>
+
+namespace
+{
+// Direct DFT of the whole image at frequency (u, v, w).
+void DirectDFT(vtkImageData* image, int u, int v, int w, double result[2])
+{
+  int* dims = image->GetDimensions();
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  int numComponents = scalars->GetNumberOfComponents();
+  result[0] = result[1] = 0.0;
+  for (int k = 0; k < dims[2]; ++k)
+    {
+    for (int j = 0; j < dims[1]; ++j)
+      {
+      for (int i = 0; i < dims[0]; ++i)
+        {
+        vtkIdType id = i + dims[0]*(j + static_cast<vtkIdType>(dims[1])*k);
+        double re = scalars->GetComponent(id, 0);
+        double im = numComponents > 1 ? scalars->GetComponent(id, 1) : 0.0;
+        double angle = -2.0*vtkMath::Pi()*
+          (static_cast<double>(u)*i/dims[0] + static_cast<double>(v)*j/dims[1] +
+           static_cast<double>(w)*k/dims[2]);
+        double c = cos(angle);
+        double s = sin(angle);
+        result[0] += re*c - im*s;
+        result[1] += re*s + im*c;
+        }
+      }
+    }
+}
+
+bool TestImage(int nx, int ny, int nz, int numComponents)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(nx, ny, nz);
+  vtkNew<vtkShortArray> scalars;
+  scalars->SetNumberOfComponents(numComponents);
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < numComponents; ++c)
+      {
+      scalars->SetComponent(i, c, (i*(7 + 4*c) + 3*c) % 23 - 11);
+      }
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkImageFFT> fft;
+  fft->SetInputData(image.GetPointer());
+  fft->Update();
+  vtkImageData* output = fft->GetOutput();
+  vtkDataArray* outScalars = output->GetPointData()->GetScalars();
+
+  // Every frequency for small images, a sample of them otherwise.
+  vtkIdType step = output->GetNumberOfPoints() > 500 ? 37 : 1;
+  for (vtkIdType id = 0; id < output->GetNumberOfPoints(); id += step)
+    {
+    int u = static_cast<int>(id % nx);
+    int v = static_cast<int>((id / nx) % ny);
+    int w = static_cast<int>(id / (static_cast<vtkIdType>(nx)*ny));
+    double expected[2];
+    DirectDFT(image.GetPointer(), u, v, w, expected);
+    double tolerance = 1e-9*image->GetNumberOfPoints()*11;
+    if (fabs(outScalars->GetComponent(id, 0) - expected[0]) > tolerance ||
+        fabs(outScalars->GetComponent(id, 1) - expected[1]) > tolerance)
+      {
+      cerr << "Error: wrong FFT of a " << nx << "x" << ny << "x" << nz
+           << " image with " << numComponents << " components at ("
+           << u << ", " << v << ", " << w << "): ("
+           << outScalars->GetComponent(id, 0) << ", "
+           << outScalars->GetComponent(id, 1) << ") instead of ("
+           << expected[0] << ", " << expected[1] << ")" << endl;
+      return false;
+      }
+    }
+
+  // The reverse transform gives the input back.
+  vtkNew<vtkImageRFFT> rfft;
+  rfft->SetInputConnection(fft->GetOutputPort());
+  rfft->Update();
+  vtkDataArray* back = rfft->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType id = 0; id < back->GetNumberOfTuples(); ++id)
+    {
+    double im = numComponents > 1 ? scalars->GetComponent(id, 1) : 0.0;
+    if (fabs(back->GetComponent(id, 0) - scalars->GetComponent(id, 0)) > 1e-9 ||
+        fabs(back->GetComponent(id, 1) - im) > 1e-9)
+      {
+      cerr << "Error: RFFT of a " << nx << "x" << ny << "x" << nz
+           << " image does not give the input back" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestTable()
+{
+  const int numValues = 360;
+  vtkNew<vtkDoubleArray> column;
+  column->SetName("signal");
+  for (int i = 0; i < numValues; ++i)
+    {
+    column->InsertNextValue(cos(2.0*vtkMath::Pi()*5*i/numValues) + 0.5);
+    }
+  vtkNew<vtkTable> table;
+  table->AddColumn(column.GetPointer());
+
+  vtkNew<vtkTableFFT> fft;
+  fft->SetInputData(table.GetPointer());
+  fft->Update();
+  vtkDataArray* result = vtkDataArray::SafeDownCast(
+    fft->GetOutput()->GetColumnByName("signal"));
+  if (!result || result->GetNumberOfComponents() != 2 ||
+      result->GetNumberOfTuples() != numValues)
+    {
+    cerr << "Error: vtkTableFFT output is missing" << endl;
+    return false;
+    }
+  for (int i = 0; i < numValues; ++i)
+    {
+    double expected = (i == 0) ? 0.5*numValues :
+      ((i == 5 || i == numValues - 5) ? 0.5*numValues : 0.0);
+    if (fabs(result->GetComponent(i, 0) - expected) > 1e-9 ||
+        fabs(result->GetComponent(i, 1)) > 1e-9)
+      {
+      cerr << "Error: wrong vtkTableFFT output at " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestImageFFT(int, char*[])
+{
+  // Radix 4, 2, 3 and general butterflies, blocks of many rows, and an odd
+  // number of real rows.
+  int sizes[][3] = {
+    {1, 1, 1}, {2, 3, 1}, {8, 6, 5}, {12, 7, 2}, {35, 9, 3}, {64, 17, 1},
+    {17, 64, 4}, {6, 45, 11}};
+  for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+    {
+    for (int numComponents = 1; numComponents <= 2; ++numComponents)
+      {
+      if (!TestImage(sizes[i][0], sizes[i][1], sizes[i][2], numComponents))
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  if (!TestTable())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
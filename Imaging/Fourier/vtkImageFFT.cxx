@@ -59,16 +59,16 @@ int vtkImageFFT::IterativeRequestUpdateExtent(
 
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
+// is always doubles.  The rows along the axis of this iteration are
+// transformed in blocks of neighbors, which are gathered and scattered one
+// position along the axis at a time.  When the input is real, pairs of rows
+// are transformed as the real and imaginary parts of a single complex row.
 template <class T>
 void vtkImageFFTExecute(vtkImageFFT *self,
                         vtkImageData *inData, int inExt[6], T *inPtr,
                         vtkImageData *outData, int outExt[6], double *outPtr,
                         int id)
 {
-  vtkImageComplex *inComplex;
-  vtkImageComplex *outComplex;
-  vtkImageComplex *pComplex;
   //
   int inMin0, inMax0;
   vtkIdType inInc0, inInc1, inInc2;
@@ -79,7 +79,8 @@ void vtkImageFFTExecute(vtkImageFFT *self,
   double *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0, numberOfComponents;
-  unsigned long count = 0;
+  int b, blockSize, count, numRows;
+  unsigned long progressCount = 0;
   unsigned long target;
   double startProgress;
 
@@ -101,13 +102,21 @@ void vtkImageFFTExecute(vtkImageFFT *self,
     vtkGenericWarningMacro("No real components");
     return;
     }
+  bool realInput = (numberOfComponents == 1);
 
-  // Allocate the arrays of complex numbers
-  inComplex = new vtkImageComplex[inSize0];
-  outComplex = new vtkImageComplex[inSize0];
+  // Allocate the block of interleaved rows
+  vtkImageFourierFilter::Plan plan(inSize0, 1);
+  blockSize = plan.GetBlockSize();
+  if (realInput && blockSize > 1)
+    {
+    blockSize &= ~1;
+    }
+  double *real = new double[2*static_cast<vtkIdType>(inSize0)*blockSize];
+  double *imag = real + static_cast<vtkIdType>(inSize0)*blockSize;
 
   target = static_cast<unsigned long>((outMax2-outMin2+1)*(outMax1-outMin1+1)
-                                      * self->GetNumberOfIterations() / 50.0);
+                                      * self->GetNumberOfIterations() /
+                                      (50.0*blockSize));
   target++;
 
   // loop over other axes
@@ -117,60 +126,112 @@ void vtkImageFFTExecute(vtkImageFFT *self,
     {
     inPtr1 = inPtr2;
     outPtr1 = outPtr2;
-    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; ++idx1)
+    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1;
+         idx1 += numRows)
       {
       if (!id)
         {
-        if (!(count%target))
+        if (!(progressCount%target))
           {
-          self->UpdateProgress(count/(50.0*target) + startProgress);
+          self->UpdateProgress(progressCount/(50.0*target) + startProgress);
           }
-        count++;
+        progressCount++;
+        }
+      numRows = outMax1 - idx1 + 1;
+      if (numRows > blockSize)
+        {
+        numRows = blockSize;
         }
-      // copy into complex numbers
+
+      // copy into the block, two real rows per complex row
+      count = realInput ? (numRows + 1) / 2 : numRows;
       inPtr0 = inPtr1;
-      pComplex = inComplex;
+      double *pReal = real;
+      double *pImag = imag;
       for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
         {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
-          { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);;
+        if (realInput)
+          {
+          for (b = 0; b < count; ++b)
+            {
+            pReal[b] = static_cast<double>(inPtr0[2*b*inInc1]);
+            pImag[b] = (2*b + 1 < numRows) ?
+              static_cast<double>(inPtr0[(2*b + 1)*inInc1]) : 0.0;
+            }
+          }
+        else
+          {
+          for (b = 0; b < count; ++b)
+            {
+            pReal[b] = static_cast<double>(inPtr0[b*inInc1]);
+            pImag[b] = static_cast<double>(inPtr0[b*inInc1 + 1]);
+            }
           }
         inPtr0 += inInc0;
-        ++pComplex;
+        pReal += count;
+        pImag += count;
         }
 
       // Call the method that performs the fft
-      self->ExecuteFft(inComplex, outComplex, inSize0);
+      plan.Execute(real, imag, count);
 
       // copy into output
       outPtr0 = outPtr1;
-      pComplex = outComplex + (outMin0 - inMin0);
       for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
         {
-        *outPtr0 = static_cast<double>(pComplex->Real);
-        outPtr0[1] = static_cast<double>(pComplex->Imag);
+        int k = idx0 - inMin0;
+        pReal = real + static_cast<vtkIdType>(k)*count;
+        pImag = imag + static_cast<vtkIdType>(k)*count;
+        if (realInput)
+          {
+          // Z = A + iB with A and B real gives A[k] = (Z[k] + Z*[N-k])/2
+          // and B[k] = -i(Z[k] - Z*[N-k])/2.
+          int kk = (k == 0) ? 0 : inSize0 - k;
+          double *qReal = real + static_cast<vtkIdType>(kk)*count;
+          double *qImag = imag + static_cast<vtkIdType>(kk)*count;
+          for (b = 0; b < numRows; ++b)
+            {
+            int c = b / 2;
+            double *o = outPtr0 + b*outInc1;
+            if (b % 2 == 0)
+              {
+              o[0] = 0.5*(pReal[c] + qReal[c]);
+              o[1] = 0.5*(pImag[c] - qImag[c]);
+              }
+            else
+              {
+              o[0] = 0.5*(pImag[c] + qImag[c]);
+              o[1] = -0.5*(pReal[c] - qReal[c]);
+              }
+            }
+          }
+        else
+          {
+          for (b = 0; b < numRows; ++b)
+            {
+            double *o = outPtr0 + b*outInc1;
+            o[0] = pReal[b];
+            o[1] = pImag[b];
+            }
+          }
         outPtr0 += outInc0;
-        ++pComplex;
         }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      inPtr1 += numRows*inInc1;
+      outPtr1 += numRows*outInc1;
       }
     inPtr2 += inInc2;
     outPtr2 += outInc2;
     }
 
-  delete [] inComplex;
-  delete [] outComplex;
+  delete [] real;
 }
 
 
 //----------------------------------------------------------------------------
 // This method is passed input and output Datas, and executes the fft
 // algorithm to fill the output from the input.
-// Not threaded yet.
+// The threads get pieces split along the axes other than that of this
+// iteration (see SplitExtent).
 void vtkImageFFT::ThreadedRequestData(
   vtkInformation* vtkNotUsed( request ),
   vtkInformationVector** inputVector,
@@ -16,6 +16,7 @@
 
 #include "vtkMath.h"
 #include <math.h>
+#include <string.h>
 
 /*=========================================================================
         Vectors of complex numbers.
@@ -144,64 +145,271 @@ void vtkImageFourierFilter::ExecuteFftStepN(vtkImageComplex *p_in,
 
 //----------------------------------------------------------------------------
 // This function calculates the whole fft (or rfft) of an array.
-// The contents of the input array are changed.
 // It is engineered for no decimation so input and output cannot be equal.
 // (fb = 1) => fft, (fb = -1) => rfft;
 void vtkImageFourierFilter::ExecuteFftForwardBackward(vtkImageComplex *in,
                                                       vtkImageComplex *out,
                                                       int N, int fb)
 {
-  vtkImageComplex *p1, *p2, *p3;
-  int block_size = 1;
-  int rest_size = N;
-  int n = 2;
+  vtkImageFourierFilter::Plan plan(N, fb);
+  double *real = new double[2*N];
+  double *imag = real + N;
   int idx;
 
-  // If this is a reverse transform (scale accordingly).
-  if(fb == -1)
+  for(idx = 0; idx < N; ++idx)
+    {
+    real[idx] = in[idx].Real;
+    imag[idx] = in[idx].Imag;
+    }
+  plan.Execute(real, imag, 1);
+  for(idx = 0; idx < N; ++idx)
+    {
+    out[idx].Real = real[idx];
+    out[idx].Imag = imag[idx];
+    }
+  delete [] real;
+}
+
+/*=========================================================================
+        Plans: blocks of rows of the same length.
+=========================================================================*/
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilter::Plan::Plan(int N, int fb)
+{
+  this->N = N > 1 ? N : 1;
+  this->FB = fb;
+
+  // Factor N, radix 4 first since it needs the fewest multiplications.
+  this->Factors = new int[32];
+  this->NumberOfFactors = 0;
+  int rest = this->N;
+  while(rest % 4 == 0)
+    {
+    this->Factors[this->NumberOfFactors++] = 4;
+    rest /= 4;
+    }
+  for(int n = 2; rest > 1; ++n)
     {
-    p1 = in;
-    for(idx = 0; idx < N; ++idx)
+    while(rest % n == 0)
       {
-      p1->Real = p1->Real / N;
-      p1->Imag = p1->Imag / N;
-      ++p1;
+      this->Factors[this->NumberOfFactors++] = n;
+      rest /= n;
       }
     }
-  p1 = in;
-  p2 = out;
-  while(block_size < N && n <= N)
+
+  this->TwiddleReal = new double[2*this->N];
+  this->TwiddleImag = this->TwiddleReal + this->N;
+  double q = -2.0 * vtkMath::Pi() * fb / this->N;
+  for(int t = 0; t < this->N; ++t)
     {
-    if((rest_size % n) == 0)
+    this->TwiddleReal[t] = cos(q * t);
+    this->TwiddleImag[t] = sin(q * t);
+    }
+
+  this->WorkReal = 0;
+  this->WorkImag = 0;
+  this->WorkSize = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilter::Plan::~Plan()
+{
+  delete [] this->Factors;
+  delete [] this->TwiddleReal;
+  delete [] this->WorkReal;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageFourierFilter::Plan::GetBlockSize()
+{
+  // The rows and the work space take 4*N*count doubles, keep them around
+  // 512 kB.
+  int count = 16384 / this->N;
+  return count < 1 ? 1 : (count > 32 ? 32 : count);
+}
+
+//----------------------------------------------------------------------------
+// One Stockham step of radix r on transforms of length n, s of which have
+// already been interleaved: the outputs k of the butterfly applied to the
+// inputs (p + j*m)*s + q, j in [0, r), are stored at (r*p + k)*s + q, after
+// multiplication by the twiddle factor exp(-2 pi i fb p*k/n).  As every row
+// of the block uses the same factors, the innermost loops run over the s
+// transforms and the count rows at once.
+void vtkImageFourierFilter::Plan::ExecuteRadix(const double *xr,
+                                               const double *xi,
+                                               double *yr, double *yi,
+                                               int n, int s, int r,
+                                               int count)
+{
+  const int m = n / r;
+  const vtkIdType S = static_cast<vtkIdType>(s) * count;
+  const vtkIdType inStride = m * S;
+  const double *tr = this->TwiddleReal;
+  const double *ti = this->TwiddleImag;
+  vtkIdType t;
+
+  for(int p = 0; p < m; ++p)
+    {
+    const double *ar = xr + p * S;
+    const double *ai = xi + p * S;
+    double *br = yr + r * p * S;
+    double *bi = yi + r * p * S;
+    // p*k*s < n*s = N, so the twiddle factors need no modulo.
+    const int w = p * s;
+
+    if(r == 2)
       {
-      // n is a prime factor, perform one "butterfly" stage of the fft.
-      if(n == 2)
+      const double w1r = tr[w], w1i = ti[w];
+      for(t = 0; t < S; ++t)
         {
-        this->ExecuteFftStep2(p1, p2, N, block_size, fb);
+        double x0r = ar[t], x0i = ai[t];
+        double x1r = ar[t + inStride], x1i = ai[t + inStride];
+        double dr = x0r - x1r, di = x0i - x1i;
+        br[t] = x0r + x1r;
+        bi[t] = x0i + x1i;
+        br[t + S] = dr * w1r - di * w1i;
+        bi[t + S] = dr * w1i + di * w1r;
         }
-      else
+      }
+    else if(r == 4)
+      {
+      const double w1r = tr[w], w1i = ti[w];
+      const double w2r = tr[2 * w], w2i = ti[2 * w];
+      const double w3r = tr[3 * w], w3i = ti[3 * w];
+      const double fb = this->FB;
+      for(t = 0; t < S; ++t)
         {
-        this->ExecuteFftStepN(p1, p2, N, block_size, n, fb);
+        double x0r = ar[t], x0i = ai[t];
+        double x1r = ar[t + inStride], x1i = ai[t + inStride];
+        double x2r = ar[t + 2 * inStride], x2i = ai[t + 2 * inStride];
+        double x3r = ar[t + 3 * inStride], x3i = ai[t + 3 * inStride];
+        double t0r = x0r + x2r, t0i = x0i + x2i;
+        double t1r = x0r - x2r, t1i = x0i - x2i;
+        double t2r = x1r + x3r, t2i = x1i + x3i;
+        // (x1 - x3) * (-i fb)
+        double t3r = fb * (x1i - x3i), t3i = -fb * (x1r - x3r);
+        double yr1 = t1r + t3r, yi1 = t1i + t3i;
+        double yr2 = t0r - t2r, yi2 = t0i - t2i;
+        double yr3 = t1r - t3r, yi3 = t1i - t3i;
+        br[t] = t0r + t2r;
+        bi[t] = t0i + t2i;
+        br[t + S] = yr1 * w1r - yi1 * w1i;
+        bi[t + S] = yr1 * w1i + yi1 * w1r;
+        br[t + 2 * S] = yr2 * w2r - yi2 * w2i;
+        bi[t + 2 * S] = yr2 * w2i + yi2 * w2r;
+        br[t + 3 * S] = yr3 * w3r - yi3 * w3i;
+        bi[t + 3 * S] = yr3 * w3i + yi3 * w3r;
+        }
+      }
+    else if(r == 3)
+      {
+      const double w1r = tr[w], w1i = ti[w];
+      const double w2r = tr[2 * w], w2i = ti[2 * w];
+      // imaginary part of exp(-2 pi i fb / 3)
+      const double c = -this->FB * sqrt(3.0) / 2.0;
+      for(t = 0; t < S; ++t)
+        {
+        double x0r = ar[t], x0i = ai[t];
+        double x1r = ar[t + inStride], x1i = ai[t + inStride];
+        double x2r = ar[t + 2 * inStride], x2i = ai[t + 2 * inStride];
+        double sr = x1r + x2r, si = x1i + x2i;
+        double mr = x0r - 0.5 * sr, mi = x0i - 0.5 * si;
+        // i c (x1 - x2)
+        double dr = -c * (x1i - x2i), di = c * (x1r - x2r);
+        double yr1 = mr + dr, yi1 = mi + di;
+        double yr2 = mr - dr, yi2 = mi - di;
+        br[t] = x0r + sr;
+        bi[t] = x0i + si;
+        br[t + S] = yr1 * w1r - yi1 * w1i;
+        bi[t + S] = yr1 * w1i + yi1 * w1r;
+        br[t + 2 * S] = yr2 * w2r - yi2 * w2i;
+        bi[t + 2 * S] = yr2 * w2i + yi2 * w2r;
         }
-      block_size = block_size * n;
-      rest_size = rest_size / n;
-      // switch input and output.
-      p3 = p1;
-      p1 = p2;
-      p2 = p3;
       }
     else
       {
-      // n is not a prime factor. increment n to see if n+1 is.
-      ++n;
+      // Direct DFT of the r inputs.
+      const int rootStep = this->N / r;
+      for(int k = 0; k < r; ++k)
+        {
+        double *ykr = br + k * S;
+        double *yki = bi + k * S;
+        for(t = 0; t < S; ++t)
+          {
+          ykr[t] = ar[t];
+          yki[t] = ai[t];
+          }
+        for(int j = 1; j < r; ++j)
+          {
+          const int e = ((j * k) % r) * rootStep;
+          const double er = tr[e], ei = ti[e];
+          const double *xjr = ar + j * inStride;
+          const double *xji = ai + j * inStride;
+          for(t = 0; t < S; ++t)
+            {
+            ykr[t] += xjr[t] * er - xji[t] * ei;
+            yki[t] += xjr[t] * ei + xji[t] * er;
+            }
+          }
+        if(k > 0 && p > 0)
+          {
+          const double wr = tr[k * w], wi = ti[k * w];
+          for(t = 0; t < S; ++t)
+            {
+            double vr = ykr[t], vi = yki[t];
+            ykr[t] = vr * wr - vi * wi;
+            yki[t] = vr * wi + vi * wr;
+            }
+          }
+        }
       }
     }
-  // If the results ended up in the input, copy to output.
-  if(p1 != out)
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilter::Plan::Execute(double *real, double *imag,
+                                          int count)
+{
+  vtkIdType size = static_cast<vtkIdType>(this->N) * count;
+  if(size > this->WorkSize)
+    {
+    delete [] this->WorkReal;
+    this->WorkReal = new double[2*size];
+    this->WorkImag = this->WorkReal + size;
+    this->WorkSize = size;
+    }
+
+  // Each step reads one buffer and writes the other.
+  double *xr = real, *xi = imag;
+  double *yr = this->WorkReal, *yi = this->WorkImag;
+  int n = this->N;
+  int s = 1;
+  for(int f = 0; f < this->NumberOfFactors; ++f)
+    {
+    int r = this->Factors[f];
+    this->ExecuteRadix(xr, xi, yr, yi, n, s, r, count);
+    double *tmp = xr; xr = yr; yr = tmp;
+    tmp = xi; xi = yi; yi = tmp;
+    n /= r;
+    s *= r;
+    }
+
+  // If the results ended up in the work space, copy them back.
+  if(xr != real)
+    {
+    memcpy(real, xr, size * sizeof(double));
+    memcpy(imag, xi, size * sizeof(double));
+    }
+
+  // The reverse transform is scaled.
+  if(this->FB == -1)
     {
-    for(n = 0; n < N; ++n)
+    double scale = 1.0 / this->N;
+    for(vtkIdType i = 0; i < size; ++i)
       {
-      *out++ = *p1++;
+      real[i] *= scale;
+      imag[i] *= scale;
       }
     }
 }
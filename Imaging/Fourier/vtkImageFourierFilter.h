@@ -18,6 +18,11 @@
 // this superclass is a container for methods that manipulate these structure
 // including fast Fourier transforms.  Complex numbers may become a class.
 // This should really be a helper class.
+//
+// The transforms are computed by a mixed radix Stockham algorithm (which
+// needs no bit reversal) with specialized radix 2, 3 and 4 butterflies.
+// A Plan holds the factors and twiddle factors of one length, and
+// transforms blocks of rows at once.
 #ifndef __vtkImageFourierFilter_h
 #define __vtkImageFourierFilter_h
 
@@ -106,6 +111,53 @@ public:
   // (It is engineered for no decimation)
   void ExecuteRfft(vtkImageComplex *in, vtkImageComplex *out, int N);
 
+  // Description:
+  // Factors and twiddle factors of the transforms of one length, computed
+  // once for all the rows of that length.  Execute() transforms count rows
+  // at once, in place.  The rows are interleaved: value k of row b is at
+  // index k*count + b of real and imag.  Each butterfly is thus applied to
+  // all the rows in one contiguous loop that the compiler can vectorize,
+  // and rows gathered across the fast axis of an image are read and
+  // written in cache-friendly blocks.  fb = 1 computes the fft and
+  // fb = -1 the rfft, scaled by 1/N like ExecuteRfft().
+  class VTKIMAGINGFOURIER_EXPORT Plan
+  {
+  public:
+    Plan(int N, int fb);
+    ~Plan();
+
+    // Description:
+    // Transform count interleaved rows of real and imaginary values.
+    void Execute(double *real, double *imag, int count);
+
+    // Description:
+    // Number of rows worth transforming together, so that they and the
+    // work space stay in cache.
+    int GetBlockSize();
+
+    int GetLength() { return this->N; }
+
+  protected:
+    void ExecuteRadix(const double *xr, const double *xi,
+                      double *yr, double *yi, int n, int s, int r,
+                      int count);
+
+    int N;
+    int FB;
+    int NumberOfFactors;
+    int *Factors;
+    // exp(-2 pi i fb t / N) for t in [0, N)
+    double *TwiddleReal;
+    double *TwiddleImag;
+    double *WorkReal;
+    double *WorkImag;
+    vtkIdType WorkSize;
+
+  private:
+    Plan(const Plan&);  // Not implemented.
+    void operator=(const Plan&);  // Not implemented.
+  };
+
   //ETX
 
 protected:
@@ -60,16 +60,15 @@ int vtkImageRFFT::IterativeRequestUpdateExtent(
 
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
+// is always doubles.  The rows along the axis of this iteration are
+// transformed in blocks of neighbors, which are gathered and scattered one
+// position along the axis at a time.
 template <class T>
 void vtkImageRFFTExecute(vtkImageRFFT *self,
                          vtkImageData *inData, int inExt[6], T *inPtr,
                          vtkImageData *outData, int outExt[6], double *outPtr,
                          int id)
 {
-  vtkImageComplex *inComplex;
-  vtkImageComplex *outComplex;
-  vtkImageComplex *pComplex;
   //
   int inMin0, inMax0;
   vtkIdType inInc0, inInc1, inInc2;
@@ -80,6 +79,7 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
   double *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0, numberOfComponents;
+  int b, blockSize, numRows;
   unsigned long count = 0;
   unsigned long target;
   double startProgress;
@@ -103,12 +103,15 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
     return;
     }
 
-  // Allocate the arrays of complex numbers
-  inComplex = new vtkImageComplex[inSize0];
-  outComplex = new vtkImageComplex[inSize0];
+  // Allocate the block of interleaved rows
+  vtkImageFourierFilter::Plan plan(inSize0, -1);
+  blockSize = plan.GetBlockSize();
+  double *real = new double[2*static_cast<vtkIdType>(inSize0)*blockSize];
+  double *imag = real + static_cast<vtkIdType>(inSize0)*blockSize;
 
   target = static_cast<unsigned long>((outMax2-outMin2+1)*(outMax1-outMin1+1)
-                                      * self->GetNumberOfIterations() / 50.0);
+                                      * self->GetNumberOfIterations() /
+                                      (50.0*blockSize));
   target++;
 
   // loop over other axes
@@ -118,7 +121,8 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
     {
     inPtr1 = inPtr2;
     outPtr1 = outPtr2;
-    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; ++idx1)
+    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1;
+         idx1 += numRows)
       {
       if (!id)
         {
@@ -128,43 +132,59 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
           }
         count++;
         }
-      // copy into complex numbers
+      numRows = outMax1 - idx1 + 1;
+      if (numRows > blockSize)
+        {
+        numRows = blockSize;
+        }
+
+      // copy into the block
       inPtr0 = inPtr1;
-      pComplex = inComplex;
+      double *pReal = real;
+      double *pImag = imag;
       for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
         {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
-          { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);;
+        for (b = 0; b < numRows; ++b)
+          {
+          pReal[b] = static_cast<double>(inPtr0[b*inInc1]);
+          pImag[b] = 0.0;
+          if (numberOfComponents > 1)
+            { // yes we have an imaginary input
+            pImag[b] = static_cast<double>(inPtr0[b*inInc1 + 1]);
+            }
           }
         inPtr0 += inInc0;
-        ++pComplex;
+        pReal += numRows;
+        pImag += numRows;
         }
 
       // Call the method that performs the RFFT
-      self->ExecuteRfft(inComplex, outComplex, inSize0);
+      plan.Execute(real, imag, numRows);
 
       // copy into output
       outPtr0 = outPtr1;
-      pComplex = outComplex + (outMin0 - inMin0);
+      pReal = real + static_cast<vtkIdType>(outMin0 - inMin0)*numRows;
+      pImag = imag + static_cast<vtkIdType>(outMin0 - inMin0)*numRows;
       for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
         {
-        *outPtr0 = static_cast<double>(pComplex->Real);
-        outPtr0[1] = static_cast<double>(pComplex->Imag);
+        for (b = 0; b < numRows; ++b)
+          {
+          double *o = outPtr0 + b*outInc1;
+          o[0] = pReal[b];
+          o[1] = pImag[b];
+          }
         outPtr0 += outInc0;
-        ++pComplex;
+        pReal += numRows;
+        pImag += numRows;
         }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      inPtr1 += numRows*inInc1;
+      outPtr1 += numRows*outInc1;
       }
     inPtr2 += inInc2;
     outPtr2 += outInc2;
     }
 
-  delete [] inComplex;
-  delete [] outComplex;
+  delete [] real;
 }
 
 
@@ -173,7 +193,8 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
 //----------------------------------------------------------------------------
 // This method is passed input and output Datas, and executes the RFFT
 // algorithm to fill the output from the input.
-// Not threaded yet.
+// The threads get pieces split along the axes other than that of this
+// iteration (see SplitExtent).
 void vtkImageRFFT::ThreadedRequestData(
   vtkInformation* vtkNotUsed( request ),
   vtkInformationVector** inputVector,
@@ -23,10 +23,9 @@
 #include "vtkTableFFT.h"
 
 #include "vtkDataArray.h"
-#include "vtkImageData.h"
-#include "vtkImageFFT.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageFourierFilter.h"
 #include "vtkObjectFactory.h"
-#include "vtkPointData.h"
 #include "vtkTable.h"
 
 #include "vtkSmartPointer.h"
@@ -34,6 +33,7 @@
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <string.h>
+#include <vector>
 
 #include <vtksys/SystemTools.hxx>
 using namespace vtksys;
@@ -99,17 +99,32 @@ int vtkTableFFT::RequestData(vtkInformation *vtkNotUsed(request),
 //-----------------------------------------------------------------------------
 vtkSmartPointer<vtkDataArray> vtkTableFFT::DoFFT(vtkDataArray *input)
 {
-  // Build an image data containing the input data.
-  VTK_CREATE(vtkImageData, imgInput);
-  imgInput->SetDimensions(input->GetNumberOfTuples(), 1, 1);
-  imgInput->SetScalarType(input->GetDataType(), input->GetInformation());
-  imgInput->GetPointData()->SetScalars(input);
-
-  // Compute the FFT
-  VTK_CREATE(vtkImageFFT, fft);
-  fft->SetInputData(imgInput);
-  fft->Update();
-
-  // Return the result
-  return vtkSmartPointer<vtkDataArray>(fft->GetOutput()->GetPointData()->GetScalars());
+  // Transform the column directly, there is no need for an image pipeline.
+  vtkIdType numValues = input->GetNumberOfTuples();
+  VTK_CREATE(vtkDoubleArray, output);
+  output->SetNumberOfComponents(2);
+  output->SetNumberOfTuples(numValues);
+  if (numValues == 0)
+    {
+    return output;
+    }
+
+  std::vector<double> values(2*numValues, 0.0);
+  double *real = &values[0];
+  double *imag = real + numValues;
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    real[i] = input->GetComponent(i, 0);
+    }
+
+  vtkImageFourierFilter::Plan plan(static_cast<int>(numValues), 1);
+  plan.Execute(real, imag, 1);
+
+  double *outPtr = output->GetPointer(0);
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    outPtr[2*i] = real[i];
+    outPtr[2*i + 1] = imag[i];
+    }
+  return output;
 }
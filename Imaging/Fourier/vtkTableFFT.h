@@ -25,8 +25,8 @@
 // .SECTION Description
 //
 // vtkTableFFT performs the Fast Fourier Transform on the columns of a table.
-// Internally, it shoves each column into an image data and then uses
-// vtkImageFFT to perform the actual FFT.
+// Each column is transformed with the same engine as vtkImageFFT, and
+// the result is a two component (real, imaginary) double array.
 //
 // .SECTION See Also
 //
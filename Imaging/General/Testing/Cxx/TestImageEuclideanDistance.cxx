@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageEuclideanDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the distance maps of vtkImageEuclideanDistance with a brute
+// force computation, for every algorithm, with anisotropic spacing, float
+// and double output, and signed distances.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <math.h>
+#include <vector>
+
+namespace
+{
+const int Dims[3] = { 23, 17, 11 };
+const double Spacing[3] = { 1.0, 1.5, 0.75 };
+
+// Squared distance from each voxel to the nearest voxel whose mask value
+// differs from "inside", or maxDist if there is none.
+double BruteForce(const std::vector<char>& mask, int x, int y, int z,
+                  char inside, double maxDist)
+{
+  double best = maxDist;
+  for (int k = 0; k < Dims[2]; ++k)
+    {
+    for (int j = 0; j < Dims[1]; ++j)
+      {
+      for (int i = 0; i < Dims[0]; ++i)
+        {
+        if (mask[i + Dims[0]*(j + Dims[1]*k)] != inside)
+          {
+          double dx = (i - x)*Spacing[0];
+          double dy = (j - y)*Spacing[1];
+          double dz = (k - z)*Spacing[2];
+          double d = dx*dx + dy*dy + dz*dz;
+          best = (d < best ? d : best);
+          }
+        }
+      }
+    }
+  return best;
+}
+
+bool TestDistance(const std::vector<char>& mask, int algorithm,
+                  int scalarType, bool signedDistance)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->SetSpacing(Spacing[0], Spacing[1], Spacing[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    scalars->SetComponent(i, 0, mask[i]);
+    }
+
+  vtkNew<vtkImageEuclideanDistance> distance;
+  distance->SetInputData(image.GetPointer());
+  distance->SetAlgorithm(algorithm);
+  distance->SetOutputScalarType(scalarType);
+  distance->SetSignedDistance(signedDistance);
+  distance->SetMaximumDistance(1000.0);
+  distance->Update();
+
+  vtkDataArray* result = distance->GetOutput()->GetPointData()->GetScalars();
+  if (result->GetDataType() != scalarType)
+    {
+    cerr << "Error: wrong output type " << result->GetDataType() << endl;
+    return false;
+    }
+  for (int k = 0; k < Dims[2]; ++k)
+    {
+    for (int j = 0; j < Dims[1]; ++j)
+      {
+      for (int i = 0; i < Dims[0]; ++i)
+        {
+        vtkIdType id = i + Dims[0]*(j + Dims[1]*k);
+        double expected = 0.0;
+        if (mask[id])
+          {
+          expected = BruteForce(mask, i, j, k, 1, 1000.0);
+          }
+        else if (signedDistance)
+          {
+          expected = -BruteForce(mask, i, j, k, 0, 1000.0);
+          }
+        double value = result->GetComponent(id, 0);
+        if (fabs(value - expected) > 1e-4)
+          {
+          cerr << "Error: algorithm " << algorithm << ", type "
+               << scalarType << ", signed " << signedDistance << ": "
+               << value << " instead of " << expected << " at (" << i
+               << ", " << j << ", " << k << ")" << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestImageEuclideanDistance(int, char*[])
+{
+  // a ball with holes, and a few isolated zero voxels
+  std::vector<char> mask(Dims[0]*Dims[1]*Dims[2]);
+  for (int k = 0; k < Dims[2]; ++k)
+    {
+    for (int j = 0; j < Dims[1]; ++j)
+      {
+      for (int i = 0; i < Dims[0]; ++i)
+        {
+        double dx = (i - 9)*Spacing[0];
+        double dy = (j - 8)*Spacing[1];
+        double dz = (k - 5)*Spacing[2];
+        int id = i + Dims[0]*(j + Dims[1]*k);
+        mask[id] = (dx*dx + dy*dy + dz*dz < 64.0 && (id*37) % 101 != 0);
+        }
+      }
+    }
+  mask[3] = 1;
+  mask[mask.size() - 2] = 1;
+
+  int algorithms[3] =
+    { VTK_EDT_SAITO, VTK_EDT_SAITO_CACHED, VTK_EDT_FELZENSZWALB };
+  for (int a = 0; a < 3; ++a)
+    {
+    if (!TestDistance(mask, algorithms[a], VTK_DOUBLE, false) ||
+        !TestDistance(mask, algorithms[a], VTK_FLOAT, false))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  if (!TestDistance(mask, VTK_EDT_FELZENSZWALB, VTK_DOUBLE, true) ||
+      !TestDistance(mask, VTK_EDT_FELZENSZWALB, VTK_FLOAT, true))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
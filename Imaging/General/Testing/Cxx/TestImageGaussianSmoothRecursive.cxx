@@ -0,0 +1,256 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageGaussianSmoothRecursive.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the recursive method of vtkImageGaussianSmooth against a sampled
+// gaussian and against the direct method, checks that it keeps constant
+// images constant up to the boundaries, then checks the first and second
+// derivatives of vtkImageGradient with and without smoothing.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkImageGradient.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <math.h>
+
+namespace
+{
+vtkImageData* CreateImage(int nx, int ny, int nz)
+{
+  vtkImageData* image = vtkImageData::New();
+  image->SetExtent(0, nx - 1, 0, ny - 1, 0, nz - 1);
+  image->AllocateScalars(VTK_DOUBLE, 1);
+  return image;
+}
+
+// The impulse response must be a normalized gaussian of the right width.
+bool TestImpulse(double sigma)
+{
+  int center = static_cast<int>(10*sigma) + 20;
+  vtkImageData* image = CreateImage(2*center + 1, 1, 1);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  scalars->FillComponent(0, 0.0);
+  scalars->SetComponent(center, 0, 1.0);
+
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputData(image);
+  smooth->SetDimensionality(1);
+  smooth->SetStandardDeviation(sigma);
+  smooth->SetMethodToRecursive();
+  smooth->Update();
+  image->Delete();
+
+  vtkDataArray* result = smooth->GetOutput()->GetPointData()->GetScalars();
+  double sum = 0.0, mean = 0.0, variance = 0.0, maxError = 0.0;
+  for (int i = 0; i <= 2*center; ++i)
+    {
+    double v = result->GetComponent(i, 0);
+    double x = i - center;
+    double g = exp(-0.5*x*x/(sigma*sigma))/(sqrt(2*vtkMath::Pi())*sigma);
+    sum += v;
+    mean += v*x;
+    variance += v*x*x;
+    maxError = (fabs(v - g) > maxError ? fabs(v - g) : maxError);
+    }
+  double peak = 1.0/(sqrt(2*vtkMath::Pi())*sigma);
+  if (fabs(sum - 1.0) > 1e-5 || fabs(mean) > 1e-6 ||
+      fabs(sqrt(variance) - sigma) > 1e-3*sigma || maxError > 0.04*peak)
+    {
+    cerr << "Error: impulse response for sigma " << sigma << " has sum "
+         << sum << ", mean " << mean << ", deviation " << sqrt(variance)
+         << ", error " << maxError/peak << endl;
+    return false;
+    }
+  return true;
+}
+
+// A constant image stays constant, and the recursive method is close to
+// the direct one with a kernel that is truncated far away.
+bool TestVolume(int scalarType)
+{
+  vtkImageData* image = CreateImage(30, 25, 20);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputData(image);
+  smooth->SetStandardDeviations(3.0, 1.5, 0.3);
+  smooth->SetMethodToRecursive();
+  scalars->FillComponent(0, 7.0);
+  smooth->Update();
+  vtkDataArray* result = smooth->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < result->GetNumberOfTuples(); ++i)
+    {
+    if (fabs(result->GetComponent(i, 0) - 7.0) > 1e-9)
+      {
+      cerr << "Error: constant image is not kept constant at " << i << endl;
+      image->Delete();
+      return false;
+      }
+    }
+
+  // a smooth pattern, so that the sampled gaussians of the direct method
+  // are comparable
+  vtkImageData* pattern = CreateImage(30, 25, 20);
+  pattern->AllocateScalars(scalarType, 1);
+  scalars = pattern->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    int x = static_cast<int>(i % 30);
+    int y = static_cast<int>((i / 30) % 25);
+    int z = static_cast<int>(i / 750);
+    scalars->SetComponent(i, 0, 100.0 + 50.0*sin(0.4*x)*cos(0.3*y) +
+                          20.0*((x*7 + y*3 + z*5) % 11));
+    }
+  image->Delete();
+
+  vtkNew<vtkImageGaussianSmooth> direct;
+  direct->SetInputData(pattern);
+  direct->SetStandardDeviations(3.0, 1.5, 0.3);
+  direct->SetRadiusFactors(6.0, 6.0, 6.0);
+  direct->Update();
+  smooth->SetInputData(pattern);
+  smooth->Update();
+
+  vtkDataArray* expected = direct->GetOutput()->GetPointData()->GetScalars();
+  result = smooth->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < result->GetNumberOfTuples(); ++i)
+    {
+    int x = static_cast<int>(i % 30);
+    int y = static_cast<int>((i / 30) % 25);
+    // the boundary conditions differ
+    if (x < 9 || x > 20 || y < 5 || y > 19)
+      {
+      continue;
+      }
+    if (fabs(result->GetComponent(i, 0) - expected->GetComponent(i, 0)) > 3.0)
+      {
+      cerr << "Error: recursive and direct methods differ at " << i << ": "
+           << result->GetComponent(i, 0) << " instead of "
+           << expected->GetComponent(i, 0) << endl;
+      pattern->Delete();
+      return false;
+      }
+    }
+
+  // a piece of the output matches the whole output
+  vtkNew<vtkImageGaussianSmooth> piece;
+  piece->SetInputData(pattern);
+  piece->SetStandardDeviations(3.0, 1.5, 0.3);
+  piece->SetMethodToRecursive();
+  piece->EnableSMPOn();
+  int extent[6] = { 4, 20, 3, 9, 5, 12 };
+  piece->UpdateInformation();
+  piece->SetUpdateExtent(extent);
+  piece->Update();
+  vtkImageData* output = piece->GetOutput();
+  for (int z = 5; z <= 12; ++z)
+    {
+    for (int y = 3; y <= 9; ++y)
+      {
+      for (int x = 4; x <= 20; ++x)
+        {
+        double a = output->GetScalarComponentAsDouble(x, y, z, 0);
+        double b = smooth->GetOutput()->GetScalarComponentAsDouble(x, y, z, 0);
+        if (a != b)
+          {
+          cerr << "Error: piece differs at (" << x << ", " << y << ", " << z
+               << ")" << endl;
+          pattern->Delete();
+          return false;
+          }
+        }
+      }
+    }
+  pattern->Delete();
+  return true;
+}
+
+// The derivatives of x^2 + 3xy - 2y are exact with central differences,
+// and are kept by the smoothing away from the boundaries, except for the
+// constant that the gaussian adds to the second derivatives.
+bool TestGradient(int order, double sigma)
+{
+  vtkImageData* image = CreateImage(100, 90, 1);
+  image->SetSpacing(0.5, 2.0, 1.0);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    double x = 0.5*(i % 100);
+    double y = 2.0*(i / 100);
+    scalars->SetComponent(i, 0, x*x + 3*x*y - 2*y);
+    }
+
+  vtkNew<vtkImageGradient> gradient;
+  gradient->SetInputData(image);
+  gradient->SetDerivativeOrder(order);
+  gradient->SetStandardDeviation(sigma);
+  gradient->Update();
+  image->Delete();
+
+  vtkImageData* output = gradient->GetOutput();
+  // the smoothing extends the image with its boundary values, whose
+  // effect decays exponentially
+  int margin = (sigma > 0.0 ? 30 : 1);
+  double tol = (sigma > 0.0 ? 1e-4 : 1e-9);
+  for (int j = margin; j < 90 - margin; ++j)
+    {
+    for (int i = margin; i < 100 - margin; ++i)
+      {
+      double x = 0.5*i;
+      double y = 2.0*j;
+      double dx = output->GetScalarComponentAsDouble(i, j, 0, 0);
+      double dy = output->GetScalarComponentAsDouble(i, j, 0, 1);
+      double ex = (order == 1 ? 2*x + 3*y : 2.0);
+      double ey = (order == 1 ? 3*x - 2 : 0.0);
+      if (fabs(dx - ex) > tol*(1.0 + fabs(ex)) ||
+          fabs(dy - ey) > tol*(1.0 + fabs(ey)))
+        {
+        cerr << "Error: derivatives of order " << order << " with sigma "
+             << sigma << " at (" << i << ", " << j << ") are (" << dx
+             << ", " << dy << ") instead of (" << ex << ", " << ey << ")"
+             << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestImageGaussianSmoothRecursive(int, char*[])
+{
+  double sigmas[] = { 1.0, 2.0, 5.0, 20.0, 150.0 };
+  for (int i = 0; i < 5; ++i)
+    {
+    if (!TestImpulse(sigmas[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  if (!TestVolume(VTK_FLOAT) || !TestVolume(VTK_DOUBLE))
+    {
+    return EXIT_FAILURE;
+    }
+  for (int order = 1; order <= 2; ++order)
+    {
+    if (!TestGradient(order, 0.0) || !TestGradient(order, 2.0))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
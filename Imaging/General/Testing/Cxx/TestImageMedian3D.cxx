@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMedian3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkImageMedian3D with a sorted neighborhood for kernels that
+// use the selection networks, the sliding histogram and the sorted
+// samples, for several scalar types and two components.  With an even
+// number of elements the median is the larger of the two middle values.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+const int Dims[3] = { 26, 19, 11 };
+
+double Value(int scalarType, vtkIdType i, int c)
+{
+  vtkIdType v = (i*7919 + c*104729) % 65521;
+  switch (scalarType)
+    {
+    case VTK_UNSIGNED_CHAR:
+      return static_cast<double>(v % 256);
+    case VTK_SHORT:
+      // clusters of values far apart, to skip many empty bins
+      return static_cast<double>((v % 3)*20000 - 30000 + v % 500);
+    case VTK_UNSIGNED_SHORT:
+      return static_cast<double>(v);
+    }
+  return 0.01*v - 300.0;
+}
+
+bool TestMedian(int scalarType, int numComponents, const int size[3],
+                bool smp)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+  image->AllocateScalars(scalarType, numComponents);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < numComponents; ++c)
+      {
+      scalars->SetComponent(i, c, Value(scalarType, i, c));
+      }
+    }
+
+  vtkNew<vtkImageMedian3D> median;
+  median->SetInputData(image.GetPointer());
+  median->SetKernelSize(size[0], size[1], size[2]);
+  median->SetNumberOfThreads(3);
+  median->SetEnableSMP(smp);
+  median->Update();
+  vtkDataArray* result = median->GetOutput()->GetPointData()->GetScalars();
+
+  std::vector<double> hood;
+  for (int z = 0; z < Dims[2]; ++z)
+    {
+    for (int y = 0; y < Dims[1]; ++y)
+      {
+      for (int x = 0; x < Dims[0]; ++x)
+        {
+        int idx[3] = { x, y, z };
+        int lo[3], hi[3];
+        for (int j = 0; j < 3; ++j)
+          {
+          lo[j] = std::max(idx[j] - size[j]/2, 0);
+          hi[j] = std::min(idx[j] - size[j]/2 + size[j] - 1, Dims[j] - 1);
+          }
+        for (int c = 0; c < numComponents; ++c)
+          {
+          hood.clear();
+          for (int k = lo[2]; k <= hi[2]; ++k)
+            {
+            for (int j = lo[1]; j <= hi[1]; ++j)
+              {
+              for (int i = lo[0]; i <= hi[0]; ++i)
+                {
+                hood.push_back(
+                  scalars->GetComponent(i + Dims[0]*(j + Dims[1]*k), c));
+                }
+              }
+            }
+          std::sort(hood.begin(), hood.end());
+          size_t n = hood.size();
+          double value = result->GetComponent(x + Dims[0]*(y + Dims[1]*z), c);
+          if (value != hood[n/2])
+            {
+            cerr << "Error: median of type "
+                 << vtkImageScalarTypeNameMacro(scalarType) << " with kernel "
+                 << size[0] << "x" << size[1] << "x" << size[2] << " is "
+                 << value << " instead of " << hood[n/2] << " at (" << x
+                 << ", " << y << ", " << z << ")" << endl;
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestImageMedian3D(int, char*[])
+{
+  int types[4] = {
+    VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT, VTK_FLOAT };
+  // networks, sorted samples or histograms, and even sizes
+  int sizes[][3] = {
+    { 3, 1, 1 }, { 1, 5, 1 }, { 7, 1, 1 }, { 3, 3, 1 }, { 5, 1, 5 },
+    { 3, 3, 3 }, { 7, 7, 1 }, { 5, 3, 3 }, { 4, 3, 1 }, { 2, 2, 2 } };
+  for (int t = 0; t < 4; ++t)
+    {
+    for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); ++s)
+      {
+      if (!TestMedian(types[t], 1 + static_cast<int>(s % 2), sizes[s],
+                      s % 3 == 0))
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -18,9 +18,11 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <math.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageEuclideanDistance);
 
@@ -32,6 +34,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->OutputScalarType = VTK_DOUBLE;
+  this->SignedDistance = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -39,7 +43,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
 int vtkImageEuclideanDistance::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
-  vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 1);
+  vtkDataObject::SetPointDataActiveScalarInfo(
+    output, this->OutputScalarType, 1);
   return 1;
 }
 
@@ -57,19 +62,19 @@ int vtkImageEuclideanDistance::IterativeRequestUpdateExtent(
 
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
-template <class TT>
+// is always float or double.
+template <class TT, class OT>
 void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance *self,
                                        vtkImageData *inData, TT *inPtr,
                                        vtkImageData *outData, int outExt[6],
-                                       double *outPtr )
+                                       OT *outPtr )
 {
   vtkIdType inInc0, inInc1, inInc2;
   TT *inPtr0, *inPtr1, *inPtr2;
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  OT *outPtr0, *outPtr1, *outPtr2;
 
   int idx0, idx1, idx2;
 
@@ -105,22 +110,22 @@ void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance *self,
 
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
-template <class T>
+// is always float or double.
+template <class T, class OT>
 void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance *self,
                                          vtkImageData *inData, T *inPtr,
                                          vtkImageData *outData,
-                                         int outExt[6], double *outPtr )
+                                         int outExt[6], OT *outPtr )
 {
   vtkIdType inInc0, inInc1, inInc2;
   T *inPtr0, *inPtr1, *inPtr2;
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  OT *outPtr0, *outPtr1, *outPtr2;
 
   int idx0, idx1, idx2;
-  double maxDist;
+  double maxDist, zeroDist;
 
   // Reorder axes
   self->PermuteExtent(outExt, outMin0,outMax0,outMin1,outMax1,outMin2,outMax2);
@@ -129,10 +134,11 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance *self,
 
   if ( self->GetInitialize() == 1 )
     // Initialization required. Input image is only used as binary mask,
-    // so all non-zero values are set to maxDist
-    //
+    // so all non-zero values are set to maxDist, and zero values to
+    // -maxDist for the signed distance
     {
     maxDist = self->GetMaximumDistance();
+    zeroDist = (self->GetSignedDistance() ? -maxDist : 0.0);
 
     inPtr2 = inPtr;
     outPtr2 = outPtr;
@@ -147,8 +153,8 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance *self,
 
         for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
           {
-          if( *inPtr0 == 0 ) {*outPtr0 = 0;}
-          else {*outPtr0 = maxDist;}
+          if( *inPtr0 == 0 ) {*outPtr0 = static_cast<OT>(zeroDist);}
+          else {*outPtr0 = static_cast<OT>(maxDist);}
 
           inPtr0 += inInc0;
           outPtr0 += outInc0;
@@ -166,8 +172,7 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance *self,
     {
     vtkImageEuclideanDistanceCopyData( self,
                                        inData, static_cast<T *>(inPtr),
-                                       outData, outExt,
-                                       static_cast<double *>(outPtr) );
+                                       outData, outExt, outPtr );
     }
 }
 
@@ -180,14 +185,15 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance *self,
 //
 // Notations stay as close as possible to those used in the paper.
 //
-static void vtkImageEuclideanDistanceExecuteSaito(vtkImageEuclideanDistance *self,
+template <class T>
+void vtkImageEuclideanDistanceExecuteSaito(vtkImageEuclideanDistance *self,
                                            vtkImageData *outData,
-                                           int outExt[6], double *outPtr )
+                                           int outExt[6], T *outPtr )
 {
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  T *outPtr0, *outPtr1, *outPtr2;
   int idx0, idx1, idx2, inSize0;
   double maxDist;
   double *sq;
@@ -362,21 +368,22 @@ static void vtkImageEuclideanDistanceExecuteSaito(vtkImageEuclideanDistance *sel
 //----------------------------------------------------------------------------
 // Execute Saito's algorithm, modified for Cache Efficiency
 //
-static void vtkImageEuclideanDistanceExecuteSaitoCached(
+template <class T>
+void vtkImageEuclideanDistanceExecuteSaitoCached(
   vtkImageEuclideanDistance *self,
-  vtkImageData *outData, int outExt[6], double *outPtr )
+  vtkImageData *outData, int outExt[6], T *outPtr )
 {
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  T *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0;
 
   double maxDist;
 
   double *sq;
-  double *buff,*temp,buffer;
+  double *buff,*temp,*tempPtr,buffer;
   int df,a,b,n;
   double m;
 
@@ -478,8 +485,8 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
 
         // forward scan
         a=0; buffer=buff[ outMin0 ];
-        outPtr0 = temp ;
-        outPtr0 ++;
+        tempPtr = temp ;
+        tempPtr ++;
 
         for (idx0 = outMin0+1; idx0 <= outMax0; ++idx0)
           {
@@ -494,7 +501,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
               {
               m=buffer+sq[n+1];
               if(buff[idx0+n]<=m) {n=b;}
-              else if(m<*(outPtr0+n)) {*(outPtr0+n)=m;}
+              else if(m<*(tempPtr+n)) {*(tempPtr+n)=m;}
               }
             a=b;
             }
@@ -504,11 +511,11 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
             }
 
           buffer=buff[idx0];
-          outPtr0 ++;
+          tempPtr ++;
           }
 
         // backward scan
-        outPtr0 -= 2;
+        tempPtr -= 2;
         a=0;
         buffer=buff[outMax0];
 
@@ -524,7 +531,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
               {
               m=buffer+sq[n+1];
               if(buff[idx0-n]<=m) {n=b;}
-              else if(m<*(outPtr0-n)) {*(outPtr0-n)=m;}
+              else if(m<*(tempPtr-n)) {*(tempPtr-n)=m;}
               }
             a=b;
             }
@@ -533,7 +540,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
             a=0;
             }
           buffer=buff[idx0];
-          outPtr0 --;
+          tempPtr --;
           }
 
         // Unbuffer current values
@@ -554,11 +561,214 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+//----------------------------------------------------------------------------
+// Execute the algorithm of Felzenszwalb and Huttenlocher, which computes
+// the lower envelope of the parabolas w*(p-q)^2 + f[q] of a row in linear
+// time.
+//
+// P.F. Felzenszwalb and D.P. Huttenlocher. Distance transforms of sampled
+// functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+//
+// The envelope d is computed from the n values of f, using v and z, which
+// have room for n and n+1 values.
+static void vtkImageEuclideanDistanceEnvelope(const double *f, double *d,
+                                              int n, double w, int *v,
+                                              double *z)
+{
+  int k = 0;
+  v[0] = 0;
+  z[0] = -VTK_DOUBLE_MAX;
+  z[1] = VTK_DOUBLE_MAX;
+  for (int q = 1; q < n; ++q)
+    {
+    // intersection of the parabolas of q and of the last one kept
+    double s;
+    for (;;)
+      {
+      int r = v[k];
+      s = ((f[q] + w*q*q) - (f[r] + w*r*r))/(2.0*w*(q - r));
+      if (s > z[k])
+        {
+        break;
+        }
+      --k;
+      }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k+1] = VTK_DOUBLE_MAX;
+    }
+
+  k = 0;
+  for (int p = 0; p < n; ++p)
+    {
+    while (z[k+1] < p)
+      {
+      ++k;
+      }
+    double dp = p - v[k];
+    d[p] = w*dp*dp + f[v[k]];
+    }
+}
+
+//----------------------------------------------------------------------------
+// Computes the envelope of each row along the iteration axis, with the rows
+// distributed over the threads.  For the signed distance, the positive
+// values hold the squared distances to the zero or negative points, and
+// the negative values minus the squared distances to the positive points,
+// so each row gives two envelopes.
+template <class T>
+class vtkImageEuclideanDistanceFunctor
+{
+public:
+  T *OutPtr;
+  vtkIdType Inc0, Inc1, Inc2;
+  int Size0, Size1;
+  double Weight;
+  int SignedDistance;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    int n = this->Size0;
+    std::vector<double> values(n), f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+    for (vtkIdType row = begin; row < end; ++row)
+      {
+      T *ptr = this->OutPtr + (row % this->Size1)*this->Inc1 +
+        (row / this->Size1)*this->Inc2;
+      int numPositive = 0, numNegative = 0;
+      int i;
+      for (i = 0; i < n; ++i)
+        {
+        values[i] = ptr[i*this->Inc0];
+        numPositive += (values[i] > 0);
+        numNegative += (values[i] < 0);
+        }
+
+      if (numPositive > 0)
+        {
+        for (i = 0; i < n; ++i)
+          {
+          f[i] = (values[i] > 0 ? values[i] : 0.0);
+          }
+        vtkImageEuclideanDistanceEnvelope(&f[0], &d[0], n, this->Weight,
+                                          &v[0], &z[0]);
+        for (i = 0; i < n; ++i)
+          {
+          if (values[i] > 0)
+            {
+            ptr[i*this->Inc0] = static_cast<T>(d[i]);
+            }
+          }
+        }
+
+      if (numNegative > 0 && this->SignedDistance)
+        {
+        for (i = 0; i < n; ++i)
+          {
+          f[i] = (values[i] < 0 ? -values[i] : 0.0);
+          }
+        vtkImageEuclideanDistanceEnvelope(&f[0], &d[0], n, this->Weight,
+                                          &v[0], &z[0]);
+        for (i = 0; i < n; ++i)
+          {
+          if (values[i] < 0)
+            {
+            ptr[i*this->Inc0] = static_cast<T>(-d[i]);
+            }
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageEuclideanDistanceExecuteFelzenszwalb(
+  vtkImageEuclideanDistance *self,
+  vtkImageData *outData, int outExt[6], T *outPtr )
+{
+  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
+  vtkImageEuclideanDistanceFunctor<T> functor;
+
+  self->PermuteExtent(outExt, outMin0,outMax0,outMin1,outMax1,outMin2,outMax2);
+  self->PermuteIncrements(outData->GetIncrements(),
+                          functor.Inc0, functor.Inc1, functor.Inc2);
+  functor.OutPtr = outPtr;
+  functor.Size0 = outMax0 - outMin0 + 1;
+  functor.Size1 = outMax1 - outMin1 + 1;
+  functor.SignedDistance = self->GetSignedDistance();
+  functor.Weight = 1.0;
+  if ( self->GetConsiderAnisotropy() )
+    {
+    double spacing = outData->GetSpacing()[ self->GetIteration() ];
+    functor.Weight = spacing*spacing;
+    }
+
+  vtkIdType numRows =
+    static_cast<vtkIdType>(functor.Size1)*(outMax2 - outMin2 + 1);
+  vtkSMPTools::For(0, numRows, functor);
+}
+
+//----------------------------------------------------------------------------
+// Initializes or copies the output, then calls the specific algorithm.
+template <class OT>
+void vtkImageEuclideanDistanceExecute(vtkImageEuclideanDistance *self,
+                                      vtkImageData *inData, void *inPtr,
+                                      vtkImageData *outData, int outExt[6],
+                                      OT *outPtr )
+{
+  if ( self->GetIteration() == 0 )
+    {
+    switch (inData->GetScalarType())
+      {
+      vtkTemplateMacro(
+        vtkImageEuclideanDistanceInitialize(self,
+                                            inData,
+                                            static_cast<VTK_TT *>(inPtr),
+                                            outData, outExt, outPtr ));
+      default:
+        vtkErrorWithObjectMacro(self, << "Execute: Unknown ScalarType");
+        return;
+      }
+    }
+  else
+    {
+    if( inData != outData )
+      switch (inData->GetScalarType())
+        {
+        vtkTemplateMacro(
+          vtkImageEuclideanDistanceCopyData(self,
+                                            inData,
+                                            static_cast<VTK_TT *>(inPtr),
+                                            outData, outExt, outPtr ));
+        }
+    }
+
+  // Call the specific algorithms.
+  switch( self->GetAlgorithm() )
+    {
+    case VTK_EDT_SAITO:
+      vtkImageEuclideanDistanceExecuteSaito( self, outData, outExt, outPtr );
+      break;
+    case VTK_EDT_SAITO_CACHED:
+      vtkImageEuclideanDistanceExecuteSaitoCached( self, outData, outExt,
+                                                   outPtr );
+      break;
+    case VTK_EDT_FELZENSZWALB:
+      vtkImageEuclideanDistanceExecuteFelzenszwalb( self, outData, outExt,
+                                                    outPtr );
+      break;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(vtkImageData *outData,
                                                       int outExt[6],
                                                       vtkInformation* outInfo)
 {
+  // the intermediate outputs need the spacing for ConsiderAnisotropy
+  outData->CopyInformationFromPipeline(outInfo);
   outData->SetExtent(outExt);
   outData->AllocateScalars(outInfo);
 }
@@ -598,10 +808,11 @@ int vtkImageEuclideanDistance::IterativeRequestData(
     }
 
 
-  // this filter expects that the output be doubles.
-  if (outData->GetScalarType() != VTK_DOUBLE)
+  // this filter expects that the output be floats or doubles.
+  if (outData->GetScalarType() != VTK_DOUBLE &&
+      outData->GetScalarType() != VTK_FLOAT)
     {
-    vtkErrorMacro(<< "Execute: Output must be be type double.");
+    vtkErrorMacro(<< "Execute: Output must be be type float or double.");
     return 1;
     }
 
@@ -612,48 +823,30 @@ int vtkImageEuclideanDistance::IterativeRequestData(
     return 1;
     }
 
-  if ( this->GetIteration() == 0 )
+  if (this->Algorithm != VTK_EDT_SAITO &&
+      this->Algorithm != VTK_EDT_SAITO_CACHED &&
+      this->Algorithm != VTK_EDT_FELZENSZWALB)
     {
-    switch (inData->GetScalarType())
-      {
-      vtkTemplateMacro(
-        vtkImageEuclideanDistanceInitialize(this,
-                                            inData,
-                                            static_cast<VTK_TT *>(inPtr),
-                                            outData, outExt,
-                                            static_cast<double *>(outPtr) ));
-      default:
-        vtkErrorMacro(<< "Execute: Unknown ScalarType");
-        return 1;
-      }
+    vtkErrorMacro(<< "Execute: Unknown Algorithm");
+    return 1;
     }
-  else
+
+  if (this->SignedDistance && this->Algorithm != VTK_EDT_FELZENSZWALB)
     {
-    if( inData != outData )
-      switch (inData->GetScalarType())
-        {
-        vtkTemplateMacro(
-          vtkImageEuclideanDistanceCopyData(this,
-                                            inData,
-                                            static_cast<VTK_TT *>(inPtr),
-                                            outData, outExt,
-                                            static_cast<double *>(outPtr) ));
-        }
+    vtkErrorMacro(<< "Execute: SignedDistance requires the Felzenszwalb "
+                  "algorithm");
+    return 1;
     }
 
-  // Call the specific algorithms.
-  switch( this->GetAlgorithm() )
+  if (outData->GetScalarType() == VTK_FLOAT)
     {
-    case VTK_EDT_SAITO:
-      vtkImageEuclideanDistanceExecuteSaito( this, outData, outExt,
-                                             static_cast<double *>(outPtr) );
-      break;
-    case VTK_EDT_SAITO_CACHED:
-      vtkImageEuclideanDistanceExecuteSaitoCached( this, outData, outExt,
-                                                   static_cast<double *>(outPtr) );
-      break;
-    default:
-      vtkErrorMacro(<< "Execute: Unknown Algorithm");
+    vtkImageEuclideanDistanceExecute(this, inData, inPtr, outData, outExt,
+                                     static_cast<float *>(outPtr));
+    }
+  else
+    {
+    vtkImageEuclideanDistanceExecute(this, inData, inPtr, outData, outExt,
+                                     static_cast<double *>(outPtr));
     }
 
   this->UpdateProgress((this->GetIteration()+1.0)/3.0);
@@ -747,10 +940,18 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << "Saito\n";
     }
+  else if ( this->Algorithm == VTK_EDT_FELZENSZWALB )
+    {
+    os << "Felzenszwalb\n";
+    }
   else
     {
     os << "Saito Cached\n";
     }
+
+  os << indent << "Output Scalar Type: " << this->OutputScalarType << "\n";
+  os << indent << "Signed Distance: "
+     << (this->SignedDistance ? "On\n" : "Off\n");
 }
 
 
@@ -29,6 +29,12 @@
 // slow it very significantly. In that case, one should use
 // ::SetAlgorithmToSaitoCached() instead for better performance.
 //
+// The algorithm of Felzenszwalb and Huttenlocher, selected with
+// ::SetAlgorithmToFelzenszwalb(), has a linear complexity whatever the
+// image.  It computes the distances of each row independently, with the
+// rows distributed over threads by vtkSMPTools, and it can compute signed
+// distances.
+//
 // References:
 //
 // T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
@@ -38,6 +44,9 @@
 // O. Cuisenaire. Distance Transformation: fast algorithms and applications
 // to medical image processing. PhD Thesis, Universite catholique de Louvain,
 // October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf
+//
+// P.F. Felzenszwalb and D.P. Huttenlocher. Distance transforms of sampled
+// functions. Theory of Computing, 8(19). pp. 415--428, 2012.
 
 
 #ifndef __vtkImageEuclideanDistance_h
@@ -48,6 +57,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -93,13 +103,37 @@ public:
   // Selects a Euclidean DT algorithm.
   // 1. Saito
   // 2. Saito-cached
-  // More algorithms will be added later on.
+  // 3. Felzenszwalb
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito ()
     { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached ()
     { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToFelzenszwalb ()
+    { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
+
+  // Description:
+  // Set/Get the scalar type of the output, float or double.  Float halves
+  // the memory, and holds exactly the squared distances, in voxels, of
+  // volumes up to 2048 voxels wide.  Other types are clamped to one of
+  // the two.  The default is double.
+  vtkSetClampMacro(OutputScalarType, int, VTK_FLOAT, VTK_DOUBLE);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat ()
+    { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble ()
+    { this->SetOutputScalarType(VTK_DOUBLE); }
+
+  // Description:
+  // Compute the signed distance map: the non-zero voxels get the squared
+  // distance to the nearest zero voxel, and the zero voxels minus the
+  // squared distance to the nearest non-zero voxel.  Without
+  // Initialize, the negative values of the input are the starting values
+  // of the zero voxels.  Only the Felzenszwalb algorithm supports it.
+  vtkSetMacro(SignedDistance, int);
+  vtkGetMacro(SignedDistance, int);
+  vtkBooleanMacro(SignedDistance, int);
 
   virtual int IterativeRequestData(vtkInformation*,
                                    vtkInformationVector**,
@@ -113,6 +147,8 @@ protected:
   int Initialize;
   int ConsiderAnisotropy;
   int Algorithm;
+  int OutputScalarType;
+  int SignedDistance;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData *outData,
@@ -18,9 +18,11 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <math.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageGaussianSmooth);
 
@@ -34,6 +36,7 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->Method = VTK_GAUSSIAN_SMOOTH_DIRECT;
 }
 
 //----------------------------------------------------------------------------
@@ -61,6 +64,31 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
      << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", "
      << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "Method: " << this->GetMethodAsString() << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char *vtkImageGaussianSmooth::GetMethodAsString()
+{
+  switch (this->Method)
+    {
+    case VTK_GAUSSIAN_SMOOTH_DIRECT:
+      return "Direct";
+    case VTK_GAUSSIAN_SMOOTH_RECURSIVE:
+      return "Recursive";
+    default:
+      return "";
+    }
+}
+
+//----------------------------------------------------------------------------
+// The recursive approximation is poor below a standard deviation of one
+// pixel, where the direct kernel is small anyway.
+int vtkImageGaussianSmooth::UseRecursion(int axis)
+{
+  return (this->Method == VTK_GAUSSIAN_SMOOTH_RECURSIVE &&
+          this->StandardDeviations[axis] >= 1.0);
 }
 
 //----------------------------------------------------------------------------
@@ -125,6 +153,13 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int *inExt,
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
     {
+    // the recursive filter needs whole rows
+    if (this->UseRecursion(idx))
+      {
+      inExt[idx*2] = wholeExtent[idx*2];
+      inExt[idx*2+1] = wholeExtent[idx*2+1];
+      continue;
+      }
     radius = static_cast<int>(this->StandardDeviations[idx]
                               * this->RadiusFactors[idx]);
     inExt[idx*2] -= radius;
@@ -243,6 +278,299 @@ size_t vtkImageGaussianSmoothGetTypeSize(T*)
   return sizeof(T);
 }
 
+//----------------------------------------------------------------------------
+// The coefficients of the third order recursive filter of van Vliet, Young
+// and Verbeek, and the matrix of Triggs and Sdika that gives the values
+// past the end of a row for the backward pass from the last values of the
+// forward pass.
+class vtkImageGaussianSmoothRecursiveFilter
+{
+public:
+  vtkImageGaussianSmoothRecursiveFilter(double sigma);
+
+  double B;
+  double A[3];
+  double M[9];
+};
+
+//----------------------------------------------------------------------------
+vtkImageGaussianSmoothRecursiveFilter::vtkImageGaussianSmoothRecursiveFilter(
+  double sigma)
+{
+  // The poles designed for a standard deviation of 2 are raised to the
+  // power 1/q, with q chosen so that the variance of the forward and
+  // backward passes is sigma^2.  Each pole p adds 2p/(1-p)^2 to it.
+  double r = sqrt(1.40098*1.40098 + 1.00236*1.00236);
+  double theta = atan2(1.00236, 1.40098);
+  double low = 0.4;
+  double high = (sigma > 1.0 ? sigma : 1.0);
+  double rho = 0.0, c = 0.0, p = 0.0;
+  for (int i = 0; i < 64; ++i)
+    {
+    double q = 0.5*(low + high);
+    // the complex poles are c +/- i*s, the real pole is p
+    rho = pow(r, -1.0/q);
+    c = rho*cos(theta/q);
+    double s = rho*sin(theta/q);
+    p = pow(1.85132, -1.0/q);
+    double u = 1.0 - c;
+    double uv = u*u + s*s;
+    double variance = 2.0*(2.0*(c*(u*u - s*s) - 2.0*s*s*u)/(uv*uv) +
+                           p/((1.0 - p)*(1.0 - p)));
+    if (variance < sigma*sigma)
+      {
+      low = q;
+      }
+    else
+      {
+      high = q;
+      }
+    }
+  this->A[0] = 2.0*c + p;
+  this->A[1] = -(rho*rho + 2.0*c*p);
+  this->A[2] = rho*rho*p;
+  this->B = 1.0 - this->A[0] - this->A[1] - this->A[2];
+
+  // Past the end of the row the input is constant, so the difference
+  // between the forward pass and that constant decays on its own, and the
+  // backward pass of that difference gives the initial values.  Follow it
+  // for each of the last three values of the forward pass.
+  std::vector<double> d;
+  for (int j = 0; j < 3; ++j)
+    {
+    d.assign(3, 0.0);
+    d[2 - j] = 1.0;
+    size_t n = 3;
+    do
+      {
+      d.push_back(this->A[0]*d[n-1] + this->A[1]*d[n-2] +
+                  this->A[2]*d[n-3]);
+      ++n;
+      }
+    while (fabs(d[n-1]) + fabs(d[n-2]) + fabs(d[n-3]) > 1e-16);
+
+    double e[3] = { 0.0, 0.0, 0.0 };
+    for (size_t k = n - 1; k >= 3; --k)
+      {
+      double v = this->B*d[k] + this->A[0]*e[0] + this->A[1]*e[1] +
+        this->A[2]*e[2];
+      e[2] = e[1];
+      e[1] = e[0];
+      e[0] = v;
+      }
+    this->M[j] = e[0];
+    this->M[3 + j] = e[1];
+    this->M[6 + j] = e[2];
+    }
+}
+
+//----------------------------------------------------------------------------
+// Filter "count" interleaved rows of "n" values in place.  The buffer must
+// have room for three more values per row before and after the rows.
+static void vtkImageGaussianSmoothRecursiveRows(
+  const vtkImageGaussianSmoothRecursiveFilter& f, double *row, int n,
+  int count)
+{
+  double b = f.B;
+  double a0 = f.A[0];
+  double a1 = f.A[1];
+  double a2 = f.A[2];
+  double *last = row + (n - 1)*count;
+  double *after = row + n*count;
+  int i, j;
+
+  // the forward pass starts from the first value, which extends the row
+  for (j = 0; j < count; ++j)
+    {
+    row[j - count] = row[j - 2*count] = row[j - 3*count] = row[j];
+    after[j + 2*count] = last[j];
+    }
+  double *ptr = row;
+  for (i = 0; i < n; ++i)
+    {
+    for (j = 0; j < count; ++j)
+      {
+      ptr[j] = b*ptr[j] + a0*ptr[j - count] + a1*ptr[j - 2*count] +
+        a2*ptr[j - 3*count];
+      }
+    ptr += count;
+    }
+
+  // the backward pass starts from the values of Triggs and Sdika
+  const double *m = f.M;
+  for (j = 0; j < count; ++j)
+    {
+    double u = after[j + 2*count];
+    double d0 = last[j] - u;
+    double d1 = last[j - count] - u;
+    double d2 = last[j - 2*count] - u;
+    after[j] = u + m[0]*d0 + m[1]*d1 + m[2]*d2;
+    after[j + count] = u + m[3]*d0 + m[4]*d1 + m[5]*d2;
+    after[j + 2*count] = u + m[6]*d0 + m[7]*d1 + m[8]*d2;
+    }
+  ptr = last;
+  for (i = 0; i < n; ++i)
+    {
+    for (j = 0; j < count; ++j)
+      {
+      ptr[j] = b*ptr[j] + a0*ptr[j + count] + a1*ptr[j + 2*count] +
+        a2*ptr[j + 3*count];
+      }
+    ptr -= count;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Filters the rows of one axis in blocks of neighboring rows, which are
+// interleaved in a buffer so that every step of the recursion runs over
+// the whole block and the rows of the slower axes are read in runs.
+template <class T>
+class vtkImageGaussianSmoothRecursiveFunctor
+{
+public:
+  const vtkImageGaussianSmoothRecursiveFilter *Filter;
+  T *InPtr;
+  T *OutPtr;
+  vtkIdType InIncs[3]; // along the axis, then along the two other axes
+  vtkIdType OutIncs[3];
+  int InLength;
+  int OutLength;
+  int Offset; // of the output within the input rows
+  int NumberOfComponents;
+  int Size0; // number of rows along the first of the other axes
+  vtkIdType NumberOfRows;
+  int BlockSize;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    int blockSize = this->BlockSize;
+    std::vector<double> buffer(
+      static_cast<size_t>(this->InLength + 6)*blockSize);
+    std::vector<T *> inRows(blockSize);
+    std::vector<T *> outRows(blockSize);
+    for (vtkIdType block = begin; block < end; ++block)
+      {
+      vtkIdType first = block*blockSize;
+      int count = static_cast<int>(
+        this->NumberOfRows - first < blockSize ?
+        this->NumberOfRows - first : blockSize);
+      int i, j;
+      for (j = 0; j < count; ++j)
+        {
+        vtkIdType r = first + j;
+        vtkIdType c = r % this->NumberOfComponents;
+        r /= this->NumberOfComponents;
+        vtkIdType i0 = r % this->Size0;
+        vtkIdType i1 = r / this->Size0;
+        inRows[j] = this->InPtr + c + i0*this->InIncs[1] +
+          i1*this->InIncs[2];
+        outRows[j] = this->OutPtr + c + i0*this->OutIncs[1] +
+          i1*this->OutIncs[2];
+        }
+
+      double *row = &buffer[3*count];
+      double *ptr = row;
+      vtkIdType inc = this->InIncs[0];
+      for (i = 0; i < this->InLength; ++i)
+        {
+        for (j = 0; j < count; ++j)
+          {
+          ptr[j] = static_cast<double>(inRows[j][i*inc]);
+          }
+        ptr += count;
+        }
+
+      vtkImageGaussianSmoothRecursiveRows(
+        *this->Filter, row, this->InLength, count);
+
+      ptr = row + this->Offset*count;
+      inc = this->OutIncs[0];
+      for (i = 0; i < this->OutLength; ++i)
+        {
+        for (j = 0; j < count; ++j)
+          {
+          outRows[j][i*inc] = static_cast<T>(ptr[j]);
+          }
+        ptr += count;
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageGaussianSmoothRecursiveExecute(
+  const vtkImageGaussianSmoothRecursiveFilter *filter, int axis,
+  vtkImageData *inData, int inExt[6], T *inPtr,
+  vtkImageData *outData, int outExt[6], T *outPtr)
+{
+  vtkImageGaussianSmoothRecursiveFunctor<T> functor;
+  functor.Filter = filter;
+  functor.InPtr = inPtr;
+  functor.OutPtr = outPtr;
+  functor.InLength = inExt[2*axis+1] - inExt[2*axis] + 1;
+  functor.OutLength = outExt[2*axis+1] - outExt[2*axis] + 1;
+  functor.Offset = outExt[2*axis] - inExt[2*axis];
+  functor.NumberOfComponents = outData->GetNumberOfScalarComponents();
+
+  vtkIdType *inIncs = inData->GetIncrements();
+  vtkIdType *outIncs = outData->GetIncrements();
+  int axis0 = (axis == 0 ? 1 : 0);
+  int axis1 = (axis == 2 ? 1 : 2);
+  functor.InIncs[0] = inIncs[axis];
+  functor.InIncs[1] = inIncs[axis0];
+  functor.InIncs[2] = inIncs[axis1];
+  functor.OutIncs[0] = outIncs[axis];
+  functor.OutIncs[1] = outIncs[axis0];
+  functor.OutIncs[2] = outIncs[axis1];
+  functor.Size0 = outExt[2*axis0+1] - outExt[2*axis0] + 1;
+  functor.NumberOfRows = static_cast<vtkIdType>(functor.Size0)*
+    (outExt[2*axis1+1] - outExt[2*axis1] + 1)*functor.NumberOfComponents;
+
+  // keep the buffer of a block around 256 kB
+  int blockSize = 32768/(functor.InLength + 6);
+  functor.BlockSize = (blockSize < 1 ? 1 : (blockSize > 16 ? 16 : blockSize));
+
+  vtkIdType numBlocks =
+    (functor.NumberOfRows + functor.BlockSize - 1)/functor.BlockSize;
+  vtkSMPTools::For(0, numBlocks, functor);
+}
+
+//----------------------------------------------------------------------------
+// This method filters one axis recursively, with the rows distributed
+// over the threads.  The input rows cover the whole extent of the axis.
+void vtkImageGaussianSmooth::ExecuteAxisRecursive(int axis,
+                                                  vtkImageData *inData,
+                                                  int inExt[6],
+                                                  vtkImageData *outData,
+                                                  int outExt[6])
+{
+  vtkImageGaussianSmoothRecursiveFilter filter(
+    this->StandardDeviations[axis]);
+
+  int coords[3];
+  coords[0] = outExt[0];
+  coords[1] = outExt[2];
+  coords[2] = outExt[4];
+  coords[axis] = inExt[2*axis];
+  void *inPtr = inData->GetScalarPointer(coords);
+  void *outPtr = outData->GetScalarPointerForExtent(outExt);
+
+  switch (inData->GetScalarType())
+    {
+    vtkTemplateMacro(
+      vtkImageGaussianSmoothRecursiveExecute(&filter, axis,
+                                             inData, inExt,
+                                             static_cast<VTK_TT*>(inPtr),
+                                             outData, outExt,
+                                             static_cast<VTK_TT*>(outPtr))
+      );
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return;
+    }
+}
+
 //----------------------------------------------------------------------------
 // This method convolves over one axis. It loops over the convolved axis,
 // and handles boundary conditions.
@@ -267,6 +595,20 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
   int coords[3];
   vtkIdType *outIncs, outIncA;
 
+  if (this->UseRecursion(axis))
+    {
+    this->ExecuteAxisRecursive(axis, inData, inExt, outData, outExt);
+    if (total)
+      {
+      int *outDims = outData->GetDimensions();
+      *pcount += outDims[0]*outDims[1]*outDims[2]*
+        outData->GetNumberOfScalarComponents();
+      this->UpdateProgress(static_cast<double>(*pcount) /
+                           static_cast<double>(total));
+      }
+    return;
+    }
+
   // Get the correct starting pointer of the output
   outPtr = outData->GetScalarPointerForExtent(outExt);
   outIncs = outData->GetIncrements();
@@ -461,3 +803,32 @@ void vtkImageGaussianSmooth::ThreadedRequestData(
       break;
     }
 }
+
+//----------------------------------------------------------------------------
+// The recursive method distributes the rows of each axis over the threads
+// instead of splitting the extent, since each piece would need the whole
+// rows of the input.
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  if (this->Method != VTK_GAUSSIAN_SMOOTH_RECURSIVE)
+    {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkImageData *inData = vtkImageData::GetData(inputVector[0]);
+  vtkImageData *outData = vtkImageData::GetData(outputVector);
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outInfo, outExt);
+  this->CopyAttributeData(inData, outData, inputVector);
+
+  vtkImageData **inDataArray = &inData;
+  this->ThreadedRequestData(request, inputVector, outputVector,
+                            &inDataArray, &outData, outExt, 0);
+
+  return 1;
+}
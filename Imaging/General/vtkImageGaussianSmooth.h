@@ -16,6 +16,19 @@
 // .SECTION Description
 // vtkImageGaussianSmooth implements a convolution of the input image
 // with a gaussian. Supports from one to three dimensional convolutions.
+//
+// By default the convolution is done directly with a kernel that is
+// truncated by the RadiusFactors, so its cost grows with the standard
+// deviation.  The recursive method instead uses the third order filter
+// of van Vliet, Young and Verbeek, whose cost per pixel does not depend
+// on the standard deviation, with the boundary conditions of Triggs and
+// Sdika:
+// [1] L.J. van Vliet, I.T. Young, P.W. Verbeek, "Recursive Gaussian
+//     derivative filters," Proceedings of the 14th International
+//     Conference on Pattern Recognition, 1:509-514, 1998.
+// [2] B. Triggs, M. Sdika, "Boundary conditions for Young-van Vliet
+//     recursive filtering," IEEE Transactions on Signal Processing
+//     54(6):2365-2367, 2006.
 
 #ifndef __vtkImageGaussianSmooth_h
 #define __vtkImageGaussianSmooth_h
@@ -24,6 +37,9 @@
 #include "vtkImagingGeneralModule.h" // For export macro
 #include "vtkThreadedImageAlgorithm.h"
 
+#define VTK_GAUSSIAN_SMOOTH_DIRECT 0
+#define VTK_GAUSSIAN_SMOOTH_RECURSIVE 1
+
 class VTKIMAGINGGENERAL_EXPORT vtkImageGaussianSmooth : public vtkThreadedImageAlgorithm
 {
 public:
@@ -70,6 +86,26 @@ public:
   vtkSetMacro(Dimensionality, int);
   vtkGetMacro(Dimensionality, int);
 
+  // Description:
+  // Set/Get the method used for the convolution.  The direct method,
+  // which is the default, convolves with the truncated kernel.  The
+  // recursive method approximates a gaussian whose cost does not depend
+  // on the standard deviation, and which is not truncated, so it needs
+  // the whole extent of the input along the smoothed axes and ignores
+  // the RadiusFactors.  At the boundaries the image is extended with its
+  // edge values, where the direct method renormalizes the truncated
+  // kernel.  The rows are distributed over threads with vtkSMPTools.
+  // Axes with a standard deviation below one pixel, where the
+  // approximation is poor, are convolved directly.
+  vtkSetClampMacro(Method, int, VTK_GAUSSIAN_SMOOTH_DIRECT,
+                   VTK_GAUSSIAN_SMOOTH_RECURSIVE);
+  void SetMethodToDirect() {
+    this->SetMethod(VTK_GAUSSIAN_SMOOTH_DIRECT); };
+  void SetMethodToRecursive() {
+    this->SetMethod(VTK_GAUSSIAN_SMOOTH_RECURSIVE); };
+  vtkGetMacro(Method, int);
+  const char *GetMethodAsString();
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth();
@@ -77,14 +113,20 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  int Method;
 
   void ComputeKernel(double *kernel, int min, int max, double std);
   virtual int RequestUpdateExtent (vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
   void InternalRequestUpdateExtent(int *, int*);
+  int UseRecursion(int axis);
   void ExecuteAxis(int axis, vtkImageData *inData, int inExt[6],
                    vtkImageData *outData, int outExt[6],
                    int *pcycle, int target, int *pcount, int total,
                    vtkInformation *inInfo);
+  void ExecuteAxisRecursive(int axis, vtkImageData *inData, int inExt[6],
+                            vtkImageData *outData, int outExt[6]);
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
                            vtkInformationVector *outputVector,
@@ -15,9 +15,12 @@
 #include "vtkImageGradient.h"
 
 #include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -33,6 +36,9 @@ vtkImageGradient::vtkImageGradient()
 {
   this->HandleBoundaries = 1;
   this->Dimensionality = 2;
+  this->DerivativeOrder = 1;
+  this->StandardDeviation = 0.0;
+  this->SmoothedInput = 0;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -45,6 +51,8 @@ void vtkImageGradient::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "HandleBoundaries: " << this->HandleBoundaries << "\n";
   os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "DerivativeOrder: " << this->DerivativeOrder << "\n";
+  os << indent << "StandardDeviation: " << this->StandardDeviation << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -106,6 +114,13 @@ int vtkImageGradient::RequestUpdateExtent(vtkInformation*,
     inUExt[idx*2] -= 1;
     inUExt[idx*2+1] += 1;
 
+    // The gaussian is not truncated, so it needs the whole extent.
+    if (this->StandardDeviation > 0.0)
+      {
+      inUExt[idx*2] = wholeExtent[idx*2];
+      inUExt[idx*2 + 1] = wholeExtent[idx*2 + 1];
+      }
+
     // If handling boundaries instead of shrinking the image then we
     // must clip the needed extent within the whole extent of the
     // input.
@@ -128,6 +143,23 @@ int vtkImageGradient::RequestUpdateExtent(vtkInformation*,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// The central difference of the given order, with the offsets of the
+// previous and next pixels.
+template <class T>
+inline double vtkImageGradientDifference(const T *inPtr, int useMin,
+                                         int useMax, int order)
+{
+  if (order == 2)
+    {
+    return (static_cast<double>(inPtr[useMin]) +
+            static_cast<double>(inPtr[useMax]) -
+            2.0*static_cast<double>(*inPtr));
+    }
+  return (static_cast<double>(inPtr[useMin]) -
+          static_cast<double>(inPtr[useMax]));
+}
+
 //----------------------------------------------------------------------------
 // This execute method handles boundaries.
 // it handles boundaries. Pixels are just replicated to get values
@@ -144,7 +176,7 @@ void vtkImageGradientExecute(vtkImageGradient *self,
   vtkIdType outIncX, outIncY, outIncZ;
   unsigned long count = 0;
   unsigned long target;
-  int axesNum;
+  int axesNum, order;
   int *inExt = inData->GetExtent();
   int *wholeExtent;
   vtkIdType *inIncs;
@@ -160,6 +192,7 @@ void vtkImageGradientExecute(vtkImageGradient *self,
 
   // Get the dimensionality of the gradient.
   axesNum = self->GetDimensionality();
+  order = self->GetDerivativeOrder();
 
   // Get increments to march through data
   inData->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
@@ -172,6 +205,13 @@ void vtkImageGradientExecute(vtkImageGradient *self,
   r[0] = -0.5 / r[0];
   r[1] = -0.5 / r[1];
   r[2] = -0.5 / r[2];
+  if (order == 2)
+    {
+    // second differences (min + max - 2*center) / spacing^2
+    r[0] = 4.0 * r[0] * r[0];
+    r[1] = 4.0 * r[1] * r[1];
+    r[2] = 4.0 * r[2] * r[2];
+    }
 
   // get some other info we need
   inIncs = inData->GetIncrements();
@@ -205,23 +245,20 @@ void vtkImageGradientExecute(vtkImageGradient *self,
         useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
 
         // do X axis
-        d = static_cast<double>(inPtr[useXMin]);
-        d -= static_cast<double>(inPtr[useXMax]);
+        d = vtkImageGradientDifference(inPtr, useXMin, useXMax, order);
         d *= r[0]; // multiply by the data spacing
         *outPtr = d;
         outPtr++;
 
         // do y axis
-        d = static_cast<double>(inPtr[useYMin]);
-        d -= static_cast<double>(inPtr[useYMax]);
+        d = vtkImageGradientDifference(inPtr, useYMin, useYMax, order);
         d *= r[1]; // multiply by the data spacing
         *outPtr = d;
         outPtr++;
         if (axesNum == 3)
           {
           // do z axis
-          d = static_cast<double>(inPtr[useZMin]);
-          d -= static_cast<double>(inPtr[useZMax]);
+          d = vtkImageGradientDifference(inPtr, useZMin, useZMax, order);
           d *= r[2]; // multiply by the data spacing
           *outPtr = d;
           outPtr++;
@@ -241,7 +278,38 @@ int vtkImageGradient::RequestData(
   vtkInformationVector** inputVector,
   vtkInformationVector* outputVector)
 {
-  if (!this->Superclass::RequestData(request, inputVector, outputVector))
+  // The derivatives of a gaussian are the differences of the input once
+  // it is smoothed by that gaussian.
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  vtkDataArray* inputArray = this->GetInputArrayToProcess(0, inputVector);
+  if (this->StandardDeviation > 0.0 && inputArray &&
+      inputArray->GetNumberOfComponents() == 1)
+    {
+    vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+    vtkNew<vtkImageData> values;
+    values->SetExtent(input->GetExtent());
+    values->SetOrigin(input->GetOrigin());
+    values->SetSpacing(input->GetSpacing());
+    vtkNew<vtkDoubleArray> scalars;
+    scalars->DeepCopy(inputArray);
+    values->GetPointData()->SetScalars(scalars.GetPointer());
+
+    smooth->SetInputData(values.GetPointer());
+    smooth->SetMethodToRecursive();
+    smooth->SetDimensionality(this->Dimensionality);
+    smooth->SetStandardDeviations(
+      this->StandardDeviation, this->StandardDeviation,
+      this->Dimensionality == 3 ? this->StandardDeviation : 0.0);
+    smooth->SetNumberOfThreads(this->NumberOfThreads);
+    smooth->SetEnableSMP(this->EnableSMP);
+    smooth->Update();
+    this->SmoothedInput = smooth->GetOutput();
+    }
+
+  int success = this->Superclass::RequestData(request, inputVector,
+                                              outputVector);
+  this->SmoothedInput = 0;
+  if (!success)
     {
     return 0;
     }
@@ -304,6 +372,13 @@ void vtkImageGradient::ThreadedRequestData(vtkInformation*,
     return;
     }
 
+  // Differentiate the smoothed input instead, which is double.
+  if (this->SmoothedInput)
+    {
+    input = this->SmoothedInput;
+    inputArray = input->GetPointData()->GetScalars();
+    }
+
   void* inPtr = inputArray->GetVoidPointer(0);
   double* outPtr = static_cast<double *>(
     output->GetScalarPointerForExtent(outExt));
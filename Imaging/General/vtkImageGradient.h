@@ -19,6 +19,17 @@
 // determines whether to perform a 2d or 3d gradient. The default is
 // two dimensional XY gradient.  OutputScalarType is always
 // double. Gradient is computed using central differences.
+//
+// The DerivativeOrder selects the first derivatives, which make the
+// gradient, or the second derivatives along each axis.  With a
+// StandardDeviation, the input is first smoothed by a gaussian, which
+// vtkImageGaussianSmooth computes recursively in a time that does not
+// depend on the standard deviation.  The derivatives are then the
+// central differences of the smoothed input.  They are not recursive
+// derivative of gaussian filters, so they add the error of central
+// differences to the smoothing.  Only single component input is
+// smoothed, the filter rejects input with more components with an error
+// whether or not a StandardDeviation is set.
 
 #ifndef __vtkImageGradient_h
 #define __vtkImageGradient_h
@@ -47,12 +58,31 @@ public:
   vtkGetMacro(HandleBoundaries, int);
   vtkBooleanMacro(HandleBoundaries, int);
 
+  // Description:
+  // Set/Get the order of the derivatives, 1 for the gradient or 2 for
+  // the second derivative along each axis.  The default is 1.
+  vtkSetClampMacro(DerivativeOrder,int,1,2);
+  vtkGetMacro(DerivativeOrder,int);
+
+  // Description:
+  // Set/Get the standard deviation, in pixels, of a gaussian that
+  // smoothes the input before it is differentiated.  The smoothing
+  // needs the whole extent of the input along the differentiated axes.
+  // The default is 0, for no smoothing.
+  vtkSetClampMacro(StandardDeviation,double,0.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(StandardDeviation,double);
+
 protected:
   vtkImageGradient();
   ~vtkImageGradient() {}
 
   int HandleBoundaries;
   int Dimensionality;
+  int DerivativeOrder;
+  double StandardDeviation;
+
+  // The smoothed input, while the derivatives of a gaussian are computed.
+  vtkImageData *SmoothedInput;
 
   virtual int RequestInformation (vtkInformation*,
                                   vtkInformationVector**,
@@ -22,6 +22,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMedian3D);
 
@@ -83,101 +87,186 @@ void vtkImageMedian3D::SetKernelSize(int size0, int size1, int size2)
 namespace {
 
 //-----------------------------------------------------------------------------
-// Add a sample to the median computation
-double *vtkImageMedian3DAccumulateMedian(int &UpNum, int &DownNum,
-                                         int &UpMax, int &DownMax,
-                                         int &NumNeighborhood,
-                                         double *Median, double val)
+// Sort two values
+template <class T>
+inline void vtkImageMedian3DSort(T &a, T &b)
 {
-  int idx, max;
-  double temp, *ptr;
-
-  // special case: no samples yet
-  if (UpNum == 0)
+  if (b < a)
     {
-    *(Median) = val;
-    // length of up and down arrays inclusive of current
-    UpNum = DownNum = 1;
-    // median is guaranteed to be in this range (length of array)
-    DownMax = UpMax = (NumNeighborhood + 1) / 2;
-    return Median;
+    T tmp = a;
+    a = b;
+    b = tmp;
     }
+}
 
-  // Case: value is above median
-  if (val >= *(Median))
+//-----------------------------------------------------------------------------
+// Select the value of rank n/2, with the selection networks of
+// N. Devillard, "Fast median search: an ANSI C implementation", 1998,
+// for 3, 5, 7, 9 or 25 values.  The values are reordered.
+template <class T>
+T vtkImageMedian3DSelect(T *p, int n)
+{
+#define vtkMedianSort(a, b) vtkImageMedian3DSort(p[a], p[b])
+  switch (n)
     {
-    // move the median if necessary
-    if (UpNum > DownNum)
-      {
-      // Move the median Up one
-      ++Median;
-      --UpNum;
-      ++DownNum;
-      --UpMax;
-      ++DownMax;
-      }
-    // find the position for val in the sorted array
-    max = (UpNum < UpMax) ? UpNum : UpMax;
-    ptr = Median;
-    idx = 0;
-    while (idx < max && val >= *ptr)
+    case 3:
+      vtkMedianSort(0,1); vtkMedianSort(1,2); vtkMedianSort(0,1);
+      return p[1];
+    case 5:
+      vtkMedianSort(0,1); vtkMedianSort(3,4); vtkMedianSort(0,3);
+      vtkMedianSort(1,4); vtkMedianSort(1,2); vtkMedianSort(2,3);
+      vtkMedianSort(1,2);
+      return p[2];
+    case 7:
+      vtkMedianSort(0,5); vtkMedianSort(0,3); vtkMedianSort(1,6);
+      vtkMedianSort(2,4); vtkMedianSort(0,1); vtkMedianSort(3,5);
+      vtkMedianSort(2,6); vtkMedianSort(2,3); vtkMedianSort(3,6);
+      vtkMedianSort(4,5); vtkMedianSort(1,4); vtkMedianSort(1,3);
+      vtkMedianSort(3,4);
+      return p[3];
+    case 9:
+      vtkMedianSort(1,2); vtkMedianSort(4,5); vtkMedianSort(7,8);
+      vtkMedianSort(0,1); vtkMedianSort(3,4); vtkMedianSort(6,7);
+      vtkMedianSort(1,2); vtkMedianSort(4,5); vtkMedianSort(7,8);
+      vtkMedianSort(0,3); vtkMedianSort(5,8); vtkMedianSort(4,7);
+      vtkMedianSort(3,6); vtkMedianSort(1,4); vtkMedianSort(2,5);
+      vtkMedianSort(4,7); vtkMedianSort(4,2); vtkMedianSort(6,4);
+      vtkMedianSort(4,2);
+      return p[4];
+    case 25:
+      vtkMedianSort(0,1);   vtkMedianSort(3,4);   vtkMedianSort(2,4);
+      vtkMedianSort(2,3);   vtkMedianSort(6,7);   vtkMedianSort(5,7);
+      vtkMedianSort(5,6);   vtkMedianSort(9,10);  vtkMedianSort(8,10);
+      vtkMedianSort(8,9);   vtkMedianSort(12,13); vtkMedianSort(11,13);
+      vtkMedianSort(11,12); vtkMedianSort(15,16); vtkMedianSort(14,16);
+      vtkMedianSort(14,15); vtkMedianSort(18,19); vtkMedianSort(17,19);
+      vtkMedianSort(17,18); vtkMedianSort(21,22); vtkMedianSort(20,22);
+      vtkMedianSort(20,21); vtkMedianSort(23,24); vtkMedianSort(2,5);
+      vtkMedianSort(3,6);   vtkMedianSort(0,6);   vtkMedianSort(0,3);
+      vtkMedianSort(4,7);   vtkMedianSort(1,7);   vtkMedianSort(1,4);
+      vtkMedianSort(11,14); vtkMedianSort(8,14);  vtkMedianSort(8,11);
+      vtkMedianSort(12,15); vtkMedianSort(9,15);  vtkMedianSort(9,12);
+      vtkMedianSort(13,16); vtkMedianSort(10,16); vtkMedianSort(10,13);
+      vtkMedianSort(20,23); vtkMedianSort(17,23); vtkMedianSort(17,20);
+      vtkMedianSort(21,24); vtkMedianSort(18,24); vtkMedianSort(18,21);
+      vtkMedianSort(19,22); vtkMedianSort(8,17);  vtkMedianSort(9,18);
+      vtkMedianSort(0,18);  vtkMedianSort(0,9);   vtkMedianSort(10,19);
+      vtkMedianSort(1,19);  vtkMedianSort(1,10);  vtkMedianSort(11,20);
+      vtkMedianSort(2,20);  vtkMedianSort(2,11);  vtkMedianSort(12,21);
+      vtkMedianSort(3,21);  vtkMedianSort(3,12);  vtkMedianSort(13,22);
+      vtkMedianSort(4,22);  vtkMedianSort(4,13);  vtkMedianSort(14,23);
+      vtkMedianSort(5,23);  vtkMedianSort(5,14);  vtkMedianSort(15,24);
+      vtkMedianSort(6,24);  vtkMedianSort(6,15);  vtkMedianSort(7,16);
+      vtkMedianSort(7,19);  vtkMedianSort(13,21); vtkMedianSort(15,23);
+      vtkMedianSort(7,13);  vtkMedianSort(7,15);  vtkMedianSort(1,9);
+      vtkMedianSort(3,11);  vtkMedianSort(5,17);  vtkMedianSort(11,17);
+      vtkMedianSort(9,17);  vtkMedianSort(4,10);  vtkMedianSort(6,12);
+      vtkMedianSort(7,14);  vtkMedianSort(4,6);   vtkMedianSort(4,7);
+      vtkMedianSort(12,14); vtkMedianSort(10,14); vtkMedianSort(6,7);
+      vtkMedianSort(10,12); vtkMedianSort(6,10);  vtkMedianSort(6,17);
+      vtkMedianSort(12,17); vtkMedianSort(7,17);  vtkMedianSort(7,10);
+      vtkMedianSort(12,18); vtkMedianSort(7,12);  vtkMedianSort(10,18);
+      vtkMedianSort(12,20); vtkMedianSort(10,20); vtkMedianSort(10,12);
+      return p[12];
+    }
+#undef vtkMedianSort
+  std::nth_element(p, p + n/2, p + n);
+  return p[n/2];
+}
+
+//-----------------------------------------------------------------------------
+// A histogram of the neighborhood for 8 and 16 bit data.  The neighborhood
+// slides along the rows, and the bin of the median is moved from the one
+// of the previous voxel, skipping whole blocks of 16 bins on the way.
+class vtkImageMedian3DHistogram
+{
+public:
+  vtkImageMedian3DHistogram() : Median(0), Below(0) {}
+
+  void Allocate(int numBins)
+  {
+    this->Bins.assign(numBins, 0);
+    this->Blocks.assign((numBins + 15)/16, 0);
+  }
+
+  void Add(int bin)
+  {
+    ++this->Bins[bin];
+    ++this->Blocks[bin >> 4];
+    this->Below += (bin < this->Median);
+  }
+
+  void Remove(int bin)
+  {
+    --this->Bins[bin];
+    --this->Blocks[bin >> 4];
+    this->Below -= (bin < this->Median);
+  }
+
+  // Return the bin of the value of the given rank, from 0.
+  int Select(int rank)
+  {
+    while (this->Below + this->Bins[this->Median] <= rank)
       {
-      ++ptr;
-      ++idx;
+      this->Below += this->Bins[this->Median++];
+      while ((this->Median & 0xf) == 0 &&
+             this->Below + this->Blocks[this->Median >> 4] <= rank)
+        {
+        this->Below += this->Blocks[this->Median >> 4];
+        this->Median += 16;
+        }
       }
-    // place val and move all others up
-    while (idx < max)
+    while (this->Below > rank)
       {
-      temp = *ptr;
-      *ptr = val;
-      val = temp;
-      ++ptr;
-      ++idx;
+      while ((this->Median & 0xf) == 0 &&
+             this->Below - this->Blocks[(this->Median >> 4) - 1] > rank)
+        {
+        this->Median -= 16;
+        this->Below -= this->Blocks[this->Median >> 4];
+        }
+      this->Below -= this->Bins[--this->Median];
       }
-    *ptr = val;
-    // Update counts
-    ++UpNum;
-    --DownMax;
-    return Median;
-    }
+    return this->Median;
+  }
 
-  // Case: value is below median
-  // If we got here, val < *(Median)
+private:
+  std::vector<int> Bins;
+  std::vector<int> Blocks;
+  // the median bin and the number of values below it
+  int Median;
+  int Below;
+};
 
-  // move the median if necessary
-  if (DownNum > UpNum)
-    {
-    // Move the median Down one
-    --Median;
-    --DownNum;
-    ++UpNum;
-    --DownMax;
-    ++UpMax;
-    }
-  // find the position for val in the sorted array
-  max = (DownNum < DownMax) ? DownNum : DownMax;
-  ptr = Median;
-  idx = 0;
-  while (idx < max && val <= *ptr)
-    {
-    --ptr;
-    ++idx;
-    }
-  // place val and move all others up
-  while (idx < max)
+//-----------------------------------------------------------------------------
+// Add or remove the values of a column of the neighborhood along x to the
+// histograms of the components.
+template <class T>
+void vtkImageMedian3DColumn(vtkImageMedian3DHistogram *histograms,
+                            const T *ptr, int numComp, int size1, int size2,
+                            vtkIdType inInc1, vtkIdType inInc2, int minValue,
+                            bool add)
+{
+  for (int idx2 = 0; idx2 < size2; ++idx2)
     {
-    temp = *ptr;
-    *ptr = val;
-    val = temp;
-    --ptr;
-    ++idx;
+    const T *ptr1 = ptr;
+    for (int idx1 = 0; idx1 < size1; ++idx1)
+      {
+      for (int c = 0; c < numComp; ++c)
+        {
+        int bin = static_cast<int>(ptr1[c]) - minValue;
+        if (add)
+          {
+          histograms[c].Add(bin);
+          }
+        else
+          {
+          histograms[c].Remove(bin);
+          }
+        }
+      ptr1 += inInc1;
+      }
+    ptr += inInc2;
     }
-  *ptr = val;
-  // Update counts
-  ++DownNum;
-  --UpMax;
-
-  return Median;
 }
 
 } // end anonymous namespace
@@ -208,12 +297,6 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
   // The portion of the out image that needs no boundary processing.
   int middleMin0, middleMax0, middleMin1, middleMax1, middleMin2, middleMax2;
   int numComp;
-  // variables for the median calc
-  int UpNum = 0;
-  int DownNum = 0;
-  int UpMax = 0;
-  int DownMax = 0;
-  double *Median;
   int *inExt;
   unsigned long count = 0;
   unsigned long target;
@@ -223,8 +306,6 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
     return;
     }
 
-  double *Sort = new double[(self->GetNumberOfElements() + 8)];
-
   // Get information to march through data
   inData->GetIncrements(inInc0, inInc1, inInc2);
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
@@ -267,6 +348,23 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
 
   NumberOfElements = self->GetNumberOfElements();
 
+  // Large neighborhoods of 8 and 16 bit data use histograms, the others
+  // are gathered for a selection network or a partial sort.
+  bool useHistogram = (sizeof(T) <= 2 && NumberOfElements > 9 &&
+                       NumberOfElements != 25);
+  std::vector<T> samples(useHistogram ? 0 : NumberOfElements);
+  std::vector<vtkImageMedian3DHistogram> histograms(useHistogram ? numComp : 0);
+  int minValue = 0;
+  if (useHistogram)
+    {
+    minValue = static_cast<int>(vtkTypeTraits<T>::Min());
+    int numBins = static_cast<int>(vtkTypeTraits<T>::Max()) - minValue + 1;
+    for (outIdxC = 0; outIdxC < numComp; outIdxC++)
+      {
+      histograms[outIdxC].Allocate(numBins);
+      }
+    }
+
   // loop through pixel of output
   inPtr = static_cast<T *>(
     inArray->GetVoidPointer((hoodMin0 - inExt[0])* inInc0 +
@@ -292,42 +390,68 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
       inPtr0 = inPtr1;
       hoodMin0 = hoodStartMin0;
       hoodMax0 = hoodStartMax0;
+      int hoodSize1 = hoodMax1 - hoodMin1 + 1;
+      int hoodSize2 = hoodMax2 - hoodMin2 + 1;
+      // The columns of the neighborhood that are in the histograms
+      int histMin0 = hoodMin0;
+      int histMax0 = hoodMin0 - 1;
       for (outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
         {
-        for (outIdxC = 0; outIdxC < numComp; outIdxC++)
+        // The median is the value of rank n/2 in the neighborhood, which
+        // is smaller where it is clipped by the image boundaries
+        int numSamples = (hoodMax0 - hoodMin0 + 1)*hoodSize1*hoodSize2;
+        if (useHistogram)
           {
-          // Compute median of neighborhood
-          // Note: For boundary, NumNeighborhood could be changed for
-          // a faster sort.
-          DownNum = UpNum = 0;
-          Median = Sort + (NumberOfElements / 2) + 4;
-          // loop through neighborhood pixels
-          tmpPtr2 = inPtr0 + outIdxC;
-          for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+          // slide the histograms along the row
+          for (; histMin0 < hoodMin0; ++histMin0)
             {
-            tmpPtr1 = tmpPtr2;
-            for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+            vtkImageMedian3DColumn(&histograms[0],
+                                   inPtr1 + (histMin0 - hoodStartMin0)*inInc0,
+                                   numComp, hoodSize1, hoodSize2,
+                                   inInc1, inInc2, minValue, false);
+            }
+          while (histMax0 < hoodMax0)
+            {
+            ++histMax0;
+            vtkImageMedian3DColumn(&histograms[0],
+                                   inPtr1 + (histMax0 - hoodStartMin0)*inInc0,
+                                   numComp, hoodSize1, hoodSize2,
+                                   inInc1, inInc2, minValue, true);
+            }
+          for (outIdxC = 0; outIdxC < numComp; outIdxC++)
+            {
+            *outPtr = static_cast<T>(
+              histograms[outIdxC].Select(numSamples / 2) + minValue);
+            outPtr++;
+            }
+          }
+        else
+          {
+          for (outIdxC = 0; outIdxC < numComp; outIdxC++)
+            {
+            // gather the neighborhood
+            T *samplePtr = &samples[0];
+            tmpPtr2 = inPtr0 + outIdxC;
+            for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
               {
-              tmpPtr0 = tmpPtr1;
-              for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
+              tmpPtr1 = tmpPtr2;
+              for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
                 {
-                // Add this pixel to the median
-                Median = vtkImageMedian3DAccumulateMedian(UpNum, DownNum,
-                                                          UpMax, DownMax,
-                                                          NumberOfElements,
-                                                          Median,
-                                                          double(*tmpPtr0));
-
-                tmpPtr0 += inInc0;
+                tmpPtr0 = tmpPtr1;
+                for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
+                  {
+                  *samplePtr++ = *tmpPtr0;
+                  tmpPtr0 += inInc0;
+                  }
+                tmpPtr1 += inInc1;
                 }
-              tmpPtr1 += inInc1;
+              tmpPtr2 += inInc2;
               }
-            tmpPtr2 += inInc2;
-            }
 
-          // Replace this pixel with the hood median
-          *outPtr = static_cast<T>(*Median);
-          outPtr++;
+            // Replace this pixel with the hood median
+            *outPtr = vtkImageMedian3DSelect(&samples[0], numSamples);
+            outPtr++;
+            }
           }
 
         // shift neighborhood considering boundaries
@@ -341,6 +465,14 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
           ++hoodMax0;
           }
         }
+      // empty the histograms at the end of the row
+      for (; histMin0 <= histMax0; ++histMin0)
+        {
+        vtkImageMedian3DColumn(&histograms[0],
+                               inPtr1 + (histMin0 - hoodStartMin0)*inInc0,
+                               numComp, hoodSize1, hoodSize2,
+                               inInc1, inInc2, minValue, false);
+        }
       // shift neighborhood considering boundaries
       if (outIdx1 >= middleMin1)
         {
@@ -365,8 +497,6 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
       }
     outPtr += outIncZ;
     }
-
-  delete [] Sort;
 }
 
 //-----------------------------------------------------------------------------
@@ -19,6 +19,23 @@
 // Neighborhoods can be no more than 3 dimensional.  Setting one
 // axis of the neighborhood kernelSize to 1 changes the filter
 // into a 2D median.
+//
+// When the neighborhood has an even number of elements, which can also
+// happen where it is clipped by the image boundaries, the median is the
+// larger of the two middle values.
+//
+// The median is found with a selection network for neighborhoods of 3, 5,
+// 7, 9 or 25 elements.  The other neighborhoods of less than 9 elements,
+// and those of data wider than 16 bits, are gathered and partially sorted,
+// which costs O(k0*k1*k2) per pixel.  Larger neighborhoods of 8 and 16 bit
+// data use a histogram that slides along the rows: moving to the next
+// pixel removes one k1*k2 column of the neighborhood and adds another, so
+// the cost per pixel is O(k1*k2), that is O(k^2) for a k*k*k kernel, plus
+// the move of the median bin, which skips blocks of 16 bins.  This is not
+// the constant time scheme of Perreault and Hebert, which also keeps a
+// histogram per column so that the columns slide along the other axes;
+// one histogram of 65536 bins per column is too large for 16 bit data.
+// Set EnableSMP to schedule the pieces of the output with vtkSMPTools.
 
 
 #ifndef __vtkImageMedian3D_h
@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageBoxMorphology.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the box kernels of vtkImageContinuousDilate3D,
+// vtkImageContinuousErode3D, vtkImageDilateErode3D and vtkImageOpenClose3D
+// with a brute force computation over the box, for odd and even kernel
+// sizes, several threads and two components, then checks that a line
+// gives the same result as the ellipse of the same size.
+
+#include "vtkDataArray.h"
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkImageOpenClose3D.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+namespace
+{
+const int Dims[3] = { 29, 23, 17 };
+
+vtkImageData* CreateImage(int scalarType, int numComponents, bool binary)
+{
+  vtkImageData* image = vtkImageData::New();
+  image->SetExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+  image->AllocateScalars(scalarType, numComponents);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < numComponents; ++c)
+      {
+      int v = static_cast<int>((i*(37 + 12*c) + 5*c) % 101);
+      if (binary)
+        {
+        // sparse foreground, and a third value that is left alone
+        v = (v < 6 ? 255 : (v < 90 ? 0 : 7));
+        }
+      scalars->SetComponent(i, c, v - (binary ? 0 : 50.5));
+      }
+    }
+  return image;
+}
+
+// The expected value at (x, y, z), with the same rules as the filters.
+double BoxValue(vtkDataArray* scalars, int x, int y, int z, int c,
+                const int size[3], int operation)
+{
+  int idx[3] = { x, y, z };
+  int lo[3], hi[3];
+  for (int j = 0; j < 3; ++j)
+    {
+    lo[j] = idx[j] - size[j]/2;
+    hi[j] = lo[j] + size[j] - 1;
+    lo[j] = (lo[j] < 0 ? 0 : lo[j]);
+    hi[j] = (hi[j] >= Dims[j] ? Dims[j] - 1 : hi[j]);
+    }
+  double center = scalars->GetComponent(x + Dims[0]*(y + Dims[1]*z), c);
+  if (operation == 2 && center != 0.0)
+    {
+    return center;
+    }
+  double result = center;
+  for (int k = lo[2]; k <= hi[2]; ++k)
+    {
+    for (int j = lo[1]; j <= hi[1]; ++j)
+      {
+      for (int i = lo[0]; i <= hi[0]; ++i)
+        {
+        double v = scalars->GetComponent(i + Dims[0]*(j + Dims[1]*k), c);
+        if (operation == 0)
+          {
+          result = (v > result ? v : result);
+          }
+        else if (operation == 1)
+          {
+          result = (v < result ? v : result);
+          }
+        else if (v == 255.0)
+          {
+          result = 255.0;
+          }
+        }
+      }
+    }
+  return result;
+}
+
+bool Compare(vtkImageData* input, vtkImageData* output, const int size[3],
+             int operation)
+{
+  vtkDataArray* in = input->GetPointData()->GetScalars();
+  vtkDataArray* out = output->GetPointData()->GetScalars();
+  for (int z = 0; z < Dims[2]; ++z)
+    {
+    for (int y = 0; y < Dims[1]; ++y)
+      {
+      for (int x = 0; x < Dims[0]; ++x)
+        {
+        for (int c = 0; c < in->GetNumberOfComponents(); ++c)
+          {
+          double expected = BoxValue(in, x, y, z, c, size, operation);
+          double value = out->GetComponent(x + Dims[0]*(y + Dims[1]*z), c);
+          if (value != expected)
+            {
+            cerr << "Error: operation " << operation << " with kernel "
+                 << size[0] << "x" << size[1] << "x" << size[2] << " gives "
+                 << value << " instead of " << expected << " at (" << x
+                 << ", " << y << ", " << z << ")" << endl;
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return true;
+}
+
+bool TestBox(const int size[3])
+{
+  int types[2] = { VTK_SHORT, VTK_FLOAT };
+  for (int t = 0; t < 2; ++t)
+    {
+    vtkImageData* image = CreateImage(types[t], 2, false);
+
+    vtkNew<vtkImageContinuousDilate3D> dilate;
+    dilate->SetInputData(image);
+    dilate->SetKernelSize(size[0], size[1], size[2]);
+    dilate->BoxKernelOn();
+    dilate->SetNumberOfThreads(3);
+    dilate->Update();
+
+    vtkNew<vtkImageContinuousErode3D> erode;
+    erode->SetInputData(image);
+    erode->SetKernelSize(size[0], size[1], size[2]);
+    erode->BoxKernelOn();
+    erode->SetNumberOfThreads(3);
+    erode->Update();
+
+    bool ok = (Compare(image, dilate->GetOutput(), size, 0) &&
+               Compare(image, erode->GetOutput(), size, 1));
+    image->Delete();
+    if (!ok)
+      {
+      return false;
+      }
+    }
+
+  vtkImageData* mask = CreateImage(VTK_UNSIGNED_CHAR, 1, true);
+  vtkNew<vtkImageDilateErode3D> dilateErode;
+  dilateErode->SetInputData(mask);
+  dilateErode->SetKernelSize(size[0], size[1], size[2]);
+  dilateErode->SetDilateValue(255);
+  dilateErode->SetErodeValue(0);
+  dilateErode->BoxKernelOn();
+  dilateErode->SetNumberOfThreads(3);
+  dilateErode->Update();
+  bool ok = Compare(mask, dilateErode->GetOutput(), size, 2);
+  mask->Delete();
+  return ok;
+}
+
+// Closing is the box dilation followed by the box erosion.
+bool TestOpenClose()
+{
+  vtkImageData* mask = CreateImage(VTK_UNSIGNED_CHAR, 1, true);
+  vtkNew<vtkImageOpenClose3D> close;
+  close->SetInputData(mask);
+  close->SetKernelSize(5, 4, 3);
+  close->SetCloseValue(255);
+  close->SetOpenValue(0);
+  close->BoxKernelOn();
+  close->Update();
+
+  vtkNew<vtkImageDilateErode3D> dilate;
+  dilate->SetInputData(mask);
+  dilate->SetKernelSize(5, 4, 3);
+  dilate->SetDilateValue(255);
+  dilate->SetErodeValue(0);
+  dilate->BoxKernelOn();
+  vtkNew<vtkImageDilateErode3D> erode;
+  erode->SetInputConnection(dilate->GetOutputPort());
+  erode->SetKernelSize(5, 4, 3);
+  erode->SetDilateValue(0);
+  erode->SetErodeValue(255);
+  erode->BoxKernelOn();
+  erode->Update();
+  mask->Delete();
+
+  vtkDataArray* a = close->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* b = erode->GetOutput()->GetPointData()->GetScalars();
+  if (!close->GetBoxKernel())
+    {
+    cerr << "Error: BoxKernel is not set on vtkImageOpenClose3D" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    if (a->GetComponent(i, 0) != b->GetComponent(i, 0))
+      {
+      cerr << "Error: vtkImageOpenClose3D differs at " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// A line is both a box and an ellipse.
+bool TestLine(int length)
+{
+  vtkImageData* image = CreateImage(VTK_SHORT, 1, false);
+  vtkNew<vtkImageContinuousDilate3D> box;
+  box->SetInputData(image);
+  box->SetKernelSize(1, length, 1);
+  box->BoxKernelOn();
+  box->Update();
+  vtkNew<vtkImageContinuousDilate3D> ellipse;
+  ellipse->SetInputData(image);
+  ellipse->SetKernelSize(1, length, 1);
+  ellipse->Update();
+  image->Delete();
+
+  vtkDataArray* a = box->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* b = ellipse->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    if (a->GetComponent(i, 0) != b->GetComponent(i, 0))
+      {
+      cerr << "Error: line of length " << length << " differs from the "
+           << "ellipse at " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestImageBoxMorphology(int, char*[])
+{
+  int sizes[][3] = {
+    { 1, 1, 1 }, { 3, 3, 3 }, { 4, 1, 2 }, { 7, 5, 1 }, { 1, 8, 6 },
+    { 31, 2, 15 } };
+  for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+    {
+    if (!TestBox(sizes[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  if (!TestOpenClose() || !TestLine(5) || !TestLine(6))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
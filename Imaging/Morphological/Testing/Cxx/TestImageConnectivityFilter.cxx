@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageConnectivityFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkImageConnectivityFilter with a flood fill from each voxel in
+// raster order, for the three connectivities on a volume that is cut into
+// several slabs, including the labels, the sizes and the extents, then
+// checks the label types, the active component and the region limit.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestErrorObserver.h"
+
+#include <stack>
+#include <vector>
+
+namespace
+{
+const int Dims[3] = { 23, 17, 45 };
+
+vtkImageData* CreateImage(int numComponents, int percent)
+{
+  vtkImageData* image = vtkImageData::New();
+  image->SetExtent(3, Dims[0] + 2, -4, Dims[1] - 5, 1, Dims[2]);
+  image->AllocateScalars(VTK_SHORT, numComponents);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  unsigned int seed = 12345;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < numComponents; ++c)
+      {
+      seed = seed*1103515245u + 12345u;
+      int v = static_cast<int>((seed >> 16) % 100);
+      scalars->SetComponent(i, c, v < percent ? 1 + v % 3 : 0);
+      }
+    }
+  return image;
+}
+
+// Label the voxels in raster order by flood filling each new region.
+int FloodFill(vtkDataArray* scalars, int c, double lower, double upper,
+              int connectivity, std::vector<int>& labels,
+              std::vector<vtkIdType>& sizes, std::vector<int>& extents)
+{
+  vtkIdType n = scalars->GetNumberOfTuples();
+  labels.assign(n, 0);
+  sizes.clear();
+  extents.clear();
+  int count = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    double v = scalars->GetComponent(i, c);
+    if (labels[i] != 0 || v < lower || v > upper)
+      {
+      continue;
+      }
+    labels[i] = ++count;
+    sizes.push_back(0);
+    int e[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN,
+                 VTK_INT_MAX, VTK_INT_MIN };
+    std::stack<vtkIdType> stack;
+    stack.push(i);
+    while (!stack.empty())
+      {
+      vtkIdType j = stack.top();
+      stack.pop();
+      sizes.back()++;
+      int idx[3];
+      idx[0] = static_cast<int>(j % Dims[0]);
+      idx[1] = static_cast<int>((j / Dims[0]) % Dims[1]);
+      idx[2] = static_cast<int>(j / (Dims[0]*Dims[1]));
+      for (int k = 0; k < 3; ++k)
+        {
+        e[2*k] = (idx[k] < e[2*k] ? idx[k] : e[2*k]);
+        e[2*k + 1] = (idx[k] > e[2*k + 1] ? idx[k] : e[2*k + 1]);
+        }
+      for (int dz = -1; dz <= 1; ++dz)
+        {
+        for (int dy = -1; dy <= 1; ++dy)
+          {
+          for (int dx = -1; dx <= 1; ++dx)
+            {
+            int d = (dx != 0) + (dy != 0) + (dz != 0);
+            int x = idx[0] + dx, y = idx[1] + dy, z = idx[2] + dz;
+            if (d == 0 || (d == 2 && connectivity < 18) ||
+                (d == 3 && connectivity < 26) ||
+                x < 0 || x >= Dims[0] || y < 0 || y >= Dims[1] ||
+                z < 0 || z >= Dims[2])
+              {
+              continue;
+              }
+            vtkIdType m = x + Dims[0]*(y + Dims[1]*static_cast<vtkIdType>(z));
+            double w = scalars->GetComponent(m, c);
+            if (labels[m] == 0 && w >= lower && w <= upper)
+              {
+              labels[m] = count;
+              stack.push(m);
+              }
+            }
+          }
+        }
+      }
+    // the extents of the filter are in structured coordinates
+    e[0] += 3;
+    e[1] += 3;
+    e[2] -= 4;
+    e[3] -= 4;
+    e[4] += 1;
+    e[5] += 1;
+    extents.insert(extents.end(), e, e + 6);
+    }
+  return count;
+}
+
+bool Compare(vtkImageConnectivityFilter* filter, vtkDataArray* scalars,
+             int c, double lower, double upper)
+{
+  std::vector<int> labels;
+  std::vector<vtkIdType> sizes;
+  std::vector<int> extents;
+  int count = FloodFill(scalars, c, lower, upper, filter->GetConnectivity(),
+                        labels, sizes, extents);
+
+  vtkDataArray* result = filter->GetOutput()->GetPointData()->GetScalars();
+  if (result->GetDataType() != filter->GetLabelScalarType() ||
+      filter->GetNumberOfRegions() != count || count < 2)
+    {
+    cerr << "Error: " << filter->GetNumberOfRegions() << " regions of type "
+         << result->GetDataTypeAsString() << " instead of " << count
+         << " with connectivity " << filter->GetConnectivity() << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < result->GetNumberOfTuples(); ++i)
+    {
+    if (result->GetComponent(i, 0) != labels[i])
+      {
+      cerr << "Error: label " << result->GetComponent(i, 0) << " instead of "
+           << labels[i] << " at " << i << " with connectivity "
+           << filter->GetConnectivity() << endl;
+      return false;
+      }
+    }
+  for (int i = 0; i < count; ++i)
+    {
+    bool ok = (filter->GetRegionSizes()->GetValue(i) == sizes[i]);
+    for (int j = 0; j < 6; ++j)
+      {
+      ok &= (filter->GetRegionExtents()->GetComponent(i, j) ==
+             extents[6*i + j]);
+      }
+    if (!ok)
+      {
+      cerr << "Error: wrong size or extent for region " << (i + 1)
+           << " with connectivity " << filter->GetConnectivity() << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestImageConnectivityFilter(int, char*[])
+{
+  vtkImageData* image = CreateImage(1, 20);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkNew<vtkImageConnectivityFilter> filter;
+  filter->SetInputData(image);
+  int connectivities[3] = { 6, 18, 26 };
+  for (int i = 0; i < 3; ++i)
+    {
+    filter->SetConnectivity(connectivities[i]);
+    filter->Update();
+    if (!Compare(filter.GetPointer(), scalars, 0, 0.5, VTK_FLOAT_MAX))
+      {
+      image->Delete();
+      return EXIT_FAILURE;
+      }
+    }
+
+  // a range of values with a smaller label type
+  filter->SetConnectivityTo18();
+  filter->ThresholdBetween(1.5, 2.5);
+  filter->SetLabelScalarTypeToUnsignedShort();
+  filter->Update();
+  bool ok = Compare(filter.GetPointer(), scalars, 0, 1.5, 2.5);
+
+  // too many regions for unsigned char
+  vtkNew<vtkTest::ErrorObserver> observer;
+  filter->AddObserver(vtkCommand::ErrorEvent, observer.GetPointer());
+  filter->SetLabelScalarTypeToUnsignedChar();
+  filter->Update();
+  ok &= (observer->GetError() && filter->GetNumberOfRegions() == 0);
+  image->Delete();
+
+  // the second component of a denser image
+  image = CreateImage(2, 60);
+  scalars = image->GetPointData()->GetScalars();
+  filter->SetInputData(image);
+  filter->SetActiveComponent(1);
+  filter->SetConnectivityTo26();
+  filter->ThresholdByUpper(2.5);
+  filter->SetLabelScalarTypeToShort();
+  filter->Update();
+  ok = ok && Compare(filter.GetPointer(), scalars, 1, 2.5, VTK_FLOAT_MAX);
+  image->Delete();
+
+  return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
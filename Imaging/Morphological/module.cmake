@@ -5,4 +5,6 @@ vtk_module(vtkImagingMorphological
   DEPENDS
     vtkImagingCore
     vtkImagingGeneral
+  TEST_DEPENDS
+    vtkTestingCore
   )
@@ -0,0 +1,677 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageConnectivityFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageConnectivityFilter.h"
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemplateAliasMacro.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkImageConnectivityFilter);
+
+//----------------------------------------------------------------------------
+vtkImageConnectivityFilter::vtkImageConnectivityFilter()
+{
+  this->UpperThreshold = VTK_FLOAT_MAX;
+  this->LowerThreshold = 0.5;
+  this->ActiveComponent = 0;
+  this->Connectivity = 6;
+  this->LabelScalarType = VTK_INT;
+
+  this->RegionSizes = vtkIdTypeArray::New();
+  this->RegionExtents = vtkIntArray::New();
+  this->RegionExtents->SetNumberOfComponents(6);
+
+  this->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS,
+    vtkDataSetAttributes::SCALARS);
+}
+
+//----------------------------------------------------------------------------
+vtkImageConnectivityFilter::~vtkImageConnectivityFilter()
+{
+  this->RegionSizes->Delete();
+  this->RegionExtents->Delete();
+}
+
+//----------------------------------------------------------------------------
+// The values greater than or equal to the value match.
+void vtkImageConnectivityFilter::ThresholdByUpper(double thresh)
+{
+  if (this->LowerThreshold != thresh || this->UpperThreshold < VTK_FLOAT_MAX)
+    {
+    this->LowerThreshold = thresh;
+    this->UpperThreshold = VTK_FLOAT_MAX;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+// The values less than or equal to the value match.
+void vtkImageConnectivityFilter::ThresholdByLower(double thresh)
+{
+  if (this->UpperThreshold != thresh ||
+      this->LowerThreshold > -VTK_FLOAT_MAX)
+    {
+    this->UpperThreshold = thresh;
+    this->LowerThreshold = -VTK_FLOAT_MAX;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+// The values in a range (inclusive) match
+void vtkImageConnectivityFilter::ThresholdBetween(double lower, double upper)
+{
+  if (this->LowerThreshold != lower || this->UpperThreshold != upper)
+    {
+    this->LowerThreshold = lower;
+    this->UpperThreshold = upper;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkImageConnectivityFilter::GetNumberOfRegions()
+{
+  return this->RegionSizes->GetNumberOfTuples();
+}
+
+namespace {
+
+//----------------------------------------------------------------------------
+// Find the root of the set of a label, which is its smallest label.
+inline int vtkImageConnectivityFind(int *parent, int label)
+{
+  while (parent[label] != label)
+    {
+    parent[label] = parent[parent[label]];
+    label = parent[label];
+    }
+  return label;
+}
+
+//----------------------------------------------------------------------------
+// Merge the sets of two labels.
+inline void vtkImageConnectivityUnion(int *parent, int a, int b)
+{
+  a = vtkImageConnectivityFind(parent, a);
+  b = vtkImageConnectivityFind(parent, b);
+  if (a < b)
+    {
+    parent[b] = a;
+    }
+  else if (b < a)
+    {
+    parent[a] = b;
+    }
+}
+
+//----------------------------------------------------------------------------
+// The labels of a slab of the image, numbered from 1 in the order of the
+// first voxel of each region in the slab.
+struct vtkImageConnectivitySlab
+{
+  int ZMin;
+  int ZMax;
+  int NumberOfRegions;
+  int Offset;
+  std::vector<vtkIdType> Sizes;
+  std::vector<int> Extents;
+};
+
+//----------------------------------------------------------------------------
+// The label buffer, the neighbors that come before a voxel in the
+// raster order, and the slabs.
+struct vtkImageConnectivityInfo
+{
+  int *Labels;
+  int Dims[3];
+  int NumberOfNeighbors;
+  int Neighbors[13][3];
+  vtkIdType NeighborOffsets[13];
+  std::vector<vtkImageConnectivitySlab> Slabs;
+
+  void SetConnectivity(int connectivity);
+  vtkIdType Index(int x, int y, int z) const
+    {
+    return x + static_cast<vtkIdType>(this->Dims[0])*(
+      y + static_cast<vtkIdType>(this->Dims[1])*z);
+    }
+  bool InPlane(const int *d, int x, int y) const
+    {
+    return (x + d[0] >= 0 && x + d[0] < this->Dims[0] &&
+            y + d[1] >= 0 && y + d[1] < this->Dims[1]);
+    }
+};
+
+//----------------------------------------------------------------------------
+void vtkImageConnectivityInfo::SetConnectivity(int connectivity)
+{
+  this->NumberOfNeighbors = 0;
+  for (int dz = -1; dz <= 0; dz++)
+    {
+    for (int dy = -1; dy <= 1; dy++)
+      {
+      for (int dx = -1; dx <= 1; dx++)
+        {
+        int d = (dx != 0) + (dy != 0) + (dz != 0);
+        bool before = (dz < 0 || (dz == 0 && (dy < 0 || (dy == 0 && dx < 0))));
+        if (before && (d == 1 || (d == 2 && connectivity >= 18) ||
+                       (d == 3 && connectivity >= 26)))
+          {
+          int *n = this->Neighbors[this->NumberOfNeighbors];
+          n[0] = dx;
+          n[1] = dy;
+          n[2] = dz;
+          this->NeighborOffsets[this->NumberOfNeighbors++] =
+            dx + static_cast<vtkIdType>(this->Dims[0])*(
+              dy + static_cast<vtkIdType>(this->Dims[1])*dz);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Label the slabs, each with a union-find of its provisional labels.
+template <class T>
+class vtkImageConnectivityLabelFunctor
+{
+public:
+  vtkImageConnectivityLabelFunctor(
+    vtkImageConnectivityInfo *info, const T *inPtr, const vtkIdType inInc[3],
+    double lower, double upper) :
+    Info(info), InPtr(inPtr), Lower(lower), Upper(upper)
+    {
+    this->InInc[0] = inInc[0];
+    this->InInc[1] = inInc[1];
+    this->InInc[2] = inInc[2];
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType s = begin; s < end; s++)
+      {
+      this->LabelSlab(&this->Info->Slabs[s]);
+      }
+    }
+
+private:
+  void LabelSlab(vtkImageConnectivitySlab *slab) const;
+
+  vtkImageConnectivityInfo *Info;
+  const T *InPtr;
+  vtkIdType InInc[3];
+  double Lower;
+  double Upper;
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageConnectivityLabelFunctor<T>::LabelSlab(
+  vtkImageConnectivitySlab *slab) const
+{
+  const vtkImageConnectivityInfo *info = this->Info;
+  const int nx = info->Dims[0];
+  const int ny = info->Dims[1];
+  const int numNeighbors = info->NumberOfNeighbors;
+
+  // label 0 is the background
+  std::vector<int> parent(1, 0);
+
+  for (int z = slab->ZMin; z <= slab->ZMax; z++)
+    {
+    for (int y = 0; y < ny; y++)
+      {
+      const T *inPtr = this->InPtr + z*this->InInc[2] + y*this->InInc[1];
+      int *labels = info->Labels + info->Index(0, y, z);
+      for (int x = 0; x < nx; x++)
+        {
+        double v = static_cast<double>(*inPtr);
+        inPtr += this->InInc[0];
+        int label = 0;
+        if (this->Lower <= v && v <= this->Upper)
+          {
+          for (int k = 0; k < numNeighbors; k++)
+            {
+            const int *d = info->Neighbors[k];
+            if (info->InPlane(d, x, y) && z + d[2] >= slab->ZMin)
+              {
+              int n = labels[x + info->NeighborOffsets[k]];
+              if (n != 0 && n != label)
+                {
+                if (label == 0)
+                  {
+                  label = n;
+                  }
+                else
+                  {
+                  vtkImageConnectivityUnion(&parent[0], label, n);
+                  }
+                }
+              }
+            }
+          if (label == 0)
+            {
+            label = static_cast<int>(parent.size());
+            parent.push_back(label);
+            }
+          }
+        labels[x] = label;
+        }
+      }
+    }
+
+  // the root of each set is its first label, so numbering the roots in
+  // order keeps the order of the first voxels
+  std::vector<int> local(parent.size(), 0);
+  int count = 0;
+  for (size_t l = 1; l < parent.size(); l++)
+    {
+    int r = vtkImageConnectivityFind(&parent[0], static_cast<int>(l));
+    local[l] = (r == static_cast<int>(l) ? ++count : local[r]);
+    }
+
+  slab->NumberOfRegions = count;
+  slab->Sizes.assign(count, 0);
+  slab->Extents.resize(6*count);
+  for (int i = 0; i < count; i++)
+    {
+    int *extent = &slab->Extents[6*i];
+    extent[0] = extent[2] = extent[4] = VTK_INT_MAX;
+    extent[1] = extent[3] = extent[5] = VTK_INT_MIN;
+    }
+
+  for (int z = slab->ZMin; z <= slab->ZMax; z++)
+    {
+    for (int y = 0; y < ny; y++)
+      {
+      int *labels = info->Labels + info->Index(0, y, z);
+      for (int x = 0; x < nx; x++)
+        {
+        int label = local[labels[x]];
+        labels[x] = label;
+        if (label != 0)
+          {
+          slab->Sizes[label - 1]++;
+          int *extent = &slab->Extents[6*(label - 1)];
+          extent[0] = (x < extent[0] ? x : extent[0]);
+          extent[1] = (x > extent[1] ? x : extent[1]);
+          extent[2] = (y < extent[2] ? y : extent[2]);
+          extent[3] = (y > extent[3] ? y : extent[3]);
+          extent[4] = (z < extent[4] ? z : extent[4]);
+          extent[5] = (z > extent[5] ? z : extent[5]);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageConnectivityLabel(
+  vtkImageConnectivityInfo *info, const T *inPtr, const vtkIdType inInc[3],
+  double lower, double upper)
+{
+  vtkImageConnectivityLabelFunctor<T> functor(
+    info, inPtr, inInc, lower, upper);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(info->Slabs.size()), 1, functor);
+}
+
+//----------------------------------------------------------------------------
+// Merge the regions of the slabs that touch across the slab boundaries,
+// and number the merged regions in the order of their first voxel.  The
+// slab labels are ordered in the same way, so the smallest global label
+// of a region comes from its first voxel.
+int vtkImageConnectivityMerge(
+  vtkImageConnectivityInfo *info, std::vector<int>& finalLabels)
+{
+  int total = 0;
+  for (size_t s = 0; s < info->Slabs.size(); s++)
+    {
+    info->Slabs[s].Offset = total;
+    total += info->Slabs[s].NumberOfRegions;
+    }
+
+  std::vector<int> parent(total + 1);
+  for (int l = 0; l <= total; l++)
+    {
+    parent[l] = l;
+    }
+
+  for (size_t s = 1; s < info->Slabs.size(); s++)
+    {
+    int z = info->Slabs[s].ZMin;
+    int offset = info->Slabs[s].Offset;
+    int prevOffset = info->Slabs[s - 1].Offset;
+    for (int y = 0; y < info->Dims[1]; y++)
+      {
+      const int *labels = info->Labels + info->Index(0, y, z);
+      for (int x = 0; x < info->Dims[0]; x++)
+        {
+        if (labels[x] == 0)
+          {
+          continue;
+          }
+        for (int k = 0; k < info->NumberOfNeighbors; k++)
+          {
+          const int *d = info->Neighbors[k];
+          if (d[2] < 0 && info->InPlane(d, x, y))
+            {
+            int n = labels[x + info->NeighborOffsets[k]];
+            if (n != 0)
+              {
+              vtkImageConnectivityUnion(
+                &parent[0], labels[x] + offset, n + prevOffset);
+              }
+            }
+          }
+        }
+      }
+    }
+
+  finalLabels.assign(total + 1, 0);
+  int count = 0;
+  for (int l = 1; l <= total; l++)
+    {
+    int r = vtkImageConnectivityFind(&parent[0], l);
+    finalLabels[l] = (r == l ? ++count : finalLabels[r]);
+    }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+// Write the final labels to the output, which can be the label buffer.
+template <class OT>
+class vtkImageConnectivityRelabelFunctor
+{
+public:
+  vtkImageConnectivityRelabelFunctor(
+    vtkImageConnectivityInfo *info, const std::vector<int> *finalLabels,
+    OT *outPtr) :
+    Info(info), FinalLabels(finalLabels), OutPtr(outPtr) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    const int *finalLabels = &(*this->FinalLabels)[0];
+    for (vtkIdType s = begin; s < end; s++)
+      {
+      const vtkImageConnectivitySlab& slab = this->Info->Slabs[s];
+      vtkIdType first = this->Info->Index(0, 0, slab.ZMin);
+      vtkIdType last = this->Info->Index(0, 0, slab.ZMax + 1);
+      const int *labels = this->Info->Labels;
+      for (vtkIdType i = first; i < last; i++)
+        {
+        int label = labels[i];
+        this->OutPtr[i] = static_cast<OT>(
+          label == 0 ? 0 : finalLabels[label + slab.Offset]);
+        }
+      }
+    }
+
+private:
+  vtkImageConnectivityInfo *Info;
+  const std::vector<int> *FinalLabels;
+  OT *OutPtr;
+};
+
+//----------------------------------------------------------------------------
+template <class OT>
+void vtkImageConnectivityRelabel(
+  vtkImageConnectivityInfo *info, const std::vector<int>& finalLabels,
+  OT *outPtr)
+{
+  vtkImageConnectivityRelabelFunctor<OT> functor(info, &finalLabels, outPtr);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(info->Slabs.size()), 1, functor);
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageConnectivityFilter::RequestInformation(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **vtkNotUsed(inputVector),
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject::SetPointDataActiveScalarInfo(
+    outInfo, this->LabelScalarType, 1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// The regions can extend anywhere, so the whole input is needed.
+int vtkImageConnectivityFilter::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *vtkNotUsed(outputVector))
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  int extent[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageConnectivityFilter::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkImageData *inData = vtkImageData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkImageData *outData = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  this->RegionSizes->Reset();
+  this->RegionExtents->Reset();
+
+  int maxLabel = 0;
+  switch (this->LabelScalarType)
+    {
+    case VTK_UNSIGNED_CHAR:
+      maxLabel = VTK_UNSIGNED_CHAR_MAX;
+      break;
+    case VTK_SHORT:
+      maxLabel = VTK_SHORT_MAX;
+      break;
+    case VTK_UNSIGNED_SHORT:
+      maxLabel = VTK_UNSIGNED_SHORT_MAX;
+      break;
+    case VTK_INT:
+      maxLabel = VTK_INT_MAX;
+      break;
+    default:
+      vtkErrorMacro("LabelScalarType must be unsigned char, short, "
+                    "unsigned short or int.");
+      return 0;
+    }
+
+  if (this->Connectivity != 6 && this->Connectivity != 18 &&
+      this->Connectivity != 26)
+    {
+    vtkErrorMacro("Connectivity must be 6, 18 or 26, not "
+                  << this->Connectivity << ".");
+    return 0;
+    }
+
+  vtkDataArray *inArray = this->GetInputArrayToProcess(0, inputVector);
+  if (inArray == 0)
+    {
+    vtkErrorMacro("No scalars to label.");
+    return 0;
+    }
+  int numComponents = inArray->GetNumberOfComponents();
+  if (this->ActiveComponent < 0 || this->ActiveComponent >= numComponents)
+    {
+    vtkErrorMacro("ActiveComponent " << this->ActiveComponent
+                  << " is not a component of the scalars.");
+    return 0;
+    }
+
+  int extent[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+  this->AllocateOutputData(outData, outInfo, extent);
+  if (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+    {
+    return 1;
+    }
+
+  vtkImageConnectivityInfo info;
+  info.Dims[0] = extent[1] - extent[0] + 1;
+  info.Dims[1] = extent[3] - extent[2] + 1;
+  info.Dims[2] = extent[5] - extent[4] + 1;
+  info.SetConnectivity(this->Connectivity);
+
+  // label in the output if it is big enough, or in a temporary buffer
+  void *outPtr = outData->GetScalarPointer();
+  std::vector<int> buffer;
+  if (this->LabelScalarType == VTK_INT)
+    {
+    info.Labels = static_cast<int *>(outPtr);
+    }
+  else
+    {
+    buffer.resize(info.Index(0, 0, info.Dims[2]));
+    info.Labels = &buffer[0];
+    }
+
+  // thick slabs keep the merge small compared to the labeling
+  int numSlabs = info.Dims[2]/8;
+  numSlabs = (numSlabs > 32 ? 32 : (numSlabs < 1 ? 1 : numSlabs));
+  info.Slabs.resize(numSlabs);
+  for (int s = 0; s < numSlabs; s++)
+    {
+    info.Slabs[s].ZMin = s*info.Dims[2]/numSlabs;
+    info.Slabs[s].ZMax = (s + 1)*info.Dims[2]/numSlabs - 1;
+    }
+
+  // the input can be larger than the whole extent
+  int inExt[6];
+  inData->GetExtent(inExt);
+  vtkIdType inInc[3];
+  inInc[0] = numComponents;
+  inInc[1] = inInc[0]*(inExt[1] - inExt[0] + 1);
+  inInc[2] = inInc[1]*(inExt[3] - inExt[2] + 1);
+  vtkIdType inOffset = this->ActiveComponent +
+    (extent[0] - inExt[0])*inInc[0] + (extent[2] - inExt[2])*inInc[1] +
+    (extent[4] - inExt[4])*inInc[2];
+  void *inPtr = inArray->GetVoidPointer(0);
+
+  switch (inArray->GetDataType())
+    {
+    vtkTemplateAliasMacro(
+      vtkImageConnectivityLabel(
+        &info, static_cast<VTK_TT *>(inPtr) + inOffset, inInc,
+        this->LowerThreshold, this->UpperThreshold));
+    default:
+      vtkErrorMacro("Execute: Unknown ScalarType");
+      return 0;
+    }
+  this->UpdateProgress(0.5);
+
+  std::vector<int> finalLabels;
+  int numRegions = vtkImageConnectivityMerge(&info, finalLabels);
+  if (numRegions > maxLabel)
+    {
+    vtkErrorMacro("There are " << numRegions << " regions, which is more "
+                  "than the LabelScalarType can hold.");
+    outData->GetPointData()->GetScalars()->FillComponent(0, 0.0);
+    return 0;
+    }
+
+  this->RegionSizes->SetNumberOfTuples(numRegions);
+  this->RegionExtents->SetNumberOfTuples(numRegions);
+  vtkIdType *sizes = this->RegionSizes->GetPointer(0);
+  int *regionExtents = this->RegionExtents->GetPointer(0);
+  for (int i = 0; i < numRegions; i++)
+    {
+    sizes[i] = 0;
+    int *regionExtent = regionExtents + 6*i;
+    regionExtent[0] = regionExtent[2] = regionExtent[4] = VTK_INT_MAX;
+    regionExtent[1] = regionExtent[3] = regionExtent[5] = VTK_INT_MIN;
+    }
+  for (int s = 0; s < numSlabs; s++)
+    {
+    const vtkImageConnectivitySlab& slab = info.Slabs[s];
+    for (int l = 0; l < slab.NumberOfRegions; l++)
+      {
+      int i = finalLabels[l + 1 + slab.Offset] - 1;
+      sizes[i] += slab.Sizes[l];
+      const int *slabExtent = &slab.Extents[6*l];
+      int *regionExtent = regionExtents + 6*i;
+      for (int j = 0; j < 6; j += 2)
+        {
+        int lo = slabExtent[j] + extent[j];
+        int hi = slabExtent[j + 1] + extent[j];
+        regionExtent[j] = (lo < regionExtent[j] ? lo : regionExtent[j]);
+        regionExtent[j + 1] = (hi > regionExtent[j + 1] ?
+                               hi : regionExtent[j + 1]);
+        }
+      }
+    }
+  this->UpdateProgress(0.75);
+
+  switch (this->LabelScalarType)
+    {
+    case VTK_UNSIGNED_CHAR:
+      vtkImageConnectivityRelabel(
+        &info, finalLabels, static_cast<unsigned char *>(outPtr));
+      break;
+    case VTK_SHORT:
+      vtkImageConnectivityRelabel(
+        &info, finalLabels, static_cast<short *>(outPtr));
+      break;
+    case VTK_UNSIGNED_SHORT:
+      vtkImageConnectivityRelabel(
+        &info, finalLabels, static_cast<unsigned short *>(outPtr));
+      break;
+    case VTK_INT:
+      vtkImageConnectivityRelabel(
+        &info, finalLabels, static_cast<int *>(outPtr));
+      break;
+    }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "LowerThreshold: " << this->LowerThreshold << "\n";
+  os << indent << "UpperThreshold: " << this->UpperThreshold << "\n";
+  os << indent << "ActiveComponent: " << this->ActiveComponent << "\n";
+  os << indent << "Connectivity: " << this->Connectivity << "\n";
+  os << indent << "LabelScalarType: " << this->LabelScalarType << "\n";
+  os << indent << "NumberOfRegions: " << this->GetNumberOfRegions() << "\n";
+  os << indent << "RegionSizes: " << this->RegionSizes << "\n";
+  os << indent << "RegionExtents: " << this->RegionExtents << "\n";
+}
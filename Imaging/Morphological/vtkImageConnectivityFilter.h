@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageConnectivityFilter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageConnectivityFilter - Label the connected regions of an image.
+// .SECTION Description
+// vtkImageConnectivityFilter labels all the regions of connected voxels
+// whose value is within the thresholds at once.  Voxels are connected
+// through their faces (6-connectivity), their faces and edges
+// (18-connectivity) or also their corners (26-connectivity).  The output
+// has the label of the region of each voxel, and 0 outside of the
+// regions.  The regions are numbered from 1 in the order in which their
+// first voxel comes in the image, and their size and extent can be
+// retrieved after the filter has executed.
+//
+// The image is cut into slabs along Z, which are labeled in parallel with
+// vtkSMPTools using a union-find of the labels of each slab, and the
+// labels are then merged across the boundaries of the slabs.  The result
+// does not depend on the number of threads.
+// .SECTION see also
+// vtkImageThresholdConnectivity vtkImageSeedConnectivity
+
+#ifndef __vtkImageConnectivityFilter_h
+#define __vtkImageConnectivityFilter_h
+
+#include "vtkImagingMorphologicalModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+
+class vtkIdTypeArray;
+class vtkIntArray;
+
+class VTKIMAGINGMORPHOLOGICAL_EXPORT vtkImageConnectivityFilter :
+  public vtkImageAlgorithm
+{
+public:
+  static vtkImageConnectivityFilter *New();
+  vtkTypeMacro(vtkImageConnectivityFilter, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Values greater than or equal to this threshold are labeled.
+  void ThresholdByUpper(double thresh);
+
+  // Description:
+  // Values less than or equal to this threshold are labeled.
+  void ThresholdByLower(double thresh);
+
+  // Description:
+  // Values within this range are labeled, including the values that are
+  // exactly equal to the lower and upper thresholds.  By default the
+  // values of at least 0.5 are labeled.
+  void ThresholdBetween(double lower, double upper);
+
+  // Description:
+  // Get the Upper and Lower thresholds.
+  vtkGetMacro(UpperThreshold, double);
+  vtkGetMacro(LowerThreshold, double);
+
+  // Description:
+  // For multi-component images, the component that is compared with
+  // the thresholds.  The default is 0.
+  vtkSetMacro(ActiveComponent, int);
+  vtkGetMacro(ActiveComponent, int);
+
+  // Description:
+  // The number of neighbors of a voxel that it is connected to: 6 for its
+  // faces, 18 to add its edges and 26 to add its corners.  The default
+  // is 6.
+  vtkSetMacro(Connectivity, int);
+  vtkGetMacro(Connectivity, int);
+  void SetConnectivityTo6() { this->SetConnectivity(6); }
+  void SetConnectivityTo18() { this->SetConnectivity(18); }
+  void SetConnectivityTo26() { this->SetConnectivity(26); }
+
+  // Description:
+  // The scalar type of the labels, which can be unsigned char, short,
+  // unsigned short or int.  The default is int.  The filter fails if
+  // there are more regions than the type can hold.
+  vtkSetMacro(LabelScalarType, int);
+  vtkGetMacro(LabelScalarType, int);
+  void SetLabelScalarTypeToUnsignedChar() {
+    this->SetLabelScalarType(VTK_UNSIGNED_CHAR); }
+  void SetLabelScalarTypeToShort() {
+    this->SetLabelScalarType(VTK_SHORT); }
+  void SetLabelScalarTypeToUnsignedShort() {
+    this->SetLabelScalarType(VTK_UNSIGNED_SHORT); }
+  void SetLabelScalarTypeToInt() {
+    this->SetLabelScalarType(VTK_INT); }
+
+  // Description:
+  // After the filter has executed, get the number of regions.
+  vtkIdType GetNumberOfRegions();
+
+  // Description:
+  // After the filter has executed, get the number of voxels of each
+  // region.  The size of the region labeled i is at index i-1.
+  vtkIdTypeArray *GetRegionSizes() { return this->RegionSizes; }
+
+  // Description:
+  // After the filter has executed, get the extent of each region, as
+  // tuples of 6 values in the same order as the region sizes.  The
+  // bounding box of a region is its extent times the spacing of the
+  // image, plus its origin.
+  vtkIntArray *GetRegionExtents() { return this->RegionExtents; }
+
+protected:
+  vtkImageConnectivityFilter();
+  ~vtkImageConnectivityFilter();
+
+  double UpperThreshold;
+  double LowerThreshold;
+  int ActiveComponent;
+  int Connectivity;
+  int LabelScalarType;
+
+  vtkIdTypeArray *RegionSizes;
+  vtkIntArray *RegionExtents;
+
+  virtual int RequestInformation(vtkInformation *, vtkInformationVector **,
+                                 vtkInformationVector *);
+  virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **,
+                                  vtkInformationVector *);
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
+
+private:
+  vtkImageConnectivityFilter(const vtkImageConnectivityFilter&);  // Not implemented.
+  void operator=(const vtkImageConnectivityFilter&);  // Not implemented.
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -35,6 +36,8 @@ vtkImageContinuousErode3D::vtkImageContinuousErode3D()
   this->KernelSize[1] = 1;
   this->KernelSize[2] = 1;
 
+  this->BoxKernel = 0;
+
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
   this->SetKernelSize(1, 1, 1);
@@ -54,6 +57,8 @@ vtkImageContinuousErode3D::~vtkImageContinuousErode3D()
 void vtkImageContinuousErode3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "BoxKernel: " << (this->BoxKernel ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -319,6 +324,26 @@ void vtkImageContinuousErode3D::ThreadedRequestData(
     return;
     }
 
+  if (this->BoxKernel)
+    {
+    vtkIdType outInc[3];
+    outData[0]->GetIncrements(outInc);
+    switch (inArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkImageBoxMorphology::Execute(this, vtkImageBoxMorphology::Erode,
+                                       static_cast<VTK_TT *>(inPtr),
+                                       inData[0][0]->GetExtent(),
+                                       inArray->GetNumberOfComponents(),
+                                       inExt, static_cast<VTK_TT *>(outPtr),
+                                       outInc, outExt, this->KernelSize,
+                                       this->KernelMiddle, 0.0, 0.0, id));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      }
+    return;
+    }
+
   switch (inArray->GetDataType())
     {
     vtkTemplateMacro(
@@ -43,11 +43,22 @@ public:
   // default middle of the neighborhood and computes the elliptical foot print.
   void SetKernelSize(int size0, int size1, int size2);
 
+  // Description:
+  // Use a box of KernelSize as the neighborhood instead of the ellipsoid.
+  // The minimum over a box is computed one axis after the other with
+  // the van Herk/Gil-Werman algorithm, so that its cost does not grow
+  // with the kernel size.  A kernel size of 1 on two axes gives a line.
+  // The default is off.
+  vtkSetMacro(BoxKernel, int);
+  vtkGetMacro(BoxKernel, int);
+  vtkBooleanMacro(BoxKernel, int);
+
 protected:
   vtkImageContinuousErode3D();
   ~vtkImageContinuousErode3D();
 
   vtkImageEllipsoidSource *Ellipse;
+  int BoxKernel;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
@@ -15,6 +15,7 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -34,6 +35,7 @@ vtkImageDilateErode3D::vtkImageDilateErode3D()
 
   this->DilateValue = 0.0;
   this->ErodeValue = 255.0;
+  this->BoxKernel = 0;
 
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
@@ -57,6 +59,7 @@ void vtkImageDilateErode3D::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "DilateValue: " << this->DilateValue << "\n";
   os << indent << "ErodeValue: " << this->ErodeValue << "\n";
+  os << indent << "BoxKernel: " << (this->BoxKernel ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -306,6 +309,26 @@ void vtkImageDilateErode3D::ThreadedRequestData(
     return;
     }
 
+  if (this->BoxKernel)
+    {
+    vtkIdType outInc[3];
+    outData[0]->GetIncrements(outInc);
+    switch (inData[0][0]->GetScalarType())
+      {
+      vtkTemplateMacro(
+        vtkImageBoxMorphology::Execute(
+          this, vtkImageBoxMorphology::DilateErode,
+          static_cast<VTK_TT *>(inData[0][0]->GetScalarPointer()),
+          inData[0][0]->GetExtent(),
+          inData[0][0]->GetNumberOfScalarComponents(), inExt,
+          static_cast<VTK_TT *>(outPtr), outInc, outExt, this->KernelSize,
+          this->KernelMiddle, this->DilateValue, this->ErodeValue, id));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      }
+    return;
+    }
+
   switch (inData[0][0]->GetScalarType())
     {
     vtkTemplateMacro(
@@ -45,6 +45,16 @@ public:
   // default middle of the neighborhood and computes the elliptical foot print.
   void SetKernelSize(int size0, int size1, int size2);
 
+  // Description:
+  // Use a box of KernelSize as the foot print instead of the ellipse.
+  // The box is done one axis after the other, and along each axis the
+  // runs of DilateValue are grown by the kernel, so that the cost does
+  // not grow with the kernel size.  A kernel size of 1 on two axes gives
+  // a line.  The default is off.
+  vtkSetMacro(BoxKernel, int);
+  vtkGetMacro(BoxKernel, int);
+  vtkBooleanMacro(BoxKernel, int);
+
 
   // Description:
   // Set/Get the Dilate and Erode values to be used by this filter.
@@ -60,6 +70,7 @@ protected:
   vtkImageEllipsoidSource *Ellipse;
   double DilateValue;
   double ErodeValue;
+  int BoxKernel;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
@@ -0,0 +1,341 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageMorphologyInternals.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageMorphologyInternals - box kernels for the morphology filters
+// .SECTION Description
+// This header is used by vtkImageContinuousDilate3D,
+// vtkImageContinuousErode3D and vtkImageDilateErode3D when their
+// BoxKernel option is set.  A box is separable, so the maximum or the
+// minimum over the box is computed one axis after the other.  Along each
+// axis, the van Herk/Gil-Werman algorithm takes the maximum over every
+// window of k values with three comparisons per value whatever k is,
+// and the binary dilation of vtkImageDilateErode3D grows the runs of
+// DilateValue along each line.
+// .SECTION See Also
+// M. van Herk, "A fast algorithm for local minimum and maximum filters on
+// rectangular and octagonal kernels", Pattern Recognition Letters 13,
+// 1992.  J. Gil and M. Werman, "Computing 2-D min, median, and max
+// filters", IEEE PAMI 15, 1993.
+
+#ifndef __vtkImageMorphologyInternals_h
+#define __vtkImageMorphologyInternals_h
+
+#include "vtkAlgorithm.h"
+#include "vtkTypeTraits.h"
+
+#include <vector>
+
+struct vtkImageBoxMorphology
+{
+  // The operation done over the box.
+  enum Operation
+  {
+    Dilate = 0,  // maximum
+    Erode = 1,   // minimum
+    DilateErode = 2 // ErodeValue becomes DilateValue next to DilateValue
+  };
+
+  // Compute outExt of the output from the inExt region of the input,
+  // whose scalars start at inPtr and cover inDataExt with numComps
+  // components.  Outside of inExt, which is clipped to the whole extent
+  // only, the image is ignored as with the ellipsoidal kernels.  The
+  // output has the same type and number of components as the input.
+  template<class T>
+  static void Execute(vtkAlgorithm *self, int operation,
+                      const T *inPtr, const int inDataExt[6], int numComps,
+                      const int inExt[6], T *outPtr, const vtkIdType outInc[3],
+                      const int outExt[6], const int kernelSize[3],
+                      const int kernelMiddle[3], double dilateValue,
+                      double erodeValue, int id);
+
+  // Set out[i] to the maximum (or minimum if erode is set) of
+  // in[i + j] for j from 0 to k-1, for n values of out.
+  template<class T>
+  static void MaximumLine(const T *in, T *out, int n, int k, bool erode,
+                          T *g, T *h);
+
+  // Set out[i] to 1 if the window of in[i] is not all zero, with the
+  // window from i - kernelMiddle to i - kernelMiddle + k - 1, for
+  // positions i from outMin to outMax.  The line has values from inMin to
+  // inMax, and the pointers are at position 0.
+  static void RunLine(const unsigned char *in, unsigned char *out,
+                      int inMin, int inMax, int outMin, int outMax,
+                      int k, int kernelMiddle);
+};
+
+//--------------------------------------------------------------------------
+template<class T>
+void vtkImageBoxMorphology::MaximumLine(
+  const T *in, T *out, int n, int k, bool erode, T *g, T *h)
+{
+  int l = n + k - 1;
+  // g is the running maximum from the start of each block of k values,
+  // and h the running maximum to its end, so that every window is made
+  // of the end of a block and the start of the next one
+  if (erode)
+    {
+    for (int j = 0; j < l; ++j)
+      {
+      g[j] = ((j % k == 0 || in[j] < g[j-1]) ? in[j] : g[j-1]);
+      }
+    h[l-1] = in[l-1];
+    for (int j = l - 2; j >= 0; --j)
+      {
+      h[j] = ((j % k == k - 1 || in[j] < h[j+1]) ? in[j] : h[j+1]);
+      }
+    for (int i = 0; i < n; ++i)
+      {
+      out[i] = (h[i] < g[i+k-1] ? h[i] : g[i+k-1]);
+      }
+    }
+  else
+    {
+    for (int j = 0; j < l; ++j)
+      {
+      g[j] = ((j % k == 0 || in[j] > g[j-1]) ? in[j] : g[j-1]);
+      }
+    h[l-1] = in[l-1];
+    for (int j = l - 2; j >= 0; --j)
+      {
+      h[j] = ((j % k == k - 1 || in[j] > h[j+1]) ? in[j] : h[j+1]);
+      }
+    for (int i = 0; i < n; ++i)
+      {
+      out[i] = (h[i] > g[i+k-1] ? h[i] : g[i+k-1]);
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+inline void vtkImageBoxMorphology::RunLine(
+  const unsigned char *in, unsigned char *out, int inMin, int inMax,
+  int outMin, int outMax, int k, int kernelMiddle)
+{
+  for (int i = outMin; i <= outMax; ++i)
+    {
+    out[i] = 0;
+    }
+  // each run from a to b sets the positions from a - (k - 1 - middle)
+  // to b + middle, which overlap the previous ones at most up to filled
+  int filled = outMin - 1;
+  int i = inMin;
+  while (i <= inMax)
+    {
+    if (!in[i])
+      {
+      ++i;
+      continue;
+      }
+    int a = i;
+    while (i <= inMax && in[i])
+      {
+      ++i;
+      }
+    int b = i - 1;
+    int first = a - (k - 1 - kernelMiddle);
+    int last = b + kernelMiddle;
+    first = (first > filled ? first : filled + 1);
+    last = (last < outMax ? last : outMax);
+    for (int j = first; j <= last; ++j)
+      {
+      out[j] = 1;
+      }
+    filled = (last > filled ? last : filled);
+    }
+}
+
+//--------------------------------------------------------------------------
+template<class T>
+void vtkImageBoxMorphology::Execute(
+  vtkAlgorithm *self, int operation, const T *inPtr,
+  const int inDataExt[6], int numComps, const int inExt[6], T *outPtr,
+  const vtkIdType outInc[3], const int outExt[6], const int kernelSize[3],
+  const int kernelMiddle[3], double dilateValue, double erodeValue, int id)
+{
+  // the work region has the size of inExt, and the region that holds
+  // the result of the axes done so far shrinks to outExt axis by axis
+  vtkIdType workInc[3];
+  workInc[0] = 1;
+  workInc[1] = inExt[1] - inExt[0] + 1;
+  workInc[2] = workInc[1]*(inExt[3] - inExt[2] + 1);
+  vtkIdType workSize = workInc[2]*(inExt[5] - inExt[4] + 1);
+
+  vtkIdType inInc[3];
+  inInc[0] = numComps;
+  inInc[1] = inInc[0]*(inDataExt[1] - inDataExt[0] + 1);
+  inInc[2] = inInc[1]*(inDataExt[3] - inDataExt[2] + 1);
+  const T *inStart = inPtr + ((inExt[0] - inDataExt[0])*inInc[0] +
+                              (inExt[2] - inDataExt[2])*inInc[1] +
+                              (inExt[4] - inDataExt[4])*inInc[2]);
+
+  bool binary = (operation == DilateErode);
+  bool erode = (operation == Erode);
+  T dilateT = static_cast<T>(dilateValue);
+  T erodeT = static_cast<T>(erodeValue);
+  // the value that does not change the maximum or minimum
+  T pad = (erode ? vtkTypeTraits<T>::Max() : vtkTypeTraits<T>::Min());
+
+  std::vector<T> work(binary ? 0 : workSize);
+  std::vector<unsigned char> workMask(binary ? workSize : 0);
+
+  // the padded lines are longer than the lines of inExt
+  int maxLength = 1;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int length = outExt[2*axis+1] - outExt[2*axis] + kernelSize[axis];
+    maxLength = (length > maxLength ? length : maxLength);
+    }
+  std::vector<T> line(binary ? 0 : 3*maxLength);
+  std::vector<unsigned char> maskLine(binary ? 2*maxLength : 0);
+
+  int numPasses = 3*numComps;
+  for (int c = 0; c < numComps && !self->AbortExecute; ++c)
+    {
+    // copy the component, or whether it is DilateValue
+    for (int z = 0; z <= inExt[5] - inExt[4]; ++z)
+      {
+      for (int y = 0; y <= inExt[3] - inExt[2]; ++y)
+        {
+        const T *inRow = inStart + z*inInc[2] + y*inInc[1] + c;
+        vtkIdType w = z*workInc[2] + y*workInc[1];
+        int nx = inExt[1] - inExt[0] + 1;
+        if (binary)
+          {
+          for (int x = 0; x < nx; ++x)
+            {
+            workMask[w + x] = (inRow[x*inInc[0]] == dilateT);
+            }
+          }
+        else
+          {
+          for (int x = 0; x < nx; ++x)
+            {
+            work[w + x] = inRow[x*inInc[0]];
+            }
+          }
+        }
+      }
+
+    int region[6];
+    for (int j = 0; j < 6; ++j)
+      {
+      region[j] = inExt[j];
+      }
+    for (int axis = 0; axis < 3 && !self->AbortExecute; ++axis)
+      {
+      int k = kernelSize[axis];
+      int inMin = inExt[2*axis];
+      int inMax = inExt[2*axis+1];
+      int outMin = outExt[2*axis];
+      int outMax = outExt[2*axis+1];
+      region[2*axis] = outMin;
+      region[2*axis+1] = outMax;
+      if (k <= 1)
+        {
+        continue;
+        }
+      // the other two axes, in order
+      int a1 = (axis == 0 ? 1 : 0);
+      int a2 = (axis == 2 ? 1 : 2);
+      // the window of position p starts at p - middle, so the padded
+      // line starts at outMin - middle
+      int start = outMin - kernelMiddle[axis];
+      int n = outMax - outMin + 1;
+      int l = n + k - 1;
+      for (int i2 = region[2*a2]; i2 <= region[2*a2+1]; ++i2)
+        {
+        for (int i1 = region[2*a1]; i1 <= region[2*a1+1]; ++i1)
+          {
+          vtkIdType w = ((i1 - inExt[2*a1])*workInc[a1] +
+                         (i2 - inExt[2*a2])*workInc[a2] -
+                         inMin*workInc[axis]);
+          vtkIdType inc = workInc[axis];
+          if (binary)
+            {
+            // positions run from inMin, so shift the lines to index 0
+            unsigned char *in = &maskLine[0] - inMin;
+            unsigned char *out = &maskLine[maxLength] - outMin;
+            for (int p = inMin; p <= inMax; ++p)
+              {
+              in[p] = workMask[w + p*inc];
+              }
+            vtkImageBoxMorphology::RunLine(in, out, inMin, inMax, outMin,
+                                           outMax, k, kernelMiddle[axis]);
+            for (int p = outMin; p <= outMax; ++p)
+              {
+              workMask[w + p*inc] = out[p];
+              }
+            }
+          else
+            {
+            T *in = &line[0];
+            T *g = in + maxLength;
+            T *h = g + maxLength;
+            for (int j = 0; j < l; ++j)
+              {
+              int p = start + j;
+              in[j] = ((p >= inMin && p <= inMax) ? work[w + p*inc] : pad);
+              }
+            // the result can go back to the line, which is read through
+            // g and h only after they are computed
+            vtkImageBoxMorphology::MaximumLine(in, in, n, k, erode, g, h);
+            for (int j = 0; j < n; ++j)
+              {
+              work[w + (outMin + j)*inc] = in[j];
+              }
+            }
+          }
+        }
+      if (!id)
+        {
+        self->UpdateProgress((3.0*c + axis + 1)/numPasses);
+        }
+      }
+
+    // copy the result to the output
+    for (int z = outExt[4]; z <= outExt[5]; ++z)
+      {
+      for (int y = outExt[2]; y <= outExt[3]; ++y)
+        {
+        T *outRow = outPtr + ((z - outExt[4])*outInc[2] +
+                              (y - outExt[2])*outInc[1] + c);
+        vtkIdType w = ((z - inExt[4])*workInc[2] + (y - inExt[2])*workInc[1] +
+                       outExt[0] - inExt[0]);
+        int nx = outExt[1] - outExt[0] + 1;
+        if (binary)
+          {
+          const T *inRow = inStart + ((z - inExt[4])*inInc[2] +
+                                      (y - inExt[2])*inInc[1] +
+                                      (outExt[0] - inExt[0])*inInc[0] + c);
+          for (int x = 0; x < nx; ++x)
+            {
+            T v = inRow[x*inInc[0]];
+            outRow[x*outInc[0]] = ((v == erodeT && workMask[w + x]) ?
+                                   dilateT : v);
+            }
+          }
+        else
+          {
+          for (int x = 0; x < nx; ++x)
+            {
+            outRow[x*outInc[0]] = work[w + x];
+            }
+          }
+        }
+      }
+    }
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageMorphologyInternals.h
@@ -66,6 +66,14 @@ public:
   // Selects the size of gaps or objects removed.
   void SetKernelSize(int size0, int size1, int size2);
 
+  // Description:
+  // Use a box of KernelSize instead of an ellipse, see
+  // vtkImageDilateErode3D::SetBoxKernel().  The cost of the box does not
+  // grow with the kernel size.
+  void SetBoxKernel(int box);
+  int GetBoxKernel();
+  vtkBooleanMacro(BoxKernel, int);
+
   // Description:
   // Determines the value that will opened.
   // Open value is first eroded, and then dilated.
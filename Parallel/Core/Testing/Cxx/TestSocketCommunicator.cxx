@@ -13,19 +13,71 @@
 
 =========================================================================*/
 // This test tests vtkSocketCommunicator.
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdList.h"
 #include "vtkNew.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkTesting.h"
 #include "vtkServerSocket.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
 
 #include <vtksys/ios/sstream>
 
 #define MESSAGE(x)\
   cout << (is_server? "SERVER" : "CLIENT") << ":" x << endl;
 
+// Poly data with compact polygons and point and cell attributes.
+static void FillPolyData(vtkPolyData* polyData)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> normals;
+  normals->SetName("normals");
+  normals->SetNumberOfComponents(3);
+  normals->SetComponentName(2, "nz");
+  for (int i = 0; i < 10; i++)
+    {
+    points->InsertNextPoint(i, i % 3, 0);
+    normals->InsertNextTuple3(0, 0, 1);
+    }
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  for (vtkIdType i = 0; i < 8; i++)
+    {
+    vtkIdType triangle[3] = {i, i + 1, i + 2};
+    polys->InsertNextCell(3, triangle);
+    ids->InsertNextValue(10 * i);
+    }
+  polys->ConvertToCompactStorage();
+  polyData->SetPoints(points.GetPointer());
+  polyData->SetPolys(polys.GetPointer());
+  polyData->GetPointData()->SetNormals(normals.GetPointer());
+  polyData->GetCellData()->AddArray(ids.GetPointer());
+}
+
+static bool CheckPolyData(vtkPolyData* polyData)
+{
+  vtkDataArray* normals = polyData->GetPointData()->GetNormals();
+  vtkDataArray* ids = polyData->GetCellData()->GetArray("ids");
+  vtkNew<vtkIdList> cell;
+  polyData->GetPolys()->GetCellAtId(7, cell.GetPointer());
+  return polyData->GetNumberOfPoints() == 10 &&
+    polyData->GetPoint(7)[1] == 1 &&
+    polyData->GetPolys()->GetStorageType() == vtkCellArray::COMPACT_STORAGE &&
+    polyData->GetNumberOfPolys() == 8 &&
+    cell->GetNumberOfIds() == 3 && cell->GetId(2) == 9 &&
+    normals && normals->GetComponentName(2) &&
+    strcmp(normals->GetComponentName(2), "nz") == 0 &&
+    ids && ids->GetDataType() == VTK_INT && ids->GetTuple1(7) == 70;
+}
+
 int main(int argc, char *argv[])
 {
   vtkNew<vtkTesting> testing;
@@ -74,6 +126,9 @@ int main(int argc, char *argv[])
   double ddata = 0;
   vtkNew<vtkDoubleArray> dArray;
   vtkNew<vtkPolyData> pData;
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkImageData> image;
+  int extent[6] = {2, 5, 0, 3, -1, 1};
 
   for (int cc=0; cc < 2; cc++)
     {
@@ -85,11 +140,18 @@ int main(int argc, char *argv[])
       dArray->SetNumberOfTuples(10);
       dArray->FillComponent(0, 10.0);
       pData->Initialize();
+      FillPolyData(polyData.GetPointer());
+      image->SetExtent(extent);
+      image->SetOrigin(1, 2, 3);
+      image->AllocateScalars(VTK_SHORT, 2);
+      image->GetPointData()->GetScalars()->FillComponent(1, 10.0);
 
       controller->Send(&idata, 1, 1, 101011);
       controller->Send(&ddata, 1, 1, 101012);
       controller->Send(dArray.GetPointer(), 1, 101013);
       controller->Send(pData.GetPointer(), 1, 101014);
+      controller->Send(polyData.GetPointer(), 1, 101015);
+      controller->Send(image.GetPointer(), 1, 101016);
       }
     else
       {
@@ -97,10 +159,19 @@ int main(int argc, char *argv[])
       controller->Receive(&ddata, 1, 1, 101012);
       controller->Receive(dArray.GetPointer(), 1, 101013);
       controller->Receive(pData.GetPointer(), 1, 101014);
+      controller->Receive(polyData.GetPointer(), 1, 101015);
+      controller->Receive(image.GetPointer(), 1, 101016);
+      vtkDataArray* scalars = image->GetPointData()->GetScalars();
       if (idata != 10 ||
         ddata != 10.0 ||
         dArray->GetNumberOfTuples() != 10 ||
-        dArray->GetValue(9) != 10.0)
+        dArray->GetValue(9) != 10.0 ||
+        pData->GetNumberOfPoints() != 0 ||
+        !CheckPolyData(polyData.GetPointer()) ||
+        image->GetExtent()[4] != extent[4] || image->GetOrigin()[2] != 3 ||
+        !scalars || scalars->GetDataType() != VTK_SHORT ||
+        scalars->GetNumberOfTuples() != 48 ||
+        scalars->GetComponent(47, 1) != 10.0)
         {
         MESSAGE("ERROR: Communication failed!!!");
         return EXIT_FAILURE;
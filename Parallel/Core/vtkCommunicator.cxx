@@ -15,6 +15,8 @@
 #include "vtkCommunicator.h"
 
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
@@ -29,6 +31,9 @@
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
@@ -36,6 +41,7 @@
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
@@ -99,6 +105,586 @@ STANDARD_OPERATION_DEFINITION(LogicalXor, (!A[i] && B[i]) || (A[i] && !B[i]));
 STANDARD_OPERATION_FLOAT_OVERRIDE(BitwiseXor);
 STANDARD_OPERATION_DEFINITION(BitwiseXor, A[i] ^ B[i]);
 
+//=============================================================================
+// Data sets are transferred as a header, which describes their structure and
+// arrays, followed by the values of the arrays.  The values are sent straight
+// from the arrays of the sender and received straight into the arrays of the
+// receiver, which are created as the header is read.  Other data objects are
+// marshaled into a string by vtkGenericDataObjectWriter.
+namespace
+{
+enum
+{
+  vtkCommunicatorStringFormat = 0,
+  vtkCommunicatorBinaryFormat = 1
+};
+
+// Sizes in packed buffers are rounded up to keep the arrays aligned.
+inline vtkTypeInt64 vtkCommunicatorPadSize(vtkTypeInt64 size)
+{
+  return (size + 7) & ~static_cast<vtkTypeInt64>(7);
+}
+
+//-----------------------------------------------------------------------------
+class vtkCommunicatorMarshaler
+{
+public:
+  vtkMultiProcessStream Header;
+  std::vector<vtkDataArray*> Arrays;
+
+  // Return whether the object can use the binary format.
+  static bool CanMarshal(vtkDataObject* object)
+  {
+    if (!object)
+      {
+      return false;
+      }
+    switch (object->GetDataObjectType())
+      {
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+      case VTK_RECTILINEAR_GRID:
+      case VTK_STRUCTURED_GRID:
+      case VTK_POLY_DATA:
+      case VTK_UNSTRUCTURED_GRID:
+        break;
+      default:
+        return false;
+      }
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(object);
+    return ds &&
+      vtkCommunicatorMarshaler::CanMarshal(object->GetFieldData()) &&
+      vtkCommunicatorMarshaler::CanMarshal(ds->GetPointData()) &&
+      vtkCommunicatorMarshaler::CanMarshal(ds->GetCellData());
+  }
+
+  // Write the description of the object and list its arrays.
+  void Marshal(vtkDataObject* object)
+  {
+    int type = object->GetDataObjectType();
+    this->Header << type;
+    switch (type)
+      {
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+        {
+        vtkImageData* id = vtkImageData::SafeDownCast(object);
+        this->WriteExtent(id->GetExtent());
+        double* origin = id->GetOrigin();
+        double* spacing = id->GetSpacing();
+        for (int i = 0; i < 3; ++i)
+          {
+          this->Header << origin[i] << spacing[i];
+          }
+        }
+        break;
+      case VTK_RECTILINEAR_GRID:
+        {
+        vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(object);
+        this->WriteExtent(rg->GetExtent());
+        this->WriteOptionalArray(rg->GetXCoordinates());
+        this->WriteOptionalArray(rg->GetYCoordinates());
+        this->WriteOptionalArray(rg->GetZCoordinates());
+        }
+        break;
+      case VTK_STRUCTURED_GRID:
+        {
+        vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(object);
+        this->WriteExtent(sg->GetExtent());
+        this->WritePoints(sg->GetPoints());
+        }
+        break;
+      case VTK_POLY_DATA:
+        {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(object);
+        this->WritePoints(pd->GetPoints());
+        this->WriteCellArray(pd->GetVerts());
+        this->WriteCellArray(pd->GetLines());
+        this->WriteCellArray(pd->GetPolys());
+        this->WriteCellArray(pd->GetStrips());
+        }
+        break;
+      case VTK_UNSTRUCTURED_GRID:
+        {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(object);
+        this->WritePoints(ug->GetPoints());
+        this->WriteCellArray(ug->GetCells());
+        this->WriteOptionalArray(ug->GetCellTypesArray());
+        this->WriteOptionalArray(ug->GetCellLocationsArray());
+        this->WriteOptionalArray(ug->GetFaces());
+        this->WriteOptionalArray(ug->GetFaceLocations());
+        }
+        break;
+      }
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(object);
+    this->WriteFieldData(object->GetFieldData(), 0);
+    this->WriteFieldData(ds->GetPointData(), ds->GetPointData());
+    this->WriteFieldData(ds->GetCellData(), ds->GetCellData());
+  }
+
+  // Send the values of the arrays to remoteHandle with tag, or broadcast
+  // them from remoteHandle when tag is negative.
+  int SendArrays(vtkCommunicator* communicator, int remoteHandle, int tag)
+  {
+    for (size_t i = 0; i < this->Arrays.size(); ++i)
+      {
+      vtkDataArray* array = this->Arrays[i];
+      vtkIdType size =
+        array->GetNumberOfTuples()*array->GetNumberOfComponents();
+      if (size == 0)
+        {
+        continue;
+        }
+      int result = tag < 0 ?
+        communicator->BroadcastVoidArray(array->GetVoidPointer(0), size,
+                                         array->GetDataType(), remoteHandle) :
+        communicator->SendVoidArray(array->GetVoidPointer(0), size,
+                                    array->GetDataType(), remoteHandle, tag);
+      if (!result)
+        {
+        return 0;
+        }
+      }
+    return 1;
+  }
+
+  // Return the number of bytes PackArrays() writes.
+  vtkTypeInt64 GetPackedArraysSize()
+  {
+    vtkTypeInt64 size = 0;
+    for (size_t i = 0; i < this->Arrays.size(); ++i)
+      {
+      size += vtkCommunicatorPadSize(this->GetArraySize(this->Arrays[i]));
+      }
+    return size;
+  }
+
+  // Copy the values of the arrays to buffer, each one starting on an 8-byte
+  // boundary.
+  void PackArrays(char* buffer)
+  {
+    for (size_t i = 0; i < this->Arrays.size(); ++i)
+      {
+      vtkTypeInt64 size = this->GetArraySize(this->Arrays[i]);
+      if (size > 0)
+        {
+        memcpy(buffer, this->Arrays[i]->GetVoidPointer(0),
+               static_cast<size_t>(size));
+        }
+      buffer += vtkCommunicatorPadSize(size);
+      }
+  }
+
+private:
+  static vtkTypeInt64 GetArraySize(vtkDataArray* array)
+  {
+    return static_cast<vtkTypeInt64>(array->GetNumberOfTuples())*
+      array->GetNumberOfComponents()*array->GetDataTypeSize();
+  }
+
+  static bool CanMarshal(vtkFieldData* fd)
+  {
+    int numArrays = fd? fd->GetNumberOfArrays() : 0;
+    for (int i = 0; i < numArrays; ++i)
+      {
+      vtkDataArray* array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+      if (!array || array->GetDataType() == VTK_BIT)
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+  void WriteExtent(int* extent)
+  {
+    for (int i = 0; i < 6; ++i)
+      {
+      this->Header << extent[i];
+      }
+  }
+
+  void WriteArray(vtkDataArray* array)
+  {
+    int numComponents = array->GetNumberOfComponents();
+    const char* name = array->GetName();
+    this->Header << array->GetDataType() << numComponents
+                 << static_cast<vtkTypeInt64>(array->GetNumberOfTuples())
+                 << (name != 0) << (name? name : "");
+    for (int i = 0; i < numComponents; ++i)
+      {
+      const char* componentName = array->GetComponentName(i);
+      this->Header << (componentName != 0)
+                   << (componentName? componentName : "");
+      }
+    this->Arrays.push_back(array);
+  }
+
+  void WriteOptionalArray(vtkDataArray* array)
+  {
+    this->Header << (array != 0);
+    if (array)
+      {
+      this->WriteArray(array);
+      }
+  }
+
+  void WritePoints(vtkPoints* points)
+  {
+    this->WriteOptionalArray(points? points->GetData() : 0);
+  }
+
+  void WriteCellArray(vtkCellArray* cells)
+  {
+    bool hasCells = cells && cells->GetNumberOfCells() > 0;
+    this->Header << hasCells;
+    if (!hasCells)
+      {
+      return;
+      }
+    int storage = cells->GetStorageType();
+    this->Header << storage;
+    if (storage == vtkCellArray::COMPACT_STORAGE)
+      {
+      this->WriteArray(cells->GetOffsetsArray());
+      this->WriteArray(cells->GetConnectivityArray());
+      }
+    else
+      {
+      this->Header << static_cast<vtkTypeInt64>(cells->GetNumberOfCells());
+      this->WriteArray(cells->GetData());
+      }
+  }
+
+  // Write the arrays of the field data, and which attribute each one is
+  // when dsa is given.
+  void WriteFieldData(vtkFieldData* fd, vtkDataSetAttributes* dsa)
+  {
+    int numArrays = fd? fd->GetNumberOfArrays() : 0;
+    this->Header << numArrays;
+    for (int i = 0; i < numArrays; ++i)
+      {
+      this->WriteArray(fd->GetArray(i));
+      if (dsa)
+        {
+        this->Header << dsa->IsArrayAnAttribute(i);
+        }
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+class vtkCommunicatorUnMarshaler
+{
+public:
+  vtkMultiProcessStream Header;
+
+  // Receive the values of the arrays from remoteHandle with tag, or from the
+  // broadcast of remoteHandle when tag is negative.
+  vtkCommunicatorUnMarshaler(vtkCommunicator* communicator, int remoteHandle,
+                             int tag) :
+    Communicator(communicator), RemoteHandle(remoteHandle), Tag(tag),
+    Values(0), ValuesEnd(0), Failed(false)
+  {
+  }
+
+  // Copy the values of the arrays from a buffer written by
+  // vtkCommunicatorMarshaler::PackArrays().
+  vtkCommunicatorUnMarshaler(const char* values, const char* valuesEnd) :
+    Communicator(0), RemoteHandle(0), Tag(0),
+    Values(values), ValuesEnd(valuesEnd), Failed(false)
+  {
+  }
+
+  // Rebuild the object described by the header, receiving the values of its
+  // arrays.  Returns 1 for success and 0 for failure.
+  int UnMarshal(vtkDataObject* object)
+  {
+    int type;
+    this->Header >> type;
+    vtkSmartPointer<vtkDataObject> target = object;
+    if (object->GetDataObjectType() != type)
+      {
+      vtkGenericWarningMacro("Type mismatch while unmarshalling data.");
+      target.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+      if (!target)
+        {
+        return 0;
+        }
+      }
+    target->Initialize();
+
+    switch (type)
+      {
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+        {
+        vtkImageData* id = vtkImageData::SafeDownCast(target);
+        int extent[6];
+        this->ReadExtent(extent);
+        double origin[3];
+        double spacing[3];
+        for (int i = 0; i < 3; ++i)
+          {
+          this->Header >> origin[i] >> spacing[i];
+          }
+        id->SetExtent(extent);
+        id->SetOrigin(origin);
+        id->SetSpacing(spacing);
+        }
+        break;
+      case VTK_RECTILINEAR_GRID:
+        {
+        vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(target);
+        int extent[6];
+        this->ReadExtent(extent);
+        rg->SetExtent(extent);
+        vtkSmartPointer<vtkDataArray> coordinates;
+        if ((coordinates = this->ReadOptionalArray()))
+          {
+          rg->SetXCoordinates(coordinates);
+          }
+        if ((coordinates = this->ReadOptionalArray()))
+          {
+          rg->SetYCoordinates(coordinates);
+          }
+        if ((coordinates = this->ReadOptionalArray()))
+          {
+          rg->SetZCoordinates(coordinates);
+          }
+        }
+        break;
+      case VTK_STRUCTURED_GRID:
+        {
+        vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(target);
+        int extent[6];
+        this->ReadExtent(extent);
+        sg->SetExtent(extent);
+        sg->SetPoints(this->ReadPoints());
+        }
+        break;
+      case VTK_POLY_DATA:
+        {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(target);
+        pd->SetPoints(this->ReadPoints());
+        pd->SetVerts(this->ReadCellArray());
+        pd->SetLines(this->ReadCellArray());
+        pd->SetPolys(this->ReadCellArray());
+        pd->SetStrips(this->ReadCellArray());
+        }
+        break;
+      case VTK_UNSTRUCTURED_GRID:
+        {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(target);
+        ug->SetPoints(this->ReadPoints());
+        vtkSmartPointer<vtkCellArray> cells = this->ReadCellArray();
+        vtkSmartPointer<vtkDataArray> types = this->ReadOptionalArray();
+        vtkSmartPointer<vtkDataArray> locations = this->ReadOptionalArray();
+        vtkSmartPointer<vtkDataArray> faces = this->ReadOptionalArray();
+        vtkSmartPointer<vtkDataArray> faceLocations =
+          this->ReadOptionalArray();
+        if (cells)
+          {
+          ug->SetCells(vtkUnsignedCharArray::SafeDownCast(types),
+                       vtkIdTypeArray::SafeDownCast(locations), cells,
+                       vtkIdTypeArray::SafeDownCast(faceLocations),
+                       vtkIdTypeArray::SafeDownCast(faces));
+          }
+        }
+        break;
+      default:
+        vtkGenericWarningMacro("Cannot unmarshal "
+          << vtkDataObjectTypes::GetClassNameFromTypeId(type));
+        return 0;
+      }
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(target);
+    this->ReadFieldData(target->GetFieldData(), 0);
+    this->ReadFieldData(ds->GetPointData(), ds->GetPointData());
+    this->ReadFieldData(ds->GetCellData(), ds->GetCellData());
+    if (this->Failed)
+      {
+      return 0;
+      }
+
+    if (target != object)
+      {
+      object->ShallowCopy(target);
+      }
+    return 1;
+  }
+
+private:
+  vtkCommunicator* Communicator;
+  int RemoteHandle;
+  int Tag;
+  const char* Values;
+  const char* ValuesEnd;
+  bool Failed;
+
+  void ReadExtent(int* extent)
+  {
+    for (int i = 0; i < 6; ++i)
+      {
+      this->Header >> extent[i];
+      }
+  }
+
+  // Create the next array and receive its values.
+  vtkSmartPointer<vtkDataArray> ReadArray()
+  {
+    vtkSmartPointer<vtkDataArray> array;
+    int type;
+    int numComponents;
+    vtkTypeInt64 numTuples;
+    bool hasName;
+    std::string name;
+    this->Header >> type >> numComponents >> numTuples >> hasName >> name;
+    if (this->Failed || type == VTK_BIT || numComponents < 1 ||
+        numTuples < 0)
+      {
+      this->Failed = true;
+      return array;
+      }
+    array.TakeReference(vtkDataArray::CreateDataArray(type));
+    if (!array)
+      {
+      this->Failed = true;
+      return array;
+      }
+    array->SetNumberOfComponents(numComponents);
+    if (hasName)
+      {
+      array->SetName(name.c_str());
+      }
+    for (int i = 0; i < numComponents; ++i)
+      {
+      this->Header >> hasName >> name;
+      if (hasName)
+        {
+        array->SetComponentName(i, name.c_str());
+        }
+      }
+    array->SetNumberOfTuples(numTuples);
+
+    vtkIdType size = array->GetNumberOfTuples()*numComponents;
+    if (!this->Communicator)
+      {
+      vtkTypeInt64 numBytes =
+        static_cast<vtkTypeInt64>(size)*array->GetDataTypeSize();
+      vtkTypeInt64 paddedBytes = vtkCommunicatorPadSize(numBytes);
+      if (paddedBytes > this->ValuesEnd - this->Values)
+        {
+        this->Failed = true;
+        return array;
+        }
+      if (numBytes > 0)
+        {
+        memcpy(array->GetVoidPointer(0), this->Values,
+               static_cast<size_t>(numBytes));
+        }
+      this->Values += paddedBytes;
+      }
+    else if (size > 0)
+      {
+      int result = this->Tag < 0 ?
+        this->Communicator->BroadcastVoidArray(array->GetVoidPointer(0),
+                                               size, type,
+                                               this->RemoteHandle) :
+        this->Communicator->ReceiveVoidArray(array->GetVoidPointer(0),
+                                             size, type, this->RemoteHandle,
+                                             this->Tag);
+      if (!result)
+        {
+        this->Failed = true;
+        }
+      }
+    return array;
+  }
+
+  vtkSmartPointer<vtkDataArray> ReadOptionalArray()
+  {
+    bool hasArray;
+    this->Header >> hasArray;
+    return hasArray? this->ReadArray() : vtkSmartPointer<vtkDataArray>();
+  }
+
+  vtkSmartPointer<vtkPoints> ReadPoints()
+  {
+    vtkSmartPointer<vtkPoints> points;
+    vtkSmartPointer<vtkDataArray> data = this->ReadOptionalArray();
+    if (data)
+      {
+      points = vtkSmartPointer<vtkPoints>::New();
+      points->SetData(data);
+      }
+    return points;
+  }
+
+  vtkSmartPointer<vtkCellArray> ReadCellArray()
+  {
+    vtkSmartPointer<vtkCellArray> cells;
+    bool hasCells;
+    this->Header >> hasCells;
+    if (!hasCells)
+      {
+      return cells;
+      }
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    int storage;
+    this->Header >> storage;
+    if (storage == vtkCellArray::COMPACT_STORAGE)
+      {
+      vtkSmartPointer<vtkDataArray> offsets = this->ReadArray();
+      vtkSmartPointer<vtkDataArray> connectivity = this->ReadArray();
+      if (!this->Failed && !cells->SetData(offsets, connectivity))
+        {
+        this->Failed = true;
+        }
+      }
+    else
+      {
+      vtkTypeInt64 numCells;
+      this->Header >> numCells;
+      vtkSmartPointer<vtkDataArray> data = this->ReadArray();
+      vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(data);
+      if (ids)
+        {
+        cells->SetCells(numCells, ids);
+        }
+      else
+        {
+        this->Failed = true;
+        }
+      }
+    return cells;
+  }
+
+  void ReadFieldData(vtkFieldData* fd, vtkDataSetAttributes* dsa)
+  {
+    int numArrays;
+    this->Header >> numArrays;
+    for (int i = 0; i < numArrays && !this->Failed; ++i)
+      {
+      vtkSmartPointer<vtkDataArray> array = this->ReadArray();
+      int attribute = -1;
+      if (dsa)
+        {
+        this->Header >> attribute;
+        }
+      if (!array)
+        {
+        return;
+        }
+      int index = fd->AddArray(array);
+      if (attribute >= 0)
+        {
+        dsa->SetActiveAttribute(index, attribute);
+        }
+      }
+  }
+};
+}
+
 //=============================================================================
 vtkCommunicator::vtkCommunicator()
 {
@@ -217,10 +803,25 @@ int vtkCommunicator::SendElementalDataObject(
   vtkDataObject* data, int remoteHandle,
   int tag)
 {
+  if (vtkCommunicatorMarshaler::CanMarshal(data))
+    {
+    int format = vtkCommunicatorBinaryFormat;
+    vtkCommunicatorMarshaler marshaler;
+    marshaler.Marshal(data);
+    if (!this->Send(&format, 1, remoteHandle, tag) ||
+        !this->Send(marshaler.Header, remoteHandle, tag))
+      {
+      return 0;
+      }
+    return marshaler.SendArrays(this, remoteHandle, tag);
+    }
+
+  int format = vtkCommunicatorStringFormat;
   VTK_CREATE(vtkCharArray, buffer);
   if (vtkCommunicator::MarshalDataObject(data, buffer))
     {
-    return this->Send(buffer, remoteHandle, tag);
+    return this->Send(&format, 1, remoteHandle, tag) &&
+      this->Send(buffer, remoteHandle, tag);
     }
 
   // could not marshal data
@@ -411,6 +1012,21 @@ int vtkCommunicator::ReceiveElementalDataObject(
   vtkDataObject* data, int remoteHandle,
   int tag)
 {
+  int format;
+  if (!this->Receive(&format, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+  if (format == vtkCommunicatorBinaryFormat)
+    {
+    vtkCommunicatorUnMarshaler unmarshaler(this, remoteHandle, tag);
+    if (!this->Receive(unmarshaler.Header, remoteHandle, tag))
+      {
+      return 0;
+      }
+    return unmarshaler.UnMarshal(data);
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (!this->Receive(buffer, remoteHandle, tag))
     {
@@ -663,6 +1279,107 @@ int vtkCommunicator::UnMarshalDataObject(vtkCharArray *buffer,
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+// A packed buffer starts with the format and the size of what follows as
+// 64-bit integers.  For the binary format, that is the raw header, and the
+// values of the arrays follow it.
+int vtkCommunicator::PackDataObject(vtkDataObject *object,
+                                    vtkCharArray *buffer)
+{
+  buffer->Initialize();
+  buffer->SetNumberOfComponents(1);
+  if (object == NULL)
+    {
+    buffer->SetNumberOfTuples(0);
+    return 1;
+    }
+
+  vtkTypeInt64 prefix[2];
+  if (vtkCommunicatorMarshaler::CanMarshal(object))
+    {
+    vtkCommunicatorMarshaler marshaler;
+    marshaler.Marshal(object);
+    std::vector<unsigned char> header;
+    marshaler.Header.GetRawData(header);
+    prefix[0] = vtkCommunicatorBinaryFormat;
+    prefix[1] = static_cast<vtkTypeInt64>(header.size());
+    vtkTypeInt64 headerSize = vtkCommunicatorPadSize(prefix[1]);
+    buffer->SetNumberOfTuples(sizeof(prefix) + headerSize +
+                              marshaler.GetPackedArraysSize());
+    char* data = buffer->GetPointer(0);
+    memcpy(data, prefix, sizeof(prefix));
+    memset(data + sizeof(prefix), 0, headerSize);
+    if (!header.empty())
+      {
+      memcpy(data + sizeof(prefix), &header[0], header.size());
+      }
+    marshaler.PackArrays(data + sizeof(prefix) + headerSize);
+    return 1;
+    }
+
+  VTK_CREATE(vtkCharArray, string);
+  if (!vtkCommunicator::MarshalDataObject(object, string))
+    {
+    return 0;
+    }
+  prefix[0] = vtkCommunicatorStringFormat;
+  prefix[1] = string->GetNumberOfTuples();
+  buffer->SetNumberOfTuples(sizeof(prefix) + prefix[1]);
+  memcpy(buffer->GetPointer(0), prefix, sizeof(prefix));
+  if (prefix[1] > 0)
+    {
+    memcpy(buffer->GetPointer(sizeof(prefix)), string->GetPointer(0),
+           prefix[1]);
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::UnPackDataObject(vtkCharArray *buffer,
+                                      vtkDataObject *object)
+{
+  vtkTypeInt64 bufferSize = buffer->GetNumberOfTuples();
+  if (bufferSize <= 0)
+    {
+    return 1;
+    }
+  vtkTypeInt64 prefix[2];
+  if (bufferSize < static_cast<vtkTypeInt64>(sizeof(prefix)))
+    {
+    vtkGenericWarningMacro("Truncated data object buffer.");
+    return 0;
+    }
+  const char* data = buffer->GetPointer(0);
+  memcpy(prefix, data, sizeof(prefix));
+  data += sizeof(prefix);
+  bufferSize -= sizeof(prefix);
+  if (prefix[1] < 0 || prefix[1] > bufferSize)
+    {
+    vtkGenericWarningMacro("Truncated data object buffer.");
+    return 0;
+    }
+
+  if (prefix[0] == vtkCommunicatorBinaryFormat)
+    {
+    vtkTypeInt64 headerSize = vtkCommunicatorPadSize(prefix[1]);
+    if (headerSize > bufferSize)
+      {
+      vtkGenericWarningMacro("Truncated data object buffer.");
+      return 0;
+      }
+    vtkCommunicatorUnMarshaler unmarshaler(data + headerSize,
+                                           data + bufferSize);
+    unmarshaler.Header.SetRawData(
+      reinterpret_cast<const unsigned char*>(data),
+      static_cast<unsigned int>(prefix[1]));
+    return unmarshaler.UnMarshal(object);
+    }
+
+  VTK_CREATE(vtkCharArray, string);
+  string->SetArray(const_cast<char*>(data), prefix[1], 1);
+  return vtkCommunicator::UnMarshalDataObject(string, object);
+}
+
 // The processors are views as a heap tree. The root is the processor of
 // id 0.
 //-----------------------------------------------------------------------------
@@ -828,6 +1545,36 @@ int vtkCommunicator::BroadcastVoidArray(void *data, vtkIdType length,
 //-----------------------------------------------------------------------------
 int vtkCommunicator::Broadcast(vtkDataObject *data, int srcProcessId)
 {
+  int format = vtkCommunicatorStringFormat;
+  if (this->LocalProcessId == srcProcessId &&
+      vtkCommunicatorMarshaler::CanMarshal(data))
+    {
+    format = vtkCommunicatorBinaryFormat;
+    }
+  if (!this->Broadcast(&format, 1, srcProcessId))
+    {
+    return 0;
+    }
+  if (format == vtkCommunicatorBinaryFormat)
+    {
+    if (this->LocalProcessId == srcProcessId)
+      {
+      vtkCommunicatorMarshaler marshaler;
+      marshaler.Marshal(data);
+      if (!this->Broadcast(marshaler.Header, srcProcessId))
+        {
+        return 0;
+        }
+      return marshaler.SendArrays(this, srcProcessId, -1);
+      }
+    vtkCommunicatorUnMarshaler unmarshaler(this, srcProcessId, -1);
+    if (!this->Broadcast(unmarshaler.Header, srcProcessId))
+      {
+      return 0;
+      }
+    return unmarshaler.UnMarshal(data);
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (this->LocalProcessId == srcProcessId)
     {
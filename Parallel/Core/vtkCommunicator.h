@@ -70,7 +70,8 @@ public:
     SCATTER_TAG         = 13,
     SCATTERV_TAG        = 14,
     REDUCE_TAG          = 15,
-    BARRIER_TAG         = 16
+    BARRIER_TAG         = 16,
+    ALLTOALL_TAG        = 17
   };
 
   enum StandardOperations
@@ -119,6 +120,12 @@ public:
   // This method sends a data object to a destination.
   // Tag eliminates ambiguity
   // and is used to match sends to receives.
+  // Image data, rectilinear grids, structured grids, poly data and
+  // unstructured grids whose arrays are all vtkDataArrays (but not
+  // vtkBitArrays) are sent as a header describing them followed by the
+  // values of their arrays, sent straight from the arrays and received
+  // straight into the arrays of the destination.  Other data objects are
+  // marshaled into a string with MarshalDataObject().
   int Send(vtkDataObject* data, int remoteHandle, int tag);
 
   // Description:
@@ -830,11 +837,22 @@ public:
 
   // Description:
   // Convert a data object into a string that can be transmitted and vice versa.
-  // Returns 1 for success and 0 for failure.
+  // Returns 1 for success and 0 for failure.  Send, Receive and Broadcast
+  // only use them for the data objects that cannot be sent as raw arrays.
   // WARNING: This will only work for types that have a vtkDataWriter class.
   static int MarshalDataObject(vtkDataObject *object, vtkCharArray *buffer);
   static int UnMarshalDataObject(vtkCharArray *buffer, vtkDataObject *object);
 
+  // Description:
+  // Convert a data object into a single contiguous buffer and vice versa.
+  // Data sets that Send() transfers as raw arrays are packed as their
+  // header followed by the values of their arrays, other data objects are
+  // packed with MarshalDataObject().  This is meant for transfers that
+  // need the whole object in one message, such as non-blocking ones.
+  // Returns 1 for success and 0 for failure.
+  static int PackDataObject(vtkDataObject *object, vtkCharArray *buffer);
+  static int UnPackDataObject(vtkCharArray *buffer, vtkDataObject *object);
+
 protected:
 
   int WriteDataArray(vtkDataArray *object);
@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNonBlockingDataObjectExchange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestNonBlockingDataObjectExchange.cxx -- Tests non-blocking data
+// object transfers.
+//
+// .SECTION Description
+//  This test exchanges data objects between all the processes:
+//  (1) Each process passes an image to the next one with NoBlockSend and
+//      NoBlockReceive, and a table, which is packed as a string, to the
+//      previous one.  The receives are started before the sends, and are
+//      completed with WaitAll and then with WaitAny
+//  (2) Each process sends a poly data of a different size to every other
+//      process with AllToAll
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Poly data sent by process source to process destination.
+vtkSmartPointer<vtkPolyData> CreatePolyData(int source, int destination)
+{
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  vtkIdType numPoints = 10*(source + 1) + destination;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    points->InsertNextPoint(source, destination, i);
+    verts->InsertNextCell(1, &i);
+    ids->InsertNextValue(static_cast<int>(1000*source + i));
+    }
+  polyData->SetPoints(points.GetPointer());
+  polyData->SetVerts(verts.GetPointer());
+  polyData->GetCellData()->SetScalars(ids.GetPointer());
+  return polyData;
+}
+
+bool CheckPolyData(vtkDataObject* object, int source, int destination)
+{
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(object);
+  vtkIdType numPoints = 10*(source + 1) + destination;
+  if (!polyData || polyData->GetNumberOfPoints() != numPoints ||
+      polyData->GetNumberOfVerts() != numPoints)
+    {
+    return false;
+    }
+  vtkDataArray* ids = polyData->GetCellData()->GetScalars();
+  if (!ids || strcmp(ids->GetName(), "ids") != 0)
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    double* point = polyData->GetPoint(i);
+    if (point[0] != source || point[1] != destination || point[2] != i ||
+        ids->GetTuple1(i) != 1000*source + i)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestPointToPoint(vtkMPIController* controller, bool waitAny)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+  int next = (rank + 1) % numProcs;
+  int previous = (rank + numProcs - 1) % numProcs;
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 3, 1, 4, rank, rank + 2);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetValue(i, rank + 0.5*i);
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkTable> table;
+  vtkNew<vtkStringArray> names;
+  names->SetName("names");
+  names->InsertNextValue("rank");
+  names->InsertNextValue(rank % 2? "odd" : "even");
+  table->AddColumn(names.GetPointer());
+
+  // Every process starts its receives before its sends, which must not
+  // wait for the other processes.
+  vtkMPICommunicator::Request requests[4];
+  vtkNew<vtkImageData> recvImage;
+  vtkNew<vtkTable> recvTable;
+  bool ok =
+    controller->NoBlockReceive(recvImage.GetPointer(), previous, 11,
+                               requests[0]) &&
+    controller->NoBlockReceive(recvTable.GetPointer(), next, 12,
+                               requests[1]) &&
+    controller->NoBlockSend(image.GetPointer(), next, 11, requests[2]) &&
+    controller->NoBlockSend(table.GetPointer(), previous, 12, requests[3]);
+  if (ok && waitAny)
+    {
+    for (int i = 0; ok && i < 4; ++i)
+      {
+      int idx;
+      ok = (controller->WaitAny(4, requests, idx) != 0);
+      }
+    }
+  else if (ok)
+    {
+    ok = (controller->WaitAll(4, requests) != 0);
+    }
+  if (!ok)
+    {
+    cerr << "ERROR: non-blocking data object transfer failed!\n";
+    return false;
+    }
+
+  int* extent = recvImage->GetExtent();
+  vtkDataArray* recvScalars = recvImage->GetPointData()->GetScalars();
+  if (extent[4] != previous || extent[5] != previous + 2 || !recvScalars ||
+      recvScalars->GetNumberOfTuples() != scalars->GetNumberOfTuples() ||
+      recvScalars->GetTuple1(5) != previous + 2.5)
+    {
+    cerr << "ERROR: received image does not match the one sent!\n";
+    return false;
+    }
+  vtkStringArray* recvNames =
+    vtkStringArray::SafeDownCast(recvTable->GetColumnByName("names"));
+  if (!recvNames || recvNames->GetNumberOfValues() != 2 ||
+      recvNames->GetValue(1) != (next % 2? "odd" : "even"))
+    {
+    cerr << "ERROR: received table does not match the one sent!\n";
+    return false;
+    }
+  return true;
+}
+
+bool TestAllToAll(vtkMPIController* controller)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  // The last process sends nothing to the first one.
+  std::vector<vtkSmartPointer<vtkPolyData> > sent(numProcs);
+  std::vector<vtkSmartPointer<vtkPolyData> > received(numProcs);
+  std::vector<vtkDataObject*> sendObjects(numProcs);
+  std::vector<vtkDataObject*> recvObjects(numProcs);
+  for (int i = 0; i < numProcs; ++i)
+    {
+    if (rank != numProcs - 1 || i != 0)
+      {
+      sent[i] = CreatePolyData(rank, i);
+      }
+    received[i] = vtkSmartPointer<vtkPolyData>::New();
+    sendObjects[i] = sent[i];
+    recvObjects[i] = received[i];
+    }
+  if (!controller->AllToAll(&sendObjects[0], &recvObjects[0]))
+    {
+    cerr << "ERROR: AllToAll failed!\n";
+    return false;
+    }
+
+  for (int i = 0; i < numProcs; ++i)
+    {
+    bool ok = (i == numProcs - 1 && rank == 0) ?
+      received[i]->GetNumberOfPoints() == 0 :
+      CheckPolyData(received[i], i, rank);
+    if (!ok)
+      {
+      cerr << "ERROR: poly data received from " << i
+           << " does not match the one sent!\n";
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestNonBlockingDataObjectExchange( int argc, char *argv[] )
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->Initialize( &argc, &argv, 0);
+
+  // Both tests run on every process, AllToAll being collective.
+  int ok = TestPointToPoint(controller, false);
+  ok = TestPointToPoint(controller, true) && ok;
+  ok = TestAllToAll(controller) && ok;
+  int allOk = 0;
+  controller->AllReduce(&ok, &allOk, 1, vtkCommunicator::MIN_OP);
+
+  controller->Finalize();
+  controller->Delete();
+
+  return allOk? 0 : 1;
+}
@@ -26,6 +26,10 @@
 #endif
 
 #include "vtkSystemIncludes.h"
+#include "vtkSmartPointer.h" // For vtkMPICommunicatorOpaqueRequest
+
+class vtkCharArray;
+class vtkDataObject;
 
 class VTKPARALLELMPI_EXPORT vtkMPICommunicatorOpaqueComm
 {
@@ -64,7 +68,18 @@ public:
 class vtkMPICommunicatorOpaqueRequest
 {
 public:
+  vtkMPICommunicatorOpaqueRequest()
+    : Handle(MPI_REQUEST_NULL), ProbeSource(0), ProbeTag(0), ProbeComm(0) { }
   MPI_Request Handle;
+  // The packed data object of a data object transfer, and the object a
+  // data object receive unpacks it into once it completes.
+  vtkSmartPointer<vtkCharArray> Buffer;
+  vtkSmartPointer<vtkDataObject> Object;
+  // The message a data object receive waits for while its size is not
+  // known.  ProbeComm is NULL once the receive is posted in Handle.
+  int ProbeSource;
+  int ProbeTag;
+  MPI_Comm* ProbeComm;
 };
 
 
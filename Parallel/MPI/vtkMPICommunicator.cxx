@@ -15,6 +15,8 @@
 
 #include "vtkMPICommunicator.h"
 
+#include "vtkCharArray.h"
+#include "vtkDataObject.h"
 #include "vtkImageData.h"
 #include "vtkMPIController.h"
 //#include "vtkMPIGroup.h"
@@ -305,6 +307,107 @@ int vtkMPICommunicatorNoBlockReceiveData(T* data, int length,
                    *(Handle), &req.Req->Handle);
 }
 //----------------------------------------------------------------------------
+// Start receiving a packed data object of the given size.
+static int vtkMPICommunicatorNoBlockReceiveDataObject(
+  vtkDataObject* data, int size, int remoteProcessId, int tag,
+  vtkMPICommunicator::Request& req, MPI_Comm *Handle)
+{
+  VTK_CREATE(vtkCharArray, buffer);
+  buffer->SetNumberOfTuples(size);
+  req.Req->Buffer = buffer;
+  req.Req->Object = data;
+  return MPI_Irecv(buffer->GetPointer(0), size, MPI_CHAR, remoteProcessId,
+                   tag, *(Handle), &req.Req->Handle);
+}
+//----------------------------------------------------------------------------
+// Release the packed data object of a completed request, unpacking it first
+// for data object receives.
+static int vtkMPICommunicatorFinishRequest(vtkMPICommunicator::Request& req)
+{
+  int result = 1;
+  if (req.Req->Object)
+    {
+    result = vtkCommunicator::UnPackDataObject(req.Req->Buffer,
+                                               req.Req->Object);
+    }
+  req.Req->Object = 0;
+  req.Req->Buffer = 0;
+  return result;
+}
+//----------------------------------------------------------------------------
+// Post the receive of a data object request once its message has arrived,
+// which gives the size of the packed object.  With block set, wait for the
+// message to arrive.
+static int vtkMPICommunicatorPostReceive(vtkMPICommunicator::Request& req,
+                                         int block)
+{
+  vtkMPICommunicatorOpaqueRequest* r = req.Req;
+  if (!r->ProbeComm)
+    {
+    return MPI_SUCCESS;
+    }
+  MPI_Status status;
+  int flag = 1;
+  int err = block ?
+    MPI_Probe(r->ProbeSource, r->ProbeTag, *r->ProbeComm, &status) :
+    MPI_Iprobe(r->ProbeSource, r->ProbeTag, *r->ProbeComm, &flag, &status);
+  int size;
+  if (err != MPI_SUCCESS || !flag ||
+      (err = MPI_Get_count(&status, MPI_CHAR, &size)) != MPI_SUCCESS)
+    {
+    return err;
+    }
+  MPI_Comm* comm = r->ProbeComm;
+  r->ProbeComm = 0;
+  // Receive the probed message, even from ANY_SOURCE.
+  return vtkMPICommunicatorNoBlockReceiveDataObject(
+    r->Object, size, status.MPI_SOURCE, r->ProbeTag, req, comm);
+}
+//----------------------------------------------------------------------------
+// Post the receives of the data object requests whose message has arrived,
+// and count the ones that are still waiting for it.
+static int vtkMPICommunicatorPostReceives(
+  int count, vtkMPICommunicator::Request requests[], int& numProbing)
+{
+  numProbing = 0;
+  for (int i = 0; i < count; ++i)
+    {
+    int err = vtkMPICommunicatorPostReceive(requests[i], 0);
+    if (err != MPI_SUCCESS)
+      {
+      return err;
+      }
+    if (requests[i].Req->ProbeComm)
+      {
+      ++numProbing;
+      }
+    }
+  return MPI_SUCCESS;
+}
+//----------------------------------------------------------------------------
+// Copy back the handles of requests completed by an MPI_Wait/Test function,
+// which sets them to MPI_REQUEST_NULL, and finish the completed ones.
+static int vtkMPICommunicatorUpdateRequests(
+  int count, vtkMPICommunicator::Request requests[], MPI_Request* r,
+  int numCompleted, int* completed)
+{
+  int result = 1;
+  for (int i = 0; i < count; ++i)
+    {
+    requests[i].Req->Handle = r[i];
+    }
+  for (int i = 0; i < numCompleted; ++i)
+    {
+    int idx = completed? completed[i] : i;
+    if (idx >= 0 && idx < count &&
+        !vtkMPICommunicatorFinishRequest(requests[idx]))
+      {
+      result = 0;
+      }
+    }
+  return result;
+}
+//----------------------------------------------------------------------------
 int vtkMPICommunicatorReduceData(const void *sendBuffer, void *recvBuffer,
                                  vtkIdType length, int type,
                                  MPI_Op operation, int destProcessId,
@@ -1037,6 +1140,148 @@ int vtkMPICommunicator::NoBlockReceive(vtkIdType* data, int length,
 }
 #endif
 
+//----------------------------------------------------------------------------
+int vtkMPICommunicator::NoBlockSend(vtkDataObject* data, int remoteProcessId,
+                                    int tag, Request& req)
+{
+  VTK_CREATE(vtkCharArray, buffer);
+  if (!vtkCommunicator::PackDataObject(data, buffer))
+    {
+    return 0;
+    }
+  vtkIdType size = buffer->GetNumberOfTuples();
+  if (size > VTK_INT_MAX)
+    {
+    vtkErrorMacro(<< data->GetClassName() << " of " << size
+                  << " bytes is too large to be sent in one message.");
+    return 0;
+    }
+  req.Req->Buffer = buffer;
+  req.Req->Object = 0;
+  return CheckForMPIError(
+    vtkMPICommunicatorNoBlockSendData(buffer->GetPointer(0),
+                                      static_cast<int>(size),
+                                      remoteProcessId, tag, MPI_CHAR, req,
+                                      this->MPIComm->Handle));
+}
+
+//----------------------------------------------------------------------------
+int vtkMPICommunicator::NoBlockReceive(vtkDataObject* data,
+                                       int remoteProcessId, int tag,
+                                       Request& req)
+{
+  if (!data)
+    {
+    vtkErrorMacro("Cannot receive into a NULL data object.");
+    return 0;
+    }
+  if (remoteProcessId == vtkMultiProcessController::ANY_SOURCE)
+    {
+    remoteProcessId = MPI_ANY_SOURCE;
+    }
+
+  // The size of the packed object is only known once the message has
+  // arrived, so the receive is posted by the first Wait or Test call that
+  // finds it, unless it is already there.
+  req.Req->Handle = MPI_REQUEST_NULL;
+  req.Req->Buffer = 0;
+  req.Req->Object = data;
+  req.Req->ProbeSource = remoteProcessId;
+  req.Req->ProbeTag = tag;
+  req.Req->ProbeComm = this->MPIComm->Handle;
+  return CheckForMPIError(vtkMPICommunicatorPostReceive(req, 0));
+}
+
+//----------------------------------------------------------------------------
+int vtkMPICommunicator::AllToAll(vtkDataObject** sendObjects,
+                                 vtkDataObject** recvObjects)
+{
+  int numProcs = this->NumberOfProcesses;
+  int localId = this->LocalProcessId;
+  int result = 1;
+
+  // Start the sends as soon as each object is packed.  Receivers learn the
+  // sizes of the packed objects from a single MPI_Alltoall.
+  std::vector<Request> sends(numProcs);
+  std::vector<int> sendSizes(numProcs, 0);
+  std::vector<int> recvSizes(numProcs, 0);
+  for (int i = 0; i < numProcs; ++i)
+    {
+    if (i == localId || !sendObjects[i])
+      {
+      continue;
+      }
+    if (!this->NoBlockSend(sendObjects[i], i, ALLTOALL_TAG, sends[i]))
+      {
+      result = 0;
+      continue;
+      }
+    sendSizes[i] =
+      static_cast<int>(sends[i].Req->Buffer->GetNumberOfTuples());
+    }
+  if (!CheckForMPIError(MPI_Alltoall(&sendSizes[0], 1, MPI_INT,
+                                     &recvSizes[0], 1, MPI_INT,
+                                     *this->MPIComm->Handle)))
+    {
+    return 0;
+    }
+
+  std::vector<Request> receives;
+  receives.reserve(numProcs);
+  for (int i = 0; i < numProcs; ++i)
+    {
+    if (i == localId)
+      {
+      continue;
+      }
+    if (recvSizes[i] > 0)
+      {
+      receives.push_back(Request());
+      if (!CheckForMPIError(
+            vtkMPICommunicatorNoBlockReceiveDataObject(
+              recvObjects[i], recvSizes[i], i, ALLTOALL_TAG,
+              receives.back(), this->MPIComm->Handle)))
+        {
+        result = 0;
+        }
+      }
+    else if (recvObjects[i])
+      {
+      recvObjects[i]->Initialize();
+      }
+    }
+
+  // The local object does not go through MPI.
+  if (recvObjects[localId] && recvObjects[localId] != sendObjects[localId])
+    {
+    if (sendObjects[localId])
+      {
+      recvObjects[localId]->ShallowCopy(sendObjects[localId]);
+      }
+    else
+      {
+      recvObjects[localId]->Initialize();
+      }
+    }
+
+  // Unpack the objects in the order they arrive.
+  int numReceives = static_cast<int>(receives.size());
+  for (int i = 0; i < numReceives; ++i)
+    {
+    int idx;
+    if (!this->WaitAny(numReceives, &receives[0], idx))
+      {
+      result = 0;
+      }
+    }
+  int numSends = static_cast<int>(sends.size());
+  if (numSends > 0 && !this->WaitAll(numSends, &sends[0]))
+    {
+    result = 0;
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 vtkMPICommunicator::Request::Request()
 {
@@ -1047,7 +1292,7 @@ vtkMPICommunicator::Request::Request()
 vtkMPICommunicator::Request::Request( const vtkMPICommunicator::Request& src )
 {
   this->Req = new vtkMPICommunicatorOpaqueRequest;
-  this->Req->Handle = src.Req->Handle;
+  *this->Req = *src.Req;
 }
 
 //----------------------------------------------------------------------------
@@ -1057,7 +1302,7 @@ vtkMPICommunicator::Request& vtkMPICommunicator::Request::operator = ( const vtk
     {
     return *this;
     }
-  this->Req->Handle = src.Req->Handle;
+  *this->Req = *src.Req;
   return *this;
 }
 
@@ -1071,12 +1316,20 @@ vtkMPICommunicator::Request::~Request()
 int vtkMPICommunicator::Request::Test()
 {
   MPI_Status status;
-  int retVal;
+  int retVal = 0;
 
-  int err = MPI_Test(&this->Req->Handle, &retVal, &status);
+  int err = vtkMPICommunicatorPostReceive(*this, 0);
+  if ( err == MPI_SUCCESS && !this->Req->ProbeComm )
+    {
+    err = MPI_Test(&this->Req->Handle, &retVal, &status);
+    }
 
   if ( err == MPI_SUCCESS )
     {
+    if ( retVal )
+      {
+      vtkMPICommunicatorFinishRequest(*this);
+      }
     return retVal;
     }
   else
@@ -1093,19 +1346,33 @@ void vtkMPICommunicator::Request::Wait()
 {
   MPI_Status status;
 
-  int err = MPI_Wait(&this->Req->Handle, &status);
+  int err = vtkMPICommunicatorPostReceive(*this, 1);
+  if ( err == MPI_SUCCESS )
+    {
+    err = MPI_Wait(&this->Req->Handle, &status);
+    }
 
   if ( err != MPI_SUCCESS )
     {
     char *msg = vtkMPIController::ErrorString(err);
     vtkGenericWarningMacro("MPI error occurred: " << msg);
     delete[] msg;
+    return;
     }
+  vtkMPICommunicatorFinishRequest(*this);
 }
 
 //----------------------------------------------------------------------------
 void vtkMPICommunicator::Request::Cancel()
 {
+  // A data object receive that is not posted yet has nothing to cancel.
+  if ( this->Req->ProbeComm )
+    {
+    this->Req->ProbeComm = 0;
+    this->Req->Object = 0;
+    return;
+    }
+
   int err = MPI_Cancel(&this->Req->Handle);
 
   if ( err != MPI_SUCCESS )
@@ -1123,6 +1390,9 @@ void vtkMPICommunicator::Request::Cancel()
     vtkGenericWarningMacro("MPI error occurred: " << msg);
     delete[] msg;
     }
+
+  this->Req->Buffer = 0;
+  this->Req->Object = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1496,6 +1766,14 @@ int vtkMPICommunicator::WaitAll(const int count, Request requests[])
     return -1;
     }
 
+  for( int i=0; i < count; ++i )
+    {
+    if( !CheckForMPIError( vtkMPICommunicatorPostReceive( requests[i], 1 ) ) )
+      {
+      return 0;
+      }
+    }
+
   MPI_Request *r = new MPI_Request[count];
   for( int i=0; i < count; ++i )
     {
@@ -1503,6 +1781,11 @@ int vtkMPICommunicator::WaitAll(const int count, Request requests[])
     }
 
   int rc = CheckForMPIError( MPI_Waitall( count, r, MPI_STATUSES_IGNORE) );
+  if( rc &&
+      !vtkMPICommunicatorUpdateRequests( count, requests, r, count, NULL ) )
+    {
+    rc = 0;
+    }
   delete [] r;
   return rc;
 }
@@ -1515,15 +1798,43 @@ int vtkMPICommunicator::WaitAny(const int count, Request requests[], int& idx )
     return 0;
     }
 
+  // Data object receives are posted as their messages arrive; until they
+  // all are, poll the requests instead of blocking in MPI_Waitany.
   MPI_Request *r = new MPI_Request[count];
-  for( int i=0; i < count; ++i )
+  int rc;
+  for(;;)
     {
-    r[ i ] = requests[ i ].Req->Handle;
+    int numProbing;
+    rc = CheckForMPIError(
+      vtkMPICommunicatorPostReceives( count, requests, numProbing ) );
+    if( !rc )
+      {
+      delete [] r;
+      return 0;
+      }
+    for( int i=0; i < count; ++i )
+      {
+      r[ i ] = requests[ i ].Req->Handle;
+      }
+    if( numProbing == 0 )
+      {
+      rc = CheckForMPIError( MPI_Waitany( count, r, &idx, MPI_STATUS_IGNORE ) );
+      break;
+      }
+    int flag;
+    rc = CheckForMPIError(
+      MPI_Testany( count, r, &idx, &flag, MPI_STATUS_IGNORE ) );
+    if( !rc || ( flag && idx != MPI_UNDEFINED ) )
+      {
+      break;
+      }
     }
-
-  int rc = CheckForMPIError( MPI_Waitany( count, r, &idx, MPI_STATUS_IGNORE ) );
   assert( "post: index from MPI_Waitany is out-of-bounds!" &&
           (idx >= 0) && (idx < count) );
+  if( rc && !vtkMPICommunicatorUpdateRequests( count, requests, r, 1, &idx ) )
+    {
+    rc = 0;
+    }
   delete [] r;
   return( rc );
 }
@@ -1537,14 +1848,42 @@ int vtkMPICommunicator::WaitSome(
     return 0;
     }
 
+  // As in WaitAny, poll until all the data object receives are posted.
   MPI_Request *r = new MPI_Request[count];
-  for( int i=0; i < count; ++i )
+  int rc;
+  for(;;)
     {
-    r[ i ] = requests[ i ].Req->Handle;
+    int numProbing;
+    rc = CheckForMPIError(
+      vtkMPICommunicatorPostReceives( count, requests, numProbing ) );
+    if( !rc )
+      {
+      delete [] r;
+      return 0;
+      }
+    for( int i=0; i < count; ++i )
+      {
+      r[ i ] = requests[ i ].Req->Handle;
+      }
+    if( numProbing == 0 )
+      {
+      rc = CheckForMPIError(
+        MPI_Waitsome(count,r,&NCompleted,completed,MPI_STATUSES_IGNORE) );
+      break;
+      }
+    rc = CheckForMPIError(
+      MPI_Testsome(count,r,&NCompleted,completed,MPI_STATUSES_IGNORE) );
+    if( !rc || ( NCompleted > 0 && NCompleted != MPI_UNDEFINED ) )
+      {
+      break;
+      }
+    }
+  if( rc && NCompleted != MPI_UNDEFINED &&
+      !vtkMPICommunicatorUpdateRequests(
+        count, requests, r, NCompleted, completed ) )
+    {
+    rc = 0;
     }
-
-  int rc = CheckForMPIError(
-      MPI_Waitsome(count,r,&NCompleted,completed,MPI_STATUSES_IGNORE) );
   delete [] r;
   return( rc );
 }
@@ -1559,6 +1898,19 @@ int vtkMPICommunicator::TestAll(
     return 0;
     }
 
+  int numProbing;
+  if( !CheckForMPIError(
+        vtkMPICommunicatorPostReceives( count, requests, numProbing ) ) )
+    {
+    flag = 0;
+    return 0;
+    }
+  if( numProbing > 0 )
+    {
+    flag = 0;
+    return 1;
+    }
+
   MPI_Request *r = new MPI_Request[count];
   for( int i=0; i < count; ++i )
     {
@@ -1566,6 +1918,11 @@ int vtkMPICommunicator::TestAll(
     }
 
   int rc = CheckForMPIError(MPI_Testall(count, r, &flag, MPI_STATUSES_IGNORE));
+  if( rc && flag &&
+      !vtkMPICommunicatorUpdateRequests( count, requests, r, count, NULL ) )
+    {
+    rc = 0;
+    }
   delete [] r;
   return( rc );
 }
@@ -1580,6 +1937,14 @@ int vtkMPICommunicator::TestAny(
     return 0;
     }
 
+  int numProbing;
+  if( !CheckForMPIError(
+        vtkMPICommunicatorPostReceives( count, requests, numProbing ) ) )
+    {
+    flag = 0;
+    return 0;
+    }
+
   MPI_Request *r = new MPI_Request[count];
   for( int i=0; i < count; ++i )
     {
@@ -1587,6 +1952,16 @@ int vtkMPICommunicator::TestAny(
     }
 
   int rc = CheckForMPIError(MPI_Testany(count,r,&idx,&flag,MPI_STATUS_IGNORE));
+  // The data object receives that are not posted yet are not complete.
+  if( rc && flag && idx == MPI_UNDEFINED && numProbing > 0 )
+    {
+    flag = 0;
+    }
+  if( rc && flag && idx != MPI_UNDEFINED &&
+      !vtkMPICommunicatorUpdateRequests( count, requests, r, 1, &idx ) )
+    {
+    rc = 0;
+    }
   delete [] r;
   return( rc );
 }
@@ -1601,6 +1976,14 @@ int vtkMPICommunicator::TestSome( const int count, Request requests[],
     return 0;
     }
 
+  int numProbing;
+  if( !CheckForMPIError(
+        vtkMPICommunicatorPostReceives( count, requests, numProbing ) ) )
+    {
+    NCompleted = 0;
+    return 0;
+    }
+
   MPI_Request *r = new MPI_Request[count];
   for( int i=0; i < count; ++i )
     {
@@ -1609,6 +1992,16 @@ int vtkMPICommunicator::TestSome( const int count, Request requests[],
 
   int rc = CheckForMPIError(
       MPI_Testsome(count,r,&NCompleted,completed,MPI_STATUSES_IGNORE) );
+  if( rc && NCompleted == MPI_UNDEFINED && numProbing > 0 )
+    {
+    NCompleted = 0;
+    }
+  if( rc && NCompleted != MPI_UNDEFINED &&
+      !vtkMPICommunicatorUpdateRequests(
+        count, requests, r, NCompleted, completed ) )
+    {
+    rc = 0;
+    }
   delete [] r;
   return( rc );
 }
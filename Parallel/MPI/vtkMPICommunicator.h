@@ -139,6 +139,36 @@ public:
                      int tag, Request& req);
 #endif
 
+  // Description:
+  // Non-blocking transfer of a data object.  NoBlockSend packs the object
+  // with vtkCommunicator::PackDataObject() and starts sending it as a
+  // single message, so it can be modified once the call returns.
+  // NoBlockReceive does not wait for the message: since its size is not
+  // known in advance, the receive is posted by the first Wait(), Test()
+  // or Wait/Test method below that finds the message has arrived, and
+  // the object is unpacked into data when req completes.  Data object
+  // receives with the same source and tag are therefore matched in the
+  // order they are waited for rather than posted.  The packed object is
+  // held by req, which must be kept until it completes.  Messages sent by
+  // NoBlockSend(vtkDataObject*) can only be received by
+  // NoBlockReceive(vtkDataObject*).  Return values are 1 for success and
+  // 0 otherwise.
+  int NoBlockSend(vtkDataObject* data, int remoteProcessId, int tag,
+                  Request& req);
+  int NoBlockReceive(vtkDataObject* data, int remoteProcessId, int tag,
+                     Request& req);
+
+  // Description:
+  // Exchange data objects between all the processes of the communicator.
+  // Both arrays have one entry per process: sendObjects[i] is sent to
+  // process i (nothing is sent if it is NULL) and recvObjects[i] receives
+  // the object process i sent to this one (it is initialized if none was
+  // sent, and the object is dropped if the entry is NULL).  All the
+  // transfers are started at once, and each received object is unpacked
+  // as soon as it arrives while the others are still in flight.  This is
+  // a collective operation.  Returns 1 for success and 0 otherwise.
+  int AllToAll(vtkDataObject** sendObjects, vtkDataObject** recvObjects);
+
 
   // Description:
   // More efficient implementations of collective operations that use
@@ -199,6 +229,8 @@ public:
   // Description:
   // Given the request objects of a set of non-blocking operations
   // (send and/or receive) this method blocks until all requests are complete.
+  // The Wait and Test methods mark the requests that complete as inactive,
+  // and unpack the data objects of the data object receives among them.
   int WaitAll(const int count, Request requests[]);
 
   // Description:
@@ -197,6 +197,29 @@ public:
         (data, length, remoteProcessId, tag, req); }
 #endif
 
+  // Description:
+  // Non-blocking transfer of a data object packed in a single message.
+  // The received object is unpacked when req completes.  See
+  // vtkMPICommunicator::NoBlockSend(vtkDataObject*, ...).
+  // Note: These methods delegate to the communicator
+  int NoBlockSend(vtkDataObject* data, int remoteProcessId, int tag,
+                  vtkMPICommunicator::Request& req)
+    { return ((vtkMPICommunicator*)this->Communicator)->NoBlockSend
+        (data, remoteProcessId, tag, req); }
+  int NoBlockReceive(vtkDataObject* data, int remoteProcessId, int tag,
+                     vtkMPICommunicator::Request& req)
+    { return ((vtkMPICommunicator*)this->Communicator)->NoBlockReceive
+        (data, remoteProcessId, tag, req); }
+
+  // Description:
+  // Exchange one data object with every process, overlapping the
+  // transfers with the unpacking of the objects already received.  See
+  // vtkMPICommunicator::AllToAll().
+  // Note: This method delegates to the communicator
+  int AllToAll(vtkDataObject** sendObjects, vtkDataObject** recvObjects)
+    { return ((vtkMPICommunicator*)this->Communicator)->AllToAll
+        (sendObjects, recvObjects); }
+
   // Description:
   // Nonblocking test for a message.  Inputs are: source -- the source rank
   // or ANY_SOURCE; tag -- the tag value.  Outputs are:
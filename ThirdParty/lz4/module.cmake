@@ -0,0 +1 @@
+vtk_module(vtklz4 EXCLUDE_FROM_WRAPPING)
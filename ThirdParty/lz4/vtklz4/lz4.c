@@ -0,0 +1,324 @@
+/*
+ *  LZ4 block compression and decompression for VTK.
+ *
+ *  This file implements the subset of the lz4.h block API used by VTK:
+ *  LZ4_versionNumber, LZ4_versionString, LZ4_compressBound,
+ *  LZ4_compress_default, LZ4_compress_fast and LZ4_decompress_safe.  It
+ *  reads and writes the standard LZ4 block format, so its output can be
+ *  decoded by the upstream library and the other way round.  See
+ *  README.Kitware.txt.
+ *
+ *  An LZ4 block is a list of sequences.  Each sequence starts with a token
+ *  whose high and low 4 bits hold the literal length and the match length
+ *  minus 4, followed by more length bytes when a field is 15, the literals,
+ *  and the 16-bit little endian offset of the match.  The last sequence
+ *  only has literals.
+ */
+#include "lz4.h"
+
+#include <string.h>
+
+#define VTK_LZ4_MIN_MATCH 4
+/* The last 5 bytes are always literals and the last match starts at least
+   12 bytes before the end of the block.  */
+#define VTK_LZ4_LAST_LITERALS 5
+#define VTK_LZ4_MATCH_FIND_LIMIT 12
+#define VTK_LZ4_MAX_DISTANCE 65535
+#define VTK_LZ4_HASH_LOG 12
+#define VTK_LZ4_SKIP_TRIGGER 6
+#define VTK_LZ4_ACCELERATION_MAX 65537
+
+static unsigned int vtkLZ4Read32(const unsigned char* p)
+{
+  unsigned int value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static unsigned int vtkLZ4Hash(unsigned int value)
+{
+  return (value * 2654435761U) >> (32 - VTK_LZ4_HASH_LOG);
+}
+
+static unsigned char* vtkLZ4WriteLength(unsigned char* op, size_t length)
+{
+  for (; length >= 255; length -= 255)
+    {
+    *op++ = 255;
+    }
+  *op++ = (unsigned char)length;
+  return op;
+}
+
+/* Write a sequence with the literals [literals, literals + numLiterals)
+   and, if matchLength is not 0, a match.  Return 0 if it does not fit.  */
+static unsigned char* vtkLZ4WriteSequence(unsigned char* op,
+                                          unsigned char* oend,
+                                          const unsigned char* literals,
+                                          size_t numLiterals, size_t offset,
+                                          size_t matchLength)
+{
+  unsigned char* token;
+  size_t needed = 1 + numLiterals / 255 + 1 + numLiterals;
+  if (matchLength)
+    {
+    needed += 2 + (matchLength - VTK_LZ4_MIN_MATCH) / 255 + 1;
+    }
+  if (needed > (size_t)(oend - op))
+    {
+    return 0;
+    }
+
+  token = op++;
+  if (numLiterals >= 15)
+    {
+    *token = 15 << 4;
+    op = vtkLZ4WriteLength(op, numLiterals - 15);
+    }
+  else
+    {
+    *token = (unsigned char)(numLiterals << 4);
+    }
+  memcpy(op, literals, numLiterals);
+  op += numLiterals;
+
+  if (matchLength)
+    {
+    size_t length = matchLength - VTK_LZ4_MIN_MATCH;
+    *op++ = (unsigned char)(offset & 0xff);
+    *op++ = (unsigned char)(offset >> 8);
+    if (length >= 15)
+      {
+      *token |= 15;
+      op = vtkLZ4WriteLength(op, length - 15);
+      }
+    else
+      {
+      *token |= (unsigned char)length;
+      }
+    }
+  return op;
+}
+
+/* Read the extra bytes of a length field.  Return 0 past the end.  */
+static int vtkLZ4ReadLength(const unsigned char** ip,
+                            const unsigned char* iend, size_t* length)
+{
+  unsigned char s;
+  do
+    {
+    if (*ip >= iend)
+      {
+      return 0;
+      }
+    s = *(*ip)++;
+    *length += s;
+    }
+  while (s == 255);
+  return 1;
+}
+
+int LZ4_versionNumber(void)
+{
+  return LZ4_VERSION_NUMBER;
+}
+
+const char* LZ4_versionString(void)
+{
+  return LZ4_VERSION_STRING;
+}
+
+int LZ4_compressBound(int inputSize)
+{
+  return LZ4_COMPRESSBOUND(inputSize);
+}
+
+int LZ4_compress_default(const char* src, char* dst, int srcSize,
+                         int dstCapacity)
+{
+  return LZ4_compress_fast(src, dst, srcSize, dstCapacity, 1);
+}
+
+int LZ4_compress_fast(const char* source, char* dest, int srcSize,
+                      int dstCapacity, int acceleration)
+{
+  const unsigned char* src = (const unsigned char*)source;
+  unsigned char* op = (unsigned char*)dest;
+  unsigned char* oend;
+  size_t size;
+  size_t anchor = 0;
+
+  if (srcSize < 0 || srcSize > LZ4_MAX_INPUT_SIZE || dstCapacity <= 0)
+    {
+    return 0;
+    }
+  if (acceleration < 1)
+    {
+    acceleration = 1;
+    }
+  if (acceleration > VTK_LZ4_ACCELERATION_MAX)
+    {
+    acceleration = VTK_LZ4_ACCELERATION_MAX;
+    }
+  size = (size_t)srcSize;
+  oend = op + dstCapacity;
+
+  /* Greedy parsing: hash the 4 bytes at each position, take the previous
+     position with the same hash when its 4 bytes match, and step faster
+     and faster through data that does not.  */
+  if (size > VTK_LZ4_MATCH_FIND_LIMIT)
+    {
+    const size_t matchFindLimit = size - VTK_LZ4_MATCH_FIND_LIMIT;
+    const size_t matchLimit = size - VTK_LZ4_LAST_LITERALS;
+    unsigned int table[1 << VTK_LZ4_HASH_LOG];
+    size_t ip = 1;
+    memset(table, 0, sizeof(table));
+
+    for (;;)
+      {
+      size_t ref = 0;
+      size_t length;
+      size_t searchCount = (size_t)acceleration << VTK_LZ4_SKIP_TRIGGER;
+      for (;;)
+        {
+        unsigned int sequence;
+        unsigned int* entry;
+        if (ip >= matchFindLimit)
+          {
+          break;
+          }
+        sequence = vtkLZ4Read32(src + ip);
+        entry = &table[vtkLZ4Hash(sequence)];
+        ref = *entry;
+        *entry = (unsigned int)ip;
+        if (ip - ref <= VTK_LZ4_MAX_DISTANCE &&
+            vtkLZ4Read32(src + ref) == sequence)
+          {
+          break;
+          }
+        ip += searchCount++ >> VTK_LZ4_SKIP_TRIGGER;
+        }
+      if (ip >= matchFindLimit)
+        {
+        break;
+        }
+
+      /* Extend the match in both directions.  */
+      while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+        {
+        --ip;
+        --ref;
+        }
+      length = VTK_LZ4_MIN_MATCH;
+      while (ip + length < matchLimit && src[ip + length] == src[ref + length])
+        {
+        ++length;
+        }
+
+      op = vtkLZ4WriteSequence(op, oend, src + anchor, ip - anchor,
+                               ip - ref, length);
+      if (!op)
+        {
+        return 0;
+        }
+      ip += length;
+      anchor = ip;
+      if (ip >= matchFindLimit)
+        {
+        break;
+        }
+      table[vtkLZ4Hash(vtkLZ4Read32(src + ip - 2))] = (unsigned int)(ip - 2);
+      }
+    }
+
+  op = vtkLZ4WriteSequence(op, oend, src + anchor, size - anchor, 0, 0);
+  if (!op)
+    {
+    return 0;
+    }
+  return (int)(op - (unsigned char*)dest);
+}
+
+int LZ4_decompress_safe(const char* source, char* dest, int compressedSize,
+                        int dstCapacity)
+{
+  const unsigned char* ip = (const unsigned char*)source;
+  const unsigned char* iend;
+  unsigned char* op = (unsigned char*)dest;
+  unsigned char* oend;
+
+  if (compressedSize <= 0 || dstCapacity < 0)
+    {
+    return -1;
+    }
+  iend = ip + compressedSize;
+  oend = op + dstCapacity;
+
+  for (;;)
+    {
+    unsigned int token;
+    size_t length;
+    size_t offset;
+    const unsigned char* match;
+
+    if (ip >= iend)
+      {
+      return -1;
+      }
+    token = *ip++;
+
+    /* Literals.  */
+    length = token >> 4;
+    if (length == 15 && !vtkLZ4ReadLength(&ip, iend, &length))
+      {
+      return -1;
+      }
+    if (length > (size_t)(iend - ip) || length > (size_t)(oend - op))
+      {
+      return -1;
+      }
+    memcpy(op, ip, length);
+    ip += length;
+    op += length;
+    if (ip == iend)
+      {
+      break;
+      }
+
+    /* Match.  */
+    if (iend - ip < 2)
+      {
+      return -1;
+      }
+    offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    length = token & 15;
+    if (length == 15 && !vtkLZ4ReadLength(&ip, iend, &length))
+      {
+      return -1;
+      }
+    length += VTK_LZ4_MIN_MATCH;
+    if (offset == 0 || offset > (size_t)(op - (unsigned char*)dest) ||
+        length > (size_t)(oend - op))
+      {
+      return -1;
+      }
+    match = op - offset;
+    if (offset >= length)
+      {
+      memcpy(op, match, length);
+      op += length;
+      }
+    else
+      {
+      /* Overlapping copy, repeats the last offset bytes.  */
+      size_t i;
+      for (i = 0; i < length; ++i)
+        {
+        *op++ = *match++;
+        }
+      }
+    }
+
+  return (int)(op - (unsigned char*)dest);
+}
@@ -0,0 +1,30 @@
+#ifndef vtk_lz4_mangle_h
+#define vtk_lz4_mangle_h
+
+/*
+
+This header file mangles all symbols exported from the lz4 library.
+It is included in all files while building the lz4 library.  Due to
+namespace pollution, no lz4 headers should be included in .h files in
+VTK.
+
+The following command was used to obtain the symbol list:
+
+nm libvtklz4.so |grep " [TRD] "
+
+This is the way to recreate the whole list:
+
+nm libvtklz4.so |grep " [TRD] " | awk '{ print "#define "$3" vtk_lz4_"$3 }'
+
+REMOVE the "_init" and "_fini" entries.
+
+*/
+
+#define LZ4_compressBound vtk_lz4_LZ4_compressBound
+#define LZ4_compress_default vtk_lz4_LZ4_compress_default
+#define LZ4_compress_fast vtk_lz4_LZ4_compress_fast
+#define LZ4_decompress_safe vtk_lz4_LZ4_decompress_safe
+#define LZ4_versionNumber vtk_lz4_LZ4_versionNumber
+#define LZ4_versionString vtk_lz4_LZ4_versionString
+
+#endif
@@ -0,0 +1,385 @@
+#ifndef vtk_zstd_mangle_h
+#define vtk_zstd_mangle_h
+
+/*
+
+This header file mangles all symbols exported from the zstd library.
+It is included in all files while building the zstd library.  Due to
+namespace pollution, no zstd headers should be included in .h files in
+VTK.
+
+The following command was used to obtain the symbol list:
+
+nm libvtkzstd.so |grep " [TRDB] "
+
+This is the way to recreate the whole list:
+
+nm libvtkzstd.so |grep " [TRDB] " | awk '{ print "#define "$3" vtk_zstd_"$3 }'
+
+REMOVE the "_init" and "_fini" entries.
+
+*/
+
+#define ERR_getErrorString vtk_zstd_ERR_getErrorString
+#define FSE_NCountWriteBound vtk_zstd_FSE_NCountWriteBound
+#define FSE_buildCTable_rle vtk_zstd_FSE_buildCTable_rle
+#define FSE_buildCTable_wksp vtk_zstd_FSE_buildCTable_wksp
+#define FSE_buildDTable_wksp vtk_zstd_FSE_buildDTable_wksp
+#define FSE_compressBound vtk_zstd_FSE_compressBound
+#define FSE_compress_usingCTable vtk_zstd_FSE_compress_usingCTable
+#define FSE_decompress_wksp_bmi2 vtk_zstd_FSE_decompress_wksp_bmi2
+#define FSE_getErrorName vtk_zstd_FSE_getErrorName
+#define FSE_isError vtk_zstd_FSE_isError
+#define FSE_normalizeCount vtk_zstd_FSE_normalizeCount
+#define FSE_optimalTableLog vtk_zstd_FSE_optimalTableLog
+#define FSE_optimalTableLog_internal vtk_zstd_FSE_optimalTableLog_internal
+#define FSE_readNCount vtk_zstd_FSE_readNCount
+#define FSE_readNCount_bmi2 vtk_zstd_FSE_readNCount_bmi2
+#define FSE_versionNumber vtk_zstd_FSE_versionNumber
+#define FSE_writeNCount vtk_zstd_FSE_writeNCount
+#define HIST_add vtk_zstd_HIST_add
+#define HIST_count vtk_zstd_HIST_count
+#define HIST_countFast vtk_zstd_HIST_countFast
+#define HIST_countFast_wksp vtk_zstd_HIST_countFast_wksp
+#define HIST_count_simple vtk_zstd_HIST_count_simple
+#define HIST_count_wksp vtk_zstd_HIST_count_wksp
+#define HIST_isError vtk_zstd_HIST_isError
+#define HUF_buildCTable_wksp vtk_zstd_HUF_buildCTable_wksp
+#define HUF_cardinality vtk_zstd_HUF_cardinality
+#define HUF_compress1X_repeat vtk_zstd_HUF_compress1X_repeat
+#define HUF_compress1X_usingCTable vtk_zstd_HUF_compress1X_usingCTable
+#define HUF_compress4X_repeat vtk_zstd_HUF_compress4X_repeat
+#define HUF_compress4X_usingCTable vtk_zstd_HUF_compress4X_usingCTable
+#define HUF_compressBound vtk_zstd_HUF_compressBound
+#define HUF_decompress1X1_DCtx_wksp vtk_zstd_HUF_decompress1X1_DCtx_wksp
+#define HUF_decompress1X2_DCtx_wksp vtk_zstd_HUF_decompress1X2_DCtx_wksp
+#define HUF_decompress1X_DCtx_wksp vtk_zstd_HUF_decompress1X_DCtx_wksp
+#define HUF_decompress1X_usingDTable vtk_zstd_HUF_decompress1X_usingDTable
+#define HUF_decompress4X_hufOnly_wksp vtk_zstd_HUF_decompress4X_hufOnly_wksp
+#define HUF_decompress4X_usingDTable vtk_zstd_HUF_decompress4X_usingDTable
+#define HUF_estimateCompressedSize vtk_zstd_HUF_estimateCompressedSize
+#define HUF_getErrorName vtk_zstd_HUF_getErrorName
+#define HUF_getNbBitsFromCTable vtk_zstd_HUF_getNbBitsFromCTable
+#define HUF_isError vtk_zstd_HUF_isError
+#define HUF_minTableLog vtk_zstd_HUF_minTableLog
+#define HUF_optimalTableLog vtk_zstd_HUF_optimalTableLog
+#define HUF_readCTable vtk_zstd_HUF_readCTable
+#define HUF_readCTableHeader vtk_zstd_HUF_readCTableHeader
+#define HUF_readDTableX1_wksp vtk_zstd_HUF_readDTableX1_wksp
+#define HUF_readDTableX2_wksp vtk_zstd_HUF_readDTableX2_wksp
+#define HUF_readStats vtk_zstd_HUF_readStats
+#define HUF_readStats_wksp vtk_zstd_HUF_readStats_wksp
+#define HUF_selectDecoder vtk_zstd_HUF_selectDecoder
+#define HUF_validateCTable vtk_zstd_HUF_validateCTable
+#define HUF_writeCTable_wksp vtk_zstd_HUF_writeCTable_wksp
+#define POOL_add vtk_zstd_POOL_add
+#define POOL_create vtk_zstd_POOL_create
+#define POOL_create_advanced vtk_zstd_POOL_create_advanced
+#define POOL_free vtk_zstd_POOL_free
+#define POOL_joinJobs vtk_zstd_POOL_joinJobs
+#define POOL_resize vtk_zstd_POOL_resize
+#define POOL_sizeof vtk_zstd_POOL_sizeof
+#define POOL_tryAdd vtk_zstd_POOL_tryAdd
+#define ZSTDMT_compressStream_generic vtk_zstd_ZSTDMT_compressStream_generic
+#define ZSTDMT_createCCtx_advanced vtk_zstd_ZSTDMT_createCCtx_advanced
+#define ZSTDMT_freeCCtx vtk_zstd_ZSTDMT_freeCCtx
+#define ZSTDMT_getFrameProgression vtk_zstd_ZSTDMT_getFrameProgression
+#define ZSTDMT_initCStream_internal vtk_zstd_ZSTDMT_initCStream_internal
+#define ZSTDMT_nextInputSizeHint vtk_zstd_ZSTDMT_nextInputSizeHint
+#define ZSTDMT_sizeof_CCtx vtk_zstd_ZSTDMT_sizeof_CCtx
+#define ZSTDMT_toFlushNow vtk_zstd_ZSTDMT_toFlushNow
+#define ZSTDMT_updateCParams_whileCompressing vtk_zstd_ZSTDMT_updateCParams_whileCompressing
+#define ZSTD_CCtxParams_getParameter vtk_zstd_ZSTD_CCtxParams_getParameter
+#define ZSTD_CCtxParams_init vtk_zstd_ZSTD_CCtxParams_init
+#define ZSTD_CCtxParams_init_advanced vtk_zstd_ZSTD_CCtxParams_init_advanced
+#define ZSTD_CCtxParams_registerSequenceProducer vtk_zstd_ZSTD_CCtxParams_registerSequenceProducer
+#define ZSTD_CCtxParams_reset vtk_zstd_ZSTD_CCtxParams_reset
+#define ZSTD_CCtxParams_setParameter vtk_zstd_ZSTD_CCtxParams_setParameter
+#define ZSTD_CCtx_getParameter vtk_zstd_ZSTD_CCtx_getParameter
+#define ZSTD_CCtx_loadDictionary vtk_zstd_ZSTD_CCtx_loadDictionary
+#define ZSTD_CCtx_loadDictionary_advanced vtk_zstd_ZSTD_CCtx_loadDictionary_advanced
+#define ZSTD_CCtx_loadDictionary_byReference vtk_zstd_ZSTD_CCtx_loadDictionary_byReference
+#define ZSTD_CCtx_refCDict vtk_zstd_ZSTD_CCtx_refCDict
+#define ZSTD_CCtx_refPrefix vtk_zstd_ZSTD_CCtx_refPrefix
+#define ZSTD_CCtx_refPrefix_advanced vtk_zstd_ZSTD_CCtx_refPrefix_advanced
+#define ZSTD_CCtx_refThreadPool vtk_zstd_ZSTD_CCtx_refThreadPool
+#define ZSTD_CCtx_reset vtk_zstd_ZSTD_CCtx_reset
+#define ZSTD_CCtx_setCParams vtk_zstd_ZSTD_CCtx_setCParams
+#define ZSTD_CCtx_setFParams vtk_zstd_ZSTD_CCtx_setFParams
+#define ZSTD_CCtx_setParameter vtk_zstd_ZSTD_CCtx_setParameter
+#define ZSTD_CCtx_setParametersUsingCCtxParams vtk_zstd_ZSTD_CCtx_setParametersUsingCCtxParams
+#define ZSTD_CCtx_setParams vtk_zstd_ZSTD_CCtx_setParams
+#define ZSTD_CCtx_setPledgedSrcSize vtk_zstd_ZSTD_CCtx_setPledgedSrcSize
+#define ZSTD_CCtx_trace vtk_zstd_ZSTD_CCtx_trace
+#define ZSTD_CStreamInSize vtk_zstd_ZSTD_CStreamInSize
+#define ZSTD_CStreamOutSize vtk_zstd_ZSTD_CStreamOutSize
+#define ZSTD_DCtx_getParameter vtk_zstd_ZSTD_DCtx_getParameter
+#define ZSTD_DCtx_loadDictionary vtk_zstd_ZSTD_DCtx_loadDictionary
+#define ZSTD_DCtx_loadDictionary_advanced vtk_zstd_ZSTD_DCtx_loadDictionary_advanced
+#define ZSTD_DCtx_loadDictionary_byReference vtk_zstd_ZSTD_DCtx_loadDictionary_byReference
+#define ZSTD_DCtx_refDDict vtk_zstd_ZSTD_DCtx_refDDict
+#define ZSTD_DCtx_refPrefix vtk_zstd_ZSTD_DCtx_refPrefix
+#define ZSTD_DCtx_refPrefix_advanced vtk_zstd_ZSTD_DCtx_refPrefix_advanced
+#define ZSTD_DCtx_reset vtk_zstd_ZSTD_DCtx_reset
+#define ZSTD_DCtx_setFormat vtk_zstd_ZSTD_DCtx_setFormat
+#define ZSTD_DCtx_setMaxWindowSize vtk_zstd_ZSTD_DCtx_setMaxWindowSize
+#define ZSTD_DCtx_setParameter vtk_zstd_ZSTD_DCtx_setParameter
+#define ZSTD_DDict_dictContent vtk_zstd_ZSTD_DDict_dictContent
+#define ZSTD_DDict_dictSize vtk_zstd_ZSTD_DDict_dictSize
+#define ZSTD_DStreamInSize vtk_zstd_ZSTD_DStreamInSize
+#define ZSTD_DStreamOutSize vtk_zstd_ZSTD_DStreamOutSize
+#define ZSTD_XXH32 vtk_zstd_ZSTD_XXH32
+#define ZSTD_XXH32_canonicalFromHash vtk_zstd_ZSTD_XXH32_canonicalFromHash
+#define ZSTD_XXH32_copyState vtk_zstd_ZSTD_XXH32_copyState
+#define ZSTD_XXH32_createState vtk_zstd_ZSTD_XXH32_createState
+#define ZSTD_XXH32_digest vtk_zstd_ZSTD_XXH32_digest
+#define ZSTD_XXH32_freeState vtk_zstd_ZSTD_XXH32_freeState
+#define ZSTD_XXH32_hashFromCanonical vtk_zstd_ZSTD_XXH32_hashFromCanonical
+#define ZSTD_XXH32_reset vtk_zstd_ZSTD_XXH32_reset
+#define ZSTD_XXH32_update vtk_zstd_ZSTD_XXH32_update
+#define ZSTD_XXH64 vtk_zstd_ZSTD_XXH64
+#define ZSTD_XXH64_canonicalFromHash vtk_zstd_ZSTD_XXH64_canonicalFromHash
+#define ZSTD_XXH64_copyState vtk_zstd_ZSTD_XXH64_copyState
+#define ZSTD_XXH64_createState vtk_zstd_ZSTD_XXH64_createState
+#define ZSTD_XXH64_digest vtk_zstd_ZSTD_XXH64_digest
+#define ZSTD_XXH64_freeState vtk_zstd_ZSTD_XXH64_freeState
+#define ZSTD_XXH64_hashFromCanonical vtk_zstd_ZSTD_XXH64_hashFromCanonical
+#define ZSTD_XXH64_reset vtk_zstd_ZSTD_XXH64_reset
+#define ZSTD_XXH64_update vtk_zstd_ZSTD_XXH64_update
+#define ZSTD_XXH_versionNumber vtk_zstd_ZSTD_XXH_versionNumber
+#define ZSTD_adjustCParams vtk_zstd_ZSTD_adjustCParams
+#define ZSTD_buildBlockEntropyStats vtk_zstd_ZSTD_buildBlockEntropyStats
+#define ZSTD_buildCTable vtk_zstd_ZSTD_buildCTable
+#define ZSTD_buildFSETable vtk_zstd_ZSTD_buildFSETable
+#define ZSTD_cParam_getBounds vtk_zstd_ZSTD_cParam_getBounds
+#define ZSTD_checkCParams vtk_zstd_ZSTD_checkCParams
+#define ZSTD_checkContinuity vtk_zstd_ZSTD_checkContinuity
+#define ZSTD_compress vtk_zstd_ZSTD_compress
+#define ZSTD_compress2 vtk_zstd_ZSTD_compress2
+#define ZSTD_compressBegin vtk_zstd_ZSTD_compressBegin
+#define ZSTD_compressBegin_advanced vtk_zstd_ZSTD_compressBegin_advanced
+#define ZSTD_compressBegin_advanced_internal vtk_zstd_ZSTD_compressBegin_advanced_internal
+#define ZSTD_compressBegin_usingCDict vtk_zstd_ZSTD_compressBegin_usingCDict
+#define ZSTD_compressBegin_usingCDict_advanced vtk_zstd_ZSTD_compressBegin_usingCDict_advanced
+#define ZSTD_compressBegin_usingCDict_deprecated vtk_zstd_ZSTD_compressBegin_usingCDict_deprecated
+#define ZSTD_compressBegin_usingDict vtk_zstd_ZSTD_compressBegin_usingDict
+#define ZSTD_compressBlock vtk_zstd_ZSTD_compressBlock
+#define ZSTD_compressBlock_btlazy2 vtk_zstd_ZSTD_compressBlock_btlazy2
+#define ZSTD_compressBlock_btlazy2_dictMatchState vtk_zstd_ZSTD_compressBlock_btlazy2_dictMatchState
+#define ZSTD_compressBlock_btlazy2_extDict vtk_zstd_ZSTD_compressBlock_btlazy2_extDict
+#define ZSTD_compressBlock_btopt vtk_zstd_ZSTD_compressBlock_btopt
+#define ZSTD_compressBlock_btopt_dictMatchState vtk_zstd_ZSTD_compressBlock_btopt_dictMatchState
+#define ZSTD_compressBlock_btopt_extDict vtk_zstd_ZSTD_compressBlock_btopt_extDict
+#define ZSTD_compressBlock_btultra vtk_zstd_ZSTD_compressBlock_btultra
+#define ZSTD_compressBlock_btultra2 vtk_zstd_ZSTD_compressBlock_btultra2
+#define ZSTD_compressBlock_btultra_dictMatchState vtk_zstd_ZSTD_compressBlock_btultra_dictMatchState
+#define ZSTD_compressBlock_btultra_extDict vtk_zstd_ZSTD_compressBlock_btultra_extDict
+#define ZSTD_compressBlock_deprecated vtk_zstd_ZSTD_compressBlock_deprecated
+#define ZSTD_compressBlock_doubleFast vtk_zstd_ZSTD_compressBlock_doubleFast
+#define ZSTD_compressBlock_doubleFast_dictMatchState vtk_zstd_ZSTD_compressBlock_doubleFast_dictMatchState
+#define ZSTD_compressBlock_doubleFast_extDict vtk_zstd_ZSTD_compressBlock_doubleFast_extDict
+#define ZSTD_compressBlock_fast vtk_zstd_ZSTD_compressBlock_fast
+#define ZSTD_compressBlock_fast_dictMatchState vtk_zstd_ZSTD_compressBlock_fast_dictMatchState
+#define ZSTD_compressBlock_fast_extDict vtk_zstd_ZSTD_compressBlock_fast_extDict
+#define ZSTD_compressBlock_greedy vtk_zstd_ZSTD_compressBlock_greedy
+#define ZSTD_compressBlock_greedy_dedicatedDictSearch vtk_zstd_ZSTD_compressBlock_greedy_dedicatedDictSearch
+#define ZSTD_compressBlock_greedy_dedicatedDictSearch_row vtk_zstd_ZSTD_compressBlock_greedy_dedicatedDictSearch_row
+#define ZSTD_compressBlock_greedy_dictMatchState vtk_zstd_ZSTD_compressBlock_greedy_dictMatchState
+#define ZSTD_compressBlock_greedy_dictMatchState_row vtk_zstd_ZSTD_compressBlock_greedy_dictMatchState_row
+#define ZSTD_compressBlock_greedy_extDict vtk_zstd_ZSTD_compressBlock_greedy_extDict
+#define ZSTD_compressBlock_greedy_extDict_row vtk_zstd_ZSTD_compressBlock_greedy_extDict_row
+#define ZSTD_compressBlock_greedy_row vtk_zstd_ZSTD_compressBlock_greedy_row
+#define ZSTD_compressBlock_lazy vtk_zstd_ZSTD_compressBlock_lazy
+#define ZSTD_compressBlock_lazy2 vtk_zstd_ZSTD_compressBlock_lazy2
+#define ZSTD_compressBlock_lazy2_dedicatedDictSearch vtk_zstd_ZSTD_compressBlock_lazy2_dedicatedDictSearch
+#define ZSTD_compressBlock_lazy2_dedicatedDictSearch_row vtk_zstd_ZSTD_compressBlock_lazy2_dedicatedDictSearch_row
+#define ZSTD_compressBlock_lazy2_dictMatchState vtk_zstd_ZSTD_compressBlock_lazy2_dictMatchState
+#define ZSTD_compressBlock_lazy2_dictMatchState_row vtk_zstd_ZSTD_compressBlock_lazy2_dictMatchState_row
+#define ZSTD_compressBlock_lazy2_extDict vtk_zstd_ZSTD_compressBlock_lazy2_extDict
+#define ZSTD_compressBlock_lazy2_extDict_row vtk_zstd_ZSTD_compressBlock_lazy2_extDict_row
+#define ZSTD_compressBlock_lazy2_row vtk_zstd_ZSTD_compressBlock_lazy2_row
+#define ZSTD_compressBlock_lazy_dedicatedDictSearch vtk_zstd_ZSTD_compressBlock_lazy_dedicatedDictSearch
+#define ZSTD_compressBlock_lazy_dedicatedDictSearch_row vtk_zstd_ZSTD_compressBlock_lazy_dedicatedDictSearch_row
+#define ZSTD_compressBlock_lazy_dictMatchState vtk_zstd_ZSTD_compressBlock_lazy_dictMatchState
+#define ZSTD_compressBlock_lazy_dictMatchState_row vtk_zstd_ZSTD_compressBlock_lazy_dictMatchState_row
+#define ZSTD_compressBlock_lazy_extDict vtk_zstd_ZSTD_compressBlock_lazy_extDict
+#define ZSTD_compressBlock_lazy_extDict_row vtk_zstd_ZSTD_compressBlock_lazy_extDict_row
+#define ZSTD_compressBlock_lazy_row vtk_zstd_ZSTD_compressBlock_lazy_row
+#define ZSTD_compressBound vtk_zstd_ZSTD_compressBound
+#define ZSTD_compressCCtx vtk_zstd_ZSTD_compressCCtx
+#define ZSTD_compressContinue vtk_zstd_ZSTD_compressContinue
+#define ZSTD_compressContinue_public vtk_zstd_ZSTD_compressContinue_public
+#define ZSTD_compressEnd vtk_zstd_ZSTD_compressEnd
+#define ZSTD_compressEnd_public vtk_zstd_ZSTD_compressEnd_public
+#define ZSTD_compressLiterals vtk_zstd_ZSTD_compressLiterals
+#define ZSTD_compressRleLiteralsBlock vtk_zstd_ZSTD_compressRleLiteralsBlock
+#define ZSTD_compressSequences vtk_zstd_ZSTD_compressSequences
+#define ZSTD_compressSequencesAndLiterals vtk_zstd_ZSTD_compressSequencesAndLiterals
+#define ZSTD_compressStream vtk_zstd_ZSTD_compressStream
+#define ZSTD_compressStream2 vtk_zstd_ZSTD_compressStream2
+#define ZSTD_compressStream2_simpleArgs vtk_zstd_ZSTD_compressStream2_simpleArgs
+#define ZSTD_compressSuperBlock vtk_zstd_ZSTD_compressSuperBlock
+#define ZSTD_compress_advanced vtk_zstd_ZSTD_compress_advanced
+#define ZSTD_compress_advanced_internal vtk_zstd_ZSTD_compress_advanced_internal
+#define ZSTD_compress_usingCDict vtk_zstd_ZSTD_compress_usingCDict
+#define ZSTD_compress_usingCDict_advanced vtk_zstd_ZSTD_compress_usingCDict_advanced
+#define ZSTD_compress_usingDict vtk_zstd_ZSTD_compress_usingDict
+#define ZSTD_convertBlockSequences vtk_zstd_ZSTD_convertBlockSequences
+#define ZSTD_copyCCtx vtk_zstd_ZSTD_copyCCtx
+#define ZSTD_copyDCtx vtk_zstd_ZSTD_copyDCtx
+#define ZSTD_copyDDictParameters vtk_zstd_ZSTD_copyDDictParameters
+#define ZSTD_createCCtx vtk_zstd_ZSTD_createCCtx
+#define ZSTD_createCCtxParams vtk_zstd_ZSTD_createCCtxParams
+#define ZSTD_createCCtx_advanced vtk_zstd_ZSTD_createCCtx_advanced
+#define ZSTD_createCDict vtk_zstd_ZSTD_createCDict
+#define ZSTD_createCDict_advanced vtk_zstd_ZSTD_createCDict_advanced
+#define ZSTD_createCDict_advanced2 vtk_zstd_ZSTD_createCDict_advanced2
+#define ZSTD_createCDict_byReference vtk_zstd_ZSTD_createCDict_byReference
+#define ZSTD_createCStream vtk_zstd_ZSTD_createCStream
+#define ZSTD_createCStream_advanced vtk_zstd_ZSTD_createCStream_advanced
+#define ZSTD_createDCtx vtk_zstd_ZSTD_createDCtx
+#define ZSTD_createDCtx_advanced vtk_zstd_ZSTD_createDCtx_advanced
+#define ZSTD_createDDict vtk_zstd_ZSTD_createDDict
+#define ZSTD_createDDict_advanced vtk_zstd_ZSTD_createDDict_advanced
+#define ZSTD_createDDict_byReference vtk_zstd_ZSTD_createDDict_byReference
+#define ZSTD_createDStream vtk_zstd_ZSTD_createDStream
+#define ZSTD_createDStream_advanced vtk_zstd_ZSTD_createDStream_advanced
+#define ZSTD_crossEntropyCost vtk_zstd_ZSTD_crossEntropyCost
+#define ZSTD_cycleLog vtk_zstd_ZSTD_cycleLog
+#define ZSTD_dParam_getBounds vtk_zstd_ZSTD_dParam_getBounds
+#define ZSTD_decodeLiteralsBlock_wrapper vtk_zstd_ZSTD_decodeLiteralsBlock_wrapper
+#define ZSTD_decodeSeqHeaders vtk_zstd_ZSTD_decodeSeqHeaders
+#define ZSTD_decodingBufferSize_min vtk_zstd_ZSTD_decodingBufferSize_min
+#define ZSTD_decompress vtk_zstd_ZSTD_decompress
+#define ZSTD_decompressBegin vtk_zstd_ZSTD_decompressBegin
+#define ZSTD_decompressBegin_usingDDict vtk_zstd_ZSTD_decompressBegin_usingDDict
+#define ZSTD_decompressBegin_usingDict vtk_zstd_ZSTD_decompressBegin_usingDict
+#define ZSTD_decompressBlock vtk_zstd_ZSTD_decompressBlock
+#define ZSTD_decompressBlock_deprecated vtk_zstd_ZSTD_decompressBlock_deprecated
+#define ZSTD_decompressBlock_internal vtk_zstd_ZSTD_decompressBlock_internal
+#define ZSTD_decompressBound vtk_zstd_ZSTD_decompressBound
+#define ZSTD_decompressContinue vtk_zstd_ZSTD_decompressContinue
+#define ZSTD_decompressDCtx vtk_zstd_ZSTD_decompressDCtx
+#define ZSTD_decompressStream vtk_zstd_ZSTD_decompressStream
+#define ZSTD_decompressStream_simpleArgs vtk_zstd_ZSTD_decompressStream_simpleArgs
+#define ZSTD_decompress_usingDDict vtk_zstd_ZSTD_decompress_usingDDict
+#define ZSTD_decompress_usingDict vtk_zstd_ZSTD_decompress_usingDict
+#define ZSTD_decompressionMargin vtk_zstd_ZSTD_decompressionMargin
+#define ZSTD_dedicatedDictSearch_lazy_loadDictionary vtk_zstd_ZSTD_dedicatedDictSearch_lazy_loadDictionary
+#define ZSTD_defaultCLevel vtk_zstd_ZSTD_defaultCLevel
+#define ZSTD_encodeSequences vtk_zstd_ZSTD_encodeSequences
+#define ZSTD_endStream vtk_zstd_ZSTD_endStream
+#define ZSTD_estimateCCtxSize vtk_zstd_ZSTD_estimateCCtxSize
+#define ZSTD_estimateCCtxSize_usingCCtxParams vtk_zstd_ZSTD_estimateCCtxSize_usingCCtxParams
+#define ZSTD_estimateCCtxSize_usingCParams vtk_zstd_ZSTD_estimateCCtxSize_usingCParams
+#define ZSTD_estimateCDictSize vtk_zstd_ZSTD_estimateCDictSize
+#define ZSTD_estimateCDictSize_advanced vtk_zstd_ZSTD_estimateCDictSize_advanced
+#define ZSTD_estimateCStreamSize vtk_zstd_ZSTD_estimateCStreamSize
+#define ZSTD_estimateCStreamSize_usingCCtxParams vtk_zstd_ZSTD_estimateCStreamSize_usingCCtxParams
+#define ZSTD_estimateCStreamSize_usingCParams vtk_zstd_ZSTD_estimateCStreamSize_usingCParams
+#define ZSTD_estimateDCtxSize vtk_zstd_ZSTD_estimateDCtxSize
+#define ZSTD_estimateDDictSize vtk_zstd_ZSTD_estimateDDictSize
+#define ZSTD_estimateDStreamSize vtk_zstd_ZSTD_estimateDStreamSize
+#define ZSTD_estimateDStreamSize_fromFrame vtk_zstd_ZSTD_estimateDStreamSize_fromFrame
+#define ZSTD_fillDoubleHashTable vtk_zstd_ZSTD_fillDoubleHashTable
+#define ZSTD_fillHashTable vtk_zstd_ZSTD_fillHashTable
+#define ZSTD_findDecompressedSize vtk_zstd_ZSTD_findDecompressedSize
+#define ZSTD_findFrameCompressedSize vtk_zstd_ZSTD_findFrameCompressedSize
+#define ZSTD_flushStream vtk_zstd_ZSTD_flushStream
+#define ZSTD_frameHeaderSize vtk_zstd_ZSTD_frameHeaderSize
+#define ZSTD_freeCCtx vtk_zstd_ZSTD_freeCCtx
+#define ZSTD_freeCCtxParams vtk_zstd_ZSTD_freeCCtxParams
+#define ZSTD_freeCDict vtk_zstd_ZSTD_freeCDict
+#define ZSTD_freeCStream vtk_zstd_ZSTD_freeCStream
+#define ZSTD_freeDCtx vtk_zstd_ZSTD_freeDCtx
+#define ZSTD_freeDDict vtk_zstd_ZSTD_freeDDict
+#define ZSTD_freeDStream vtk_zstd_ZSTD_freeDStream
+#define ZSTD_fseBitCost vtk_zstd_ZSTD_fseBitCost
+#define ZSTD_generateSequences vtk_zstd_ZSTD_generateSequences
+#define ZSTD_get1BlockSummary vtk_zstd_ZSTD_get1BlockSummary
+#define ZSTD_getBlockSize vtk_zstd_ZSTD_getBlockSize
+#define ZSTD_getCParams vtk_zstd_ZSTD_getCParams
+#define ZSTD_getCParamsFromCCtxParams vtk_zstd_ZSTD_getCParamsFromCCtxParams
+#define ZSTD_getCParamsFromCDict vtk_zstd_ZSTD_getCParamsFromCDict
+#define ZSTD_getDecompressedSize vtk_zstd_ZSTD_getDecompressedSize
+#define ZSTD_getDictID_fromCDict vtk_zstd_ZSTD_getDictID_fromCDict
+#define ZSTD_getDictID_fromDDict vtk_zstd_ZSTD_getDictID_fromDDict
+#define ZSTD_getDictID_fromDict vtk_zstd_ZSTD_getDictID_fromDict
+#define ZSTD_getDictID_fromFrame vtk_zstd_ZSTD_getDictID_fromFrame
+#define ZSTD_getErrorCode vtk_zstd_ZSTD_getErrorCode
+#define ZSTD_getErrorName vtk_zstd_ZSTD_getErrorName
+#define ZSTD_getErrorString vtk_zstd_ZSTD_getErrorString
+#define ZSTD_getFrameContentSize vtk_zstd_ZSTD_getFrameContentSize
+#define ZSTD_getFrameHeader vtk_zstd_ZSTD_getFrameHeader
+#define ZSTD_getFrameHeader_advanced vtk_zstd_ZSTD_getFrameHeader_advanced
+#define ZSTD_getFrameProgression vtk_zstd_ZSTD_getFrameProgression
+#define ZSTD_getParams vtk_zstd_ZSTD_getParams
+#define ZSTD_getSeqStore vtk_zstd_ZSTD_getSeqStore
+#define ZSTD_getcBlockSize vtk_zstd_ZSTD_getcBlockSize
+#define ZSTD_initCStream vtk_zstd_ZSTD_initCStream
+#define ZSTD_initCStream_advanced vtk_zstd_ZSTD_initCStream_advanced
+#define ZSTD_initCStream_internal vtk_zstd_ZSTD_initCStream_internal
+#define ZSTD_initCStream_srcSize vtk_zstd_ZSTD_initCStream_srcSize
+#define ZSTD_initCStream_usingCDict vtk_zstd_ZSTD_initCStream_usingCDict
+#define ZSTD_initCStream_usingCDict_advanced vtk_zstd_ZSTD_initCStream_usingCDict_advanced
+#define ZSTD_initCStream_usingDict vtk_zstd_ZSTD_initCStream_usingDict
+#define ZSTD_initDStream vtk_zstd_ZSTD_initDStream
+#define ZSTD_initDStream_usingDDict vtk_zstd_ZSTD_initDStream_usingDDict
+#define ZSTD_initDStream_usingDict vtk_zstd_ZSTD_initDStream_usingDict
+#define ZSTD_initStaticCCtx vtk_zstd_ZSTD_initStaticCCtx
+#define ZSTD_initStaticCDict vtk_zstd_ZSTD_initStaticCDict
+#define ZSTD_initStaticCStream vtk_zstd_ZSTD_initStaticCStream
+#define ZSTD_initStaticDCtx vtk_zstd_ZSTD_initStaticDCtx
+#define ZSTD_initStaticDDict vtk_zstd_ZSTD_initStaticDDict
+#define ZSTD_initStaticDStream vtk_zstd_ZSTD_initStaticDStream
+#define ZSTD_insertAndFindFirstIndex vtk_zstd_ZSTD_insertAndFindFirstIndex
+#define ZSTD_insertBlock vtk_zstd_ZSTD_insertBlock
+#define ZSTD_invalidateRepCodes vtk_zstd_ZSTD_invalidateRepCodes
+#define ZSTD_isError vtk_zstd_ZSTD_isError
+#define ZSTD_isFrame vtk_zstd_ZSTD_isFrame
+#define ZSTD_isSkippableFrame vtk_zstd_ZSTD_isSkippableFrame
+#define ZSTD_ldm_adjustParameters vtk_zstd_ZSTD_ldm_adjustParameters
+#define ZSTD_ldm_blockCompress vtk_zstd_ZSTD_ldm_blockCompress
+#define ZSTD_ldm_fillHashTable vtk_zstd_ZSTD_ldm_fillHashTable
+#define ZSTD_ldm_generateSequences vtk_zstd_ZSTD_ldm_generateSequences
+#define ZSTD_ldm_getMaxNbSeq vtk_zstd_ZSTD_ldm_getMaxNbSeq
+#define ZSTD_ldm_getTableSize vtk_zstd_ZSTD_ldm_getTableSize
+#define ZSTD_ldm_skipRawSeqStoreBytes vtk_zstd_ZSTD_ldm_skipRawSeqStoreBytes
+#define ZSTD_ldm_skipSequences vtk_zstd_ZSTD_ldm_skipSequences
+#define ZSTD_loadCEntropy vtk_zstd_ZSTD_loadCEntropy
+#define ZSTD_loadDEntropy vtk_zstd_ZSTD_loadDEntropy
+#define ZSTD_maxCLevel vtk_zstd_ZSTD_maxCLevel
+#define ZSTD_mergeBlockDelimiters vtk_zstd_ZSTD_mergeBlockDelimiters
+#define ZSTD_minCLevel vtk_zstd_ZSTD_minCLevel
+#define ZSTD_nextInputType vtk_zstd_ZSTD_nextInputType
+#define ZSTD_nextSrcSizeToDecompress vtk_zstd_ZSTD_nextSrcSizeToDecompress
+#define ZSTD_noCompressLiterals vtk_zstd_ZSTD_noCompressLiterals
+#define ZSTD_readSkippableFrame vtk_zstd_ZSTD_readSkippableFrame
+#define ZSTD_referenceExternalSequences vtk_zstd_ZSTD_referenceExternalSequences
+#define ZSTD_registerSequenceProducer vtk_zstd_ZSTD_registerSequenceProducer
+#define ZSTD_resetCStream vtk_zstd_ZSTD_resetCStream
+#define ZSTD_resetDStream vtk_zstd_ZSTD_resetDStream
+#define ZSTD_resetSeqStore vtk_zstd_ZSTD_resetSeqStore
+#define ZSTD_reset_compressedBlockState vtk_zstd_ZSTD_reset_compressedBlockState
+#define ZSTD_row_update vtk_zstd_ZSTD_row_update
+#define ZSTD_selectBlockCompressor vtk_zstd_ZSTD_selectBlockCompressor
+#define ZSTD_selectEncodingType vtk_zstd_ZSTD_selectEncodingType
+#define ZSTD_seqToCodes vtk_zstd_ZSTD_seqToCodes
+#define ZSTD_sequenceBound vtk_zstd_ZSTD_sequenceBound
+#define ZSTD_sizeof_CCtx vtk_zstd_ZSTD_sizeof_CCtx
+#define ZSTD_sizeof_CDict vtk_zstd_ZSTD_sizeof_CDict
+#define ZSTD_sizeof_CStream vtk_zstd_ZSTD_sizeof_CStream
+#define ZSTD_sizeof_DCtx vtk_zstd_ZSTD_sizeof_DCtx
+#define ZSTD_sizeof_DDict vtk_zstd_ZSTD_sizeof_DDict
+#define ZSTD_sizeof_DStream vtk_zstd_ZSTD_sizeof_DStream
+#define ZSTD_splitBlock vtk_zstd_ZSTD_splitBlock
+#define ZSTD_toFlushNow vtk_zstd_ZSTD_toFlushNow
+#define ZSTD_updateTree vtk_zstd_ZSTD_updateTree
+#define ZSTD_versionNumber vtk_zstd_ZSTD_versionNumber
+#define ZSTD_versionString vtk_zstd_ZSTD_versionString
+#define ZSTD_writeLastEmptyBlock vtk_zstd_ZSTD_writeLastEmptyBlock
+#define ZSTD_writeSkippableFrame vtk_zstd_ZSTD_writeSkippableFrame
+#define g_ZSTD_threading_useless_symbol vtk_zstd_g_ZSTD_threading_useless_symbol
+#define g_debuglevel vtk_zstd_g_debuglevel
+
+#endif